@@ -0,0 +1,17 @@
+#!/bin/sh
+# Usage: copy-resources.sh <project dir> <dist dir> <build dir>
+
+builddir="$1/$3"
+distdir="$1/$2"
+
+mkdir -p "$distdir/fonts" "$distdir/images"
+
+cp "$builddir/benchmark" "$distdir"
+
+cp "$1"/../../resources/common/fonts/* "$distdir/fonts"
+cp "$1"/../../resources/common/images/* "$distdir/images"
+cp "$1"/../../resources/simpleskin/fonts/* "$distdir/fonts"
+cp "$1"/../../resources/simpleskin/images/* "$distdir/images"
+
+rm -f "$distdir/fonts/.cvsignore" "$distdir/images/.cvsignore"
+exit 0
@@ -0,0 +1,63 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include "Headers.h"
+
+
+BatchRecorder::BatchRecorder()
+{
+	ASSERTION_COBJECT(this);
+	textureCount = 0;
+}
+
+void BatchRecorder::clear()
+{
+	ASSERTION_COBJECT(this);
+
+	batches = "";
+	textureCount = 0;
+}
+
+const String & BatchRecorder::getBatches()
+{
+	ASSERTION_COBJECT(this);
+	return batches;
+}
+
+int BatchRecorder::getTextureNo(Image * texture)
+{
+	ASSERTION_COBJECT(this);
+
+	for (int textureNo = 0; textureNo < textureCount; textureNo++)
+		if (textures[textureNo] == texture)
+			return textureNo;
+
+	if (textureCount >= MAXIMUM_TEXTURES)
+		throw EILLEGALSTATE("The batch recorder supports up to 8 different textures");
+
+	textures[textureCount] = texture;
+	return textureCount++;
+}
+
+void BatchRecorder::submitPrimitives(PrimitiveBatcher::PrimitiveType type, Image * texture,
+	PlatformAdapter::BlendType blendType, const PrimitiveBatcher::Vertex * vertices, int vertexCount)
+{
+	ASSERTION_COBJECT(this);
+
+	String batch;
+	if (texture != NULL)
+		batch.Format("%s%c%d:%d/%d", batches.IsEmpty() ? "" : " ",
+			type == PrimitiveBatcher::PRIMITIVETYPE_LINES ? 'L' : 'T', vertexCount,
+			getTextureNo(texture), (int) blendType);
+	else
+		batch.Format("%s%c%d", batches.IsEmpty() ? "" : " ",
+			type == PrimitiveBatcher::PRIMITIVETYPE_LINES ? 'L' : 'T', vertexCount);
+
+	batches += batch;
+}
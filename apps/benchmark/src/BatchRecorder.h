@@ -0,0 +1,51 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __BATCHRECORDER_H
+#define __BATCHRECORDER_H
+
+
+/**
+ * The batch recorder is a primitive batcher backend that records the batches
+ * submitted to it instead of drawing them. The batching check compares the records
+ * with the batches expected for known primitive sequences.
+ * Each batch is recorded as its primitive type (L for lines, T for triangles)
+ * and vertex count, followed by the texture number (in the order of the textures'
+ * first submission) and the blend type number for textured batches.
+ * Batches are separated by blanks, e.g. "T12 L2 T6:0/0".
+ * @see BatchingCheck
+ */
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	class BatchRecorder : public CObject, public PrimitiveBatcher::Backend
+#else
+	class BatchRecorder : public PrimitiveBatcher::Backend
+#endif
+{
+	public:
+
+		static const int MAXIMUM_TEXTURES = 8;
+
+	private:
+
+		String batches;
+		int textureCount;
+		Image * textures[MAXIMUM_TEXTURES];
+
+		int getTextureNo(Image * texture);
+
+	public:
+
+		BatchRecorder();
+		void clear();
+		const String & getBatches();
+		virtual void submitPrimitives(PrimitiveBatcher::PrimitiveType type, Image * texture,
+			PlatformAdapter::BlendType blendType, const PrimitiveBatcher::Vertex * vertices, int vertexCount);
+};
+
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include "Headers.h"
+
+
+bool BatchingCheck::expect(const char * name, PrimitiveBatcher * batcher, BatchRecorder * recorder,
+	const char * expectedBatches, unsigned long expectedPrimitives)
+{
+	batcher->flush();
+
+	// The recorded batches imply the batch count, but the batcher counts on its own
+	int expectedBatchCount = 0;
+	for (const char * character = expectedBatches; *character != 0; character++)
+		if (*character == 'L' || *character == 'T')
+			expectedBatchCount++;
+
+	bool passed = recorder->getBatches().Equals(expectedBatches)
+		&& batcher->getBatchCount() == (unsigned long) expectedBatchCount
+		&& batcher->getPrimitiveCount() == expectedPrimitives;
+	if (!passed)
+		fprintf(stderr, "Batching check %s failed: expected batches \"%s\" (%d batches, %lu primitives),"
+			" got \"%s\" (%lu batches, %lu primitives)\n", name, expectedBatches, expectedBatchCount,
+			expectedPrimitives, (const char *) recorder->getBatches(), batcher->getBatchCount(),
+			batcher->getPrimitiveCount());
+
+	recorder->clear();
+	batcher->resetStatistics();
+	return passed;
+}
+
+int BatchingCheck::run()
+{
+	int failures = 0;
+
+	BatchRecorder * recorder;
+	if ((recorder = new BatchRecorder) == NULL)
+		throw EOUTOFMEMORY;
+
+	PrimitiveBatcher * batcher;
+	if ((batcher = new PrimitiveBatcher(recorder, CAPACITY)) == NULL)
+		throw EOUTOFMEMORY;
+
+	// The batcher only compares textures, they are never loaded
+	ArrayList<Image> textures;
+	Image * texture;
+	if ((texture = new SoftwareImage("a.png", Image::TYPE_RGB_ALPHA)) == NULL)
+		throw EOUTOFMEMORY;
+	textures.Append(texture);
+	if ((texture = new SoftwareImage("b.png", Image::TYPE_RGB_ALPHA)) == NULL)
+		throw EOUTOFMEMORY;
+	textures.Append(texture);
+
+	float xs[4] = {0.0f, 10.0f, 0.0f, 10.0f};
+	float ys[4] = {0.0f, 0.0f, 10.0f, 10.0f};
+
+	// Consecutive untextured triangles merge into one batch
+	batcher->addRect(0.0f, 0.0f, 10.0f, 10.0f, GL_WHITE);
+	batcher->addTriangle(xs, ys, GL_WHITE);
+	if (!expect("triangles", batcher, recorder, "T9", 3))
+		failures++;
+
+	// A different primitive type splits the batch
+	batcher->addRect(0.0f, 0.0f, 10.0f, 10.0f, GL_WHITE);
+	batcher->addLine(0.0f, 0.0f, 10.0f, 10.0f, GL_WHITE);
+	batcher->addLine(10.0f, 0.0f, 0.0f, 10.0f, GL_WHITE);
+	batcher->addRect(0.0f, 0.0f, 10.0f, 10.0f, GL_WHITE);
+	if (!expect("types", batcher, recorder, "T6 L4 T6", 6))
+		failures++;
+
+	// A full batch is submitted before the next primitive
+	batcher->addRect(0.0f, 0.0f, 10.0f, 10.0f, GL_WHITE);
+	batcher->addRect(0.0f, 0.0f, 10.0f, 10.0f, GL_WHITE);
+	batcher->addRect(0.0f, 0.0f, 10.0f, 10.0f, GL_WHITE);
+	if (!expect("capacity", batcher, recorder, "T12 T6", 6))
+		failures++;
+
+	// Quads of the same texture and blend type merge, e.g. the glyphs of a text
+	batcher->addQuad(textures.Get(0), PlatformAdapter::BLENDTYPE_NORMAL, xs, ys,
+		0.0f, 0.0f, 8.0f, 8.0f, GL_WHITE);
+	batcher->addQuad(textures.Get(0), PlatformAdapter::BLENDTYPE_NORMAL, xs, ys,
+		8.0f, 0.0f, 8.0f, 8.0f, GL_WHITE);
+	batcher->addQuad(textures.Get(1), PlatformAdapter::BLENDTYPE_NORMAL, xs, ys,
+		0.0f, 0.0f, 8.0f, 8.0f, GL_WHITE);
+	batcher->addQuad(textures.Get(1), PlatformAdapter::BLENDTYPE_STENCIL, xs, ys,
+		0.0f, 0.0f, 8.0f, 8.0f, GL_WHITE);
+	batcher->addRect(0.0f, 0.0f, 10.0f, 10.0f, GL_WHITE);
+	String expectedBatches;
+	expectedBatches.Format("T12:0/%d T6:1/%d T6:1/%d T6", (int) PlatformAdapter::BLENDTYPE_NORMAL,
+		(int) PlatformAdapter::BLENDTYPE_NORMAL, (int) PlatformAdapter::BLENDTYPE_STENCIL);
+	if (!expect("textures", batcher, recorder, expectedBatches, 10))
+		failures++;
+
+	// Flushing nothing submits nothing, discarded primitives are counted but not submitted
+	batcher->flush();
+	batcher->addRect(0.0f, 0.0f, 10.0f, 10.0f, GL_WHITE);
+	batcher->discard();
+	if (!expect("discard", batcher, recorder, "", 2))
+		failures++;
+
+	delete batcher;
+	delete recorder;
+
+	return failures;
+}
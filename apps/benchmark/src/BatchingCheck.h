@@ -0,0 +1,35 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __BATCHINGCHECK_H
+#define __BATCHINGCHECK_H
+
+
+/**
+ * The batching check feeds known primitive sequences into a primitive batcher
+ * with a batch recorder backend, and compares the submitted batches and the batch
+ * and primitive counts with the expected ones. It does not require a desktop.
+ * Run it using benchmark --check-batching.
+ * @see BatchRecorder
+ */
+class BatchingCheck
+{
+	private:
+
+		static const int CAPACITY = 12;
+
+		static bool expect(const char * name, PrimitiveBatcher * batcher, BatchRecorder * recorder,
+			const char * expectedBatches, unsigned long expectedPrimitives);
+
+	public:
+
+		static int run();
+};
+
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include "Headers.h"
+
+
+BenchmarkAdapter::BenchmarkAdapter()
+{
+	ASSERTION_COBJECT(this);
+	callCount = 0;
+}
+
+void BenchmarkAdapter::clear(DrawingContext & context, unsigned long fillColor)
+{
+	ASSERTION_COBJECT(this);
+
+	callCount++;
+	SoftwarePlatformAdapter::clear(context, fillColor);
+}
+
+void BenchmarkAdapter::drawEllipse(DrawingContext & context, Vector center, Vector radius,
+	unsigned long fillColor, unsigned long borderColor)
+{
+	ASSERTION_COBJECT(this);
+
+	callCount++;
+	SoftwarePlatformAdapter::drawEllipse(context, center, radius, fillColor, borderColor);
+}
+
+void BenchmarkAdapter::drawImage(DrawingContext & context, Image * image,
+	Vector sourcePosition, Vector sourceSize, Vector targetPosition, Vector targetSize,
+	unsigned long modulationColor, BlendType blendType)
+{
+	ASSERTION_COBJECT(this);
+
+	callCount++;
+	SoftwarePlatformAdapter::drawImage(context, image, sourcePosition, sourceSize,
+		targetPosition, targetSize, modulationColor, blendType);
+}
+
+void BenchmarkAdapter::drawLine(DrawingContext & context, Vector from, Vector to,
+	unsigned long color)
+{
+	ASSERTION_COBJECT(this);
+
+	callCount++;
+	SoftwarePlatformAdapter::drawLine(context, from, to, color);
+}
+
+void BenchmarkAdapter::drawPixel(DrawingContext & context, Vector position,
+	unsigned long color)
+{
+	ASSERTION_COBJECT(this);
+
+	callCount++;
+	SoftwarePlatformAdapter::drawPixel(context, position, color);
+}
+
+void BenchmarkAdapter::drawRect(DrawingContext & context, Vector from, Vector to,
+	unsigned long fillColor, unsigned long borderColor)
+{
+	ASSERTION_COBJECT(this);
+
+	callCount++;
+	SoftwarePlatformAdapter::drawRect(context, from, to, fillColor, borderColor);
+}
+
+void BenchmarkAdapter::drawRotatedImage(DrawingContext & context, Image * image,
+	Vector sourcePosition, Vector sourceSize, Vector targetPosition, Vector targetSize,
+	Vector rotationAnchor, double rotationAngle,
+	unsigned long modulationColor, BlendType blendType)
+{
+	ASSERTION_COBJECT(this);
+
+	callCount++;
+	SoftwarePlatformAdapter::drawRotatedImage(context, image, sourcePosition, sourceSize,
+		targetPosition, targetSize, rotationAnchor, rotationAngle, modulationColor, blendType);
+}
+
+void BenchmarkAdapter::drawTriangle(DrawingContext & context, Vector * vertices,
+	unsigned long fillColor, unsigned long borderColor)
+{
+	ASSERTION_COBJECT(this);
+
+	callCount++;
+	SoftwarePlatformAdapter::drawTriangle(context, vertices, fillColor, borderColor);
+}
+
+unsigned long BenchmarkAdapter::getCallCount()
+{
+	ASSERTION_COBJECT(this);
+	return callCount;
+}
@@ -0,0 +1,48 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __BENCHMARKADAPTER_H
+#define __BENCHMARKADAPTER_H
+
+
+/**
+ * The benchmark adapter is a software platform adapter that counts
+ * the drawing operations issued by the desktop.
+ */
+class BenchmarkAdapter : public SoftwarePlatformAdapter
+{
+	private:
+
+		unsigned long callCount;
+
+	public:
+
+		BenchmarkAdapter();
+		virtual void clear(DrawingContext & context, unsigned long fillColor = GL_TRANSPARENCY);
+		virtual void drawEllipse(DrawingContext & context, Vector center, Vector radius,
+			unsigned long fillColor, unsigned long borderColor);
+		virtual void drawImage(DrawingContext & context, Image * image,
+			Vector sourcePosition, Vector sourceSize, Vector targetPosition, Vector targetSize,
+			unsigned long modulationColor = GL_WHITE, BlendType blendType = BLENDTYPE_NORMAL);
+		virtual void drawLine(DrawingContext & context, Vector from, Vector to,
+			unsigned long color);
+		virtual void drawPixel(DrawingContext & context, Vector position,
+			unsigned long color);
+		virtual void drawRect(DrawingContext & context, Vector from, Vector to,
+			unsigned long fillColor, unsigned long borderColor);
+		virtual void drawRotatedImage(DrawingContext & context, Image * image,
+			Vector sourcePosition, Vector sourceSize, Vector targetPosition, Vector targetSize,
+			Vector rotationAnchor, double rotationAngle,
+			unsigned long modulationColor = GL_WHITE, BlendType blendType = BLENDTYPE_NORMAL);
+		virtual void drawTriangle(DrawingContext & context, Vector * vertices,
+			unsigned long fillColor, unsigned long borderColor);
+		unsigned long getCallCount();
+};
+
+
+#endif
@@ -0,0 +1,34 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include "Headers.h"
+
+
+unsigned long BenchmarkLayouter::passCount = 0;
+
+unsigned long BenchmarkLayouter::getPassCount()
+{
+	return passCount;
+}
+
+bool BenchmarkLayouter::layout(FieldsArea * fieldsArea, bool resizeArea)
+{
+	ASSERTION_COBJECT(this);
+
+	passCount++;
+	return GridLayouter::layout(fieldsArea, resizeArea);
+}
+
+bool BenchmarkLayouter::layout(GroupField * groupField, bool resizeGroupField)
+{
+	ASSERTION_COBJECT(this);
+
+	passCount++;
+	return GridLayouter::layout(groupField, resizeGroupField);
+}
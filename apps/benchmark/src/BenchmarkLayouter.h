@@ -0,0 +1,31 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __BENCHMARKLAYOUTER_H
+#define __BENCHMARKLAYOUTER_H
+
+
+/**
+ * The benchmark layouter is a grid layouter that counts its layout passes.
+ * The benchmark scene installs it in all fields areas it creates.
+ */
+class BenchmarkLayouter : public GridLayouter
+{
+	private:
+
+		static unsigned long passCount;
+
+	public:
+
+		static unsigned long getPassCount();
+		virtual bool layout(FieldsArea * fieldsArea, bool resizeArea);
+		virtual bool layout(GroupField * groupField, bool resizeGroupField);
+};
+
+
+#endif
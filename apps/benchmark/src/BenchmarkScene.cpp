@@ -0,0 +1,648 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include "Headers.h"
+
+
+const char * BenchmarkScene::ID = "BenchmarkScene";
+
+const char * BenchmarkScene::SCENARIO_NAMES[SCENARIO_COUNT] =
+	{"windows", "list", "tree", "text", "grid", "idle"};
+
+BenchmarkScene::BenchmarkScene(int frameCount, int scale, const bool * enabled)
+{
+	ASSERTION_COBJECT(this);
+
+	int scenarioNo;
+	for (scenarioNo = 0; scenarioNo < SCENARIO_COUNT; scenarioNo++)
+	{
+		this->enabled[scenarioNo] = enabled[scenarioNo];
+		setupMicroseconds[scenarioNo] = 0;
+	}
+
+	this->frameCount = frameCount;
+	frameNo = -1;
+	frames = NULL;
+	inputField = NULL;
+	labelCount = 0;
+	labels = NULL;
+	lastAdapterCalls = 0;
+	lastAllocations = 0;
+	lastCpuMicroseconds = 0;
+	lastLayoutPasses = 0;
+	randomSeed = 1;
+	this->scale = scale;
+	this->scenarioNo = -1;
+
+	if ((frames = new Frame[SCENARIO_COUNT * frameCount]) == NULL)
+		throw EOUTOFMEMORY;
+	memset(frames, 0, SCENARIO_COUNT * frameCount * sizeof(Frame));
+
+	// All scenarios run on the same, fixed screen size
+	setDesiredWidth(1280);
+	setDesiredHeight(1024);
+}
+
+BenchmarkScene::~BenchmarkScene()
+{
+	ASSERTION_COBJECT(this);
+
+	if (frames != NULL) {delete[] frames; frames = NULL;}
+	if (labels != NULL) {delete[] labels; labels = NULL;}
+}
+
+void BenchmarkScene::beginScenario()
+{
+	ASSERTION_COBJECT(this);
+
+	// The same scenario is always built and driven the same way
+	randomSeed = 1;
+	inputField = NULL;
+
+	unsigned long setupStart = getCpuMicroseconds();
+
+	switch (scenarioNo)
+	{
+		case SCENARIO_WINDOWS:
+			buildWindows();
+			break;
+
+		case SCENARIO_LIST:
+			buildList();
+			break;
+
+		case SCENARIO_TREE:
+			buildTree();
+			break;
+
+		case SCENARIO_TEXT:
+			buildText();
+			break;
+
+		case SCENARIO_GRID:
+			buildGrid();
+			break;
+
+		case SCENARIO_IDLE:
+			buildWindows();
+
+			// Attribute the allocations to the profiler zones
+			Desktop::getInstance()->getProfiler().setEnabled(true);
+			break;
+	}
+
+	setupMicroseconds[scenarioNo] = getCpuMicroseconds() - setupStart;
+	pointerPosition = pointerCenter;
+}
+
+void BenchmarkScene::buildGrid()
+{
+	ASSERTION_COBJECT(this);
+
+	// A dialog with 500 fields, i.e. label and text field pairs in a 10 column grid
+	FieldsArea * area = createFieldsArea(10);
+	labelCount = getScaled(250);
+	if ((labels = new Label *[labelCount]) == NULL)
+		throw EOUTOFMEMORY;
+
+	for (int fieldNo = 0; fieldNo < labelCount; fieldNo++)
+	{
+		String text;
+		text.Format("Field %d", fieldNo);
+		GLAZIERY_LABEL(label, area, NULL, text)
+		GLAZIERY_FIELDLAYOUTDATA(label, END, CENTER, 1)
+		labels[fieldNo] = label;
+
+		GLAZIERY_TEXTFIELD(textField, area, NULL, false)
+		GLAZIERY_FIELDLAYOUTDATA(textField, FILL, CENTER, 1)
+		textField->setText(text);
+
+		if (fieldNo == 0)
+			inputField = textField;
+	}
+
+	area->setAutoLayouting(true, false);
+
+	Vector position(20, 20);
+	Vector size(1240, 980);
+	createWindow(area, "Grid", position, size);
+	pointerCenter = position + size / 2;
+	pointerRadius = size / 3;
+}
+
+void BenchmarkScene::buildList()
+{
+	ASSERTION_COBJECT(this);
+
+	SingleFieldArea * area;
+	if ((area = new SingleFieldArea) == NULL)
+		throw EOUTOFMEMORY;
+
+	GLAZIERY_LISTFIELD(listField, NULL, NULL, true, true, MANY)
+	area->setContentField(listField);
+	inputField = listField;
+
+	GLAZIERY_LISTFIELD_COLUMN_S(column1, listField, 100, false, RIGHT, "Number")
+	GLAZIERY_LISTFIELD_COLUMN_S(column2, listField, 300, false, LEFT, "Name")
+	GLAZIERY_LISTFIELD_COLUMN_S(column3, listField, 200, false, RIGHT, "Value")
+
+	static const char * names[] = {"Smith", "Bella", "Dowell", "Sandell", "Fork", "Pratt", "Powers", "Tott"};
+	int rowCount = getScaled(1000000);
+	for (int rowNo = 0; rowNo < rowCount; rowNo++)
+	{
+		GLAZIERY_LISTFIELD_ROW(row, listField)
+
+		String text;
+		text.Format("%d", rowNo);
+		GLAZIERY_LISTFIELD_CELL(cell1, row)
+		GLAZIERY_LISTFIELD_TEXTELEMENT(element1, cell1, text)
+
+		GLAZIERY_LISTFIELD_CELL(cell2, row)
+		GLAZIERY_LISTFIELD_TEXTELEMENT(element2, cell2, names[getRandom(8)])
+
+		text.Format("%d", getRandom(100000));
+		GLAZIERY_LISTFIELD_CELL(cell3, row)
+		GLAZIERY_LISTFIELD_TEXTELEMENT(element3, cell3, text)
+	}
+
+	Vector position(20, 20);
+	Vector size(1240, 980);
+	createWindow(area, "List", position, size);
+	listField->setFocus();
+	pointerCenter = position + size / 2;
+	pointerRadius = size / 3;
+}
+
+void BenchmarkScene::buildText()
+{
+	ASSERTION_COBJECT(this);
+
+	SingleFieldArea * area;
+	if ((area = new SingleFieldArea) == NULL)
+		throw EOUTOFMEMORY;
+
+	GLAZIERY_TEXTFIELD(textField, NULL, NULL, true)
+	area->setContentField(textField);
+	inputField = textField;
+
+	// Compose the text in one buffer, appending line by line would be quadratic
+	static const char * line = "The quick brown fox jumps over the lazy dog.";
+	int lineCount = getScaled(100000);
+	int lineLength = (int) strlen(line) + 16;
+	char * buffer;
+	if ((buffer = new char[lineCount * lineLength + 1]) == NULL)
+		throw EOUTOFMEMORY;
+
+	char * end = buffer;
+	for (int lineNo = 0; lineNo < lineCount; lineNo++)
+		end += sprintf(end, lineNo < lineCount - 1 ? "%06d %s\n" : "%06d %s", lineNo, line);
+
+	textField->setText(buffer);
+	delete[] buffer;
+
+	Vector position(20, 20);
+	Vector size(1240, 980);
+	createWindow(area, "Text", position, size);
+	textField->setFocus();
+	pointerCenter = position + size / 2;
+	pointerRadius = size / 3;
+}
+
+void BenchmarkScene::buildTree()
+{
+	ASSERTION_COBJECT(this);
+
+	SingleFieldArea * area;
+	if ((area = new SingleFieldArea) == NULL)
+		throw EOUTOFMEMORY;
+
+	TreeField * treeField;
+	if ((treeField = new TreeField) == NULL)
+		throw EOUTOFMEMORY;
+	area->setContentField(treeField);
+	treeField->setType(TreeField::TYPE_ONE);
+	inputField = treeField;
+
+	// Build the tree breadth first, alternating 4 and 3 children per level,
+	// so 200000 nodes span 10 levels
+	int nodeCount = getScaled(200000);
+	TreeField::Item ** items;
+	if ((items = new TreeField::Item *[nodeCount]) == NULL)
+		throw EOUTOFMEMORY;
+	int * levels;
+	if ((levels = new int[nodeCount]) == NULL)
+		throw EOUTOFMEMORY;
+
+	int count = 0;
+	int parentNo = 0;
+	while (count < nodeCount)
+	{
+		TreeField::Item * parent = NULL;
+		int level = 1;
+		int children = 2;
+		if (count >= 2)
+		{
+			parent = items[parentNo];
+			level = levels[parentNo] + 1;
+			children = level % 2 == 0 ? 4 : 3;
+			parentNo++;
+		}
+
+		if (level > 10)
+			break;
+
+		for (int childNo = 0; childNo < children && count < nodeCount; childNo++)
+		{
+			TreeField::Item * item;
+			if ((item = new TreeField::Item) == NULL)
+				throw EOUTOFMEMORY;
+
+			if (parent == NULL)
+				treeField->appendRoot(item);
+			else
+				parent->appendChild(item);
+
+			String text;
+			text.Format("Node %d", count);
+			TextElement * element;
+			if ((element = new TextElement) == NULL)
+				throw EOUTOFMEMORY;
+			item->appendElement(element);
+			element->setText(text);
+
+			items[count] = item;
+			levels[count] = level;
+			count++;
+		}
+	}
+
+	for (int rootNo = 0; rootNo < count && levels[rootNo] == 1; rootNo++)
+		items[rootNo]->setExpanded(true, true);
+
+	delete[] items;
+	delete[] levels;
+
+	Vector position(20, 20);
+	Vector size(1240, 980);
+	createWindow(area, "Tree", position, size);
+	treeField->setFocus();
+	pointerCenter = position + size / 2;
+	pointerRadius = size / 3;
+}
+
+void BenchmarkScene::buildWindows()
+{
+	ASSERTION_COBJECT(this);
+
+	// 50 overlapping windows with some fields each
+	int windowCount = getScaled(50);
+	for (int windowNo = 0; windowNo < windowCount; windowNo++)
+	{
+		FieldsArea * area = createFieldsArea(2);
+		for (int fieldNo = 0; fieldNo < 3; fieldNo++)
+		{
+			String text;
+			text.Format("Field %d", fieldNo);
+			GLAZIERY_LABEL(label, area, NULL, text)
+			GLAZIERY_FIELDLAYOUTDATA(label, END, CENTER, 1)
+
+			GLAZIERY_TEXTFIELD(textField, area, NULL, false)
+			GLAZIERY_FIELDLAYOUTDATA(textField, FILL, CENTER, 1)
+			textField->setText(text);
+
+			if (fieldNo == 0)
+				inputField = textField;
+		}
+
+		GLAZIERY_BUTTON(button, area, NULL, "Button", NULL)
+		GLAZIERY_FIELDLAYOUTDATA(button, CENTER, CENTER, 2)
+
+		area->setAutoLayouting(true, false);
+
+		String title;
+		title.Format("Window %d", windowNo);
+		createWindow(area, title, Vector(20 + (windowNo % 10) * 80 + (windowNo / 10) * 20,
+			20 + (windowNo % 10) * 60 + (windowNo / 10) * 30), Vector(360, 220));
+	}
+
+	pointerCenter = Vector(640, 512);
+	pointerRadius = Vector(560, 440);
+}
+
+int BenchmarkScene::compareTimes(const void * time1, const void * time2)
+{
+	unsigned long value1 = *(const unsigned long *) time1;
+	unsigned long value2 = *(const unsigned long *) time2;
+	return value1 < value2 ? -1 : value1 > value2 ? 1 : 0;
+}
+
+FieldsArea * BenchmarkScene::createFieldsArea(int columns)
+{
+	ASSERTION_COBJECT(this);
+
+	FieldsArea * area;
+	if ((area = new FieldsArea) == NULL)
+		throw EOUTOFMEMORY;
+
+	BenchmarkLayouter * layouter;
+	if ((layouter = new BenchmarkLayouter) == NULL)
+		throw EOUTOFMEMORY;
+	area->setLayouter(layouter);
+
+	GLAZIERY_FIELDSAREALAYOUTDATA(area, columns)
+	return area;
+}
+
+Window * BenchmarkScene::createWindow(ClientArea * clientArea, const String & title,
+	Vector position, Vector size)
+{
+	ASSERTION_COBJECT(this);
+
+	Window * window;
+	if ((window = new Window) == NULL)
+		throw EOUTOFMEMORY;
+	Desktop::getInstance()->addWindow(window);
+
+	window->setClientArea(clientArea);
+	window->setTitle(title);
+	window->moveTo(position);
+	window->resize(size);
+
+	return window;
+}
+
+void BenchmarkScene::emitInput()
+{
+	ASSERTION_COBJECT(this);
+
+	Desktop * desktop = Desktop::getInstance();
+	PlatformAdapter * adapter = desktop->getPlatformAdapter();
+
+	// Move the pointer along a Lissajous figure over the scenario's components
+	Vector oldPosition = pointerPosition;
+	pointerPosition = pointerCenter + Vector((int) (pointerRadius.x * sin(frameNo * 0.05)),
+		(int) (pointerRadius.y * sin(frameNo * 0.07)));
+	adapter->getMouseHandler()->setPointerPosition(pointerPosition);
+
+	InputEvent * event;
+	if ((event = new PointerMoveEvent(false, false, oldPosition, pointerPosition)) == NULL)
+		throw EOUTOFMEMORY;
+	desktop->addEvent(event);
+
+	// Scroll down and up again
+	if (frameNo % 2 == 0)
+	{
+		if ((event = new PointerWheelEvent(false, false, frameNo % 120 < 60 ? -3 : 3)) == NULL)
+			throw EOUTOFMEMORY;
+		desktop->addEvent(event);
+	}
+
+	// Navigate in the focused field
+	if (inputField != NULL && frameNo % 5 == 0)
+	{
+		SpecialEvent::Type type = frameNo % 50 == 0 ? SpecialEvent::EVENT_PAGE_DOWN
+			: scenarioNo == SCENARIO_GRID ? SpecialEvent::EVENT_TAB : SpecialEvent::EVENT_MOVE_DOWN;
+		if ((event = new SpecialEvent(false, false, 0, false, true, false, 0, type)) == NULL)
+			throw EOUTOFMEMORY;
+		desktop->addEvent(event);
+	}
+
+	// Shuffle and move the windows
+	const ArrayList<Window> & windows = desktop->getWindows();
+	if (scenarioNo == SCENARIO_WINDOWS && frameNo % 3 == 0 && !windows.IsEmpty())
+	{
+		Window * window = windows.Get(getRandom(windows.GetCount()));
+		window->bringToFront(false);
+		window->moveTo(window->getPosition() + Vector(getRandom(9) - 4, getRandom(9) - 4));
+	}
+
+	// Change labels, which requires relayouting
+	if (scenarioNo == SCENARIO_GRID && frameNo % 10 == 0 && labelCount > 0)
+	{
+		String text;
+		text.Format("Changed field %d", frameNo);
+		labels[getRandom(labelCount)]->setText(text);
+	}
+}
+
+void BenchmarkScene::endScenario()
+{
+	ASSERTION_COBJECT(this);
+
+	Desktop * desktop = Desktop::getInstance();
+
+	// Report the allocations of the idle steady state by phase and zone, before tearing down
+	if (scenarioNo == SCENARIO_IDLE)
+	{
+		desktop->getProfiler().logFrameStatistics();
+		desktop->getProfiler().setEnabled(false);
+	}
+
+	while (!desktop->getWindows().IsEmpty())
+		desktop->getWindows().Get(0)->destroy();
+
+	inputField = NULL;
+	labelCount = 0;
+	if (labels != NULL) {delete[] labels; labels = NULL;}
+}
+
+unsigned long BenchmarkScene::getCpuMicroseconds()
+{
+	struct timespec now;
+	if (::clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now) != 0)
+		return 0;
+
+	return (unsigned long) now.tv_sec * 1000000UL + (unsigned long) (now.tv_nsec / 1000L);
+}
+
+const char * BenchmarkScene::getId()
+{
+	ASSERTION_COBJECT(this);
+	return ID;
+}
+
+unsigned long BenchmarkScene::getIdleAllocations()
+{
+	ASSERTION_COBJECT(this);
+
+	if (!enabled[SCENARIO_IDLE])
+		return 0;
+
+	Frame * idleFrames = frames + SCENARIO_IDLE * frameCount;
+	unsigned long allocations = 0;
+	for (int frameNo = getSteadyStateStart(); frameNo < frameCount; frameNo++)
+		allocations += idleFrames[frameNo].allocations;
+
+	return allocations;
+}
+
+int BenchmarkScene::getRandom(int range)
+{
+	ASSERTION_COBJECT(this);
+
+	randomSeed = (randomSeed * 1103515245UL + 12345UL) & 0x7FFFFFFFUL;
+	return (int) ((randomSeed >> 8) % (unsigned long) range);
+}
+
+String BenchmarkScene::getResults()
+{
+	ASSERTION_COBJECT(this);
+
+	PlatformAdapter * adapter = Desktop::getInstance()->getPlatformAdapter();
+	Vector screenSize = adapter->getScreenSize();
+
+	String results;
+	String value;
+	results += "{\n";
+	results += "\t\"benchmark\": \"glaziery\",\n";
+	#ifdef GL_SOFTWARE_SSE2
+		results += "\t\"renderer\": \"software-sse2\",\n";
+	#else
+		results += "\t\"renderer\": \"software\",\n";
+	#endif
+	value.Format("\t\"screen\": {\"width\": %d, \"height\": %d},\n", screenSize.x, screenSize.y);
+	results += value;
+	value.Format("\t\"frames\": %d,\n\t\"scale\": %d,\n", frameCount, scale);
+	results += value;
+	results += "\t\"scenarios\": [";
+
+	unsigned long * times;
+	if ((times = new unsigned long[frameCount]) == NULL)
+		throw EOUTOFMEMORY;
+
+	bool first = true;
+	for (int scenarioNo = 0; scenarioNo < SCENARIO_COUNT; scenarioNo++)
+	{
+		if (!enabled[scenarioNo])
+			continue;
+
+		Frame * scenarioFrames = frames + scenarioNo * frameCount;
+		unsigned long totalTime = 0;
+		unsigned long totalCalls = 0;
+		unsigned long totalAllocations = 0;
+		unsigned long totalLayoutPasses = 0;
+		int frameNo;
+		for (frameNo = 0; frameNo < frameCount; frameNo++)
+		{
+			times[frameNo] = scenarioFrames[frameNo].cpuMicroseconds;
+			totalTime += scenarioFrames[frameNo].cpuMicroseconds;
+			totalCalls += scenarioFrames[frameNo].adapterCalls;
+			totalAllocations += scenarioFrames[frameNo].allocations;
+			totalLayoutPasses += scenarioFrames[frameNo].layoutPasses;
+		}
+		qsort(times, frameCount, sizeof(unsigned long), compareTimes);
+
+		results += first ? "\n" : ",\n";
+		first = false;
+
+		value.Format("\t\t{\n\t\t\t\"name\": \"%s\",\n\t\t\t\"setupMicroseconds\": %lu,\n",
+			SCENARIO_NAMES[scenarioNo], setupMicroseconds[scenarioNo]);
+		results += value;
+		value.Format("\t\t\t\"cpuMicroseconds\": {\"total\": %lu, \"mean\": %lu, \"min\": %lu,"
+			" \"median\": %lu, \"p95\": %lu, \"max\": %lu},\n",
+			totalTime, totalTime / frameCount, times[0], times[frameCount / 2],
+			times[(frameCount * 95) / 100 < frameCount ? (frameCount * 95) / 100 : frameCount - 1],
+			times[frameCount - 1]);
+		results += value;
+		value.Format("\t\t\t\"adapterCalls\": %lu,\n\t\t\t\"allocations\": %lu,\n\t\t\t\"layoutPasses\": %lu,\n",
+			totalCalls, totalAllocations, totalLayoutPasses);
+		results += value;
+
+		results += "\t\t\t\"perFrame\": [";
+		for (frameNo = 0; frameNo < frameCount; frameNo++)
+		{
+			Frame & frame = scenarioFrames[frameNo];
+			value.Format("%s\n\t\t\t\t{\"cpuMicroseconds\": %lu, \"adapterCalls\": %lu,"
+				" \"allocations\": %lu, \"layoutPasses\": %lu}", frameNo > 0 ? "," : "",
+				frame.cpuMicroseconds, frame.adapterCalls, frame.allocations, frame.layoutPasses);
+			results += value;
+		}
+		results += "\n\t\t\t]\n\t\t}";
+	}
+
+	delete[] times;
+
+	results += "\n\t]\n}\n";
+	return results;
+}
+
+int BenchmarkScene::getScaled(int count)
+{
+	ASSERTION_COBJECT(this);
+
+	int scaled = (int) (((long long) count * scale) / 100);
+	return scaled > 0 ? scaled : 1;
+}
+
+int BenchmarkScene::getSteadyStateStart()
+{
+	ASSERTION_COBJECT(this);
+	return frameCount / 2;
+}
+
+void BenchmarkScene::onInitialize(bool firstRun)
+{
+	ASSERTION_COBJECT(this);
+}
+
+void BenchmarkScene::renderBackground(DrawingContext & context)
+{
+	ASSERTION_COBJECT(this);
+	Desktop::getInstance()->getPlatformAdapter()->clear(context, GL_RGB(32, 48, 64));
+}
+
+void BenchmarkScene::update()
+{
+	ASSERTION_COBJECT(this);
+
+	Desktop * desktop = Desktop::getInstance();
+	BenchmarkAdapter * adapter = (BenchmarkAdapter *) desktop->getPlatformAdapter();
+
+	// Record the frame completed since the last update
+	if (scenarioNo >= 0 && frameNo >= 0)
+	{
+		Frame & frame = frames[scenarioNo * frameCount + frameNo];
+		frame.adapterCalls = adapter->getCallCount() - lastAdapterCalls;
+		frame.allocations = Profiler::getAllocationCount() - lastAllocations;
+		frame.cpuMicroseconds = getCpuMicroseconds() - lastCpuMicroseconds;
+		frame.layoutPasses = BenchmarkLayouter::getPassCount() - lastLayoutPasses;
+	}
+
+	// Advance to the next frame, or the next scenario
+	frameNo++;
+	if (scenarioNo < 0 || frameNo >= frameCount)
+	{
+		if (scenarioNo >= 0)
+			endScenario();
+
+		do
+			scenarioNo++;
+		while (scenarioNo < SCENARIO_COUNT && !enabled[scenarioNo]);
+
+		if (scenarioNo >= SCENARIO_COUNT)
+		{
+			desktop->end();
+			return;
+		}
+
+		beginScenario();
+		frameNo = 0;
+	}
+
+	// The idle scenario gets no input, and its steady state is reported by the profiler
+	if (scenarioNo != SCENARIO_IDLE)
+		emitInput();
+	else if (frameNo == getSteadyStateStart())
+		desktop->getProfiler().resetFrameStatistics();
+
+	lastAdapterCalls = adapter->getCallCount();
+	lastAllocations = Profiler::getAllocationCount();
+	lastLayoutPasses = BenchmarkLayouter::getPassCount();
+	lastCpuMicroseconds = getCpuMicroseconds();
+}
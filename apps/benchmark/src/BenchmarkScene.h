@@ -0,0 +1,98 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __BENCHMARKSCENE_H
+#define __BENCHMARKSCENE_H
+
+
+/**
+ * The benchmark scene builds reproducible stress scenarios one after another,
+ * drives each of them for a given number of frames with scripted input,
+ * and measures every frame. The measurements are reported as JSON by getResults().
+ * A frame is measured from one scene update to the next one, so it contains
+ * event processing, deferrals, effects, and drawing. The scenario setup is measured separately.
+ * The idle scenario emits no input, its second half is the steady state, which should not
+ * allocate any memory. Meanwhile, the profiler attributes allocations to its zones.
+ */
+class BenchmarkScene : public Scene
+{
+	public:
+
+		enum Scenario
+		{
+			SCENARIO_WINDOWS,
+			SCENARIO_LIST,
+			SCENARIO_TREE,
+			SCENARIO_TEXT,
+			SCENARIO_GRID,
+			SCENARIO_IDLE,
+			SCENARIO_COUNT
+		};
+
+	private:
+
+		struct Frame
+		{
+			unsigned long adapterCalls;
+			unsigned long allocations;
+			unsigned long cpuMicroseconds;
+			unsigned long layoutPasses;
+		};
+
+		bool enabled[SCENARIO_COUNT];
+		int frameCount;
+		int frameNo;
+		Frame * frames;
+		InputField * inputField;
+		int labelCount;
+		Label ** labels;
+		unsigned long lastAdapterCalls;
+		unsigned long lastAllocations;
+		unsigned long lastCpuMicroseconds;
+		unsigned long lastLayoutPasses;
+		Vector pointerCenter;
+		Vector pointerPosition;
+		Vector pointerRadius;
+		unsigned long randomSeed;
+		int scale;
+		int scenarioNo;
+		unsigned long setupMicroseconds[SCENARIO_COUNT];
+
+		void beginScenario();
+		void buildGrid();
+		void buildList();
+		void buildText();
+		void buildTree();
+		void buildWindows();
+		static int compareTimes(const void * time1, const void * time2);
+		FieldsArea * createFieldsArea(int columns);
+		Window * createWindow(ClientArea * clientArea, const String & title, Vector position, Vector size);
+		void emitInput();
+		void endScenario();
+		static unsigned long getCpuMicroseconds();
+		int getRandom(int range);
+		int getScaled(int count);
+		int getSteadyStateStart();
+
+	public:
+
+		static const char * ID;
+		static const char * SCENARIO_NAMES[SCENARIO_COUNT];
+
+		BenchmarkScene(int frameCount, int scale, const bool * enabled);
+		virtual ~BenchmarkScene();
+		virtual const char * getId();
+		unsigned long getIdleAllocations();
+		String getResults();
+		virtual void onInitialize(bool firstRun);
+		virtual void renderBackground(DrawingContext & context);
+		virtual void update();
+};
+
+
+#endif
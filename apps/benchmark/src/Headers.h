@@ -0,0 +1,41 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __HEADERS_H
+#define __HEADERS_H
+
+
+// Toolbox
+#include <ToolBox/Headers.h>
+
+// Glaziery
+#include <Glaziery/src/Headers.h>
+
+#ifndef GL_SOFTWARE_ADAPTER
+	#error The benchmark requires the software platform adapter (define GL_SOFTWARE_ADAPTER)
+#endif
+
+
+// Class declarations
+class BatchingCheck;
+class BatchRecorder;
+class BenchmarkAdapter;
+class BenchmarkLayouter;
+class BenchmarkScene;
+
+
+// Benchmark headers
+#include "BatchingCheck.h"
+#include "BatchRecorder.h"
+#include "BenchmarkAdapter.h"
+#include "BenchmarkLayouter.h"
+#include "BenchmarkScene.h"
+#include "Main.h"
+
+
+#endif
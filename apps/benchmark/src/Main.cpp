@@ -0,0 +1,195 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include "Headers.h"
+
+
+// Every heap allocation of the process passes the operators below,
+// so the profiler can report allocations per frame, phase, and zone.
+void * operator new(size_t size)
+{
+	Profiler::countAllocation(size);
+	void * memory = malloc(size > 0 ? size : 1);
+	if (memory == NULL)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void * operator new[](size_t size)
+{
+	Profiler::countAllocation(size);
+	void * memory = malloc(size > 0 ? size : 1);
+	if (memory == NULL)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void operator delete(void * memory) throw()
+{
+	free(memory);
+}
+
+void operator delete[](void * memory) throw()
+{
+	free(memory);
+}
+
+int main(int argc, char ** argv)
+{
+	bool checkBatching = false;
+	bool checkIdleAllocations = false;
+	int frameCount = 300;
+	int scale = 100;
+	const char * outputPath = NULL;
+	bool enabled[BenchmarkScene::SCENARIO_COUNT];
+	bool scenarioSelected = false;
+
+	int scenarioNo;
+	for (scenarioNo = 0; scenarioNo < BenchmarkScene::SCENARIO_COUNT; scenarioNo++)
+		enabled[scenarioNo] = false;
+
+	bool valid = true;
+	for (int argNo = 1; argNo < argc && valid; argNo++)
+	{
+		if (strcmp(argv[argNo], "--check-batching") == 0)
+			checkBatching = true;
+		else if (strcmp(argv[argNo], "--check-idle-allocations") == 0)
+			checkIdleAllocations = true;
+		else if (argNo + 1 >= argc)
+			valid = false;
+		else if (strcmp(argv[argNo], "--frames") == 0)
+			valid = (frameCount = atoi(argv[++argNo])) > 0;
+		else if (strcmp(argv[argNo], "--scale") == 0)
+			valid = (scale = atoi(argv[++argNo])) > 0;
+		else if (strcmp(argv[argNo], "--output") == 0)
+			outputPath = argv[++argNo];
+		else if (strcmp(argv[argNo], "--scenario") == 0)
+		{
+			argNo++;
+			for (scenarioNo = 0; scenarioNo < BenchmarkScene::SCENARIO_COUNT; scenarioNo++)
+				if (strcmp(argv[argNo], BenchmarkScene::SCENARIO_NAMES[scenarioNo]) == 0)
+					break;
+
+			if (scenarioNo < BenchmarkScene::SCENARIO_COUNT)
+			{
+				enabled[scenarioNo] = true;
+				scenarioSelected = true;
+			}
+			else
+				valid = false;
+		}
+		else
+			valid = false;
+	}
+
+	if (!valid)
+	{
+		fprintf(stderr, "Usage: %s [--frames N] [--scale PERCENT] [--scenario NAME]... [--output PATH]"
+			" [--check-idle-allocations] [--check-batching]\nScenarios:", argv[0]);
+		for (scenarioNo = 0; scenarioNo < BenchmarkScene::SCENARIO_COUNT; scenarioNo++)
+			fprintf(stderr, " %s", BenchmarkScene::SCENARIO_NAMES[scenarioNo]);
+		fprintf(stderr, " (default: all)\n");
+		return 2;
+	}
+
+	if (checkBatching)
+	{
+		int failures;
+		try
+		{
+			failures = BatchingCheck::run();
+		}
+		catch (Exception & exception)
+		{
+			fprintf(stderr, "Batching check aborted: %s: %s\nSource: %s:%d\n",
+				(const char *) exception.GetClassName(), (const char *) exception.GetMessage(),
+				(const char *) exception.GetSource(), exception.GetLineNumber());
+			return 1;
+		}
+
+		if (failures > 0)
+			return 4;
+
+		printf("Batching check passed\n");
+		return 0;
+	}
+
+	if (!scenarioSelected)
+		for (scenarioNo = 0; scenarioNo < BenchmarkScene::SCENARIO_COUNT; scenarioNo++)
+			enabled[scenarioNo] = true;
+	if (checkIdleAllocations)
+		enabled[BenchmarkScene::SCENARIO_IDLE] = true;
+
+	String results;
+	unsigned long idleAllocations = 0;
+	try
+	{
+		BenchmarkAdapter * adapter;
+		if ((adapter = new BenchmarkAdapter) == NULL)
+			throw EOUTOFMEMORY;
+
+		Skin * skin;
+		if ((skin = new SimpleSkin) == NULL)
+			throw EOUTOFMEMORY;
+
+		Desktop * desktop = Desktop::createInstance(adapter, skin, "Glaziery", "Benchmark");
+
+		// Do not wait between frames, the frame times are measured instead
+		desktop->setMinimumFrameDuration(0);
+
+		BenchmarkScene * scene;
+		if ((scene = new BenchmarkScene(frameCount, scale, enabled)) == NULL)
+			throw EOUTOFMEMORY;
+		desktop->addScene(scene);
+		desktop->setActiveScene(BenchmarkScene::ID);
+
+		desktop->run();
+		results = scene->getResults();
+
+		idleAllocations = scene->getIdleAllocations();
+
+		Desktop::destroyInstance();
+	}
+	catch (Exception & exception)
+	{
+		try
+		{
+			Desktop::destroyInstance();
+		}
+		catch (...)
+		{
+		}
+
+		fprintf(stderr, "Benchmark aborted: %s: %s\nSource: %s:%d\n",
+			(const char *) exception.GetClassName(), (const char *) exception.GetMessage(),
+			(const char *) exception.GetSource(), exception.GetLineNumber());
+		return 1;
+	}
+
+	FILE * file = outputPath != NULL ? fopen(outputPath, "w") : stdout;
+	if (file == NULL)
+	{
+		fprintf(stderr, "Cannot write %s\n", outputPath);
+		return 1;
+	}
+
+	fputs(results, file);
+	if (file != stdout)
+		fclose(file);
+
+	// The phases and zones of the allocations have been written to the log
+	if (checkIdleAllocations && idleAllocations > 0)
+	{
+		fprintf(stderr, "Idle frames allocated %lu times in the steady state, see the log\n",
+			idleAllocations);
+		return 3;
+	}
+
+	return 0;
+}
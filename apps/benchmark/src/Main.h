@@ -0,0 +1,28 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __MAIN_H
+#define __MAIN_H
+
+
+/**
+ * The benchmark entry point.
+ * Usage: benchmark [--frames N] [--scale PERCENT] [--scenario NAME]... [--output PATH]
+ * [--check-idle-allocations] [--check-batching]
+ * With --check-idle-allocations, the benchmark fails with exit code 3 if a frame
+ * of the idle scenario's steady state allocates memory.
+ * With --check-batching, only the batching check runs instead of the benchmark,
+ * failing with exit code 4 if the primitive batcher merges primitives unexpectedly.
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
+ * @return The exit code, 0 on success.
+ */
+int main(int argc, char ** argv);
+
+
+#endif
@@ -35,6 +35,8 @@ void DirectXImage::destroyTexture()
 		= (DirectXPlatformAdapter *) Desktop::getInstance()->getPlatformAdapter();
 	if (surface != NULL && adapter->getCurrentSurface() == surface)
 		adapter->releaseScene();
+	if (adapter->primitiveBatcher.getTexture() == this)
+		adapter->primitiveBatcher.flush();
 
 	if (surfaceRenderer != NULL) {surfaceRenderer->Release(); surfaceRenderer = NULL;}
 	if (surface != NULL) {surface->Release(); surface = NULL;}
@@ -454,6 +454,10 @@ void DirectXKeyboardHandler::initialize()
 	::SetFocus(adapter->getWindowHandle());
 	adapter->processMessages();
 
+	// Wake up idle waiting desktops on input, even if the device is exclusive
+	if (FAILED(result = keyboardDevice->SetEventNotification(adapter->getWakeEvent())))
+		LOGPRINTF1(LOG_WARN, "Cannot set keyboard event notification (error code %d)", result);
+
 	if (FAILED(result = keyboardDevice->Acquire()))
 	{
 		LOGPRINTF1(LOG_WARN, "Cannot acquire keyboard device (error code %d)", result);
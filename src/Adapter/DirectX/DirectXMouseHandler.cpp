@@ -91,6 +91,10 @@ void DirectXMouseHandler::initialize()
 	::SetFocus(adapter->getWindowHandle());
 	adapter->processMessages();
 
+	// Wake up idle waiting desktops on input, even if the device is exclusive
+	if (FAILED(result = mouseDevice->SetEventNotification(adapter->getWakeEvent())))
+		LOGPRINTF1(LOG_WARN, "Cannot set mouse event notification (error code %d)", result);
+
 	if (FAILED(result = mouseDevice->Acquire()))
 	{
 		LOGPRINTF1(LOG_WARN, "Cannot acquire mouse device (error code %d)", result);
@@ -13,6 +13,7 @@ const int DirectXPlatformAdapter::CIRCLE_VERTEX_COUNT = 128;
 const int DirectXPlatformAdapter::VERTEX_BUFFER_SIZE = 1024;
 
 DirectXPlatformAdapter::DirectXPlatformAdapter()
+	: primitiveBatcher(this, VERTEX_BUFFER_SIZE)
 {
 	ASSERTION_COBJECT(this);
 
@@ -24,7 +25,6 @@ DirectXPlatformAdapter::DirectXPlatformAdapter()
 	currentBlendType = BLENDTYPE_NORMAL;
 	currentRenderer = NULL;
 	currentTexture = NULL;
-	currentVertices = NULL;
 
 	char formatted[64];
 	strcpy(formatted, "0.0");
@@ -69,8 +69,11 @@ DirectXPlatformAdapter::DirectXPlatformAdapter()
 
 	sineTable = NULL;
 	squareRequired = false;
-	vertexNo = 0;
 	vertexBuffer = NULL;
+
+	if ((wakeEvent = ::CreateEvent(NULL, FALSE, FALSE, NULL)) == NULL)
+		throw EDEVICEERROR_RESULT("Cannot create wake event", GetLastError());
+
 	windowClassNameAtom = 0;
 	windowHandle = NULL;
 
@@ -93,6 +96,7 @@ DirectXPlatformAdapter::~DirectXPlatformAdapter()
 
 	if (cosineTable != NULL) {delete cosineTable; cosineTable = NULL;}
 	if (sineTable != NULL) {delete sineTable; sineTable = NULL;}
+	if (wakeEvent != NULL) {::CloseHandle(wakeEvent); wakeEvent = NULL;}
 }
 
 Vector DirectXPlatformAdapter::alignSize(Vector size)
@@ -220,9 +224,16 @@ void DirectXPlatformAdapter::clear(DrawingContext & context, unsigned long fillC
 {
 	ASSERTION_COBJECT(this);
 
+	if (context.getDisplayList() != NULL)
+		context.getDisplayList()->recordClear(context, fillColor);
+
 	if (!ensureScene(context))
 		return;
 
+	// Clearing is not batched, so draw the pending primitives first
+	primitiveBatcher.flush();
+	currentStatistics.increment(RendererStatistics::CLEARS);
+
 	if (!setTexture(NULL))
 		return;
 
@@ -238,6 +249,9 @@ void DirectXPlatformAdapter::clear(DrawingContext & context, unsigned long fillC
 		"Cannot clear surface"))
 		return;
 
+	// Opaque blending has been set for clearing, and is reset now
+	currentStatistics.increment(RendererStatistics::BLEND_CHANGES, 2);
+
 	if (failedObserving(direct3DDevice->SetRenderState(D3DRS_SRCBLEND, D3DBLEND_SRCALPHA),
 		"Cannot set source color blending"))
 		return;
@@ -306,6 +320,9 @@ void DirectXPlatformAdapter::drawEllipse(DrawingContext & context, Vector center
 {
 	ASSERTION_COBJECT(this);
 
+	if (context.getDisplayList() != NULL)
+		context.getDisplayList()->recordEllipse(context, center, radius, fillColor, borderColor);
+
 	center += context.getDrawingOffset();
 	if (!context.isInClippingArea(center - radius, center + radius))
 		return;
@@ -313,68 +330,38 @@ void DirectXPlatformAdapter::drawEllipse(DrawingContext & context, Vector center
 	if (!ensureScene(context))
 		return;
 
-	if (!setTexture(NULL))
-		return;
-
-	Point * points;
-	if (failedObserving(vertexBuffer->Lock(0, (CIRCLE_VERTEX_COUNT + 2) * sizeof(Point),
-		(void **) &points, D3DLOCK_DISCARD),
-		"Cannot draw ellipse: Cannot lock vertex buffer"))
-		return;
-
-	::ZeroMemory(points, (CIRCLE_VERTEX_COUNT + 2) * sizeof(Point));
+	currentStatistics.increment(RendererStatistics::ELLIPSES);
 
+	// The center is the center of the center pixel
+	float centerX = center.x + 0.5f;
+	float centerY = center.y + 0.5f;
 	float radiusX = radius.x + 0.5f;
 	float radiusY = radius.y + 0.5f;
 
-	points[0].x = (float) center.x;
-	points[0].y = (float) center.y;
-	points[0].z = 1.0f;
-	points[0].rhw = 1.0f;
-	points[0].diffuse = fillColor;
+	float xs[3];
+	float ys[3];
+	xs[0] = centerX;
+	ys[0] = centerY;
 	int i;
 	for (i=0; i<CIRCLE_VERTEX_COUNT; i++)
 	{
-		points[i+1].x = center.x + radiusX * sineTable[i];
-		points[i+1].y = center.y + radiusY * cosineTable[i];
-		points[i+1].z = 1.0f;
-		points[i+1].rhw = 1.0f;
-		points[i+1].diffuse = fillColor;
+		int next = (i + 1) % CIRCLE_VERTEX_COUNT;
+		xs[1] = centerX + radiusX * sineTable[i];
+		ys[1] = centerY + radiusY * cosineTable[i];
+		xs[2] = centerX + radiusX * sineTable[next];
+		ys[2] = centerY + radiusY * cosineTable[next];
+		primitiveBatcher.addTriangle(xs, ys, fillColor);
 	}
-	points[CIRCLE_VERTEX_COUNT + 1].x = center.x + radiusX * sineTable[0];
-	points[CIRCLE_VERTEX_COUNT + 1].y = center.y + radiusY * cosineTable[0];
-	points[CIRCLE_VERTEX_COUNT + 1].z = 1.0f;
-	points[CIRCLE_VERTEX_COUNT + 1].rhw = 1.0f;
-	points[CIRCLE_VERTEX_COUNT + 1].diffuse = fillColor;
-
-	if (failedObserving(vertexBuffer->Unlock(), "Cannot draw ellipse: Cannot unlock vertex buffer"))
-		return;
-
-	if (failedObserving(direct3DDevice->DrawPrimitive(D3DPT_TRIANGLEFAN,
-		0, CIRCLE_VERTEX_COUNT), "Cannot draw ellipse: Cannot draw triangle fan"))
-		return;
 
 	if (GL_ALPHA_OF(borderColor) == 0)
 		return;
 
-	if (failedObserving(vertexBuffer->Lock(1, CIRCLE_VERTEX_COUNT * sizeof(Point),
-		(void **) &points, D3DLOCK_DISCARD),
-		"Cannot draw ellipse: Cannot lock vertex buffer"))
-		return;
-
 	for (i=0; i<CIRCLE_VERTEX_COUNT; i++)
 	{
-		points[i].diffuse = borderColor;
-		points[i].z = 0.5f;
-		points[i].rhw = 1.0f;
+		int next = (i + 1) % CIRCLE_VERTEX_COUNT;
+		primitiveBatcher.addLine(centerX + radiusX * sineTable[i], centerY + radiusY * cosineTable[i],
+			centerX + radiusX * sineTable[next], centerY + radiusY * cosineTable[next], borderColor);
 	}
-
-	if (failedObserving(vertexBuffer->Unlock(), "Cannot draw ellipse: Cannot unlock vertex buffer"))
-		return;
-
-	if (failedObserving(direct3DDevice->DrawPrimitive(D3DPT_LINESTRIP,
-		1, CIRCLE_VERTEX_COUNT), "Cannot draw ellipse: Cannot draw line strip"))
-		return;
 }
 
 void DirectXPlatformAdapter::drawImage(DrawingContext & context, Image * image,
@@ -383,6 +370,10 @@ void DirectXPlatformAdapter::drawImage(DrawingContext & context, Image * image,
 {
 	ASSERTION_COBJECT(this);
 
+	if (context.getDisplayList() != NULL)
+		context.getDisplayList()->recordImage(context, image, sourcePosition, sourceSize,
+			targetPosition, targetSize, modulationColor, blendType);
+
 	targetPosition += context.getDrawingOffset();
 	if (!context.isInClippingArea(targetPosition, targetPosition + targetSize))
 		return;
@@ -390,10 +381,21 @@ void DirectXPlatformAdapter::drawImage(DrawingContext & context, Image * image,
 	if (!ensureScene(context))
 		return;
 
-	if (!setTexture(image, blendType))
-		return;
+	currentStatistics.increment(RendererStatistics::IMAGES);
 
-	addTextureRectangle(sourcePosition, sourceSize, targetPosition, targetSize, modulationColor);
+	float xs[4];
+	float ys[4];
+	xs[0] = (float) targetPosition.x;
+	ys[0] = (float) targetPosition.y;
+	xs[1] = (float) (targetPosition.x + targetSize.x);
+	ys[1] = ys[0];
+	xs[2] = xs[0];
+	ys[2] = (float) (targetPosition.y + targetSize.y);
+	xs[3] = xs[1];
+	ys[3] = ys[2];
+
+	primitiveBatcher.addQuad(image, blendType, xs, ys, (float) sourcePosition.x, (float) sourcePosition.y,
+		(float) sourceSize.x, (float) sourceSize.y, modulationColor);
 }
 
 void DirectXPlatformAdapter::drawLine(DrawingContext & context, Vector from, Vector to,
@@ -407,6 +409,9 @@ void DirectXPlatformAdapter::drawLine(DrawingContext & context, Vector from, Vec
 		return;
 	}
 
+	if (context.getDisplayList() != NULL)
+		context.getDisplayList()->recordLine(context, from, to, color);
+
 	from += context.getDrawingOffset();
 	to += context.getDrawingOffset();
 	if (!context.isInClippingArea(from, to))
@@ -415,39 +420,24 @@ void DirectXPlatformAdapter::drawLine(DrawingContext & context, Vector from, Vec
 	if (!ensureScene(context))
 		return;
 
-	if (!setTexture(NULL))
-		return;
-
-	Point * points;
-	if (failedObserving(vertexBuffer->Lock(0, 2 * sizeof(Point), (void **) &points,
-		D3DLOCK_DISCARD), "Cannot draw line: Cannot lock vertex buffer"))
-		return;
+	currentStatistics.increment(RendererStatistics::LINES);
 
-	::ZeroMemory(points, 2 * sizeof(Point));
-
-	points[0].x = (float) from.x;
-	points[0].y = (float) from.y;
-	points[0].z = 1.0f;
-	points[0].rhw = 1.0f;
-	points[0].diffuse = color;
-
-	points[1].x = (float) to.x;
-	points[1].y = (float) to.y;
-	points[1].z = 1.0f;
-	points[1].rhw = 1.0f;
-	points[1].diffuse = color;
+	// Horizontal and vertical lines are filled rectangles, so they are batched with the
+	// surrounding rectangles, and cover exactly their pixels including the last one
+	if (from.x == to.x || from.y == to.y)
+	{
+		if (to.x < from.x) {int x = to.x; to.x = from.x; from.x = x;}
+		if (to.y < from.y) {int y = to.y; to.y = from.y; from.y = y;}
 
-	if (failedObserving(vertexBuffer->Unlock(), "Cannot draw line: Cannot unlock vertex buffer"))
+		primitiveBatcher.addRect((float) from.x, (float) from.y,
+			(float) (to.x + 1), (float) (to.y + 1), color);
 		return;
+	}
 
-	if (failedObserving(direct3DDevice->DrawPrimitive(D3DPT_LINELIST, 0, 1),
-		"Cannot draw line: Cannot draw primitive"))
-		return;
+	primitiveBatcher.addLine(from.x + 0.5f, from.y + 0.5f, to.x + 0.5f, to.y + 0.5f, color);
 
 	// Rendering of last pixel currently does not work. Disabled, and rendering manually now.
-	if (failedObserving(direct3DDevice->DrawPrimitive(D3DPT_POINTLIST, 1, 1),
-		"Cannot draw pixel: Cannot draw primitive"))
-		return;
+	primitiveBatcher.addRect((float) to.x, (float) to.y, (float) (to.x + 1), (float) (to.y + 1), color);
 }
 
 void DirectXPlatformAdapter::drawPixel(DrawingContext & context, Vector position,
@@ -455,6 +445,9 @@ void DirectXPlatformAdapter::drawPixel(DrawingContext & context, Vector position
 {
 	ASSERTION_COBJECT(this);
 
+	if (context.getDisplayList() != NULL)
+		context.getDisplayList()->recordPixel(context, position, color);
+
 	position += context.getDrawingOffset();
 	if (!context.isInClippingArea(position))
 		return;
@@ -462,28 +455,9 @@ void DirectXPlatformAdapter::drawPixel(DrawingContext & context, Vector position
 	if (!ensureScene(context))
 		return;
 
-	if (!setTexture(NULL))
-		return;
-
-	Point * points;
-	if (failedObserving(vertexBuffer->Lock(0, sizeof(Point), (void **) &points,
-		D3DLOCK_DISCARD), "Cannot draw pixel: Cannot lock vertex buffer"))
-		return;
-
-	::ZeroMemory(points, sizeof(Point));
-
-	points[0].x = (float) position.x;
-	points[0].y = (float) position.y;
-	points[0].z = 1.0f;
-	points[0].rhw = 1.0f;
-	points[0].diffuse = color;
-
-	if (failedObserving(vertexBuffer->Unlock(), "Cannot draw pixel: Cannot unlock vertex buffer"))
-		return;
-
-	if (failedObserving(direct3DDevice->DrawPrimitive(D3DPT_POINTLIST, 0, 1),
-		"Cannot draw pixel: Cannot draw primitive"))
-		return;
+	currentStatistics.increment(RendererStatistics::PIXELS);
+	primitiveBatcher.addRect((float) position.x, (float) position.y,
+		(float) (position.x + 1), (float) (position.y + 1), color);
 }
 
 void DirectXPlatformAdapter::drawRect(DrawingContext & context, Vector from, Vector to,
@@ -491,6 +465,9 @@ void DirectXPlatformAdapter::drawRect(DrawingContext & context, Vector from, Vec
 {
 	ASSERTION_COBJECT(this);
 
+	if (context.getDisplayList() != NULL)
+		context.getDisplayList()->recordRect(context, from, to, fillColor, borderColor);
+
 	from += context.getDrawingOffset();
 	to += context.getDrawingOffset();
 	if (!context.isInClippingArea(from, to))
@@ -499,135 +476,38 @@ void DirectXPlatformAdapter::drawRect(DrawingContext & context, Vector from, Vec
 	if (!ensureScene(context))
 		return;
 
-	if (!setTexture(NULL))
-		return;
+	currentStatistics.increment(RendererStatistics::RECTS);
 
 	if (to.x < from.x) {int x = to.x; to.x = from.x; from.x = x;}
 	if (to.y < from.y) {int y = to.y; to.y = from.y; from.y = y;}
 
+	float left = (float) from.x;
+	float top = (float) from.y;
+	float right = (float) (to.x + 1);
+	float bottom = (float) (to.y + 1);
+
 	if (borderColor == fillColor)
 	{
-		Point * points;
-		if (failedObserving(vertexBuffer->Lock(0, 4 * sizeof(Point), (void **) &points,
-			D3DLOCK_DISCARD), "Cannot draw rect: Cannot lock vertex buffer"))
-			return;
-
-		::ZeroMemory(points, 4 * sizeof(Point));
-
-		points[0].x = (float) from.x - 0.5f;
-		points[0].y = (float) from.y - 0.5f;
-		points[0].z = 1.0f;
-		points[0].rhw = 1.0f;
-		points[0].diffuse = fillColor;
-
-		points[1].x = (float) to.x + 0.5f;
-		points[1].y = points[0].y;
-		points[1].z = 1.0f;
-		points[1].rhw = 1.0f;
-		points[1].diffuse = fillColor;
-
-		points[2].x = points[1].x;
-		points[2].y = (float) to.y + 0.5f;
-		points[2].z = 1.0f;
-		points[2].rhw = 1.0f;
-		points[2].diffuse = fillColor;
-
-		points[3].x = points[0].x;
-		points[3].y = points[2].y;
-		points[3].z = 1.0f;
-		points[3].rhw = 1.0f;
-		points[3].diffuse = fillColor;
-
-		if (failedObserving(vertexBuffer->Unlock(), "Cannot draw rect: Cannot unlock vertex buffer"))
-			return;
-
-		if (failedObserving(direct3DDevice->DrawPrimitive(D3DPT_TRIANGLEFAN, 0, 2),
-			"Cannot draw rect: Cannot draw primitive"))
-			return;
+		primitiveBatcher.addRect(left, top, right, bottom, fillColor);
+		return;
 	}
-	else
-	{
-		Point * points;
-		if (failedObserving(vertexBuffer->Lock(0, 5 * sizeof(Point), (void **) &points,
-			D3DLOCK_DISCARD), "Cannot draw rect: Cannot lock vertex buffer"))
-			return;
 
-		::ZeroMemory(points, 5 * sizeof(Point));
-
-		points[0].x = (float) (from.x + 1) - 0.5f;
-		points[0].y = (float) (from.y + 1) - 0.5f;
-		points[0].z = 1.0f;
-		points[0].rhw = 1.0f;
-		points[0].diffuse = fillColor;
-
-		points[1].x = (float) (to.x - 1) + 0.5f;
-		points[1].y = points[0].y;
-		points[1].z = 1.0f;
-		points[1].rhw = 1.0f;
-		points[1].diffuse = fillColor;
-
-		points[2].x = points[1].x;
-		points[2].y = (float) (to.y - 1) + 0.5f;
-		points[2].z = 1.0f;
-		points[2].rhw = 1.0f;
-		points[2].diffuse = fillColor;
-
-		points[3].x = points[0].x;
-		points[3].y = points[2].y;
-		points[3].z = 1.0f;
-		points[3].rhw = 1.0f;
-		points[3].diffuse = fillColor;
-
-		if (failedObserving(vertexBuffer->Unlock(), "Cannot draw rect: Cannot unlock vertex buffer"))
-			return;
-
-		if (failedObserving(direct3DDevice->DrawPrimitive(D3DPT_TRIANGLEFAN, 0, 2),
-			"Cannot draw rect: Cannot draw primitive"))
-			return;
-
-		if (GL_ALPHA_OF(borderColor) == 0)
-			return;
+	if (to.x - from.x > 1 && to.y - from.y > 1)
+		primitiveBatcher.addRect(left + 1.0f, top + 1.0f, right - 1.0f, bottom - 1.0f, fillColor);
 
-		if (failedObserving(vertexBuffer->Lock(0, 5 * sizeof(Point), (void **) &points,
-			D3DLOCK_DISCARD), "Cannot draw rect: Cannot lock vertex buffer"))
-			return;
-
-		points[0].x = (float) from.x;
-		points[0].y = (float) from.y;
-		points[0].z = 1.0f;
-		points[0].rhw = 1.0f;
-		points[0].diffuse = borderColor;
-
-		points[1].x = (float) to.x;
-		points[1].y = points[0].y;
-		points[1].z = 1.0f;
-		points[1].rhw = 1.0f;
-		points[1].diffuse = borderColor;
-
-		points[2].x = points[1].x;
-		points[2].y = (float) to.y;
-		points[2].z = 1.0f;
-		points[2].rhw = 1.0f;
-		points[2].diffuse = borderColor;
-
-		points[3].x = points[0].x;
-		points[3].y = points[2].y;
-		points[3].z = 1.0f;
-		points[3].rhw = 1.0f;
-		points[3].diffuse = borderColor;
-
-		points[4].x = points[0].x;
-		points[4].y = points[0].y;
-		points[4].z = 1.0f;
-		points[4].rhw = 1.0f;
-		points[4].diffuse = borderColor;
-
-		if (failedObserving(vertexBuffer->Unlock(), "Cannot draw rect: Cannot unlock vertex buffer"))
-			return;
+	if (GL_ALPHA_OF(borderColor) == 0)
+		return;
 
-		if (failedObserving(direct3DDevice->DrawPrimitive(D3DPT_LINESTRIP, 0, 4),
-			"Cannot draw rect: Cannot draw primitive"))
-			return;
+	// The border consists of four non-overlapping rectangles, so the entire rectangle
+	// is a single batchable triangle run, and translucent borders are not blended twice
+	primitiveBatcher.addRect(left, top, right, top + 1.0f, borderColor);
+	if (to.y > from.y)
+		primitiveBatcher.addRect(left, bottom - 1.0f, right, bottom, borderColor);
+	if (to.y - from.y > 1)
+	{
+		primitiveBatcher.addRect(left, top + 1.0f, left + 1.0f, bottom - 1.0f, borderColor);
+		if (to.x > from.x)
+			primitiveBatcher.addRect(right - 1.0f, top + 1.0f, right, bottom - 1.0f, borderColor);
 	}
 }
 
@@ -638,11 +518,14 @@ void DirectXPlatformAdapter::drawRotatedImage(DrawingContext & context, Image *
 {
 	ASSERTION_COBJECT(this);
 
+	if (context.getDisplayList() != NULL)
+		context.getDisplayList()->recordRotatedImage(context, image, sourcePosition, sourceSize,
+			targetPosition, targetSize, rotationAnchor, rotationAngle, modulationColor, blendType);
+
 	if (!ensureScene(context))
 		return;
 
-	if (!setTexture(image, blendType))
-		return;
+	currentStatistics.increment(RendererStatistics::IMAGES);
 
 	targetPosition += currentContext.getDrawingOffset();
 	float xs[4];
@@ -673,8 +556,8 @@ void DirectXPlatformAdapter::drawRotatedImage(DrawingContext & context, Image *
 		ys[i] = rotatedPointY + anchorY;
 	}
 
-	addTextureRectangle(sourcePosition.x, sourcePosition.y, sourceSize.x, sourceSize.y,
-		xs[0], ys[0], xs[1], ys[1], xs[2], ys[2], xs[3], ys[3], modulationColor);
+	primitiveBatcher.addQuad(image, blendType, xs, ys, (float) sourcePosition.x, (float) sourcePosition.y,
+		(float) sourceSize.x, (float) sourceSize.y, modulationColor);
 }
 
 void DirectXPlatformAdapter::drawTextInternal(DrawingContext & context, Font * font, Vector position,
@@ -693,6 +576,7 @@ void DirectXPlatformAdapter::drawTextInternal(DrawingContext & context, Font * f
 	else
 		correctedText = text;
 
+	// Display lists record the glyph images drawn below, so replaying skips the text layout
 	Image * image = font->getImage();
 	int originalX = position.x;
 	int height = font->getHeight();
@@ -719,6 +603,7 @@ void DirectXPlatformAdapter::drawTextInternal(DrawingContext & context, Font * f
 			if (width > 0)
 			{
 				Vector glyphSize(width, height);
+				currentStatistics.increment(RendererStatistics::GLYPHS);
 				drawImage(context, image, font->getPosition(character), glyphSize,
 					position, glyphSize, modulationColor, blendType);
 
@@ -741,60 +626,31 @@ void DirectXPlatformAdapter::drawTriangle(DrawingContext & context, Vector * ver
 {
 	ASSERTION_COBJECT(this);
 
-	if (!ensureScene(context))
-		return;
+	if (context.getDisplayList() != NULL)
+		context.getDisplayList()->recordTriangle(context, vertices, fillColor, borderColor);
 
-	if (!setTexture(NULL))
-		return;
-
-	Point * points;
-	if (failedObserving(vertexBuffer->Lock(0, 3 * sizeof(Point), (void **) &points,
-		D3DLOCK_DISCARD), "Cannot draw triangle: Cannot lock vertex buffer"))
+	if (!ensureScene(context))
 		return;
 
-	::ZeroMemory(points, 3 * sizeof(Point));
-
-	int i; // loop variable
+	currentStatistics.increment(RendererStatistics::TRIANGLES);
 
+	// The vertices are the centers of their pixels
+	float xs[3];
+	float ys[3];
+	int i;
 	for (i=0; i<3; i++)
 	{
-		points[i].x = (float) (vertices[i].x + currentContext.getDrawingOffset().x);
-		points[i].y = (float) (vertices[i].y + currentContext.getDrawingOffset().y);
-		points[i].z = 1.0f;
-		points[i].rhw = 1.0f;
-		points[i].diffuse = fillColor;
+		xs[i] = vertices[i].x + currentContext.getDrawingOffset().x + 0.5f;
+		ys[i] = vertices[i].y + currentContext.getDrawingOffset().y + 0.5f;
 	}
 
-	if (failedObserving(vertexBuffer->Unlock(), "Cannot draw triangle: Cannot unlock vertex buffer"))
-		return;
-
-	if (failedObserving(direct3DDevice->DrawPrimitive(D3DPT_TRIANGLELIST, 0, 1),
-		"Cannot draw triangle: Cannot draw triangle primitive"))
-		return;
+	primitiveBatcher.addTriangle(xs, ys, fillColor);
 
 	if (GL_ALPHA_OF(borderColor) == 0)
 		return;
 
-	if (failedObserving(vertexBuffer->Lock(0, 4 * sizeof(Point), (void **) &points,
-		D3DLOCK_DISCARD), "Cannot draw triangle: Cannot lock vertex buffer"))
-		return;
-
-	::ZeroMemory(points, 4 * sizeof(Point));
-
 	for (i=0; i<3; i++)
-		points[i].diffuse = borderColor;
-	points[3].x = (float) (vertices[0].x + currentContext.getDrawingOffset().x);
-	points[3].y = (float) (vertices[0].y + currentContext.getDrawingOffset().y);
-	points[3].z = 1.0f;
-	points[3].rhw = 1.0f;
-	points[3].diffuse = borderColor;
-
-	if (failedObserving(vertexBuffer->Unlock(), "Cannot draw triangle: Cannot unlock vertex buffer"))
-		return;
-
-	if (failedObserving(direct3DDevice->DrawPrimitive(D3DPT_LINESTRIP, 0, 3),
-		"Cannot draw triangle: Cannot draw line strip"))
-		return;
+		primitiveBatcher.addLine(xs[i], ys[i], xs[(i + 1) % 3], ys[(i + 1) % 3], borderColor);
 }
 
 bool DirectXPlatformAdapter::ensureScene(DrawingContext & context)
@@ -936,6 +792,7 @@ bool DirectXPlatformAdapter::ensureScene(DrawingContext & context)
 	// Memorize successful scene preparation
 
 	currentContext = context;
+	currentStatistics.increment(RendererStatistics::TARGET_SWITCHES);
 	inScene = true;
 
 	return true;
@@ -1389,6 +1246,10 @@ unsigned long DirectXPlatformAdapter::getPixel(DrawingContext & context, Vector
 
 	IDirect3DSurface9 * surface = target != NULL ? target->getSurface() : backBufferSurface;
 
+	// The pixel may be covered by pending primitives
+	if (inScene && currentContext.getTarget() == context.getTarget())
+		primitiveBatcher.flush();
+
 	RECT rect;
 	rect.left = position.x;
 	rect.top = position.y;
@@ -1407,6 +1268,30 @@ unsigned long DirectXPlatformAdapter::getPixel(DrawingContext & context, Vector
 	return pixel;
 }
 
+double DirectXPlatformAdapter::getPreciseTime()
+{
+	ASSERTION_COBJECT(this);
+
+	if (performanceTimerFactor > 0.0)
+	{
+		LARGE_INTEGER performanceTimerCounter;
+		if (::QueryPerformanceCounter(&performanceTimerCounter))
+		{
+			__int64 performanceTimerCounter64 = performanceTimerCounter.QuadPart;
+			if (performanceTimerCounter64 > 0)
+				return (performanceTimerCounter64 - performanceTimerStart) * performanceTimerFactor * 1000.0;
+		}
+	}
+
+	return ::GetTickCount() * 1000.0;
+}
+
+PrimitiveBatcher * DirectXPlatformAdapter::getPrimitiveBatcher()
+{
+	ASSERTION_COBJECT(this);
+	return &primitiveBatcher;
+}
+
 Vector DirectXPlatformAdapter::getScreenSize()
 {
 	ASSERTION_COBJECT(this);
@@ -1638,6 +1523,12 @@ unsigned long DirectXPlatformAdapter::getTime()
 	return ::GetTickCount();
 }
 
+HANDLE DirectXPlatformAdapter::getWakeEvent()
+{
+	ASSERTION_COBJECT(this);
+	return wakeEvent;
+}
+
 HWND DirectXPlatformAdapter::getWindowHandle()
 {
 	ASSERTION_COBJECT(this);
@@ -1661,6 +1552,12 @@ LRESULT CALLBACK DirectXPlatformAdapter::getWindowProc(HWND windowHandle, UINT m
 		}
 		break;
 
+		case WM_PAINT:
+			// The OS requires the window content, e.g. after being overlapped
+			if (Desktop::getInstance() != NULL)
+				Desktop::getInstance()->invalidate();
+		break;
+
 		case WM_QUIT:
 			::PostQuitMessage(0);
 		break;
@@ -2043,6 +1940,12 @@ bool DirectXPlatformAdapter::isApplicationFocused()
 	return ::GetForegroundWindow() == windowHandle;
 }
 
+bool DirectXPlatformAdapter::isBackBufferRetained()
+{
+	ASSERTION_COBJECT(this);
+	return presentParameters.SwapEffect == D3DSWAPEFFECT_COPY;
+}
+
 bool DirectXPlatformAdapter::isDeleteKey(int keyCode)
 {
 	ASSERTION_COBJECT(this);
@@ -2224,12 +2127,18 @@ void DirectXPlatformAdapter::recoverFromDirect3DProblems()
 			LOGPRINTF0(LOG_DEBUG, "Cannot recover from a Direct3D problem");
 		}
 	}
+
+	// Frames drawn during the problem may have been lost
+	if (!direct3DProblems)
+		Desktop::getInstance()->invalidate();
 }
 
 void DirectXPlatformAdapter::releaseBuffers()
 {
 	ASSERTION_COBJECT(this);
 
+	primitiveBatcher.discard();
+
 	if (backBufferSurface != NULL) {backBufferSurface->Release(); backBufferSurface = NULL;}
 	if (vertexBuffer != NULL) {vertexBuffer->Release(); vertexBuffer = NULL;}
 }
@@ -2249,7 +2158,7 @@ void DirectXPlatformAdapter::releaseScene()
 	if (!inScene)
 		return;
 
-	flushVertexBuffer();
+	primitiveBatcher.flush();
 
 	DirectXImage * target = (DirectXImage *) currentContext.getTarget();
 	IDirect3DSurface9 * surface = target != NULL ? target->getSurface() : backBufferSurface;
@@ -2511,17 +2420,47 @@ void DirectXPlatformAdapter::sleep(unsigned long msecs)
 {
 	ASSERTION_COBJECT(this);
 
-	#ifdef GL_DEBUG_CPUPROFILER
-		CPUProfiler & profiler = Desktop::getInstance()->getProfiler();
-		CPUProfiler::UsageType usageType = profiler.getUsageType();
-		profiler.setUsageType(CPUProfiler::IDLE);
-	#endif
-
 	::Sleep(msecs);
+}
+
+void DirectXPlatformAdapter::submitPrimitives(PrimitiveBatcher::PrimitiveType type, Image * texture,
+	BlendType blendType, const PrimitiveBatcher::Vertex * vertices, int vertexCount)
+{
+	ASSERTION_COBJECT(this);
+
+	if (!setTexture(texture, blendType))
+		return;
 
-	#ifdef GL_DEBUG_CPUPROFILER
-		profiler.setUsageType(usageType);
-	#endif
+	Point * points;
+	if (failedObserving(vertexBuffer->Lock(0, vertexCount * sizeof(Point), (void **) &points,
+		D3DLOCK_DISCARD), "Cannot draw primitives: Cannot lock vertex buffer"))
+		return;
+
+	// Direct3D 9 pixel centers are at integer coordinates, the batcher's are at half pixels
+	for (int i=0; i<vertexCount; i++)
+	{
+		const PrimitiveBatcher::Vertex & vertex = vertices[i];
+		points[i].x = vertex.x - 0.5f;
+		points[i].y = vertex.y - 0.5f;
+		points[i].z = texture != NULL ? 0.5f : 1.0f;
+		points[i].rhw = 1.0f;
+		points[i].diffuse = vertex.color;
+		points[i].tu = texture != NULL ? vertex.u / currentTextureSize.x : 0.0f;
+		points[i].tv = texture != NULL ? vertex.v / currentTextureSize.y : 0.0f;
+	}
+
+	if (failedObserving(vertexBuffer->Unlock(), "Cannot draw primitives: Cannot unlock vertex buffer"))
+		return;
+
+	currentStatistics.increment(RendererStatistics::BATCHES);
+	currentStatistics.increment(RendererStatistics::VERTEX_BYTES, vertexCount * sizeof(Point));
+
+	if (type == PrimitiveBatcher::PRIMITIVETYPE_LINES)
+		failedObserving(direct3DDevice->DrawPrimitive(D3DPT_LINELIST, 0, vertexCount / 2),
+			"Cannot draw primitives: Cannot draw line list");
+	else
+		failedObserving(direct3DDevice->DrawPrimitive(D3DPT_TRIANGLELIST, 0, vertexCount / 3),
+			"Cannot draw primitives: Cannot draw triangle list");
 }
 
 void DirectXPlatformAdapter::update()
@@ -2530,6 +2469,21 @@ void DirectXPlatformAdapter::update()
 	processMessages();
 }
 
+void DirectXPlatformAdapter::waitForInput(long timeout)
+{
+	ASSERTION_COBJECT(this);
+
+	// Wake up on any window message (including input already queued), or on wakeUp()
+	::MsgWaitForMultipleObjectsEx(1, &wakeEvent, timeout >= 0 ? (DWORD) timeout : INFINITE,
+		QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+}
+
+void DirectXPlatformAdapter::wakeUp()
+{
+	ASSERTION_COBJECT(this);
+	::SetEvent(wakeEvent);
+}
+
 void DirectXPlatformAdapter::updatePresentParameters()
 {
 	ASSERTION_COBJECT(this);
@@ -12,7 +12,7 @@
 
 namespace glaziery
 {
-	class DirectXPlatformAdapter : public PlatformAdapter
+	class DirectXPlatformAdapter : public PlatformAdapter, public PrimitiveBatcher::Backend
 	{
 		protected:
 
@@ -46,7 +46,6 @@ namespace glaziery
 			ID3DXRenderToSurface * currentRenderer;
 			IDirect3DTexture9 * currentTexture;
 			Vector currentTextureSize;
-			Point * currentVertices;
 			char decimalPoint;
 			IDirect3D9 * direct3D;
 			IDirect3DDevice9 * direct3DDevice;
@@ -66,24 +65,14 @@ namespace glaziery
 			__int64 performanceTimerStart;
 			bool pow2Required;
 			D3DPRESENT_PARAMETERS presentParameters;
+			PrimitiveBatcher primitiveBatcher;
 			float * sineTable;
 			bool squareRequired;
-			int vertexNo;
 			IDirect3DVertexBuffer9 * vertexBuffer;
+			HANDLE wakeEvent;
 			ATOM windowClassNameAtom;
 			HWND windowHandle;
 
-			inline void addTextureRectangle(Vector sourcePosition, Vector sourceSize,
-				Vector targetPosition, Vector targetSize, unsigned long modulationColor);
-			inline void addTextureRectangle(int sourceX, int sourceY, int sourceWidth, int sourceHeight,
-				float targetX, float targetY, float targetWidth, float targetHeight, unsigned long modulationColor);
-			inline void DirectXPlatformAdapter::addTextureRectangle(Vector sourcePosition, Vector sourceSize,
-				Vector targetPosition0, Vector targetPosition1, Vector targetPosition2, Vector targetPosition3,
-				unsigned long modulationColor);
-			inline void DirectXPlatformAdapter::addTextureRectangle(int sourceX, int sourceY,
-				int sourceWidth, int sourceHeight,
-				float target0X, float target0Y, float target1X, float target1Y,
-				float target2X, float target2Y, float target3X, float target3Y, unsigned long modulationColor);
 			Vector alignSize(Vector size);
 			bool checkAndChooseMode(D3DFORMAT d3dFormat,
 				unsigned int minimumWidth, unsigned int minimumHeight,
@@ -100,7 +89,6 @@ namespace glaziery
 				bool withHotKeys, bool ellipse);
 			bool ensureScene(DrawingContext & context);
 			inline bool failedObserving(HRESULT result, const char * message);
-			inline bool flushVertexBuffer();
 			D3DFORMAT getBackBufferFormat();
 			IDirect3DSurface9 * getCurrentSurface();
 			D3DFORMAT getD3DFormat(int format);
@@ -172,13 +160,25 @@ namespace glaziery
 			virtual int getMasterVolume();
 			virtual MouseHandler * getMouseHandler();
 			virtual unsigned long getPixel(DrawingContext & context, Vector position);
+			virtual double getPreciseTime();
+			virtual PrimitiveBatcher * getPrimitiveBatcher();
 			virtual Vector getScreenSize();
 			virtual String getSystemInformation();
 			virtual unsigned long getTime();
+			HANDLE getWakeEvent();
 			HWND getWindowHandle();
 			virtual void initialize();
 			virtual bool isAlphaFullySupported();
 			virtual bool isApplicationFocused();
+
+			/**
+			 * Returns whether the back buffer still contains the last shown frame
+			 * when the next frame is drawn. This is the case for the copy swap effect
+			 * used in windowed mode, but not for the flip swap effect used in full screen mode.
+			 * @return Whether the back buffer is retained between frames.
+			 * @see Desktop::setDamageTracking()
+			 */
+			virtual bool isBackBufferRetained();
 			virtual bool isDeleteKey(int keyCode);
 			virtual bool isExclusive();
 			virtual bool isFullScreen();
@@ -196,7 +196,17 @@ namespace glaziery
 			virtual void showFrame();
 			virtual void shutDown();
 			virtual void sleep(unsigned long msecs);
+
+			/**
+			 * Draws a batch of primitives collected by the primitive batcher,
+			 * using one vertex buffer fill and one draw call.
+			 * @see PrimitiveBatcher::Backend::submitPrimitives()
+			 */
+			virtual void submitPrimitives(PrimitiveBatcher::PrimitiveType type, Image * texture,
+				BlendType blendType, const PrimitiveBatcher::Vertex * vertices, int vertexCount);
 			virtual void update();
+			virtual void waitForInput(long timeout);
+			virtual void wakeUp();
 	};
 }
 
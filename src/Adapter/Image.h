@@ -134,7 +134,7 @@ namespace glaziery
 			 * Does nothing if it is a render target.
 			 * @see PlatformAdapter::getImage()
 			 */
-			virtual void ensureLoaded() = NULL;
+			virtual void ensureLoaded() = 0;
 
 			/**
 			 * Returns the type of the image (whether the image contains RGB
@@ -177,7 +177,7 @@ namespace glaziery
 			 *
 			 * @param size The required size.
 			 */
-			virtual void resize(Vector size) = NULL;
+			virtual void resize(Vector size) = 0;
 
 			/**
 			 * Sets the maximum size of this image. Resize and image load operations are constrained to this size.
@@ -191,7 +191,7 @@ namespace glaziery
 			 * Does nothing if it is a render target.
 			 * @see PlatformAdapter::getImage()
 			 */
-			virtual void unload() = NULL;
+			virtual void unload() = 0;
 	};
 }
 
@@ -121,13 +121,13 @@ namespace glaziery
 			 * Shuts down the input handler.
 			 * @note Implement this method in the platform implementation.
 			 */
-			virtual void shutDown() = NULL;
+			virtual void shutDown() = 0;
 
 			/**
 			 * Handles all input and updates event quantities.
 			 * @note Implement this method in the platform implementation.
 			 */
-			virtual void update() = NULL;
+			virtual void update() = 0;
 
 			/**
 			 * Updates the handler when the scene's exclusive changes.
@@ -86,7 +86,7 @@ namespace glaziery
 			 * to the underlying OS pointer (and maybe caching).
 			 * @return The pointer position.
 			 */
-			virtual Vector getPointerPosition() = NULL;
+			virtual Vector getPointerPosition() = 0;
 
 			/**
 			 * Initializes the input handler.
@@ -128,19 +128,19 @@ namespace glaziery
 			 * to the underlying OS pointer (and maybe caching).
 			 * @param position The new pointer position.
 			 */
-			virtual void setPointerPosition(Vector position) = NULL;
+			virtual void setPointerPosition(Vector position) = 0;
 
 			/**
 			 * Shuts down the input handler.
 			 * @note Implement this method in the platform implementation.
 			 */
-			virtual void shutDown() = NULL;
+			virtual void shutDown() = 0;
 
 			/**
 			 * Handles all input and updates event quantities.
 			 * @note Implement this method in the platform implementation.
 			 */
-			virtual void update() = NULL;
+			virtual void update() = 0;
 
 			/**
 			 * Updates the handler when the scene's exclusive changes.
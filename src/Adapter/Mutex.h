@@ -43,12 +43,12 @@ namespace glaziery
 			/**
 			 * TODO
 			 */
-			virtual bool lock(long timeout = NO_TIMEOUT) = NULL;
+			virtual bool lock(long timeout = NO_TIMEOUT) = 0;
 
 			/**
 			 * TODO
 			 */
-			virtual void release() = NULL;
+			virtual void release() = 0;
 	};
 }
 
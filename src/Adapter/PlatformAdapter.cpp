@@ -10,9 +10,29 @@
 #include <Glaziery/src/Headers.h>
 
 
+const long PlatformAdapter::IDLE_POLLING_INTERVAL = 10;
+
+// Configurable properties
+CF_INT_IMPL(PlatformAdapter, RenderTargetPoolBudget)
+
+PlatformAdapter::PlatformAdapter()
+{
+	ASSERTION_COBJECT(this);
+
+	pooledRenderTargetBytes = 0;
+	renderTargetPoolHits = 0;
+	renderTargetPoolMisses = 0;
+	scrollingBuffer = NULL;
+
+	RenderTargetPoolBudget = 16384;
+}
+
 PlatformAdapter::~PlatformAdapter()
 {
 	ASSERTION_COBJECT(this);
+
+	// The pooled render targets are owned by renderTargetImages
+	pooledRenderTargets.UnlinkAll();
 }
 
 void PlatformAdapter::Configure(ConfigSection * section, bool write)
@@ -22,6 +42,36 @@ void PlatformAdapter::Configure(ConfigSection * section, bool write)
 	section->Configure("JoystickHandler", getJoystickHandler(), write);
 	section->Configure("KeyboardHandler", getKeyboardHandler(), write);
 	section->Configure("MouseHandler", getMouseHandler(), write);
+	section->Configure("RenderTargetPoolBudget", RenderTargetPoolBudget, write, 16384);
+}
+
+Image * PlatformAdapter::acquireRenderTarget(Vector size, Image::Type imageType)
+{
+	ASSERTION_COBJECT(this);
+
+	Vector bucketSize = getRenderTargetBucketSize(size);
+
+	// Prefer the most recently released render target, its memory is most likely still warm
+	for (int i = pooledRenderTargets.GetCount() - 1; i >= 0; i--)
+	{
+		Image * image = pooledRenderTargets.Get(i);
+		if (image->getImageType() == imageType && getRenderTargetBucketSize(image->getSize()) == bucketSize)
+		{
+			pooledRenderTargets.Unlink(i);
+			pooledRenderTargetBytes -= getRenderTargetBytes(image);
+			renderTargetPoolHits++;
+
+			image->resize(size);
+			return image;
+		}
+	}
+
+	// Allocate the entire bucket, so that resizing within the bucket keeps the allocation
+	renderTargetPoolMisses++;
+	Image * image = createRenderTarget(bucketSize, imageType);
+	image->resize(size);
+
+	return image;
 }
 
 PlatformAdapter * PlatformAdapter::createInstance()
@@ -31,6 +81,8 @@ PlatformAdapter * PlatformAdapter::createInstance()
 		adapter = new DirectXPlatformAdapter;
 	#elif defined(TODO_MACOS_KEYWORD)
 		adapter = new MacOSPlatformAdapter;
+	#elif defined(GL_SOFTWARE_ADAPTER)
+		adapter = new SoftwarePlatformAdapter;
 	#else
 		#error Unknown platform
 	#endif
@@ -97,6 +149,19 @@ void PlatformAdapter::drawText(DrawingContext & context, Font * font, Vector pos
 		BLENDTYPE_NORMAL, caps, withHotKeys, ellipse);
 }
 
+void PlatformAdapter::evictRenderTargets()
+{
+	ASSERTION_COBJECT(this);
+
+	long budget = (long) GetRenderTargetPoolBudget() * 1024;
+	while (pooledRenderTargetBytes > budget && !pooledRenderTargets.IsEmpty())
+	{
+		Image * image = pooledRenderTargets.UnlinkFirst();
+		pooledRenderTargetBytes -= getRenderTargetBytes(image);
+		destroyRenderTarget(image);
+	}
+}
+
 Font * PlatformAdapter::getFont(const String & path)
 {
 	ASSERTION_COBJECT(this);
@@ -111,6 +176,12 @@ Font * PlatformAdapter::getFont(const String & path)
 	return font;
 }
 
+const RendererStatistics & PlatformAdapter::getFrameStatistics()
+{
+	ASSERTION_COBJECT(this);
+	return lastFrameStatistics;
+}
+
 Image * PlatformAdapter::getImage(const String & path, bool load)
 {
 	ASSERTION_COBJECT(this);
@@ -128,15 +199,130 @@ Image * PlatformAdapter::getImage(const String & path, bool load)
 	return image;
 }
 
+long PlatformAdapter::getPooledRenderTargetBytes()
+{
+	ASSERTION_COBJECT(this);
+	return pooledRenderTargetBytes;
+}
+
+double PlatformAdapter::getPreciseTime()
+{
+	ASSERTION_COBJECT(this);
+	return getTime() * 1000.0;
+}
+
+PrimitiveBatcher * PlatformAdapter::getPrimitiveBatcher()
+{
+	ASSERTION_COBJECT(this);
+	return NULL;
+}
+
+Vector PlatformAdapter::getRenderTargetBucketSize(Vector size)
+{
+	Vector bucketSize(1, 1);
+	while (bucketSize.x < size.x)
+		bucketSize.x <<= 1;
+	while (bucketSize.y < size.y)
+		bucketSize.y <<= 1;
+
+	return bucketSize;
+}
+
+long PlatformAdapter::getRenderTargetBytes(Image * image)
+{
+	Vector bucketSize = getRenderTargetBucketSize(image->getSize());
+	return (long) bucketSize.x * (long) bucketSize.y * 4;
+}
+
+unsigned long PlatformAdapter::getRenderTargetPoolHits()
+{
+	ASSERTION_COBJECT(this);
+	return renderTargetPoolHits;
+}
+
+unsigned long PlatformAdapter::getRenderTargetPoolMisses()
+{
+	ASSERTION_COBJECT(this);
+	return renderTargetPoolMisses;
+}
+
+const RendererStatistics & PlatformAdapter::getTotalStatistics()
+{
+	ASSERTION_COBJECT(this);
+	return totalStatistics;
+}
+
 #if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
 	IMPLEMENT_DYNAMIC(PlatformAdapter, CObject);
 #endif
 
+bool PlatformAdapter::isRenderTargetFitting(Image * image, Vector size)
+{
+	ASSERTION_COBJECT(this);
+	return getRenderTargetBucketSize(image->getSize()) == getRenderTargetBucketSize(size);
+}
+
 void PlatformAdapter::onDesktopTitleChanged()
 {
 	ASSERTION_COBJECT(this);
 }
 
+void PlatformAdapter::releaseRenderTarget(Image * image)
+{
+	ASSERTION_COBJECT(this);
+
+	// The pool must not notify the previous user when the render target gets invalidated
+	while (!image->getListeners().IsEmpty())
+		image->removeListener(image->getListeners().Get(0));
+
+	pooledRenderTargets.Append(image);
+	pooledRenderTargetBytes += getRenderTargetBytes(image);
+
+	evictRenderTargets();
+}
+
+void PlatformAdapter::resetStatistics()
+{
+	ASSERTION_COBJECT(this);
+	totalStatistics.reset();
+}
+
+void PlatformAdapter::scrollImageArea(Image * image, Vector position, Vector size, Vector delta)
+{
+	ASSERTION_COBJECT(this);
+
+	Vector retainedSize = size - delta.absolute();
+	if (retainedSize.x <= 0 || retainedSize.y <= 0)
+		return;
+
+	Vector sourcePosition = position + Vector(delta.x < 0 ? -delta.x : 0, delta.y < 0 ? -delta.y : 0);
+	Vector targetPosition = position + Vector(delta.x > 0 ? delta.x : 0, delta.y > 0 ? delta.y : 0);
+
+	// Images cannot be drawn onto themselves on all platforms,
+	// so copy the retained pixels to the scrolling buffer and back
+	if (scrollingBuffer != NULL && scrollingBuffer->getImageType() != image->getImageType())
+	{
+		destroyRenderTarget(scrollingBuffer);
+		scrollingBuffer = NULL;
+	}
+
+	if (scrollingBuffer == NULL)
+		scrollingBuffer = createRenderTarget(retainedSize, image->getImageType());
+	else if (!(scrollingBuffer->getSize() >= retainedSize))
+	{
+		Vector bufferSize = scrollingBuffer->getSize();
+		scrollingBuffer->resize(Vector(bufferSize.x > retainedSize.x ? bufferSize.x : retainedSize.x,
+			bufferSize.y > retainedSize.y ? bufferSize.y : retainedSize.y));
+	}
+
+	DrawingContext bufferContext(scrollingBuffer);
+	drawImage(bufferContext, image, sourcePosition, retainedSize,
+		Vector(), retainedSize, GL_WHITE, BLENDTYPE_OPAQUE);
+	DrawingContext imageContext(image);
+	drawImage(imageContext, scrollingBuffer, Vector(), retainedSize,
+		targetPosition, retainedSize, GL_WHITE, BLENDTYPE_OPAQUE);
+}
+
 void PlatformAdapter::sleepWithCheatProtection(unsigned long time)
 {
 	ASSERTION_COBJECT(this);
@@ -150,6 +336,15 @@ void PlatformAdapter::sleepWithCheatProtection(unsigned long time)
 	sleep(time);
 }
 
+void PlatformAdapter::snapshotStatistics()
+{
+	ASSERTION_COBJECT(this);
+
+	lastFrameStatistics = currentStatistics;
+	totalStatistics.add(currentStatistics);
+	currentStatistics.reset();
+}
+
 void PlatformAdapter::updateExclusive()
 {
 	ASSERTION_COBJECT(this);
@@ -158,3 +353,14 @@ void PlatformAdapter::updateExclusive()
 	getMouseHandler()->updateExclusive();
 	getJoystickHandler()->updateExclusive();
 }
+
+void PlatformAdapter::waitForInput(long timeout)
+{
+	ASSERTION_COBJECT(this);
+	sleep(timeout >= 0 && timeout < IDLE_POLLING_INTERVAL ? timeout : IDLE_POLLING_INTERVAL);
+}
+
+void PlatformAdapter::wakeUp()
+{
+	ASSERTION_COBJECT(this);
+}
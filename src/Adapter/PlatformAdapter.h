@@ -34,6 +34,9 @@ namespace glaziery
 		class PlatformAdapter : public Configurable
 	#endif
 	{
+		// Configurable properties
+		CF_INT_DECL(RenderTargetPoolBudget)
+
 		public:
 
 			enum BlendType
@@ -76,6 +79,20 @@ namespace glaziery
 
 		protected:
 
+			/**
+			 * The maximum time in milli seconds the default implementation
+			 * of waitForInput() sleeps before returning to poll for input.
+			 * @see waitForInput()
+			 */
+			static const long IDLE_POLLING_INTERVAL;
+
+			/**
+			 * The renderer statistics of the frame currently being rendered.
+			 * Subclasses increment them while drawing.
+			 * @see snapshotStatistics()
+			 */
+			RendererStatistics currentStatistics;
+
 			/**
 			 * The currently managed file-based images.
 			 * @see getImage()
@@ -88,19 +105,65 @@ namespace glaziery
 			 */
 			StringKeyHashMap<Font> fonts;
 
+			/**
+			 * The renderer statistics of the last completed frame.
+			 * @see getFrameStatistics()
+			 */
+			RendererStatistics lastFrameStatistics;
+
+			/**
+			 * The number of bytes held by the pooled render targets.
+			 * @see pooledRenderTargets
+			 */
+			long pooledRenderTargetBytes;
+
+			/**
+			 * The render targets released to the pool, least recently released first.
+			 * They are still managed by renderTargetImages, this list does not own them.
+			 * @see acquireRenderTarget()
+			 * @see releaseRenderTarget()
+			 */
+			ArrayList<Image> pooledRenderTargets;
+
 			/**
 			 * The currently managed render target images.
 			 * @see createImage()
 			 */
 			ArrayList<Image> renderTargetImages;
 
+			/**
+			 * The number of render target acquisitions served from the pool.
+			 * @see acquireRenderTarget()
+			 */
+			unsigned long renderTargetPoolHits;
+
+			/**
+			 * The number of render target acquisitions that created a new render target.
+			 * @see acquireRenderTarget()
+			 */
+			unsigned long renderTargetPoolMisses;
+
+			/**
+			 * The render target used by scrollImageArea() to buffer the shifted pixels,
+			 * or NULL if not created yet. It is grown on demand and never shrinks.
+			 * @see scrollImageArea()
+			 */
+			Image * scrollingBuffer;
+
+			/**
+			 * The renderer statistics accumulated over all completed frames
+			 * since the last resetStatistics().
+			 * @see getTotalStatistics()
+			 */
+			RendererStatistics totalStatistics;
+
 			/**
 			 * Creates a new font object for a given font file path.
 			 * @param path The path of the font file, may be relative or absolute.
 			 * Relative paths are relative to the application's executable location.
 			 * @return The new font object.
 			 */
-			virtual Font * createFont(const String & path) = NULL;
+			virtual Font * createFont(const String & path) = 0;
 
 			/**
 			 * Creates a new image object from a file, or an empty render target.
@@ -110,7 +173,38 @@ namespace glaziery
 			 * and/or alpha information).
 			 * @return The new image object.
 			 */
-			virtual Image * createImage(const String & path, Image::Type imageType) = NULL;
+			virtual Image * createImage(const String & path, Image::Type imageType) = 0;
+
+			/**
+			 * Destroys the least recently released pooled render targets
+			 * until the pool fits the RenderTargetPoolBudget.
+			 */
+			void evictRenderTargets();
+
+			/**
+			 * Returns the size of the pool bucket a render target of a given size belongs to.
+			 * Each dimension is rounded up to the next power of two, so that resizing a render target
+			 * within its bucket never reallocates it, and a pooled render target serves all sizes
+			 * of its bucket.
+			 * @param size The render target size.
+			 * @return The bucket size.
+			 */
+			static Vector getRenderTargetBucketSize(Vector size);
+
+			/**
+			 * Returns the estimated number of video memory bytes held by a render target,
+			 * assuming it is allocated with its bucket size.
+			 * @param image The render target.
+			 * @return The number of bytes.
+			 */
+			static long getRenderTargetBytes(Image * image);
+
+			/**
+			 * Completes the renderer statistics of the current frame:
+			 * They become the last frame's statistics, are added to the total statistics,
+			 * and the current statistics restart at 0. Called by the Desktop once per frame.
+			 */
+			void snapshotStatistics();
 
 			/**
 			 * Draws a multi-colored text at a given position, using a given font
@@ -137,7 +231,7 @@ namespace glaziery
 			 */
 			virtual void drawTextInternal(DrawingContext & context, Font * font, Vector position,
 				const String & text, unsigned long modulationColor, BlendType blendType, bool caps,
-				bool withHotKeys, bool ellipse) = NULL;
+				bool withHotKeys, bool ellipse) = 0;
 
 			/**
 			 * Updates all handlers when the scene's exclusive changes.
@@ -153,6 +247,11 @@ namespace glaziery
 
 		public:
 
+			/**
+			 * Creates a new platform adapter.
+			 */
+			PlatformAdapter();
+
 			/**
 			 * Destroys the platform adapter. Do not use this destructor if the adapter has been passed to the Desktop.
 			 */
@@ -166,6 +265,21 @@ namespace glaziery
 			 */
 			virtual void Configure(ConfigSection * section, bool write);
 
+			/**
+			 * Returns a render target image of a given size and type, preferring a pooled one
+			 * of the same bucket over creating a new one. Use this method for render targets that
+			 * are frequently created and destroyed, e.g. component caches of popups and menus.
+			 * The content of the returned image is undefined.
+			 * @param size The size of the image.
+			 * @param imageType The type of the image (whether the image contains RGB
+			 * and/or alpha information).
+			 * @return The render target image.
+			 * @note The object is managed by the platform adapter,
+			 * return it by calling releaseRenderTarget().
+			 * @see releaseRenderTarget()
+			 */
+			Image * acquireRenderTarget(Vector size, Image::Type imageType);
+
 			/**
 			 * Clears the entire surface defined by a drawing context.
 			 * @param context The drawing context to be used. The drawing context defines
@@ -174,13 +288,13 @@ namespace glaziery
 			 * red, green, and blue components. Use the color macros to synthesize this color.
 			 * Defaults to black.
 			 */
-			virtual void clear(DrawingContext & context, unsigned long fillColor = GL_BLACK) = NULL;
+			virtual void clear(DrawingContext & context, unsigned long fillColor = GL_BLACK) = 0;
 
 			/**
 			 * Clears the contents of the system's clipboard or at least the text version of it,
 			 * so that getClipboardText() will return an empty string.
 			 */
-			virtual void clearClipboard() = NULL;
+			virtual void clearClipboard() = 0;
 
 			/**
 			 * Creates a new platform adapter, determining the current platform's implementation.
@@ -194,7 +308,7 @@ namespace glaziery
 			 * @return The new mutex. You must delete this object after use.
 			 * @see createThread()
 			 */
-			virtual Mutex * createMutex() = NULL;
+			virtual Mutex * createMutex() = 0;
 
 			/**
 			 * Creates a new render target image.
@@ -226,7 +340,7 @@ namespace glaziery
 			 * @see Desktop::deferOperation()
 			 */
 			virtual Thread * createThread(int (*function)(Thread & thread, void * parameter),
-				void * parameter) = NULL;
+				void * parameter) = 0;
 
 			/**
 			 * Destroys a render target image.
@@ -287,7 +401,7 @@ namespace glaziery
 			 * the ellipse has no outline.
 			 */
 			virtual void drawEllipse(DrawingContext & context, Vector center, Vector radius,
-				unsigned long fillColor, unsigned long borderColor) = NULL;
+				unsigned long fillColor, unsigned long borderColor) = 0;
 
 			/**
 			 * Draws all of an image without stretching or shrinking.
@@ -356,7 +470,7 @@ namespace glaziery
 			 */
 			virtual void drawImage(DrawingContext & context, Image * image,
 				Vector sourcePosition, Vector sourceSize, Vector targetPosition, Vector targetSize,
-				unsigned long modulationColor = GL_WHITE, BlendType blendType = BLENDTYPE_NORMAL) = NULL;
+				unsigned long modulationColor = GL_WHITE, BlendType blendType = BLENDTYPE_NORMAL) = 0;
 
 			/**
 			 * Draws a line from a given position to another one.
@@ -368,7 +482,7 @@ namespace glaziery
 			 * green, and blue components. Use the color macros to synthesize this color.
 			 */
 			virtual void drawLine(DrawingContext & context, Vector from, Vector to,
-				unsigned long color) = NULL;
+				unsigned long color) = 0;
 
 			/**
 			 * Draws a mono-colored text at a given position, using a given font
@@ -403,7 +517,7 @@ namespace glaziery
 			 * green, and blue components. Use the color macros to synthesize this color.
 			 */
 			virtual void drawPixel(DrawingContext & context, Vector position,
-				unsigned long color) = NULL;
+				unsigned long color) = 0;
 
 			/**
 			 * Draws a rectangle (or square) without an outline.
@@ -434,7 +548,7 @@ namespace glaziery
 			 * the rectangle has no outline.
 			 */
 			virtual void drawRect(DrawingContext & context, Vector from, Vector to,
-				unsigned long fillColor, unsigned long borderColor) = NULL;
+				unsigned long fillColor, unsigned long borderColor) = 0;
 
 			/**
 			 * Draws all of an image without stretching or shrinking, and using rotation.
@@ -515,7 +629,7 @@ namespace glaziery
 			virtual void drawRotatedImage(DrawingContext & context, Image * image,
 				Vector sourcePosition, Vector sourceSize, Vector targetPosition, Vector targetSize,
 				Vector rotationAnchor, double rotationAngle,
-				unsigned long modulationColor = GL_WHITE, BlendType blendType = BLENDTYPE_NORMAL) = NULL;
+				unsigned long modulationColor = GL_WHITE, BlendType blendType = BLENDTYPE_NORMAL) = 0;
 
 			/**
 			 * Draws a multi-colored text at a given position, using a given font
@@ -570,26 +684,26 @@ namespace glaziery
 			 * the triangle has no outline.
 			 */
 			virtual void drawTriangle(DrawingContext & context, Vector * vertices,
-				unsigned long fillColor, unsigned long borderColor) = NULL;
+				unsigned long fillColor, unsigned long borderColor) = 0;
 
 			/**
 			 * Returns the current time since the beginning of the ERA
 			 * (since 1st of January 1970, 0:00) in seconds.
 			 * @return The absolute time in seconds.
 			 */
-			virtual unsigned long getAbsoluteTime() = NULL;
+			virtual unsigned long getAbsoluteTime() = 0;
 
 			/**
 			 * Returns the currently available video memory in KB.
 			 * @return The currently available video memory in KB.
 			 */
-			virtual unsigned long getAvailableVideoMemory() = NULL;
+			virtual unsigned long getAvailableVideoMemory() = 0;
 
 			/**
 			 * Returns a text version of the current content of the system's clipboard.
 			 * @return The clipboard text.
 			 */
-			virtual String getClipboardText() = NULL;
+			virtual String getClipboardText() = 0;
 
 			/**
 			 * Returns the path to the configuration folder for this application on the OS.
@@ -598,7 +712,7 @@ namespace glaziery
 			 * @param applicationName The technical name of the application (may be used to build folder name).
 			 * @return The path to the configuration folder.
 			 */
-			virtual String getConfigFolder(const String & manufacturer, const String & applicationName) = NULL;
+			virtual String getConfigFolder(const String & manufacturer, const String & applicationName) = 0;
 
 			/**
 			 * Returns a font by its font file path.
@@ -610,11 +724,18 @@ namespace glaziery
 			 */
 			Font * getFont(const String & path);
 
+			/**
+			 * Returns the renderer statistics of the last completed frame,
+			 * e.g. the number of primitives drawn, batches submitted, and texture binds.
+			 * @return The renderer statistics.
+			 */
+			const RendererStatistics & getFrameStatistics();
+
 			/**
 			 * Returns the decimal point used by the system's default locale.
 			 * @return The decimal point (e.g. '.' or ',').
 			 */
-			virtual char getDecimalPoint() = NULL;
+			virtual char getDecimalPoint() = 0;
 
 			/**
 			 * Returns an image by its file path.
@@ -633,32 +754,32 @@ namespace glaziery
 			 * Returns the joystick input handler of this platform adapter.
 			 * @return The joystick input handler.
 			 */
-			virtual JoystickHandler * getJoystickHandler() = NULL;
+			virtual JoystickHandler * getJoystickHandler() = 0;
 
 			/**
 			 * Returns the keyboard input handler of this platform adapter.
 			 * @return The keyboard input handler.
 			 */
-			virtual KeyboardHandler * getKeyboardHandler() = NULL;
+			virtual KeyboardHandler * getKeyboardHandler() = 0;
 
 			/**
 			 * Returns the human friendly name of a key for a given key code.
 			 * @param keyCode The key code.
 			 * @return The human friendly name.
 			 */
-			virtual const char * getKeyName(int keyCode) = NULL;
+			virtual const char * getKeyName(int keyCode) = 0;
 
 			/**
 			 * Returns the current master volume, which ranges from 0 to 255.
 			 * @return The current master volume.
 			 */
-			virtual int getMasterVolume() = NULL;
+			virtual int getMasterVolume() = 0;
 
 			/**
 			 * Returns the mouse input handler of this platform adapter.
 			 * @return The mouse input handler.
 			 */
-			virtual MouseHandler * getMouseHandler() = NULL;
+			virtual MouseHandler * getMouseHandler() = 0;
 
 			/**
 			 * Returns the color of an image's pixel at a given position.
@@ -677,90 +798,155 @@ namespace glaziery
 			 * @return The point color. The color consists of alpha, red, green,
 			 * and blue components. Use the color macros to analyze this color.
 			 */
-			virtual unsigned long getPixel(DrawingContext & context, Vector position) = NULL;
+			virtual unsigned long getPixel(DrawingContext & context, Vector position) = 0;
+
+			/**
+			 * Returns the number of bytes currently held by pooled (unused) render targets.
+			 * After each release, the pool is trimmed to RenderTargetPoolBudget kilobytes.
+			 * @return The number of bytes.
+			 * @see releaseRenderTarget()
+			 */
+			long getPooledRenderTargetBytes();
+
+			/**
+			 * Returns the current time in micro seconds since the application's start,
+			 * as precise as the platform permits, e.g. for profiling.
+			 * The default implementation is based on getTime().
+			 * @return The current time in micro seconds.
+			 */
+			virtual double getPreciseTime();
+
+			/**
+			 * Returns the primitive batcher the adapter collects its drawing primitives with,
+			 * e.g. to read its batch statistics.
+			 * The default implementation returns NULL, for adapters that draw immediately.
+			 * @return The primitive batcher, or NULL.
+			 */
+			virtual PrimitiveBatcher * getPrimitiveBatcher();
+
+			/**
+			 * Returns the number of render target acquisitions served from the pool.
+			 * @return The number of hits.
+			 * @see acquireRenderTarget()
+			 */
+			unsigned long getRenderTargetPoolHits();
+
+			/**
+			 * Returns the number of render target acquisitions that had to create a new render target.
+			 * @return The number of misses.
+			 * @see acquireRenderTarget()
+			 */
+			unsigned long getRenderTargetPoolMisses();
 
 			/**
 			 * Returns the size of the entire screen.
 			 * @return The screen size.
 			 */
-			virtual Vector getScreenSize() = NULL;
+			virtual Vector getScreenSize() = 0;
 
 			/**
 			 * Returns a string that describes the system (hardware, software, metrics, capabilities, etc.).
 			 * Useful for debugging on crashes etc.
 			 * @return The system information.
 			 */
-			virtual String getSystemInformation() = NULL;
+			virtual String getSystemInformation() = 0;
 
 			/**
 			 * Returns the current time in milli seconds since the application's start.
 			 * @return The current time in milli seconds
 			 */
-			virtual unsigned long getTime() = NULL;
+			virtual unsigned long getTime() = 0;
+
+			/**
+			 * Returns the renderer statistics accumulated over all completed frames
+			 * since the adapter's creation or the last resetStatistics().
+			 * @return The renderer statistics.
+			 */
+			const RendererStatistics & getTotalStatistics();
 
 			/**
 			 * Initializes the platform adapter. This method is called by the desktop
 			 * when it is initialized. Do not call this method manually.
 			 * @see Desktop::createInstance()
 			 */
-			virtual void initialize() = NULL;
+			virtual void initialize() = 0;
 
 			/**
 			 * Returns whether the alpha operations are fully supported.
 			 * If not, some alpha blending may fail and fall back to opaqueness.
 			 * @return Whether the alpha operations are fully supported.
 			 */
-			virtual bool isAlphaFullySupported() = NULL;
+			virtual bool isAlphaFullySupported() = 0;
 
 			/**
 			 * Returns whether the application is currently focused.
 			 * @return Whether the application is currently focused.
 			 */
-			virtual bool isApplicationFocused() = NULL;
+			virtual bool isApplicationFocused() = 0;
+
+			/**
+			 * Returns whether the back buffer still contains the last shown frame
+			 * when the next frame is drawn. If so, the Desktop redraws only the areas
+			 * damaged since the last frame, if damage tracking is enabled.
+			 * Otherwise, it redraws entire frames, but still skips unchanged ones.
+			 * @return Whether the back buffer is retained between frames.
+			 * @see Desktop::setDamageTracking()
+			 */
+			virtual bool isBackBufferRetained() = 0;
 
 			/**
 			 * Returns whether a given key is the delete key.
 			 * @param keyCode The key code.
 			 * @return Whether the key is the delete key.
 			 */
-			virtual bool isDeleteKey(int keyCode) = NULL;
+			virtual bool isDeleteKey(int keyCode) = 0;
 
 			/**
 			 * Returns whether the platform adapter is initialized as exclusive.
 			 * This is controlled by the last scene that issued an adapter restart.
 			 * @see Scene::isExlusive()
 			 */
-			virtual bool isExclusive() = NULL;
+			virtual bool isExclusive() = 0;
 
 			/**
 			 * Returns whether the platform adapter is initialized as full screen.
 			 * This is controlled by the last scene that issued an adapter restart.
 			 * @see Scene::isFullScreen()
 			 */
-			virtual bool isFullScreen() = NULL;
+			virtual bool isFullScreen() = 0;
 
 			/**
 			 * Returns whether the speakers are mute (which is independent from the master volume).
 			 * @return Whether the speakers are mute.
 			 */
-			virtual bool isMute() = NULL;
+			virtual bool isMute() = 0;
 
 			/**
 			 * Returns whether all images widths and height require to be a power of two.
 			 * @return Whether all images widths and height require to be a power of two.
 			 */
-			virtual bool isPow2Required() = NULL;
+			virtual bool isPow2Required() = 0;
+
+			/**
+			 * Returns whether an acquired render target can be resized to a given size
+			 * without leaving its pool bucket. If not, release it and acquire a new one.
+			 * @param image The render target.
+			 * @param size The new size.
+			 * @return Whether the render target fits.
+			 * @see acquireRenderTarget()
+			 */
+			bool isRenderTargetFitting(Image * image, Vector size);
 
 			/**
 			 * Returns whether all images widths and height require to be equal.
 			 * @return Whether all images widths and height require to be equal.
 			 */
-			virtual bool isSquareRequired() = NULL;
+			virtual bool isSquareRequired() = 0;
 
 			/**
 			 * Minimizes the entire application.
 			 */
-			virtual void minimizeDesktop() = NULL;
+			virtual void minimizeDesktop() = 0;
 
 			/**
 			 * Called when the desktop title changes.
@@ -772,49 +958,77 @@ namespace glaziery
 			 * Opens a given URL in a web browser.
 			 * @param url The URL to open.
 			 */
-			virtual void openUrl(const String & url) = NULL;
+			virtual void openUrl(const String & url) = 0;
+
+			/**
+			 * Returns a render target acquired by acquireRenderTarget() to the pool.
+			 * All its listeners are removed. If the pool exceeds RenderTargetPoolBudget
+			 * kilobytes then, the least recently released render targets are destroyed.
+			 * @param image The render target.
+			 * @see acquireRenderTarget()
+			 */
+			void releaseRenderTarget(Image * image);
+
+			/**
+			 * Resets the total renderer statistics.
+			 * @see getTotalStatistics()
+			 */
+			void resetStatistics();
 
 			/**
 			 * Restores the entire application.
 			 */
-			virtual void restoreDesktop() = NULL;
+			virtual void restoreDesktop() = 0;
 
 			/**
 			 * Sets a given text into system's clipboard.
 			 * @param text The new clipboard text.
 			 */
-			virtual void setClipboardText(const String & text) = NULL;
+			virtual void setClipboardText(const String & text) = 0;
 
 			/**
 			 * Sets the current master volume, which ranges from 0 to 255.
 			 * @param volume The current master volume.
 			 */
-			virtual void setMasterVolume(int masterVolume) = NULL;
+			virtual void setMasterVolume(int masterVolume) = 0;
 
 			/**
 			 * Sets whether the speakers are mute (which is independent from the master volume).
 			 * @param mute Whether the speakers are mute.
 			 */
-			virtual void setMute(bool mute) = NULL;
+			virtual void setMute(bool mute) = 0;
+
+			/**
+			 * Shifts the pixels of a rectangular area of a render target image by a given delta.
+			 * Pixels shifted outside the area are dropped, and the strips exposed by the shift
+			 * keep their previous content, so the caller must redraw them.
+			 * This enables scrolling without redrawing the entire scrolled content.
+			 * @param image The render target image.
+			 * @param position The top-left position of the area.
+			 * @param size The size of the area.
+			 * @param delta The number of pixels to shift the area's content by
+			 * (positive values shift right resp. down).
+			 */
+			void scrollImageArea(Image * image, Vector position, Vector size, Vector delta);
 
 			/**
 			 * Issues to show the drawing operations since the last call to showFrame().
 			 * Call this method at the end of a frame.
 			 */
-			virtual void showFrame() = NULL;
+			virtual void showFrame() = 0;
 
 			/**
 			 * Shuts down the platform adapter. This method is called by the desktop
 			 * when it is shut down. Do not call this method manually.
 			 * @see Desktop::destroyInstance()
 			 */
-			virtual void shutDown() = NULL;
+			virtual void shutDown() = 0;
 
 			/**
 			 * Suspends the current thread for a given number of milli seconds.
 			 * @param msecs The number of milli seconds to wait.
 			 */
-			virtual void sleep(unsigned long msecs) = NULL;
+			virtual void sleep(unsigned long msecs) = 0;
 
 			/**
 			 * Suspends the current thread for a given number of milli seconds,
@@ -828,7 +1042,27 @@ namespace glaziery
 			 * Called each frame to perform operations depending on the system,
 			 * such as dispatching Windows messages.
 			 */
-			virtual void update() = NULL;
+			virtual void update() = 0;
+
+			/**
+			 * Blocks until input events arrive, wakeUp() is called, or a timeout expires,
+			 * whichever happens first. The desktop calls this method when it is idle.
+			 * The default implementation cannot detect input events, so it sleeps for
+			 * IDLE_POLLING_INTERVAL milli seconds at most, resulting in a polling loop.
+			 * Platform adapters should override this method to block on the system's event queue.
+			 * @param timeout The maximum time to wait in milli seconds, or -1 to wait without timeout.
+			 * @see wakeUp()
+			 * @see Desktop::setIdleWaiting()
+			 */
+			virtual void waitForInput(long timeout);
+
+			/**
+			 * Causes a current or the next call to waitForInput() to return immediately.
+			 * This method may be called from any thread, e.g. after deferring operations.
+			 * The default implementation does nothing, since the default waitForInput() polls.
+			 * @see waitForInput()
+			 */
+			virtual void wakeUp();
 	};
 }
 
@@ -78,7 +78,8 @@ inline void PlatformAdapter::drawTriangle(DrawingContext & context, Vector * ver
 
 inline unsigned long PlatformAdapter::getPixel(Image * image, Vector position)
 {
-	return getPixel(DrawingContext(image), position);
+	DrawingContext context(image);
+	return getPixel(context, position);
 }
 
 
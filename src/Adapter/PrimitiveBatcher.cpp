@@ -0,0 +1,219 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+PrimitiveBatcher::PrimitiveBatcher(Backend * backend, int capacity)
+{
+	ASSERTION_COBJECT(this);
+
+	this->backend = backend;
+	batchCount = 0;
+	blendType = PlatformAdapter::BLENDTYPE_NORMAL;
+	this->capacity = capacity;
+	primitiveCount = 0;
+	texture = NULL;
+	type = PRIMITIVETYPE_TRIANGLES;
+	vertexCount = 0;
+
+	if ((vertices = new Vertex[capacity]) == NULL)
+		throw EOUTOFMEMORY;
+}
+
+PrimitiveBatcher::~PrimitiveBatcher()
+{
+	ASSERTION_COBJECT(this);
+	if (vertices != NULL) {delete[] vertices; vertices = NULL;}
+}
+
+void PrimitiveBatcher::addLine(float fromX, float fromY, float toX, float toY, unsigned long color)
+{
+	ASSERTION_COBJECT(this);
+
+	Vertex * line = addVertices(PRIMITIVETYPE_LINES, NULL, PlatformAdapter::BLENDTYPE_NORMAL, 2);
+	line[0].x = fromX;
+	line[0].y = fromY;
+	line[0].color = color;
+	line[1].x = toX;
+	line[1].y = toY;
+	line[1].color = color;
+
+	for (int i=0; i<2; i++)
+	{
+		line[i].u = 0.0f;
+		line[i].v = 0.0f;
+	}
+}
+
+void PrimitiveBatcher::addQuad(Image * texture, PlatformAdapter::BlendType blendType,
+	const float * xs, const float * ys, float sourceX, float sourceY, float sourceWidth, float sourceHeight,
+	unsigned long modulationColor)
+{
+	ASSERTION_COBJECT(this);
+
+	Vertex * quad = addVertices(PRIMITIVETYPE_TRIANGLES, texture, blendType, 6);
+	quad[0].x = xs[0];
+	quad[0].y = ys[0];
+	quad[0].u = sourceX;
+	quad[0].v = sourceY;
+
+	quad[1].x = xs[1];
+	quad[1].y = ys[1];
+	quad[1].u = sourceX + sourceWidth;
+	quad[1].v = sourceY;
+
+	quad[2].x = xs[2];
+	quad[2].y = ys[2];
+	quad[2].u = sourceX;
+	quad[2].v = sourceY + sourceHeight;
+
+	quad[3] = quad[1];
+	quad[4] = quad[2];
+
+	quad[5].x = xs[3];
+	quad[5].y = ys[3];
+	quad[5].u = sourceX + sourceWidth;
+	quad[5].v = sourceY + sourceHeight;
+
+	for (int i=0; i<6; i++)
+		quad[i].color = modulationColor;
+}
+
+void PrimitiveBatcher::addRect(float left, float top, float right, float bottom, unsigned long color)
+{
+	ASSERTION_COBJECT(this);
+
+	Vertex * rect = addVertices(PRIMITIVETYPE_TRIANGLES, NULL, PlatformAdapter::BLENDTYPE_NORMAL, 6);
+	rect[0].x = left;
+	rect[0].y = top;
+	rect[1].x = right;
+	rect[1].y = top;
+	rect[2].x = left;
+	rect[2].y = bottom;
+	rect[3] = rect[1];
+	rect[4] = rect[2];
+	rect[5].x = right;
+	rect[5].y = bottom;
+
+	for (int i=0; i<6; i++)
+	{
+		rect[i].color = color;
+		rect[i].u = 0.0f;
+		rect[i].v = 0.0f;
+	}
+}
+
+void PrimitiveBatcher::addTriangle(const float * xs, const float * ys, unsigned long color)
+{
+	ASSERTION_COBJECT(this);
+
+	Vertex * triangle = addVertices(PRIMITIVETYPE_TRIANGLES, NULL, PlatformAdapter::BLENDTYPE_NORMAL, 3);
+	for (int i=0; i<3; i++)
+	{
+		triangle[i].x = xs[i];
+		triangle[i].y = ys[i];
+		triangle[i].color = color;
+		triangle[i].u = 0.0f;
+		triangle[i].v = 0.0f;
+	}
+}
+
+PrimitiveBatcher::Vertex * PrimitiveBatcher::addVertices(PrimitiveType type, Image * texture,
+	PlatformAdapter::BlendType blendType, int count)
+{
+	ASSERTION_COBJECT(this);
+
+	if (count <= 0 || count > capacity)
+		throw EILLEGALARGUMENT("The number of vertices must be between 1 and the batch capacity");
+
+	if (vertexCount > 0 && (this->type != type || this->texture != texture
+		|| this->blendType != blendType || vertexCount + count > capacity))
+		flush();
+
+	this->type = type;
+	this->texture = texture;
+	this->blendType = blendType;
+	primitiveCount += type == PRIMITIVETYPE_LINES ? count / 2 : count / 3;
+
+	Vertex * reserved = &vertices[vertexCount];
+	vertexCount += count;
+	return reserved;
+}
+
+void PrimitiveBatcher::discard()
+{
+	ASSERTION_COBJECT(this);
+	vertexCount = 0;
+	texture = NULL;
+}
+
+void PrimitiveBatcher::flush()
+{
+	ASSERTION_COBJECT(this);
+
+	if (vertexCount <= 0)
+		return;
+
+	// Reset the pending state first, so a failing backend does not resubmit the batch
+	int submittedCount = vertexCount;
+	Image * submittedTexture = texture;
+	vertexCount = 0;
+	texture = NULL;
+
+	batchCount++;
+	backend->submitPrimitives(type, submittedTexture, blendType, vertices, submittedCount);
+}
+
+unsigned long PrimitiveBatcher::getBatchCount()
+{
+	ASSERTION_COBJECT(this);
+	return batchCount;
+}
+
+int PrimitiveBatcher::getCapacity()
+{
+	ASSERTION_COBJECT(this);
+	return capacity;
+}
+
+int PrimitiveBatcher::getPendingVertexCount()
+{
+	ASSERTION_COBJECT(this);
+	return vertexCount;
+}
+
+unsigned long PrimitiveBatcher::getPrimitiveCount()
+{
+	ASSERTION_COBJECT(this);
+	return primitiveCount;
+}
+
+Image * PrimitiveBatcher::getTexture()
+{
+	ASSERTION_COBJECT(this);
+	return texture;
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(PrimitiveBatcher, CObject);
+#endif
+
+void PrimitiveBatcher::resetStatistics()
+{
+	ASSERTION_COBJECT(this);
+
+	batchCount = 0;
+	primitiveCount = 0;
+}
+
+
+PrimitiveBatcher::Backend::~Backend()
+{
+}
@@ -0,0 +1,284 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_PRIMITIVEBATCHER_H
+#define __GLAZIERY_PRIMITIVEBATCHER_H
+
+
+namespace glaziery
+{
+	/**
+	 * The primitive batcher collects the lines, rectangles, triangles, and textured quads
+	 * drawn by a platform adapter into a vertex array, and submits consecutive primitives
+	 * that share the same primitive type, texture, and blend type to a backend as one batch.
+	 * This way, the backend issues one draw call per run of compatible primitives
+	 * (e.g. all glyphs of a text, or all background rectangles of a list) instead of one per
+	 * primitive. The batcher is platform independent; the backend performs the actual drawing.
+	 * Primitives are always submitted in the order they have been added, so the drawing result
+	 * is not changed by batching. A platform adapter must flush the batcher before it changes
+	 * any state the pending primitives depend on (the render target, the viewport,
+	 * or the content of a pending texture), and before reading or presenting pixels.
+	 * Coordinates are absolute pixel edge coordinates, i.e. the center of the pixel (x, y)
+	 * is (x + 0.5, y + 0.5), and a rectangle covering the pixels x to x2 spans x to x2 + 1.
+	 * Texture coordinates are given in source image pixels.
+	 * @see PlatformAdapter::getPrimitiveBatcher()
+	 */
+	#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+		class PrimitiveBatcher : public CObject
+	#else
+		class PrimitiveBatcher
+	#endif
+	{
+		public:
+
+			/**
+			 * The type of the primitives of a batch.
+			 */
+			enum PrimitiveType
+			{
+				/**
+				 * Each two vertices define a line.
+				 */
+				PRIMITIVETYPE_LINES,
+
+				/**
+				 * Each three vertices define a filled triangle.
+				 */
+				PRIMITIVETYPE_TRIANGLES
+			};
+
+			/**
+			 * A vertex of a batched primitive.
+			 */
+			struct Vertex
+			{
+				/**
+				 * The position of the vertex, in absolute pixel edge coordinates.
+				 */
+				float x, y;
+
+				/**
+				 * The color of the vertex, or the modulation color of textured primitives.
+				 */
+				unsigned long color;
+
+				/**
+				 * The texture position of the vertex, in source image pixels.
+				 * Ignored for untextured primitives.
+				 */
+				float u, v;
+			};
+
+			/**
+			 * The backend performs the drawing of the batches submitted by a primitive batcher.
+			 * Platform adapters implement it using their graphics API, other implementations
+			 * may e.g. record the batches for verification.
+			 * The backend is an interface that is usually mixed into a platform adapter,
+			 * so it does not derive from CObject.
+			 */
+			class Backend
+			{
+				public:
+
+					/**
+					 * Destroys the backend.
+					 */
+					virtual ~Backend();
+
+					/**
+					 * Draws a batch of primitives.
+					 * @param type The type of all primitives of the batch.
+					 * @param texture The texture image of all primitives, or NULL for untextured ones.
+					 * @param blendType How to blend the primitives on the target.
+					 * @param vertices The vertices of the primitives.
+					 * @param vertexCount The number of vertices, a multiple of the vertices per primitive.
+					 */
+					virtual void submitPrimitives(PrimitiveType type, Image * texture,
+						PlatformAdapter::BlendType blendType, const Vertex * vertices, int vertexCount) = 0;
+			};
+
+		private:
+
+			/**
+			 * The backend the batches are submitted to.
+			 */
+			Backend * backend;
+
+			/**
+			 * The number of batches submitted since the last resetStatistics().
+			 */
+			unsigned long batchCount;
+
+			/**
+			 * The blend type of the pending primitives.
+			 */
+			PlatformAdapter::BlendType blendType;
+
+			/**
+			 * The maximum number of vertices of a batch.
+			 */
+			int capacity;
+
+			/**
+			 * The number of primitives added since the last resetStatistics().
+			 */
+			unsigned long primitiveCount;
+
+			/**
+			 * The texture image of the pending primitives, or NULL.
+			 */
+			Image * texture;
+
+			/**
+			 * The primitive type of the pending primitives.
+			 */
+			PrimitiveType type;
+
+			/**
+			 * The number of pending vertices.
+			 */
+			int vertexCount;
+
+			/**
+			 * The pending vertices (capacity entries).
+			 */
+			Vertex * vertices;
+
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(PrimitiveBatcher);
+			#endif
+
+		public:
+
+			/**
+			 * Creates a new primitive batcher.
+			 * @param backend The backend the batches are submitted to.
+			 * @param capacity The maximum number of vertices of a batch.
+			 * Must hold the largest group of vertices added at once.
+			 */
+			PrimitiveBatcher(Backend * backend, int capacity);
+
+			/**
+			 * Destroys the primitive batcher, discarding all pending primitives.
+			 */
+			~PrimitiveBatcher();
+
+			/**
+			 * Adds an untextured line.
+			 * @param fromX The x coordinate of the start point.
+			 * @param fromY The y coordinate of the start point.
+			 * @param toX The x coordinate of the end point.
+			 * @param toY The y coordinate of the end point.
+			 * @param color The color of the line.
+			 */
+			void addLine(float fromX, float fromY, float toX, float toY, unsigned long color);
+
+			/**
+			 * Adds a textured quad, i.e. two textured triangles.
+			 * The corners may describe any (e.g. rotated) parallelogram.
+			 * @param texture The texture image.
+			 * @param blendType How to blend the quad on the target.
+			 * @param xs The x coordinates of the top-left, top-right, bottom-left,
+			 * and bottom-right corners (4 entries).
+			 * @param ys The y coordinates of the corners, see xs (4 entries).
+			 * @param sourceX The left source image pixel.
+			 * @param sourceY The top source image pixel.
+			 * @param sourceWidth The width of the source image area.
+			 * @param sourceHeight The height of the source image area.
+			 * @param modulationColor The modulation color.
+			 */
+			void addQuad(Image * texture, PlatformAdapter::BlendType blendType, const float * xs, const float * ys,
+				float sourceX, float sourceY, float sourceWidth, float sourceHeight, unsigned long modulationColor);
+
+			/**
+			 * Adds an untextured, axis-aligned filled rectangle, i.e. two triangles.
+			 * @param left The left edge.
+			 * @param top The top edge.
+			 * @param right The right edge.
+			 * @param bottom The bottom edge.
+			 * @param color The color of the rectangle.
+			 */
+			void addRect(float left, float top, float right, float bottom, unsigned long color);
+
+			/**
+			 * Adds an untextured filled triangle.
+			 * @param xs The x coordinates of the corners (3 entries).
+			 * @param ys The y coordinates of the corners (3 entries).
+			 * @param color The color of the triangle.
+			 */
+			void addTriangle(const float * xs, const float * ys, unsigned long color);
+
+			/**
+			 * Reserves vertices for primitives of a given type, texture, and blend type.
+			 * If the pending primitives are not compatible, or the batch is full,
+			 * they are submitted first.
+			 * @param type The type of the primitives.
+			 * @param texture The texture image, or NULL for untextured primitives.
+			 * @param blendType How to blend the primitives on the target.
+			 * @param count The number of vertices to reserve, a multiple of the vertices
+			 * per primitive, at most the capacity.
+			 * @return The reserved vertices, to be filled in by the caller.
+			 */
+			Vertex * addVertices(PrimitiveType type, Image * texture,
+				PlatformAdapter::BlendType blendType, int count);
+
+			/**
+			 * Discards all pending primitives without submitting them,
+			 * e.g. when the backend's device has been lost.
+			 */
+			void discard();
+
+			/**
+			 * Submits all pending primitives to the backend.
+			 */
+			void flush();
+
+			/**
+			 * Returns the number of batches submitted since the last resetStatistics().
+			 * Compare it with getPrimitiveCount() to judge how well primitives are merged.
+			 * @return The number of batches.
+			 */
+			unsigned long getBatchCount();
+
+			/**
+			 * Returns the maximum number of vertices of a batch.
+			 * @return The capacity.
+			 */
+			int getCapacity();
+
+			/**
+			 * Returns the number of vertices pending to be submitted.
+			 * @return The number of vertices.
+			 */
+			int getPendingVertexCount();
+
+			/**
+			 * Returns the number of primitives (lines and triangles) added
+			 * since the last resetStatistics().
+			 * @return The number of primitives.
+			 */
+			unsigned long getPrimitiveCount();
+
+			/**
+			 * Returns the texture image of the pending primitives.
+			 * @return The texture image, or NULL if there are no pending textured primitives.
+			 */
+			Image * getTexture();
+
+			/**
+			 * Resets the batch and primitive counters.
+			 */
+			void resetStatistics();
+	};
+}
+
+
+#endif
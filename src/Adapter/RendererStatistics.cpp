@@ -0,0 +1,76 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+const char * RendererStatistics::COUNTER_NAMES[COUNT] =
+{
+	"Clears", // CLEARS
+	"Ellipses", // ELLIPSES
+	"Images", // IMAGES
+	"Lines", // LINES
+	"Pixels", // PIXELS
+	"Rects", // RECTS
+	"Triangles", // TRIANGLES
+	"Glyphs", // GLYPHS
+	"Batches", // BATCHES
+	"Texture binds", // TEXTURE_BINDS
+	"Blend changes", // BLEND_CHANGES
+	"Target switches", // TARGET_SWITCHES
+	"Vertex bytes" // VERTEX_BYTES
+};
+
+RendererStatistics::RendererStatistics()
+{
+	ASSERTION_COBJECT(this);
+	reset();
+}
+
+void RendererStatistics::add(const RendererStatistics & statistics)
+{
+	ASSERTION_COBJECT(this);
+
+	for (int counterNo = 0; counterNo < COUNT; counterNo++)
+		counters[counterNo] += statistics.counters[counterNo];
+}
+
+unsigned long RendererStatistics::get(Counter counter) const
+{
+	ASSERTION_COBJECT(this);
+	return counters[counter];
+}
+
+const char * RendererStatistics::getName(Counter counter)
+{
+	return COUNTER_NAMES[counter];
+}
+
+unsigned long RendererStatistics::getPrimitiveCount() const
+{
+	ASSERTION_COBJECT(this);
+
+	unsigned long count = 0;
+	for (int counterNo = CLEARS; counterNo <= TRIANGLES; counterNo++)
+		count += counters[counterNo];
+
+	return count;
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(RendererStatistics, CObject);
+#endif
+
+void RendererStatistics::reset()
+{
+	ASSERTION_COBJECT(this);
+
+	for (int counterNo = 0; counterNo < COUNT; counterNo++)
+		counters[counterNo] = 0;
+}
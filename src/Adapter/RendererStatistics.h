@@ -0,0 +1,172 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_RENDERERSTATISTICS_H
+#define __GLAZIERY_RENDERERSTATISTICS_H
+
+
+namespace glaziery
+{
+	/**
+	 * The renderer statistics count the work a platform adapter performs to render,
+	 * e.g. the primitives drawn by type, the batches submitted to the graphics device,
+	 * and the state changes between them. Platform adapters increment the counters
+	 * while drawing, the Desktop snapshots them once per frame.
+	 * Counters an adapter cannot measure (e.g. batches of an immediate renderer) remain 0.
+	 * @see PlatformAdapter::getFrameStatistics()
+	 */
+	#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+		class RendererStatistics : public CObject
+	#else
+		class RendererStatistics
+	#endif
+	{
+		public:
+
+			enum Counter
+			{
+				/**
+				 * The number of clear operations.
+				 */
+				CLEARS = 0,
+
+				/**
+				 * The number of ellipses drawn.
+				 */
+				ELLIPSES,
+
+				/**
+				 * The number of (also rotated) images drawn, including text glyphs.
+				 */
+				IMAGES,
+
+				/**
+				 * The number of lines drawn.
+				 */
+				LINES,
+
+				/**
+				 * The number of pixels drawn using drawPixel().
+				 */
+				PIXELS,
+
+				/**
+				 * The number of rectangles drawn.
+				 */
+				RECTS,
+
+				/**
+				 * The number of triangles drawn.
+				 */
+				TRIANGLES,
+
+				/**
+				 * The number of text glyphs drawn.
+				 */
+				GLYPHS,
+
+				/**
+				 * The number of batches (draw calls) submitted to the graphics device.
+				 */
+				BATCHES,
+
+				/**
+				 * The number of texture binds.
+				 */
+				TEXTURE_BINDS,
+
+				/**
+				 * The number of blend state changes.
+				 */
+				BLEND_CHANGES,
+
+				/**
+				 * The number of render target switches, i.e. scenes begun on a new target.
+				 */
+				TARGET_SWITCHES,
+
+				/**
+				 * The number of vertex bytes uploaded to the graphics device.
+				 */
+				VERTEX_BYTES,
+
+				/**
+				 * The total number of different counters.
+				 */
+				COUNT
+			};
+
+		protected:
+
+			/**
+			 * The names of the counters, e.g. for the profile overlay.
+			 */
+			static const char * COUNTER_NAMES[COUNT];
+
+			/**
+			 * The counter values.
+			 */
+			unsigned long counters[COUNT];
+
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(RendererStatistics);
+			#endif
+
+		public:
+
+			/**
+			 * Creates new renderer statistics with all counters set to 0.
+			 */
+			RendererStatistics();
+
+			/**
+			 * Adds all counters of other renderer statistics to the ones of this.
+			 * @param statistics The other renderer statistics.
+			 */
+			void add(const RendererStatistics & statistics);
+
+			/**
+			 * Returns the value of a counter.
+			 * @param counter The counter.
+			 * @return The value.
+			 */
+			unsigned long get(Counter counter) const;
+
+			/**
+			 * Returns the name of a counter.
+			 * @param counter The counter.
+			 * @return The name.
+			 */
+			static const char * getName(Counter counter);
+
+			/**
+			 * Returns the total number of primitives drawn (clears, ellipses, images,
+			 * lines, pixels, rectangles, and triangles).
+			 * @return The number of primitives.
+			 */
+			unsigned long getPrimitiveCount() const;
+
+			/**
+			 * Increments a counter.
+			 * @param counter The counter.
+			 * @param amount The amount to add.
+			 */
+			inline void increment(Counter counter, unsigned long amount = 1);
+
+			/**
+			 * Sets all counters to 0.
+			 */
+			void reset();
+	};
+}
+
+
+#endif
@@ -0,0 +1,19 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_RENDERERSTATISTICS_INL
+#define __GLAZIERY_RENDERERSTATISTICS_INL
+
+
+inline void RendererStatistics::increment(Counter counter, unsigned long amount)
+{
+	counters[counter] += amount;
+}
+
+
+#endif
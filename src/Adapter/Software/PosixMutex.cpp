@@ -0,0 +1,62 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+PosixMutex::PosixMutex()
+{
+	ASSERTION_COBJECT(this);
+
+	// Recursive like Win32 mutexes, so the owning thread may lock again
+	pthread_mutexattr_t attributes;
+	pthread_mutexattr_init(&attributes);
+	pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+	int result = pthread_mutex_init(&handle, &attributes);
+	pthread_mutexattr_destroy(&attributes);
+
+	if (result != 0)
+		throw EDEVICEERROR("Cannot create POSIX mutex");
+}
+
+PosixMutex::~PosixMutex()
+{
+	ASSERTION_COBJECT(this);
+	pthread_mutex_destroy(&handle);
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(PosixMutex, Mutex);
+#endif
+
+bool PosixMutex::lock(long timeout)
+{
+	ASSERTION_COBJECT(this);
+
+	if (timeout < 0)
+		return pthread_mutex_lock(&handle) == 0;
+
+	struct timespec deadline;
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += timeout / 1000;
+	deadline.tv_nsec += (timeout % 1000) * 1000000L;
+	if (deadline.tv_nsec >= 1000000000L)
+	{
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000L;
+	}
+
+	return pthread_mutex_timedlock(&handle, &deadline) == 0;
+}
+
+void PosixMutex::release()
+{
+	ASSERTION_COBJECT(this);
+	pthread_mutex_unlock(&handle);
+}
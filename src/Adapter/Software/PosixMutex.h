@@ -0,0 +1,40 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_POSIXMUTEX_H
+#define __GLAZIERY_POSIXMUTEX_H
+
+
+namespace glaziery
+{
+	class PosixMutex : public Mutex
+	{
+		friend SoftwarePlatformAdapter;
+
+		private:
+
+			pthread_mutex_t handle;
+
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(PosixMutex);
+			#endif
+
+		public:
+
+			PosixMutex();
+			virtual ~PosixMutex();
+			virtual bool lock(long timeout);
+			virtual void release();
+	};
+}
+
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+PosixThread::PosixThread(int (*function)(Thread & thread, void * parameter), void * parameter)
+	: Thread(function, parameter)
+{
+	ASSERTION_COBJECT(this);
+
+	finished = false;
+	started = false;
+	suspended = true;
+}
+
+PosixThread::~PosixThread()
+{
+	ASSERTION_COBJECT(this);
+	kill();
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(PosixThread, Thread);
+#endif
+
+bool PosixThread::isFinished()
+{
+	ASSERTION_COBJECT(this);
+
+	if (!started)
+		return finished;
+
+	if (!finished)
+		return false;
+
+	pthread_join(handle, NULL);
+	started = false;
+	return true;
+}
+
+bool PosixThread::isSuspended()
+{
+	ASSERTION_COBJECT(this);
+	return !finished && suspended;
+}
+
+void PosixThread::kill()
+{
+	ASSERTION_COBJECT(this);
+
+	if (!started)
+	{
+		finished = true;
+		return;
+	}
+
+	if (!finished)
+		pthread_cancel(handle);
+
+	pthread_join(handle, NULL);
+	started = false;
+	finished = true;
+}
+
+void PosixThread::resume()
+{
+	ASSERTION_COBJECT(this);
+
+	if (finished || !suspended)
+		return;
+
+	suspended = false;
+	if (started)
+		return;
+
+	if (pthread_create(&handle, NULL, &PosixThread::threadFunction, this) != 0)
+		throw EDEVICEERROR("Cannot create POSIX thread");
+
+	started = true;
+}
+
+void PosixThread::setExitCodeByThreadFunction(int exitCode)
+{
+	ASSERTION_COBJECT(this);
+	setExitCode(exitCode);
+}
+
+void PosixThread::suspend()
+{
+	ASSERTION_COBJECT(this);
+
+	if (finished || suspended)
+		return;
+
+	if (started)
+	{
+		LOGPRINTF0(LOG_WARN, "Cannot suspend a running POSIX thread");
+		return;
+	}
+
+	suspended = true;
+}
+
+void * PosixThread::threadFunction(void * parameter)
+{
+	PosixThread * thread = (PosixThread *) parameter;
+	int (*function)(Thread & thread, void * parameter) = thread->getFunction();
+	void * functionParameter = thread->getParameter();
+	int exitCode = function(*thread, functionParameter);
+	thread->setExitCodeByThreadFunction(exitCode);
+	thread->finished = true;
+	return NULL;
+}
@@ -0,0 +1,53 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_POSIXTHREAD_H
+#define __GLAZIERY_POSIXTHREAD_H
+
+
+namespace glaziery
+{
+	/**
+	 * The POSIX thread is created suspended and started by the first resume(), like Win32 threads.
+	 * POSIX cannot suspend running threads, so suspend() has no effect once the thread runs.
+	 */
+	class PosixThread : public Thread
+	{
+		friend SoftwarePlatformAdapter;
+
+		private:
+
+			volatile bool finished;
+			pthread_t handle;
+			bool started;
+			bool suspended;
+
+			void setExitCodeByThreadFunction(int exitCode);
+			static void * threadFunction(void * parameter);
+
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(PosixThread);
+			#endif
+
+		public:
+
+			PosixThread(int (*function)(Thread & thread, void * parameter), void * parameter = NULL);
+			~PosixThread();
+			virtual bool isFinished();
+			virtual bool isSuspended();
+			virtual void kill();
+			virtual void resume();
+			virtual void suspend();
+	};
+}
+
+
+#endif
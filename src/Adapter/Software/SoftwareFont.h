@@ -0,0 +1,44 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_SOFTWAREFONT_H
+#define __GLAZIERY_SOFTWAREFONT_H
+
+
+namespace glaziery
+{
+	/**
+	 * The software font reads the Glaziery font format from a software image.
+	 * @see SoftwarePlatformAdapter
+	 */
+	class SoftwareFont : public Font
+	{
+		private:
+
+			static const int FONT_VERSION;
+
+		protected:
+
+			unsigned long getPixel(SoftwareImage * image, int x, int y);
+
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(SoftwareFont);
+			#endif
+
+		public:
+
+			SoftwareFont(const String & path);
+			virtual ~SoftwareFont();
+	};
+}
+
+
+#endif
@@ -0,0 +1,258 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+SoftwareImage::SoftwareImage(const String & path, Type imageType)
+	: Image(path, imageType)
+{
+	ASSERTION_COBJECT(this);
+
+	fatalErrors = false;
+	pixels = NULL;
+}
+
+SoftwareImage::~SoftwareImage()
+{
+	ASSERTION_COBJECT(this);
+	destroyPixels();
+}
+
+void SoftwareImage::destroyPixels()
+{
+	ASSERTION_COBJECT(this);
+
+	if (pixels == NULL)
+		return;
+
+	delete[] pixels;
+	pixels = NULL;
+	bufferSize = Vector();
+
+	int listenersCount = listeners.GetCount();
+	for (int i=0; i<listenersCount; i++)
+	{
+		Image::Listener * imageListener
+			= dynamic_cast<Image::Listener *>(listeners.Get(i));
+		if (imageListener != NULL)
+			imageListener->onRenderTargetInvalidated(this);
+	}
+}
+
+void SoftwareImage::ensureLoaded()
+{
+	ASSERTION_COBJECT(this);
+
+	if (getPath().IsEmpty())
+		return;
+
+	ensurePixels();
+}
+
+bool SoftwareImage::ensurePixels()
+{
+	ASSERTION_COBJECT(this);
+
+	if (pixels != NULL)
+		return true;
+
+	if (fatalErrors)
+		return false;
+
+	if (getPath().IsEmpty())
+	{
+		// Create empty pixels
+		resize(size);
+		return pixels != NULL;
+	}
+
+	return loadFile();
+}
+
+int SoftwareImage::getPitch()
+{
+	ASSERTION_COBJECT(this);
+	return bufferSize.x;
+}
+
+unsigned int * SoftwareImage::getPixels()
+{
+	ASSERTION_COBJECT(this);
+
+	if (!ensurePixels())
+		return NULL;
+
+	return pixels;
+}
+
+Vector SoftwareImage::getSize()
+{
+	ASSERTION_COBJECT(this);
+
+	if (!ensurePixels())
+		size = Vector();
+
+	return Image::getSize();
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(SoftwareImage, Image);
+#endif
+
+bool SoftwareImage::loadFile()
+{
+	ASSERTION_COBJECT(this);
+
+	Path * path;
+	Path imagePath(getPath());
+	if (imagePath.IsAbsolute())
+		path = imagePath.HeapClone();
+	else
+	{
+		if ((path = Path::CreateApplicationFolderPath()) == NULL)
+			throw EOUTOFMEMORY;
+		path->AppendPath(&imagePath);
+	}
+	char * pathString = path->ToString(false);
+	delete path;
+
+	LOGPRINTF1(LOG_DEBUG, "Loading image file '%s'", pathString);
+
+	png_image fileImage;
+	memset(&fileImage, 0, sizeof(fileImage));
+	fileImage.version = PNG_IMAGE_VERSION;
+
+	unsigned char * fileBuffer = NULL;
+	if (png_image_begin_read_from_file(&fileImage, pathString))
+	{
+		fileImage.format = PNG_FORMAT_RGBA;
+		if ((fileBuffer = new unsigned char[PNG_IMAGE_SIZE(fileImage)]) == NULL)
+		{
+			png_image_free(&fileImage);
+			delete pathString;
+			throw EOUTOFMEMORY;
+		}
+
+		if (!png_image_finish_read(&fileImage, NULL, fileBuffer, 0, NULL))
+		{
+			delete[] fileBuffer;
+			fileBuffer = NULL;
+		}
+	}
+
+	if (fileBuffer == NULL)
+	{
+		png_image_free(&fileImage);
+
+		String message("Cannot load image file '");
+		message += pathString;
+		message += '\'';
+		delete pathString;
+
+		#ifdef _DEBUG
+			throw EDEVICEERROR((const char *) message);
+		#else
+			LOGPRINTF1(LOG_ERROR, "%s", (const char *) message);
+			size = Vector();
+			fatalErrors = true;
+			return false;
+		#endif
+	}
+
+	delete pathString;
+
+	Vector fileSize(fileImage.width, fileImage.height);
+	size = fileSize;
+
+	// Constrain to maximum size
+	if (maximumSize.x > 0 && size.x > maximumSize.x)
+		size.x = maximumSize.x;
+	if (maximumSize.y > 0 && size.y > maximumSize.y)
+		size.y = maximumSize.y;
+
+	bufferSize = size;
+	if (bufferSize.x <= 0 || bufferSize.y <= 0)
+		bufferSize = Vector(1, 1);
+	if ((pixels = new unsigned int[bufferSize.x * bufferSize.y]) == NULL)
+		throw EOUTOFMEMORY;
+	memset(pixels, 0, bufferSize.x * bufferSize.y * sizeof(unsigned int));
+
+	// libpng delivers the rows top-down, 4 bytes per pixel, alpha is 0xFF for opaque formats
+	for (int y=0; y<size.y; y++)
+	{
+		unsigned int * row = pixels + y * bufferSize.x;
+		unsigned char * fileRow = fileBuffer + y * fileSize.x * 4;
+		for (int x=0; x<size.x; x++)
+		{
+			unsigned char * color = fileRow + x * 4;
+
+			if (getImageType() == Image::TYPE_RGB)
+				row[x] = GL_RGB(color[0], color[1], color[2]);
+			else if (getImageType() == Image::TYPE_ALPHA)
+				row[x] = GL_RGBA(0, 0, 0, color[3]);
+			else
+				row[x] = GL_RGBA(color[0], color[1], color[2], color[3]);
+		}
+	}
+
+	delete[] fileBuffer;
+	return true;
+}
+
+void SoftwareImage::resize(Vector size)
+{
+	ASSERTION_COBJECT(this);
+
+	// Ensure minimum image size
+	if (!(size >= Vector(1, 1)))
+		size = Vector(1, 1);
+
+	// Constrain to maximum size
+	if (maximumSize.x > 0 && size.x > maximumSize.x)
+		size.x = maximumSize.x;
+	if (maximumSize.y > 0 && size.y > maximumSize.y)
+		size.y = maximumSize.y;
+
+	// Memorize the image size
+	this->size = size;
+
+	// Check whether the pixels should be reallocated
+	if (pixels != NULL && size <= bufferSize && size > bufferSize / 4)
+	{
+		// The requested new size is smaller or equal in both x and y direction,
+		// but it is not MUCH smaller, to leave it, to reduce number of reallocations
+		return;
+	}
+
+	destroyPixels();
+
+	LOGIFLEVEL_START(LOG_DEBUG)
+		LOGPRINTF2(LOG_DEBUG, "Creating a software render target with %dx%d pixels", size.x, size.y);
+	LOGIFLEVEL_END
+	if ((pixels = new unsigned int[size.x * size.y]) == NULL)
+		throw EOUTOFMEMORY;
+
+	// RGB images are opaque, like on the other platforms
+	unsigned int emptyPixel = getImageType() == Image::TYPE_RGB ? 0xFF000000 : 0;
+	for (int i = size.x * size.y - 1; i >= 0; i--)
+		pixels[i] = emptyPixel;
+
+	bufferSize = size;
+}
+
+void SoftwareImage::unload()
+{
+	ASSERTION_COBJECT(this);
+
+	if (getPath().IsEmpty())
+		return;
+
+	destroyPixels();
+}
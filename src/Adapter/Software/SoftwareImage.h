@@ -0,0 +1,60 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_SOFTWAREIMAGE_H
+#define __GLAZIERY_SOFTWAREIMAGE_H
+
+
+namespace glaziery
+{
+	/**
+	 * The software image holds its pixels in main memory as 32 bit ARGB values
+	 * (the format of the Glaziery color macros), row by row.
+	 * File images are decoded using libpng, so they must be PNG files.
+	 * @see SoftwarePlatformAdapter
+	 */
+	class SoftwareImage : public Image
+	{
+		friend SoftwareFont;
+		friend SoftwarePlatformAdapter;
+
+		private:
+
+			Vector bufferSize;
+			bool fatalErrors;
+			unsigned int * pixels;
+
+			void destroyPixels();
+			bool ensurePixels();
+			int getPitch();
+			unsigned int * getPixels();
+			bool loadFile();
+
+		protected:
+
+			virtual ~SoftwareImage();
+
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(SoftwareImage);
+			#endif
+
+		public:
+
+			SoftwareImage(const String & path, Type imageType);
+			virtual void ensureLoaded();
+			virtual Vector getSize();
+			virtual void resize(Vector size);
+			virtual void unload();
+	};
+}
+
+
+#endif
@@ -0,0 +1,31 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+SoftwareJoystickHandler::SoftwareJoystickHandler()
+{
+	ASSERTION_COBJECT(this);
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(SoftwareJoystickHandler, JoystickHandler);
+#endif
+
+void SoftwareJoystickHandler::shutDown()
+{
+	ASSERTION_COBJECT(this);
+	LOGPRINTF0(LOG_INFO, "Joystick input handler shut down");
+}
+
+void SoftwareJoystickHandler::update()
+{
+	ASSERTION_COBJECT(this);
+}
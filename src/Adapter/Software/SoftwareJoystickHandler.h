@@ -0,0 +1,38 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_SOFTWAREJOYSTICKINPUTHANDLER_H
+#define __GLAZIERY_SOFTWAREJOYSTICKINPUTHANDLER_H
+
+
+namespace glaziery
+{
+	/**
+	 * The software joystick handler is a headless handler that has no device.
+	 * Input is simulated by passing events to the input manager directly.
+	 * @see SoftwarePlatformAdapter
+	 */
+	class SoftwareJoystickHandler : public JoystickHandler
+	{
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(SoftwareJoystickHandler);
+			#endif
+
+		public:
+
+			SoftwareJoystickHandler();
+			virtual void shutDown();
+			virtual void update();
+	};
+}
+
+
+#endif
@@ -0,0 +1,31 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+SoftwareKeyboardHandler::SoftwareKeyboardHandler()
+{
+	ASSERTION_COBJECT(this);
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(SoftwareKeyboardHandler, KeyboardHandler);
+#endif
+
+void SoftwareKeyboardHandler::shutDown()
+{
+	ASSERTION_COBJECT(this);
+	LOGPRINTF0(LOG_INFO, "Keyboard input handler shut down");
+}
+
+void SoftwareKeyboardHandler::update()
+{
+	ASSERTION_COBJECT(this);
+}
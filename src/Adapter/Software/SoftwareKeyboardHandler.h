@@ -0,0 +1,38 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_SOFTWAREKEYBOARDINPUTHANDLER_H
+#define __GLAZIERY_SOFTWAREKEYBOARDINPUTHANDLER_H
+
+
+namespace glaziery
+{
+	/**
+	 * The software keyboard handler is a headless handler that has no device.
+	 * Input is simulated by passing events to the input manager directly.
+	 * @see SoftwarePlatformAdapter
+	 */
+	class SoftwareKeyboardHandler : public KeyboardHandler
+	{
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(SoftwareKeyboardHandler);
+			#endif
+
+		public:
+
+			SoftwareKeyboardHandler();
+			virtual void shutDown();
+			virtual void update();
+	};
+}
+
+
+#endif
@@ -0,0 +1,43 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+SoftwareMouseHandler::SoftwareMouseHandler()
+{
+	ASSERTION_COBJECT(this);
+}
+
+Vector SoftwareMouseHandler::getPointerPosition()
+{
+	ASSERTION_COBJECT(this);
+	return pointerPosition;
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(SoftwareMouseHandler, MouseHandler);
+#endif
+
+void SoftwareMouseHandler::setPointerPosition(Vector position)
+{
+	ASSERTION_COBJECT(this);
+	pointerPosition = position;
+}
+
+void SoftwareMouseHandler::shutDown()
+{
+	ASSERTION_COBJECT(this);
+	LOGPRINTF0(LOG_INFO, "Mouse input handler shut down");
+}
+
+void SoftwareMouseHandler::update()
+{
+	ASSERTION_COBJECT(this);
+}
@@ -0,0 +1,45 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_SOFTWAREMOUSEINPUTHANDLER_H
+#define __GLAZIERY_SOFTWAREMOUSEINPUTHANDLER_H
+
+
+namespace glaziery
+{
+	/**
+	 * The software mouse handler is a headless handler that has no device.
+	 * It only holds the pointer position, input is simulated by passing events
+	 * to the input manager directly.
+	 * @see SoftwarePlatformAdapter
+	 */
+	class SoftwareMouseHandler : public MouseHandler
+	{
+		protected:
+
+			Vector pointerPosition;
+
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(SoftwareMouseHandler);
+			#endif
+
+		public:
+
+			SoftwareMouseHandler();
+			virtual Vector getPointerPosition();
+			virtual void setPointerPosition(Vector position);
+			virtual void shutDown();
+			virtual void update();
+	};
+}
+
+
+#endif
@@ -0,0 +1,1190 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+const int SoftwarePlatformAdapter::DEFAULT_SCREEN_HEIGHT = 768;
+const int SoftwarePlatformAdapter::DEFAULT_SCREEN_WIDTH = 1024;
+
+SoftwarePlatformAdapter::SoftwarePlatformAdapter()
+{
+	ASSERTION_COBJECT(this);
+
+	backBuffer = NULL;
+	currentTarget = NULL;
+	frameCount = 0;
+	masterVolume = 100;
+	mute = false;
+	scanline = NULL;
+	scanlineCapacity = 0;
+	startTime = getMonotonicTime();
+}
+
+SoftwarePlatformAdapter::~SoftwarePlatformAdapter()
+{
+	ASSERTION_COBJECT(this);
+
+	if (backBuffer != NULL) {delete[] backBuffer; backBuffer = NULL;}
+	if (scanline != NULL) {delete[] scanline; scanline = NULL;}
+}
+
+unsigned int SoftwarePlatformAdapter::blendPixel(unsigned int target, unsigned int source, BlendType blendType)
+{
+	if (blendType == BLENDTYPE_OPAQUE)
+		return source;
+
+	if (blendType == BLENDTYPE_STENCIL)
+		return (target & 0x00FFFFFF) | (source & 0xFF000000);
+
+	// Color is Sc * Sa + Dc * (1-Sa), alpha is Sa + Da * (1-Sa), see BLENDTYPE_NORMAL
+	unsigned int sourceAlpha = source >> 24;
+	if (sourceAlpha == 0xFF)
+		return source;
+	if (sourceAlpha == 0)
+		return target;
+
+	unsigned int inverseAlpha = 0xFF - sourceAlpha;
+	unsigned int result = 0;
+	for (int shift = 0; shift < 32; shift += 8)
+	{
+		unsigned int sourceFactor = shift == 24 ? 0xFF : sourceAlpha;
+		unsigned int value = ((source >> shift) & 0xFF) * sourceFactor + ((target >> shift) & 0xFF) * inverseAlpha;
+		value += 128;
+		result |= ((value + (value >> 8)) >> 8) << shift;
+	}
+
+	return result;
+}
+
+#ifdef GL_SOFTWARE_SSE2
+	__m128i SoftwarePlatformAdapter::blendPixels(__m128i target, __m128i source,
+		__m128i modulation, bool modulated, BlendType blendType)
+	{
+		// The channels are processed as 16 bit lanes, two pixels per half,
+		// in the byte order B, G, R, A of the ARGB pixels
+		__m128i zero = _mm_setzero_si128();
+		__m128i maximum = _mm_set1_epi16(0xFF);
+		__m128i alphaLanes = _mm_set_epi16(0xFF, 0, 0, 0, 0xFF, 0, 0, 0);
+		__m128i colorLanes = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+
+		__m128i halves[2];
+		for (int half = 0; half < 2; half++)
+		{
+			__m128i source16 = half == 0 ? _mm_unpacklo_epi8(source, zero) : _mm_unpackhi_epi8(source, zero);
+			if (modulated)
+				source16 = divideBy255(_mm_mullo_epi16(source16, modulation));
+
+			if (blendType == BLENDTYPE_OPAQUE)
+			{
+				halves[half] = source16;
+				continue;
+			}
+
+			__m128i target16 = half == 0 ? _mm_unpacklo_epi8(target, zero) : _mm_unpackhi_epi8(target, zero);
+			__m128i sourceFactor;
+			__m128i targetFactor;
+			if (blendType == BLENDTYPE_STENCIL)
+			{
+				sourceFactor = alphaLanes;
+				targetFactor = _mm_and_si128(maximum, colorLanes);
+			}
+			else
+			{
+				__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(source16, 0xFF), 0xFF);
+				sourceFactor = _mm_or_si128(_mm_and_si128(alpha, colorLanes), alphaLanes);
+				targetFactor = _mm_sub_epi16(maximum, alpha);
+			}
+
+			halves[half] = divideBy255(_mm_add_epi16(_mm_mullo_epi16(source16, sourceFactor),
+				_mm_mullo_epi16(target16, targetFactor)));
+		}
+
+		return _mm_packus_epi16(halves[0], halves[1]);
+	}
+#endif
+
+void SoftwarePlatformAdapter::blendSpan(unsigned int * target, const unsigned int * source, bool solid, int count,
+	unsigned long modulationColor, BlendType blendType, Image::Type targetType)
+{
+	// RGB targets are always opaque, alpha targets have no color
+	unsigned int orMask = targetType == Image::TYPE_RGB ? 0xFF000000 : 0;
+	unsigned int andMask = targetType == Image::TYPE_ALPHA ? 0xFF000000 : 0xFFFFFFFF;
+
+	unsigned int modulation = (unsigned int) modulationColor;
+	unsigned int silhouetteMask = blendType == BLENDTYPE_SILHOUETTE ? 0x00FFFFFF : 0;
+	bool modulated = modulation != 0xFFFFFFFF || silhouetteMask != 0;
+	unsigned int solidSource = 0;
+	if (solid)
+	{
+		// Solid spans are modulated only once
+		solidSource = modulatePixel(source[0] | silhouetteMask, modulation);
+		modulated = false;
+
+		if (blendType == BLENDTYPE_OPAQUE || (blendType != BLENDTYPE_STENCIL && (solidSource >> 24) == 0xFF))
+		{
+			unsigned int pixel = (solidSource | orMask) & andMask;
+			for (int i=0; i<count; i++)
+				target[i] = pixel;
+			return;
+		}
+
+		if (blendType != BLENDTYPE_STENCIL && (solidSource >> 24) == 0)
+			return;
+	}
+
+	int i = 0;
+
+	#ifdef GL_SOFTWARE_SSE2
+		__m128i zero = _mm_setzero_si128();
+		__m128i modulation16 = _mm_unpacklo_epi8(_mm_set1_epi32((int) modulation), zero);
+		__m128i silhouette = _mm_set1_epi32((int) silhouetteMask);
+		__m128i solidSource128 = _mm_set1_epi32((int) solidSource);
+		__m128i orMask128 = _mm_set1_epi32((int) orMask);
+		__m128i andMask128 = _mm_set1_epi32((int) andMask);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i source128 = solid ? solidSource128
+				: _mm_or_si128(_mm_loadu_si128((const __m128i *) (source + i)), silhouette);
+			__m128i target128 = _mm_loadu_si128((const __m128i *) (target + i));
+			__m128i result = blendPixels(target128, source128, modulation16, modulated, blendType);
+			_mm_storeu_si128((__m128i *) (target + i),
+				_mm_and_si128(_mm_or_si128(result, orMask128), andMask128));
+		}
+	#endif
+
+	for (; i<count; i++)
+	{
+		unsigned int sourcePixel = solid ? solidSource : source[i] | silhouetteMask;
+		if (modulated)
+			sourcePixel = modulatePixel(sourcePixel, modulation);
+		target[i] = (blendPixel(target[i], sourcePixel, blendType) | orMask) & andMask;
+	}
+}
+
+void SoftwarePlatformAdapter::clear(DrawingContext & context, unsigned long fillColor)
+{
+	ASSERTION_COBJECT(this);
+
+	if (context.getDisplayList() != NULL)
+		context.getDisplayList()->recordClear(context, fillColor);
+
+	unsigned int * pixels;
+	int pitch;
+	Vector clippingFrom;
+	Vector clippingTo;
+	Image::Type targetType;
+	if (!getTarget(context, pixels, pitch, clippingFrom, clippingTo, targetType))
+		return;
+
+	currentStatistics.increment(RendererStatistics::CLEARS);
+
+	unsigned int color = (unsigned int) fillColor;
+	for (int y = clippingFrom.y; y < clippingTo.y; y++)
+		blendSpan(pixels + y * pitch + clippingFrom.x, &color, true, clippingTo.x - clippingFrom.x,
+			GL_WHITE, BLENDTYPE_OPAQUE, targetType);
+}
+
+void SoftwarePlatformAdapter::clearClipboard()
+{
+	ASSERTION_COBJECT(this);
+	clipboardText = "";
+}
+
+Font * SoftwarePlatformAdapter::createFont(const String & path)
+{
+	ASSERTION_COBJECT(this);
+
+	SoftwareFont * font;
+	if ((font = new SoftwareFont(path)) == NULL)
+		throw EOUTOFMEMORY;
+
+	return font;
+}
+
+Image * SoftwarePlatformAdapter::createImage(const String & path, Image::Type imageType)
+{
+	ASSERTION_COBJECT(this);
+
+	SoftwareImage * image;
+	if ((image = new SoftwareImage(path, imageType)) == NULL)
+		throw EOUTOFMEMORY;
+
+	return image;
+}
+
+Mutex * SoftwarePlatformAdapter::createMutex()
+{
+	ASSERTION_COBJECT(this);
+
+	Mutex * mutex;
+	if ((mutex = new PosixMutex) == NULL)
+		throw EOUTOFMEMORY;
+	return mutex;
+}
+
+Thread * SoftwarePlatformAdapter::createThread(int (*function)(Thread & thread, void * parameter),
+	void * parameter)
+{
+	ASSERTION_COBJECT(this);
+
+	Thread * thread;
+	if ((thread = new PosixThread(function, parameter)) == NULL)
+		throw EOUTOFMEMORY;
+	return thread;
+}
+
+void SoftwarePlatformAdapter::drawEllipse(DrawingContext & context, Vector center,
+	Vector radius, unsigned long fillColor, unsigned long borderColor)
+{
+	ASSERTION_COBJECT(this);
+
+	if (context.getDisplayList() != NULL)
+		context.getDisplayList()->recordEllipse(context, center, radius, fillColor, borderColor);
+
+	center += context.getDrawingOffset();
+	if (!context.isInClippingArea(center - radius, center + radius))
+		return;
+
+	currentStatistics.increment(RendererStatistics::ELLIPSES);
+
+	// Like the DirectX adapter, the ellipse reaches to the outer edges of the radius pixels.
+	// A pixel of a row is covered if its center is inside the ellipse.
+	int rows = 2 * radius.y + 1;
+	int * halfWidths;
+	if ((halfWidths = new int[rows]) == NULL)
+		throw EOUTOFMEMORY;
+
+	int row;
+	for (row = 0; row < rows; row++)
+	{
+		double relativeY = (row - radius.y) / (radius.y + 0.5);
+		double halfWidth = (radius.x + 0.5) * sqrt(1.0 - relativeY * relativeY);
+		halfWidths[row] = (int) ceil(halfWidth) - 1;
+	}
+
+	bool bordered = GL_ALPHA_OF(borderColor) != 0;
+	for (row = 0; row < rows; row++)
+	{
+		int halfWidth = halfWidths[row];
+		if (halfWidth < 0)
+			continue;
+
+		int y = center.y - radius.y + row;
+		if (!bordered)
+		{
+			fillSpan(context, y, center.x - halfWidth, center.x + halfWidth, fillColor);
+			continue;
+		}
+
+		// The border covers the pixels not covered by both neighbour rows,
+		// but at least the outermost pixel
+		int neighbourHalfWidth = row > 0 ? halfWidths[row - 1] : -1;
+		if (row < rows - 1 && halfWidths[row + 1] < neighbourHalfWidth)
+			neighbourHalfWidth = halfWidths[row + 1];
+		if (row == rows - 1)
+			neighbourHalfWidth = -1;
+
+		int innerHalfWidth = neighbourHalfWidth < halfWidth ? neighbourHalfWidth : halfWidth - 1;
+		if (innerHalfWidth >= 0)
+		{
+			fillSpan(context, y, center.x - innerHalfWidth, center.x + innerHalfWidth, fillColor);
+			fillSpan(context, y, center.x - halfWidth, center.x - innerHalfWidth - 1, borderColor);
+			fillSpan(context, y, center.x + innerHalfWidth + 1, center.x + halfWidth, borderColor);
+		}
+		else
+			fillSpan(context, y, center.x - halfWidth, center.x + halfWidth, borderColor);
+	}
+
+	delete[] halfWidths;
+}
+
+void SoftwarePlatformAdapter::drawImage(DrawingContext & context, Image * image,
+	Vector sourcePosition, Vector sourceSize, Vector targetPosition, Vector targetSize,
+	unsigned long modulationColor, BlendType blendType)
+{
+	ASSERTION_COBJECT(this);
+
+	if (context.getDisplayList() != NULL)
+		context.getDisplayList()->recordImage(context, image, sourcePosition, sourceSize,
+			targetPosition, targetSize, modulationColor, blendType);
+
+	targetPosition += context.getDrawingOffset();
+	if (!context.isInClippingArea(targetPosition, targetPosition + targetSize))
+		return;
+
+	currentStatistics.increment(RendererStatistics::IMAGES);
+
+	if (!(sourceSize > Vector()) || !(targetSize > Vector()))
+		return;
+
+	SoftwareImage * sourceImage = (SoftwareImage *) image;
+	unsigned int * sourcePixels = sourceImage->getPixels();
+	if (sourcePixels == NULL)
+		return;
+	int sourcePitch = sourceImage->getPitch();
+	Vector imageSize = sourceImage->size;
+
+	unsigned int * pixels;
+	int pitch;
+	Vector clippingFrom;
+	Vector clippingTo;
+	Image::Type targetType;
+	if (!getTarget(context, pixels, pitch, clippingFrom, clippingTo, targetType))
+		return;
+
+	Vector from = targetPosition;
+	Vector to = targetPosition + targetSize;
+	bool scaled = sourceSize != targetSize;
+	if (!scaled)
+	{
+		// Unscaled rows are blended directly from the image, so clip to its pixels, too
+		from.constrain(targetPosition - sourcePosition, targetPosition - sourcePosition + imageSize);
+		to.constrain(targetPosition - sourcePosition, targetPosition - sourcePosition + imageSize);
+	}
+	from.constrain(clippingFrom, clippingTo);
+	to.constrain(clippingFrom, clippingTo);
+	if (!(from < to))
+		return;
+
+	int count = to.x - from.x;
+	unsigned int * line = NULL;
+	unsigned int * columns = NULL;
+	if (scaled)
+	{
+		// Sample the nearest source pixel of each target pixel center
+		line = getScanline(2 * count);
+		columns = line + count;
+		for (int i=0; i<count; i++)
+		{
+			int x = sourcePosition.x + (int) (((2LL * (from.x + i - targetPosition.x) + 1) * sourceSize.x)
+				/ (2LL * targetSize.x));
+			columns[i] = x < 0 ? 0 : x >= imageSize.x ? imageSize.x - 1 : x;
+		}
+	}
+
+	for (int y = from.y; y < to.y; y++)
+	{
+		unsigned int * targetRow = pixels + y * pitch + from.x;
+		if (!scaled)
+		{
+			blendSpan(targetRow, sourcePixels + (y - targetPosition.y + sourcePosition.y) * sourcePitch
+				+ from.x - targetPosition.x + sourcePosition.x, false, count, modulationColor, blendType, targetType);
+			continue;
+		}
+
+		int sourceY = sourcePosition.y + (int) (((2LL * (y - targetPosition.y) + 1) * sourceSize.y)
+			/ (2LL * targetSize.y));
+		sourceY = sourceY < 0 ? 0 : sourceY >= imageSize.y ? imageSize.y - 1 : sourceY;
+
+		const unsigned int * sourceRow = sourcePixels + sourceY * sourcePitch;
+		for (int i=0; i<count; i++)
+			line[i] = sourceRow[columns[i]];
+		blendSpan(targetRow, line, false, count, modulationColor, blendType, targetType);
+	}
+}
+
+void SoftwarePlatformAdapter::drawLine(DrawingContext & context, Vector from, Vector to,
+	unsigned long color)
+{
+	ASSERTION_COBJECT(this);
+
+	if (from == to)
+	{
+		drawPixel(context, from, color);
+		return;
+	}
+
+	if (context.getDisplayList() != NULL)
+		context.getDisplayList()->recordLine(context, from, to, color);
+
+	from += context.getDrawingOffset();
+	to += context.getDrawingOffset();
+	if (!context.isInClippingArea(from, to))
+		return;
+
+	currentStatistics.increment(RendererStatistics::LINES);
+	plotLine(context, from, to, color);
+}
+
+void SoftwarePlatformAdapter::drawPixel(DrawingContext & context, Vector position,
+	unsigned long color)
+{
+	ASSERTION_COBJECT(this);
+
+	if (context.getDisplayList() != NULL)
+		context.getDisplayList()->recordPixel(context, position, color);
+
+	position += context.getDrawingOffset();
+	if (!context.isInClippingArea(position))
+		return;
+
+	currentStatistics.increment(RendererStatistics::PIXELS);
+	fillSpan(context, position.y, position.x, position.x, color);
+}
+
+void SoftwarePlatformAdapter::drawRect(DrawingContext & context, Vector from, Vector to,
+	unsigned long fillColor, unsigned long borderColor)
+{
+	ASSERTION_COBJECT(this);
+
+	if (context.getDisplayList() != NULL)
+		context.getDisplayList()->recordRect(context, from, to, fillColor, borderColor);
+
+	from += context.getDrawingOffset();
+	to += context.getDrawingOffset();
+	if (!context.isInClippingArea(from, to))
+		return;
+
+	currentStatistics.increment(RendererStatistics::RECTS);
+
+	if (to.x < from.x) {int x = to.x; to.x = from.x; from.x = x;}
+	if (to.y < from.y) {int y = to.y; to.y = from.y; from.y = y;}
+
+	int y;
+	if (borderColor == fillColor)
+	{
+		for (y = from.y; y <= to.y; y++)
+			fillSpan(context, y, from.x, to.x, fillColor);
+		return;
+	}
+
+	if (to.x - from.x > 1)
+		for (y = from.y + 1; y < to.y; y++)
+			fillSpan(context, y, from.x + 1, to.x - 1, fillColor);
+
+	if (GL_ALPHA_OF(borderColor) == 0)
+		return;
+
+	// The border edges do not overlap, so translucent borders are not blended twice
+	fillSpan(context, from.y, from.x, to.x, borderColor);
+	if (to.y > from.y)
+		fillSpan(context, to.y, from.x, to.x, borderColor);
+	for (y = from.y + 1; y < to.y; y++)
+	{
+		fillSpan(context, y, from.x, from.x, borderColor);
+		if (to.x > from.x)
+			fillSpan(context, y, to.x, to.x, borderColor);
+	}
+}
+
+void SoftwarePlatformAdapter::drawRotatedImage(DrawingContext & context, Image * image,
+	Vector sourcePosition, Vector sourceSize, Vector targetPosition, Vector targetSize,
+	Vector rotationAnchor, double rotationAngle,
+	unsigned long modulationColor, BlendType blendType)
+{
+	ASSERTION_COBJECT(this);
+
+	if (context.getDisplayList() != NULL)
+		context.getDisplayList()->recordRotatedImage(context, image, sourcePosition, sourceSize,
+			targetPosition, targetSize, rotationAnchor, rotationAngle, modulationColor, blendType);
+
+	if (!(sourceSize > Vector()) || !(targetSize > Vector()))
+		return;
+
+	currentStatistics.increment(RendererStatistics::IMAGES);
+
+	SoftwareImage * sourceImage = (SoftwareImage *) image;
+	unsigned int * sourcePixels = sourceImage->getPixels();
+	if (sourcePixels == NULL)
+		return;
+	int sourcePitch = sourceImage->getPitch();
+	Vector imageSize = sourceImage->size;
+
+	unsigned int * pixels;
+	int pitch;
+	Vector clippingFrom;
+	Vector clippingTo;
+	Image::Type targetType;
+	if (!getTarget(context, pixels, pitch, clippingFrom, clippingTo, targetType))
+		return;
+
+	targetPosition += context.getDrawingOffset();
+	double sinAngle = sin(rotationAngle);
+	double cosAngle = cos(rotationAngle);
+	double anchorX = (double) rotationAnchor.x * targetSize.x / sourceSize.x
+		- sourcePosition.x + targetPosition.x;
+	double anchorY = (double) rotationAnchor.y * targetSize.y / sourceSize.y
+		- sourcePosition.y + targetPosition.y;
+
+	// Determine the bounding box of the rotated corners
+	double left = 0.0, top = 0.0, right = 0.0, bottom = 0.0;
+	for (int corner = 0; corner < 4; corner++)
+	{
+		double pointX = targetPosition.x + (corner & 1 ? targetSize.x : 0) - anchorX;
+		double pointY = targetPosition.y + (corner & 2 ? targetSize.y : 0) - anchorY;
+		double rotatedX = pointX * cosAngle - pointY * sinAngle + anchorX;
+		double rotatedY = pointX * sinAngle + pointY * cosAngle + anchorY;
+		if (corner == 0 || rotatedX < left) left = rotatedX;
+		if (corner == 0 || rotatedX > right) right = rotatedX;
+		if (corner == 0 || rotatedY < top) top = rotatedY;
+		if (corner == 0 || rotatedY > bottom) bottom = rotatedY;
+	}
+
+	Vector from((int) floor(left), (int) floor(top));
+	Vector to((int) ceil(right), (int) ceil(bottom));
+	from.constrain(clippingFrom, clippingTo);
+	to.constrain(clippingFrom, clippingTo);
+	if (!(from < to))
+		return;
+
+	// Map each target pixel center back into the unrotated image,
+	// the covered pixels of a row are contiguous, so they are blended as one span
+	unsigned int * line = getScanline(to.x - from.x);
+	for (int y = from.y; y < to.y; y++)
+	{
+		int start = -1;
+		int count = 0;
+		for (int x = from.x; x < to.x; x++)
+		{
+			double pointX = x + 0.5 - anchorX;
+			double pointY = y + 0.5 - anchorY;
+			double unrotatedX = pointX * cosAngle + pointY * sinAngle + anchorX - targetPosition.x;
+			double unrotatedY = -pointX * sinAngle + pointY * cosAngle + anchorY - targetPosition.y;
+			if (unrotatedX < 0.0 || unrotatedY < 0.0 || unrotatedX >= targetSize.x || unrotatedY >= targetSize.y)
+			{
+				if (start >= 0)
+					break;
+				continue;
+			}
+
+			int sourceX = sourcePosition.x + (int) (unrotatedX * sourceSize.x / targetSize.x);
+			int sourceY = sourcePosition.y + (int) (unrotatedY * sourceSize.y / targetSize.y);
+			sourceX = sourceX < 0 ? 0 : sourceX >= imageSize.x ? imageSize.x - 1 : sourceX;
+			sourceY = sourceY < 0 ? 0 : sourceY >= imageSize.y ? imageSize.y - 1 : sourceY;
+
+			if (start < 0)
+				start = x;
+			line[count++] = sourcePixels[sourceY * sourcePitch + sourceX];
+		}
+
+		if (count > 0)
+			blendSpan(pixels + y * pitch + start, line, false, count, modulationColor, blendType, targetType);
+	}
+}
+
+void SoftwarePlatformAdapter::drawTextInternal(DrawingContext & context, Font * font, Vector position,
+	const String & text, unsigned long modulationColor, BlendType blendType, bool caps,
+	bool withHotKeys, bool ellipse)
+{
+	ASSERTION_COBJECT(this);
+
+	String correctedText;
+	if (ellipse)
+	{
+		int maximumWidth = context.getClippingOffset().x
+			+ context.getClippingSize().x - position.x - context.getDrawingOffset().x;
+		correctedText = font->shortenTextForEllipse(text, maximumWidth);
+	}
+	else
+		correctedText = text;
+
+	// Display lists record the glyph images drawn below, so replaying skips the text layout
+	Image * image = font->getImage();
+	int originalX = position.x;
+	int height = font->getHeight();
+	for (int charNo = 0; correctedText[charNo] != 0; charNo++)
+	{
+		unsigned char character = correctedText[charNo];
+		if (character == '\n')
+			position = Vector(originalX, position.y + height);
+		else
+		{
+			bool hotKey;
+			if (withHotKeys && character == '&' && correctedText[charNo+1] != 0)
+			{
+				character = correctedText[++charNo];
+				hotKey = character != '&';
+			}
+			else
+				hotKey = false;
+
+			if (caps)
+				character = String::ToUpperCase(character);
+
+			int width = font->getWidth(character);
+			if (width > 0)
+			{
+				Vector glyphSize(width, height);
+				currentStatistics.increment(RendererStatistics::GLYPHS);
+				drawImage(context, image, font->getPosition(character), glyphSize,
+					position, glyphSize, modulationColor, blendType);
+
+				if (hotKey)
+					for (int i=0; i<width; i++)
+					{
+						Vector underlineSize(1, height - 1);
+						drawImage(context, image, Vector(1, 1), underlineSize,
+							position + Vector(i, 0), underlineSize, modulationColor, blendType);
+					}
+			}
+
+			position.x += width + 1;
+		}
+	}
+}
+
+void SoftwarePlatformAdapter::drawTriangle(DrawingContext & context, Vector * vertices,
+	unsigned long fillColor, unsigned long borderColor)
+{
+	ASSERTION_COBJECT(this);
+
+	if (context.getDisplayList() != NULL)
+		context.getDisplayList()->recordTriangle(context, vertices, fillColor, borderColor);
+
+	currentStatistics.increment(RendererStatistics::TRIANGLES);
+
+	// The vertices are the centers of their pixels
+	Vector points[3];
+	int i;
+	for (i=0; i<3; i++)
+		points[i] = vertices[i] + context.getDrawingOffset();
+
+	int top = points[0].y;
+	int bottom = points[0].y;
+	for (i=1; i<3; i++)
+	{
+		if (points[i].y < top) top = points[i].y;
+		if (points[i].y > bottom) bottom = points[i].y;
+	}
+
+	// Fill each row between the leftmost and rightmost edge crossing
+	for (int y = top; y <= bottom; y++)
+	{
+		double left = 0.0;
+		double right = 0.0;
+		bool crossed = false;
+		for (i=0; i<3; i++)
+		{
+			Vector & edgeFrom = points[i];
+			Vector & edgeTo = points[(i + 1) % 3];
+			if ((y < edgeFrom.y && y < edgeTo.y) || (y > edgeFrom.y && y > edgeTo.y))
+				continue;
+
+			double crossingXs[2];
+			int crossings;
+			if (edgeFrom.y == edgeTo.y)
+			{
+				crossingXs[0] = edgeFrom.x;
+				crossingXs[1] = edgeTo.x;
+				crossings = 2;
+			}
+			else
+			{
+				crossingXs[0] = edgeFrom.x + (double) (y - edgeFrom.y) * (edgeTo.x - edgeFrom.x)
+					/ (edgeTo.y - edgeFrom.y);
+				crossings = 1;
+			}
+
+			for (int crossing = 0; crossing < crossings; crossing++)
+			{
+				if (!crossed || crossingXs[crossing] < left) left = crossingXs[crossing];
+				if (!crossed || crossingXs[crossing] > right) right = crossingXs[crossing];
+				crossed = true;
+			}
+		}
+
+		if (crossed)
+			fillSpan(context, y, (int) ceil(left), (int) floor(right), fillColor);
+	}
+
+	if (GL_ALPHA_OF(borderColor) == 0)
+		return;
+
+	for (i=0; i<3; i++)
+		plotLine(context, points[i], points[(i + 1) % 3], borderColor);
+}
+
+void SoftwarePlatformAdapter::fillSpan(DrawingContext & context, int y, int fromX, int toX, unsigned long color)
+{
+	ASSERTION_COBJECT(this);
+
+	unsigned int * pixels;
+	int pitch;
+	Vector clippingFrom;
+	Vector clippingTo;
+	Image::Type targetType;
+	if (!getTarget(context, pixels, pitch, clippingFrom, clippingTo, targetType))
+		return;
+
+	if (y < clippingFrom.y || y >= clippingTo.y)
+		return;
+	if (fromX < clippingFrom.x)
+		fromX = clippingFrom.x;
+	if (toX >= clippingTo.x)
+		toX = clippingTo.x - 1;
+	if (fromX > toX)
+		return;
+
+	unsigned int source = (unsigned int) color;
+	blendSpan(pixels + y * pitch + fromX, &source, true, toX - fromX + 1, GL_WHITE, BLENDTYPE_NORMAL, targetType);
+}
+
+unsigned long SoftwarePlatformAdapter::getAbsoluteTime()
+{
+	ASSERTION_COBJECT(this);
+	return (unsigned long) ::time(NULL);
+}
+
+unsigned long SoftwarePlatformAdapter::getAvailableVideoMemory()
+{
+	ASSERTION_COBJECT(this);
+
+	long pages = ::sysconf(_SC_AVPHYS_PAGES);
+	long pageSize = ::sysconf(_SC_PAGESIZE);
+	return pages > 0 && pageSize > 0 ? (unsigned long) pages * (pageSize / 1024) : 0;
+}
+
+String SoftwarePlatformAdapter::getClipboardText()
+{
+	ASSERTION_COBJECT(this);
+	return clipboardText;
+}
+
+String SoftwarePlatformAdapter::getConfigFolder(const String & manufacturer, const String & applicationName)
+{
+	ASSERTION_COBJECT(this);
+
+	class Path * Path;
+
+	const char * basePath = ::getenv("HOME");
+	if (basePath == NULL || basePath[0] == 0)
+		Path = Path::CreateApplicationFolderPath();
+	else
+	{
+		if ((Path = new class Path(basePath)) == NULL)
+			throw EOUTOFMEMORY;
+
+		Path->AppendElement(".config");
+		Path->AppendElement(manufacturer);
+		Path->AppendElement(applicationName);
+		if (!Path->Exists())
+			if (!Path->MakeDirectories())
+			{
+				delete Path;
+				Path = Path::CreateApplicationFolderPath();
+			}
+	}
+
+	char * path = Path->ToString(false);
+	delete Path;
+	String pathString = String(path);
+	delete path;
+
+	return pathString;
+}
+
+char SoftwarePlatformAdapter::getDecimalPoint()
+{
+	ASSERTION_COBJECT(this);
+	return '.';
+}
+
+const unsigned int * SoftwarePlatformAdapter::getFrameBuffer()
+{
+	ASSERTION_COBJECT(this);
+	return backBuffer;
+}
+
+unsigned long SoftwarePlatformAdapter::getFrameCount()
+{
+	ASSERTION_COBJECT(this);
+	return frameCount;
+}
+
+JoystickHandler * SoftwarePlatformAdapter::getJoystickHandler()
+{
+	ASSERTION_COBJECT(this);
+	return &joystickHandler;
+}
+
+KeyboardHandler * SoftwarePlatformAdapter::getKeyboardHandler()
+{
+	ASSERTION_COBJECT(this);
+	return &keyboardHandler;
+}
+
+const char * SoftwarePlatformAdapter::getKeyName(int keyCode)
+{
+	ASSERTION_COBJECT(this);
+	return "";
+}
+
+int SoftwarePlatformAdapter::getMasterVolume()
+{
+	ASSERTION_COBJECT(this);
+	return masterVolume;
+}
+
+unsigned long SoftwarePlatformAdapter::getMonotonicTime()
+{
+	struct timespec now;
+	if (::clock_gettime(CLOCK_MONOTONIC, &now) != 0)
+		return 0;
+
+	return (unsigned long) now.tv_sec * 1000UL + (unsigned long) (now.tv_nsec / 1000000L);
+}
+
+MouseHandler * SoftwarePlatformAdapter::getMouseHandler()
+{
+	ASSERTION_COBJECT(this);
+	return &mouseHandler;
+}
+
+unsigned long SoftwarePlatformAdapter::getPixel(DrawingContext & context, Vector position)
+{
+	ASSERTION_COBJECT(this);
+
+	position += context.getDrawingOffset();
+
+	unsigned int * pixels;
+	int pitch;
+	Vector clippingFrom;
+	Vector clippingTo;
+	Image::Type targetType;
+	if (!getTarget(context, pixels, pitch, clippingFrom, clippingTo, targetType))
+		return GL_TRANSPARENCY;
+
+	if (!(position >= clippingFrom && position < clippingTo))
+		return GL_TRANSPARENCY;
+
+	return pixels[position.y * pitch + position.x];
+}
+
+double SoftwarePlatformAdapter::getPreciseTime()
+{
+	ASSERTION_COBJECT(this);
+
+	struct timespec now;
+	if (::clock_gettime(CLOCK_MONOTONIC, &now) != 0)
+		return getTime() * 1000.0;
+
+	return now.tv_sec * 1000000.0 + now.tv_nsec / 1000.0 - startTime * 1000.0;
+}
+
+unsigned int * SoftwarePlatformAdapter::getScanline(int length)
+{
+	ASSERTION_COBJECT(this);
+
+	if (length > scanlineCapacity)
+	{
+		if (scanline != NULL) {delete[] scanline; scanline = NULL;}
+		scanlineCapacity = 0;
+
+		if ((scanline = new unsigned int[length]) == NULL)
+			throw EOUTOFMEMORY;
+		scanlineCapacity = length;
+	}
+
+	return scanline;
+}
+
+Vector SoftwarePlatformAdapter::getScreenSize()
+{
+	ASSERTION_COBJECT(this);
+	return screenSize;
+}
+
+String SoftwarePlatformAdapter::getSystemInformation()
+{
+	ASSERTION_COBJECT(this);
+
+	String information;
+	String value;
+
+	struct utsname systemName;
+	if (::uname(&systemName) == 0)
+	{
+		value.Format("OS: %s %s (%s)\n", systemName.sysname, systemName.release, systemName.machine);
+		information += value;
+	}
+	else
+		information += "OS: Unknown\n";
+
+	#ifdef GL_SOFTWARE_SSE2
+		information += "Renderer: Software (SSE2)\n";
+	#else
+		information += "Renderer: Software\n";
+	#endif
+
+	value.Format("Processors: %ld\n", ::sysconf(_SC_NPROCESSORS_ONLN));
+	information += value;
+
+	value.Format("Screen: %dx%d\n", screenSize.x, screenSize.y);
+	information += value;
+
+	return information;
+}
+
+bool SoftwarePlatformAdapter::getTarget(DrawingContext & context, unsigned int *& pixels, int & pitch,
+	Vector & clippingFrom, Vector & clippingTo, Image::Type & targetType)
+{
+	ASSERTION_COBJECT(this);
+
+	SoftwareImage * target = (SoftwareImage *) context.getTarget();
+	if (target != currentTarget)
+	{
+		currentStatistics.increment(RendererStatistics::TARGET_SWITCHES);
+		currentTarget = target;
+	}
+
+	Vector size;
+	if (target != NULL)
+	{
+		if ((pixels = target->getPixels()) == NULL)
+			return false;
+
+		pitch = target->getPitch();
+		size = target->size;
+		targetType = target->getImageType();
+	}
+	else
+	{
+		if ((pixels = backBuffer) == NULL)
+			return false;
+
+		pitch = screenSize.x;
+		size = screenSize;
+		targetType = Image::TYPE_RGB;
+	}
+
+	// The clipping rectangle is constrained to the target, clippingTo is exclusive
+	clippingFrom = context.getClippingOffset();
+	clippingTo = context.getClippingOffset() + context.getClippingSize();
+	clippingFrom.constrain(Vector(), size);
+	clippingTo.constrain(Vector(), size);
+
+	return clippingFrom < clippingTo;
+}
+
+unsigned long SoftwarePlatformAdapter::getTime()
+{
+	ASSERTION_COBJECT(this);
+	return getMonotonicTime() - startTime;
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(SoftwarePlatformAdapter, PlatformAdapter);
+#endif
+
+void SoftwarePlatformAdapter::initialize()
+{
+	ASSERTION_COBJECT(this);
+
+	LOGPRINTF0(LOG_INFO, "Initializing software platform adapter");
+
+	// The screen has the size of the active scene, if any
+	Desktop * desktop = Desktop::getInstance();
+	Scene * scene = desktop != NULL ? desktop->getActiveScene() : NULL;
+	screenSize = Vector(DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT);
+	if (scene != NULL && scene->getDesiredWidth() > 0 && scene->getDesiredHeight() > 0)
+		screenSize = Vector(scene->getDesiredWidth(), scene->getDesiredHeight());
+
+	if ((backBuffer = new unsigned int[screenSize.x * screenSize.y]) == NULL)
+		throw EOUTOFMEMORY;
+	for (int i = screenSize.x * screenSize.y - 1; i >= 0; i--)
+		backBuffer[i] = GL_BLACK;
+
+	LOGPRINTF2(LOG_INFO, "Software platform adapter initialized with %dx%d pixels", screenSize.x, screenSize.y);
+}
+
+bool SoftwarePlatformAdapter::isAlphaFullySupported()
+{
+	ASSERTION_COBJECT(this);
+	return true;
+}
+
+bool SoftwarePlatformAdapter::isApplicationFocused()
+{
+	ASSERTION_COBJECT(this);
+	return true;
+}
+
+bool SoftwarePlatformAdapter::isBackBufferRetained()
+{
+	ASSERTION_COBJECT(this);
+	return true;
+}
+
+bool SoftwarePlatformAdapter::isDeleteKey(int keyCode)
+{
+	ASSERTION_COBJECT(this);
+	return keyCode == 0x7F;
+}
+
+bool SoftwarePlatformAdapter::isExclusive()
+{
+	ASSERTION_COBJECT(this);
+	return false;
+}
+
+bool SoftwarePlatformAdapter::isFullScreen()
+{
+	ASSERTION_COBJECT(this);
+	return false;
+}
+
+bool SoftwarePlatformAdapter::isMute()
+{
+	ASSERTION_COBJECT(this);
+	return mute;
+}
+
+bool SoftwarePlatformAdapter::isPow2Required()
+{
+	ASSERTION_COBJECT(this);
+	return false;
+}
+
+bool SoftwarePlatformAdapter::isSquareRequired()
+{
+	ASSERTION_COBJECT(this);
+	return false;
+}
+
+void SoftwarePlatformAdapter::minimizeDesktop()
+{
+	ASSERTION_COBJECT(this);
+}
+
+unsigned int SoftwarePlatformAdapter::modulatePixel(unsigned int source, unsigned int modulationColor)
+{
+	if (modulationColor == 0xFFFFFFFF)
+		return source;
+
+	unsigned int result = 0;
+	for (int shift = 0; shift < 32; shift += 8)
+	{
+		unsigned int value = ((source >> shift) & 0xFF) * ((modulationColor >> shift) & 0xFF) + 128;
+		result |= ((value + (value >> 8)) >> 8) << shift;
+	}
+
+	return result;
+}
+
+void SoftwarePlatformAdapter::openUrl(const String & url)
+{
+	ASSERTION_COBJECT(this);
+	LOGPRINTF1(LOG_INFO, "Not opening URL '%s' in the software platform adapter", (const char *) url);
+}
+
+#ifdef GL_SOFTWARE_SSE2
+	__m128i SoftwarePlatformAdapter::divideBy255(__m128i values)
+	{
+		// (x + 128 + ((x + 128) >> 8)) >> 8 equals x / 255 rounded for all products of two bytes
+		values = _mm_add_epi16(values, _mm_set1_epi16(128));
+		return _mm_srli_epi16(_mm_add_epi16(values, _mm_srli_epi16(values, 8)), 8);
+	}
+#endif
+
+void SoftwarePlatformAdapter::plotLine(DrawingContext & context, Vector from, Vector to, unsigned long color)
+{
+	ASSERTION_COBJECT(this);
+
+	// Horizontal and vertical lines are spans
+	if (from.y == to.y)
+	{
+		fillSpan(context, from.y, from.x < to.x ? from.x : to.x, from.x < to.x ? to.x : from.x, color);
+		return;
+	}
+
+	if (from.x == to.x)
+	{
+		for (int y = from.y < to.y ? from.y : to.y; y <= (from.y < to.y ? to.y : from.y); y++)
+			fillSpan(context, y, from.x, from.x, color);
+		return;
+	}
+
+	// Bresenham, including both end points
+	int deltaX = to.x > from.x ? to.x - from.x : from.x - to.x;
+	int deltaY = to.y > from.y ? from.y - to.y : to.y - from.y;
+	int stepX = to.x > from.x ? 1 : -1;
+	int stepY = to.y > from.y ? 1 : -1;
+	int error = deltaX + deltaY;
+	Vector position = from;
+	while (true)
+	{
+		fillSpan(context, position.y, position.x, position.x, color);
+		if (position == to)
+			break;
+
+		int doubleError = 2 * error;
+		if (doubleError >= deltaY)
+		{
+			error += deltaY;
+			position.x += stepX;
+		}
+		if (doubleError <= deltaX)
+		{
+			error += deltaX;
+			position.y += stepY;
+		}
+	}
+}
+
+void SoftwarePlatformAdapter::restoreDesktop()
+{
+	ASSERTION_COBJECT(this);
+}
+
+void SoftwarePlatformAdapter::setClipboardText(const String & text)
+{
+	ASSERTION_COBJECT(this);
+	clipboardText = text;
+}
+
+void SoftwarePlatformAdapter::setMasterVolume(int masterVolume)
+{
+	ASSERTION_COBJECT(this);
+	this->masterVolume = masterVolume;
+}
+
+void SoftwarePlatformAdapter::setMute(bool mute)
+{
+	ASSERTION_COBJECT(this);
+	this->mute = mute;
+}
+
+void SoftwarePlatformAdapter::showFrame()
+{
+	ASSERTION_COBJECT(this);
+
+	// The back buffer is retained, so the frame is just counted
+	frameCount++;
+}
+
+void SoftwarePlatformAdapter::shutDown()
+{
+	ASSERTION_COBJECT(this);
+
+	LOGPRINTF0(LOG_INFO, "Shutting down software platform adapter");
+
+	keyboardHandler.shutDown();
+	mouseHandler.shutDown();
+	joystickHandler.shutDown();
+
+	if (backBuffer != NULL) {delete[] backBuffer; backBuffer = NULL;}
+	if (scanline != NULL) {delete[] scanline; scanline = NULL;}
+	scanlineCapacity = 0;
+
+	LOGPRINTF0(LOG_INFO, "Software platform adapter shut down");
+}
+
+void SoftwarePlatformAdapter::sleep(unsigned long msecs)
+{
+	ASSERTION_COBJECT(this);
+
+	::usleep((useconds_t) msecs * 1000);
+}
+
+void SoftwarePlatformAdapter::update()
+{
+	ASSERTION_COBJECT(this);
+}
@@ -0,0 +1,157 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_SOFTWAREPLATFORMADAPTER_H
+#define __GLAZIERY_SOFTWAREPLATFORMADAPTER_H
+
+
+namespace glaziery
+{
+	/**
+	 * The software platform adapter renders on the CPU into 32 bit ARGB frame buffers
+	 * in main memory, without any window, graphics device, or input device.
+	 * It is used to run, render, and profile Glaziery on machines without a GPU or display,
+	 * e.g. on a build farm. The shown frame is available using getFrameBuffer().
+	 * Blending is performed by span kernels that process four pixels at a time using SSE2,
+	 * if available (see GL_SOFTWARE_SSE2), and fall back to portable scalar code otherwise.
+	 * Images are sampled without filtering (nearest pixel).
+	 * Input is simulated by passing events to the input manager, the handlers are headless.
+	 */
+	class SoftwarePlatformAdapter : public PlatformAdapter
+	{
+		friend SoftwareFont;
+		friend SoftwareImage;
+
+		protected:
+
+			static const int DEFAULT_SCREEN_HEIGHT;
+			static const int DEFAULT_SCREEN_WIDTH;
+
+			unsigned int * backBuffer;
+			String clipboardText;
+			Image * currentTarget;
+			unsigned long frameCount;
+			SoftwareJoystickHandler joystickHandler;
+			SoftwareKeyboardHandler keyboardHandler;
+			int masterVolume;
+			SoftwareMouseHandler mouseHandler;
+			bool mute;
+			unsigned int * scanline;
+			int scanlineCapacity;
+			Vector screenSize;
+			unsigned long startTime;
+
+			static unsigned int blendPixel(unsigned int target, unsigned int source, BlendType blendType);
+			static void blendSpan(unsigned int * target, const unsigned int * source, bool solid, int count,
+				unsigned long modulationColor, BlendType blendType, Image::Type targetType);
+			virtual Image * createImage(const String & path, Image::Type imageType);
+			virtual Font * createFont(const String & path);
+			virtual void drawTextInternal(DrawingContext & context, Font * font, Vector position,
+				const String & text, unsigned long modulationColor, BlendType blendType, bool caps,
+				bool withHotKeys, bool ellipse);
+			void fillSpan(DrawingContext & context, int y, int fromX, int toX, unsigned long color);
+			unsigned int * getScanline(int length);
+			bool getTarget(DrawingContext & context, unsigned int *& pixels, int & pitch,
+				Vector & clippingFrom, Vector & clippingTo, Image::Type & targetType);
+			static unsigned long getMonotonicTime();
+			static unsigned int modulatePixel(unsigned int source, unsigned int modulationColor);
+			void plotLine(DrawingContext & context, Vector from, Vector to, unsigned long color);
+
+			#ifdef GL_SOFTWARE_SSE2
+				static __m128i blendPixels(__m128i target, __m128i source,
+					__m128i modulation, bool modulated, BlendType blendType);
+				static __m128i divideBy255(__m128i values);
+			#endif
+
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(SoftwarePlatformAdapter);
+			#endif
+
+		public:
+
+			SoftwarePlatformAdapter();
+			virtual ~SoftwarePlatformAdapter();
+			virtual void clear(DrawingContext & context, unsigned long fillColor = GL_TRANSPARENCY);
+			virtual void clearClipboard();
+			virtual Mutex * createMutex();
+			virtual Thread * createThread(int (*function)(Thread & thread, void * parameter),
+				void * parameter);
+			virtual void drawEllipse(DrawingContext & context, Vector center, Vector radius,
+				unsigned long fillColor, unsigned long borderColor);
+			virtual void drawImage(DrawingContext & context, Image * image,
+				Vector sourcePosition, Vector sourceSize, Vector targetPosition, Vector targetSize,
+				unsigned long modulationColor = GL_WHITE, BlendType blendType = BLENDTYPE_NORMAL);
+			virtual void drawLine(DrawingContext & context, Vector from, Vector to,
+				unsigned long color);
+			virtual void drawPixel(DrawingContext & context, Vector position,
+				unsigned long color);
+			virtual void drawRect(DrawingContext & context, Vector from, Vector to,
+				unsigned long fillColor, unsigned long borderColor);
+			virtual void drawRotatedImage(DrawingContext & context, Image * image,
+				Vector sourcePosition, Vector sourceSize, Vector targetPosition, Vector targetSize,
+				Vector rotationAnchor, double rotationAngle,
+				unsigned long modulationColor = GL_WHITE, BlendType blendType = BLENDTYPE_NORMAL);
+			virtual void drawTriangle(DrawingContext & context, Vector * vertices,
+				unsigned long fillColor, unsigned long borderColor);
+			virtual unsigned long getAbsoluteTime();
+			virtual unsigned long getAvailableVideoMemory();
+			virtual String getClipboardText();
+			virtual String getConfigFolder(const String & manufacturer, const String & applicationName);
+			virtual char getDecimalPoint();
+
+			/**
+			 * Returns the pixels of the back buffer, row by row (getScreenSize().x pixels per row).
+			 * After showFrame(), they contain the shown frame, until the next frame is drawn.
+			 * @return The back buffer pixels in 32 bit ARGB format, or NULL before initialize().
+			 */
+			const unsigned int * getFrameBuffer();
+
+			/**
+			 * Returns the number of frames shown since the initialization.
+			 * @return The number of frames.
+			 */
+			unsigned long getFrameCount();
+
+			virtual JoystickHandler * getJoystickHandler();
+			virtual KeyboardHandler * getKeyboardHandler();
+			virtual const char * getKeyName(int keyCode);
+			virtual int getMasterVolume();
+			virtual MouseHandler * getMouseHandler();
+			virtual unsigned long getPixel(DrawingContext & context, Vector position);
+			virtual double getPreciseTime();
+			virtual Vector getScreenSize();
+			virtual String getSystemInformation();
+			virtual unsigned long getTime();
+			virtual void initialize();
+			virtual bool isAlphaFullySupported();
+			virtual bool isApplicationFocused();
+			virtual bool isBackBufferRetained();
+			virtual bool isDeleteKey(int keyCode);
+			virtual bool isExclusive();
+			virtual bool isFullScreen();
+			virtual bool isMute();
+			virtual bool isPow2Required();
+			virtual bool isSquareRequired();
+			virtual void minimizeDesktop();
+			virtual void openUrl(const String & url);
+			virtual void restoreDesktop();
+			virtual void setClipboardText(const String & text);
+			virtual void setMasterVolume(int masterVolume);
+			virtual void setMute(bool mute);
+			virtual void showFrame();
+			virtual void shutDown();
+			virtual void sleep(unsigned long msecs);
+			virtual void update();
+	};
+}
+
+
+#endif
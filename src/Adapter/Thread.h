@@ -113,22 +113,22 @@ namespace glaziery
 			/**
 			 * TODO
 			 */
-			virtual bool isFinished() = NULL;
+			virtual bool isFinished() = 0;
 
 			/**
 			 * TODO
 			 */
-			virtual bool isSuspended() = NULL;
+			virtual bool isSuspended() = 0;
 
 			/**
 			 * TODO
 			 */
-			virtual void kill() = NULL;
+			virtual void kill() = 0;
 
 			/**
 			 * TODO
 			 */
-			virtual void resume() = NULL;
+			virtual void resume() = 0;
 
 			/**
 			 * @warn Thread::runAndWait() may call the code again from where it has been
@@ -146,7 +146,7 @@ namespace glaziery
 			/**
 			 * TODO
 			 */
-			virtual void suspend() = NULL;
+			virtual void suspend() = 0;
 	};
 }
 
@@ -77,16 +77,23 @@ void FieldsArea::drawAreaContent(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
 
-	Desktop::getInstance()->getSkin()->drawFieldsArea(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawFieldsArea")
+		Desktop::getInstance()->getSkin()->drawFieldsArea(context, this);
+	}
 
 	#ifdef GL_DEBUG_FIELDBOUNDS
 		PlatformAdapter * adapter = Desktop::getInstance()->getPlatformAdapter();
 	#endif
 
-	for (int i=0; i<fields.GetCount(); i++)
+	// Draw only the fields within the clipping area (e.g. the invalid area of the window)
+	fieldIndex.startQuery(fields, NULL, context.getClippingOffset() - context.getDrawingOffset(),
+		context.getClippingSize());
+	int fieldNo;
+	while ((fieldNo = fieldIndex.getNextFieldNo(fields)) >= 0)
 	{
-		Field * field = fields.Get(i);
-		if (field->isVisible() && field->getGroupField() == NULL)
+		Field * field = fields.Get(fieldNo);
+		if (field->isVisible())
 		{
 			DrawingContext fieldContext(context, field);
 
@@ -95,7 +102,7 @@ void FieldsArea::drawAreaContent(DrawingContext & context)
 					GL_TRANSPARENCY, GL_RGBA(128, 160, 128, 128));
 			#endif
 
-			field->draw(fieldContext);
+			field->drawRecorded(fieldContext);
 		}
 	}
 }
@@ -225,6 +232,7 @@ void FieldsArea::insertField(int position, Field * field)
 		throw EILLEGALSTATE("The fields area must be added to a parent before using it");
 
 	fields.Insert(field, position);
+	fieldIndex.invalidate();
 	setComponentParent(field);
 
 	if (focusField == NULL)
@@ -300,6 +308,22 @@ bool FieldsArea::onBackTab(bool secondary)
 		return consumed;
 }
 
+void FieldsArea::onChildMoved(Component * child, Vector oldPosition)
+{
+	ASSERTION_COBJECT(this);
+
+	ScrollingArea::onChildMoved(child, oldPosition);
+	fieldIndex.invalidate();
+}
+
+void FieldsArea::onChildResized(Component * child, Vector oldSize)
+{
+	ASSERTION_COBJECT(this);
+
+	ScrollingArea::onChildResized(child, oldSize);
+	fieldIndex.invalidate();
+}
+
 void FieldsArea::onDestroying()
 {
 	ASSERTION_COBJECT(this);
@@ -380,6 +404,7 @@ void FieldsArea::removeField(Field * field)
 		setFocusField(NULL);
 
 	fields.Unlink(field);
+	fieldIndex.invalidate();
 	field->destroy();
 
 	if (focusField == NULL)
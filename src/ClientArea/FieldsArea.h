@@ -22,6 +22,7 @@ namespace glaziery
 	class FieldsArea : public ScrollingArea
 	{
 		friend Field;
+		friend GroupField;
 
 		private:
 
@@ -80,6 +81,12 @@ namespace glaziery
 			 */
 			Vector defaultFieldTopLeftPadding;
 
+			/**
+			 * The spatial index of the fields not contained in a group field,
+			 * used to draw only the fields within the clipping area.
+			 */
+			FieldIndex fieldIndex;
+
 			/**
 			 * The fields contained in this fields area.
 			 */
@@ -376,6 +383,26 @@ namespace glaziery
 			 */
 			virtual bool onBackTab(bool secondary);
 
+			/**
+			 * Performs operations necessary when a child component
+			 * has been moved within this parent. E.g. move the parent,
+			 * too, if the child uses all the area of the parent, or
+			 * ignore the event if the child can move freely.
+			 * @param child The child component that moved.
+			 * @param oldPosition The position of the child before the move.
+			 */
+			virtual void onChildMoved(Component * child, Vector oldPosition);
+
+			/**
+			 * Performs operations necessary when a child component
+			 * has been resized within this parent. E.g. resize the parent,
+			 * too, if the child uses all the area of the parent, or
+			 * ignore the event if the child can resize freely.
+			 * @param child The child component that resized.
+			 * @param oldSize The size of the child before the resize.
+			 */
+			virtual void onChildResized(Component * child, Vector oldSize);
+
 			/**
 			 * Notifies all component listeners about the destruction
 			 * of the component, but does not delete it nor adds it to
@@ -66,10 +66,14 @@ void ScrollingArea::drawContent(DrawingContext & context)
 	ASSERTION_COBJECT(this);
 
 	Skin * skin = Desktop::getInstance()->getSkin();
-	skin->drawScrollingArea(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawScrollingArea")
+		skin->drawScrollingArea(context, this);
+	}
 
-	drawAreaContent(DrawingContext(DrawingContext(context, borderSize + outerPaddingSize,
-		getContentViewSize()), -scrollPositionNow));
+	DrawingContext contentContext(DrawingContext(context, borderSize + outerPaddingSize,
+		getContentViewSize()), -scrollPositionNow);
+	drawAreaContent(contentContext);
 }
 
 void ScrollingArea::ensureVisible(Vector point)
@@ -255,15 +259,36 @@ Vector ScrollingArea::getScrollPositionNow()
 	IMPLEMENT_DYNAMIC(ScrollingArea, ClientArea);
 #endif
 
+void ScrollingArea::invalidateContentViewFrame()
+{
+	ASSERTION_COBJECT(this);
+
+	Vector size = getSize();
+	Vector viewPosition = borderSize + outerPaddingSize;
+	Vector viewEnd = viewPosition + getContentViewSize();
+
+	Component::invalidateArea(Vector(), Vector(size.x, viewPosition.y));
+	Component::invalidateArea(Vector(0, viewEnd.y), Vector(size.x, size.y - viewEnd.y));
+	Component::invalidateArea(Vector(0, viewPosition.y), Vector(viewPosition.x, viewEnd.y - viewPosition.y));
+	Component::invalidateArea(Vector(viewEnd.x, viewPosition.y), Vector(size.x - viewEnd.x, viewEnd.y - viewPosition.y));
+}
+
 void ScrollingArea::invalidateArea(Vector position, Vector size)
 {
 	ASSERTION_COBJECT(this);
 
-	Component * parent = getParent();
-	if (parent != NULL && parent->isChildVisible(this))
-		parent->invalidateArea(getPosition() + position - scrollPositionNow, size);
+	// Constraining the scroll position below is tracked as an invalidation of its own
+	{
+		GLAZIERY_INVALIDATIONSCOPE(this, size)
+
+		discardDisplayList();
 
-	if (parent == NULL)
+		Component * parent = getParent();
+		if (parent != NULL && parent->isChildVisible(this))
+			parent->invalidateArea(getPosition() + position - scrollPositionNow, size);
+	}
+
+	if (getParent() == NULL)
 		return;
 
 	constrainScrollPosition();
@@ -285,7 +310,6 @@ bool ScrollingArea::isWithinContent(Vector position)
 {
 	ASSERTION_COBJECT(this);
 
-	Skin * skin = Desktop::getInstance()->getSkin();
 	return position >= borderSize + outerPaddingSize
 		&& position < getSize() - getScrollerSizes() - borderSize - getEffectiveInnerPaddingSize();
 }
@@ -563,6 +587,18 @@ void ScrollingArea::scroll(Vector delta)
 	scrollTo(getScrollPosition() + delta);
 }
 
+bool ScrollingArea::scrollArea(Vector position, Vector size, Vector delta)
+{
+	ASSERTION_COBJECT(this);
+
+	Vector viewPosition = borderSize + outerPaddingSize;
+	Vector areaPosition = position - scrollPositionNow + viewPosition;
+	if (!(areaPosition >= viewPosition) || !(areaPosition + size <= viewPosition + getContentViewSize()))
+		return false;
+
+	return ClientArea::scrollArea(areaPosition, size, delta);
+}
+
 void ScrollingArea::scrollTo(Vector scrollPosition)
 {
 	ASSERTION_COBJECT(this);
@@ -572,6 +608,7 @@ void ScrollingArea::scrollTo(Vector scrollPosition)
 void ScrollingArea::scrollToNow(Vector scrollPositionNow)
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_INVALIDATIONCAUSE(CAUSE_SCROLL)
 
 	if (this->scrollPositionNow == scrollPositionNow)
 		return;
@@ -579,8 +616,18 @@ void ScrollingArea::scrollToNow(Vector scrollPositionNow)
 	Vector previousPosition = this->scrollPositionNow;
 	this->scrollPositionNow = scrollPositionNow;
 
-	// Performs scroll position checks, too.
-	invalidate();
+	// Shift the content view, if possible, instead of redrawing it
+	if (ClientArea::scrollArea(borderSize + outerPaddingSize, getContentViewSize(),
+		previousPosition - scrollPositionNow))
+	{
+		invalidateContentViewFrame();
+		constrainScrollPosition();
+	}
+	else
+	{
+		// Performs scroll position checks, too.
+		invalidate();
+	}
 
 	int listenersCount = listeners.GetCount();
 	for (int i=0; i<listenersCount; i++)
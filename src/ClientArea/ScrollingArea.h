@@ -251,7 +251,7 @@ namespace glaziery
 			 * @see CachableComponent::invalidate()
 			 * @see CachableComponent
 			 */
-			virtual void drawAreaContent(DrawingContext & context) = NULL;
+			virtual void drawAreaContent(DrawingContext & context) = 0;
 
 			/**
 			 * Draws the content of the component to the display surface.
@@ -283,6 +283,14 @@ namespace glaziery
 			 */
 			Vector getScrollerSizes();
 
+			/**
+			 * Invalidates the parts of the scrolling area around the content view,
+			 * i.e. the border, the padding, and the scrollers.
+			 * This is required after the content view has been scrolled by shifting it.
+			 * @see scrollToNow()
+			 */
+			void invalidateContentViewFrame();
+
 			/**
 			 * Returns whether a position is within the content area of the scrolling area,
 			 * i.e. not within a scroller.
@@ -809,6 +817,19 @@ namespace glaziery
 			 */
 			void scroll(Vector delta);
 
+			/**
+			 * Shifts the already rendered content of an area of this component by a given delta.
+			 * The area must be entirely within the content view.
+			 * @param position The top-left position of the area, relative to the content
+			 * (using the same coordinates as invalidateArea()).
+			 * @param size The size of the area.
+			 * @param delta The number of pixels to shift the content by
+			 * (positive values shift right resp. down).
+			 * @return Whether the content has been shifted. If not, the caller must invalidate the area.
+			 * @see Component::scrollArea()
+			 */
+			virtual bool scrollArea(Vector position, Vector size, Vector delta);
+
 			/**
 			 * Sets the current scroll position the way the skin defines. The scroll position
 			 * is the position of the content to be displayed in the upper-left corner of the
@@ -30,9 +30,12 @@ void SingleFieldArea::drawContent(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
 
-	Desktop::getInstance()->getSkin()->drawSingleFieldArea(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawSingleFieldArea")
+		Desktop::getInstance()->getSkin()->drawSingleFieldArea(context, this);
+	}
 	if (contentField != NULL && contentField->isVisible())
-		contentField->draw(context);
+		contentField->drawRecorded(context);
 }
 
 class Field * SingleFieldArea::getContentField()
@@ -104,12 +104,21 @@ void SplittingArea::drawContent(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
 
-	Desktop::getInstance()->getSkin()->drawSplittingArea(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawSplittingArea")
+		Desktop::getInstance()->getSkin()->drawSplittingArea(context, this);
+	}
 	for (int i=0; i<panes.GetCount(); i++)
 	{
+		// Skip panes outside the clipping area (e.g. the invalid area of the window)
 		ClientArea * pane = panes.Get(i);
-		if (pane->isVisible())
-			pane->draw(DrawingContext(context, pane));
+		Vector panePosition = context.getDrawingOffset() + pane->getPosition();
+		if (pane->isVisible() && context.isInClippingArea(panePosition,
+			panePosition + pane->getSize() - Vector(1, 1)))
+		{
+			DrawingContext paneContext(context, pane);
+			pane->draw(paneContext);
+		}
 	}
 }
 
@@ -73,10 +73,16 @@ void TabbingArea::drawContent(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
 
-	Desktop::getInstance()->getSkin()->drawTabbingArea(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawTabbingArea")
+		Desktop::getInstance()->getSkin()->drawTabbingArea(context, this);
+	}
 
 	if (focusPane != NULL && focusPane->isVisible())
-		focusPane->draw(DrawingContext(context, focusPane));
+	{
+		DrawingContext paneContext(context, focusPane);
+		focusPane->draw(paneContext);
+	}
 }
 
 EventTarget * TabbingArea::getEventTargetAt(Vector position)
@@ -10,12 +10,20 @@
 #include <Glaziery/src/Headers.h>
 
 
+const int CachableComponent::CACHING_MAXIMUM_INVALIDATION_RATE = 75;
+const unsigned long CachableComponent::CACHING_MINIMUM_SAVED_TIME = 20;
+const unsigned long CachableComponent::CACHING_SAMPLE_LENGTH = 500;
+
 CachableComponent::CachableComponent()
 {
 	ASSERTION_COBJECT(this);
 
 	withAlphaChannel = Desktop::getInstance()->getPlatformAdapter()->isAlphaFullySupported();
+	automaticCaching = false;
 	caching = false;
+	cachingBytes = 0;
+	cachingSamplesTaken = 0;
+	cachingSampleStartTime = 0;
 	focusAlpha = 255;
 	nonFocusAlpha = 255;
 	surface = NULL;
@@ -25,29 +33,73 @@ CachableComponent::CachableComponent()
 CachableComponent::~CachableComponent()
 {
 	ASSERTION_COBJECT(this);
+
+	setCachingBytes(0);
 	releaseCache();
 }
 
 void CachableComponent::draw(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_PROFILERZONE_D("CachableComponent::draw", toString())
+
+	Desktop * desktop = Desktop::getInstance();
+	PlatformAdapter * adapter = desktop->getPlatformAdapter();
+	InvalidationTracker & tracker = desktop->getInvalidationTracker();
+
+	if (automaticCaching)
+	{
+		updateCachingSamples();
+
+		CachingSample & sample = cachingSamples[0];
+		sample.drawnFrames++;
+		if (!valid)
+			sample.invalidatedFrames++;
+	}
 
 	if (!caching)
 	{
+		valid = true;
+		invalidRegion.clear();
+
+		unsigned long startTime = adapter->getTime();
 		drawContent(context);
+		if (tracker.isEnabled())
+		{
+			Vector clippingSize = context.getClippingSize();
+			tracker.onRedraw(this, (unsigned long) clippingSize.x * (unsigned long) clippingSize.y);
+		}
+		if (automaticCaching)
+		{
+			cachingSamples[0].contentDraws++;
+			cachingSamples[0].contentDrawTime += adapter->getTime() - startTime;
+		}
+
+		#ifdef GL_DEBUG_CACHING
+			if (automaticCaching)
+				adapter->drawRect(context, Vector(), getSize() - Vector(1, 1), GL_TRANSPARENCY, GL_RED);
+		#endif
+
 		return;
 	}
 
-	PlatformAdapter * adapter = Desktop::getInstance()->getPlatformAdapter();
+	// Exchange the surface if it would have to be reallocated anyway
+	if (surface != NULL && !adapter->isRenderTargetFitting(surface, getSize()))
+		releaseCache();
 
 	if (surface == NULL)
 	{
-		surface = adapter->createRenderTarget(getSize(), withAlphaChannel ? Image::TYPE_RGB_ALPHA : Image::TYPE_RGB);
+		surface = adapter->acquireRenderTarget(getSize(), withAlphaChannel ? Image::TYPE_RGB_ALPHA : Image::TYPE_RGB);
 
 		SurfaceListener * surfaceListener;
 		if ((surfaceListener = new SurfaceListener(this)) == NULL)
 			throw EOUTOFMEMORY;
 		surface->appendListener(surfaceListener);
+
+		// Pooled surfaces contain the content of their previous user
+		valid = false;
+		invalidRegion.clear();
+		invalidRegion.add(Vector(), getSize());
 	}
 
 	if (!valid)
@@ -55,48 +107,40 @@ void CachableComponent::draw(DrawingContext & context)
 
 	if (!valid)
 	{
-		// Set valid to true before updating the surface,
+		// Set valid to true and take over the invalid region before updating the surface,
 		// to enable the drawing method to invalidate the surface while drawing
 		valid = true;
-
-		LOGPRINTF0(LOG_DEBUG, "Redrawing cachable component's content...");
-		drawContent(DrawingContext(DrawingContext(DrawingContext(surface),
-			invalidAreaPosition, invalidAreaSize), -invalidAreaPosition));
+		Region region = invalidRegion;
+		invalidRegion.clear();
+
+		// Redraw each invalid rectangle on its own, scattered invalidations
+		// (e.g. a caret and a progress bar) do not redraw everything in between
+		LOGPRINTF1(LOG_DEBUG, "Redrawing cachable component's content in %d rectangle(s)...",
+			region.getRectangleCount());
+		unsigned long startTime = adapter->getTime();
+		for (int i = 0; i < region.getRectangleCount(); i++)
+		{
+			Vector position = region.getRectanglePosition(i);
+			Vector size = region.getRectangleSize(i);
+			DrawingContext rectangleContext(DrawingContext(DrawingContext(surface),
+				position, size), -position);
+			drawContent(rectangleContext);
+			if (tracker.isEnabled())
+				tracker.onRedraw(this, (unsigned long) size.x * (unsigned long) size.y);
+		}
+		if (automaticCaching)
+		{
+			cachingSamples[0].contentDraws++;
+			cachingSamples[0].contentDrawTime += adapter->getTime() - startTime;
+		}
 		LOGPRINTF0(LOG_DEBUG, "Cachable component's redrawn");
 	}
 
-	Skin * skin = Desktop::getInstance()->getSkin();
 	adapter->drawImage(context, surface, Vector(), getModulationColor());
 
-	#ifdef GL_DEBUG_INVALIDATIONS
-		if (!redrawRegions.IsEmpty())
-		{
-			unsigned long latestTime = Desktop::getInstance()->getFrameTime() - 500;
-			int i;
-			for (i = redrawRegions.GetCount() - 1; i >= 0; i--)
-			{
-				RedrawRegion * region = redrawRegions.Get(i);
-				if (region->time < latestTime)
-					break;
-
-				Desktop * desktop = Desktop::getInstance();
-				PlatformAdapter * adapter = desktop->getPlatformAdapter();
-
-				unsigned int alpha = (unsigned int) (region->time - latestTime);
-				if (alpha > 255)
-					alpha = 255;
-
-				adapter->drawRect(context, region->position, region->position + region->size - Vector(1, 1),
-					GL_RGBA(128, 16, 64, alpha / 2), GL_RGBA(255, 32, 128, alpha));
-			}
-
-			for (; i >= 0; i--)
-				redrawRegions.Delete(i);
-
-			Component * parent = getParent();
-			if (parent != NULL)
-				parent->invalidate();
-		}
+	#ifdef GL_DEBUG_CACHING
+		if (automaticCaching)
+			adapter->drawRect(context, Vector(), getSize() - Vector(1, 1), GL_TRANSPARENCY, GL_GREEN);
 	#endif
 }
 
@@ -106,6 +150,44 @@ unsigned char CachableComponent::getAlpha()
 	return hasFocus() ? focusAlpha : nonFocusAlpha;
 }
 
+int CachableComponent::getCachingInvalidationRate()
+{
+	ASSERTION_COBJECT(this);
+
+	int drawnFrames = 0;
+	int invalidatedFrames = 0;
+	for (int sampleNo = 0; sampleNo < GL_CACHING_SAMPLE_COUNT; sampleNo++)
+	{
+		drawnFrames += cachingSamples[sampleNo].drawnFrames;
+		invalidatedFrames += cachingSamples[sampleNo].invalidatedFrames;
+	}
+
+	return drawnFrames > 0 ? invalidatedFrames * 100 / drawnFrames : 0;
+}
+
+unsigned long CachableComponent::getCachingSavedTime()
+{
+	ASSERTION_COBJECT(this);
+
+	int contentDraws = 0;
+	unsigned long contentDrawTime = 0;
+	int drawnFrames = 0;
+	int invalidatedFrames = 0;
+	for (int sampleNo = 0; sampleNo < GL_CACHING_SAMPLE_COUNT; sampleNo++)
+	{
+		CachingSample & sample = cachingSamples[sampleNo];
+		contentDraws += sample.contentDraws;
+		contentDrawTime += sample.contentDrawTime;
+		drawnFrames += sample.drawnFrames;
+		invalidatedFrames += sample.invalidatedFrames;
+	}
+
+	if (contentDraws == 0 || drawnFrames <= invalidatedFrames)
+		return 0;
+
+	return contentDrawTime * (drawnFrames - invalidatedFrames) / contentDraws;
+}
+
 unsigned char CachableComponent::getFocusAlpha()
 {
 	ASSERTION_COBJECT(this);
@@ -146,75 +228,14 @@ void CachableComponent::invalidateArea(Vector position, Vector size)
 	position.constrain(Vector(0, 0), componentSize - Vector(1, 1));
 	size.constrain(Vector(0, 0), componentSize - position);
 
-	if (valid)
-	{
-		valid = false;
-
-		invalidAreaPosition = position;
-		invalidAreaSize = size;
-	}
-	else
-	{
-		Vector toPosition = position + size;
-		Vector currentToPosition = invalidAreaPosition + invalidAreaSize;
-
-		if (position.x < invalidAreaPosition.x)
-		{
-			if (position.x < 0)
-				invalidAreaPosition.x = 0;
-			else
-				invalidAreaPosition.x = position.x;
-		}
-
-		if (position.y < invalidAreaPosition.y)
-		{
-			if (position.y < 0)
-				invalidAreaPosition.y = 0;
-			else
-				invalidAreaPosition.y = position.y;
-		}
-
-		if (toPosition.x > currentToPosition.x)
-		{
-			if (toPosition.x > componentSize.x)
-				currentToPosition.x = componentSize.x;
-			else
-				currentToPosition.x = toPosition.x;
-
-		}
-
-		if (toPosition.y > currentToPosition.y)
-		{
-			if (toPosition.y > componentSize.y)
-				currentToPosition.y = componentSize.y;
-			else
-				currentToPosition.y = toPosition.y;
-		}
-
-		invalidAreaSize = currentToPosition - invalidAreaPosition;
-	}
-
-	if (invalidAreaSize.y == 1)
-		invalidAreaSize.y = 1;
-
-	#ifdef GL_DEBUG_INVALIDATIONS
-		LOGPRINTF5(LOG_DEBUG, "Invalidation on %s at (%d,%d)-(%d,%d)", (const char *) toString(),
-			position.x, position.y, position.x + size.x - 1, position.y + size.y - 1);
-
-		for (int i=0; i<redrawRegions.GetCount();)
-		{
-			RedrawRegion * region = redrawRegions.Get(i);
-			if (region->position == position && region->size == size)
-				redrawRegions.Delete(i);
-			else
-				i++;
-		}
+	valid = false;
+	invalidRegion.add(position, size);
+}
 
-		RedrawRegion * region;
-		if ((region = new RedrawRegion(position, size)) == NULL)
-			throw EOUTOFMEMORY;
-		redrawRegions.Append(region);
-	#endif
+bool CachableComponent::isAutomaticCaching()
+{
+	ASSERTION_COBJECT(this);
+	return automaticCaching;
 }
 
 bool CachableComponent::isCaching()
@@ -223,6 +244,15 @@ bool CachableComponent::isCaching()
 	return caching;
 }
 
+bool CachableComponent::isOpaque()
+{
+	ASSERTION_COBJECT(this);
+
+	// Running effects may move, resize, or fade the component any time
+	return caching && !withAlphaChannel && GL_ALPHA_OF(getModulationColor()) == 255
+		&& getEffects().IsEmpty();
+}
+
 bool CachableComponent::isValid()
 {
 	ASSERTION_COBJECT(this);
@@ -249,15 +279,84 @@ void CachableComponent::releaseCache()
 
 	if (surface != NULL)
 	{
-		Desktop::getInstance()->getPlatformAdapter()->destroyRenderTarget(surface);
+		Desktop::getInstance()->getPlatformAdapter()->releaseRenderTarget(surface);
 		surface = NULL;
 	}
 }
 
+bool CachableComponent::scrollArea(Vector position, Vector size, Vector delta)
+{
+	ASSERTION_COBJECT(this);
+
+	if (!caching)
+		return Component::scrollArea(position, size, delta);
+
+	// The surface must hold valid content for the whole area, and the shift must retain some of it
+	if (surface == NULL || surface->getSize() != getSize() || invalidRegion.intersects(position, size))
+		return false;
+	if (!(position >= Vector()) || !(position + size <= getSize()))
+		return false;
+	Vector distance = delta.absolute();
+	if (!(distance < size))
+		return false;
+
+	Desktop::getInstance()->getPlatformAdapter()->scrollImageArea(surface, position, size, delta);
+
+	// The shifted part is valid on the surface, but must be recomposed by the ancestors
+	Component::invalidateArea(position, size);
+
+	// Redraw the strips exposed by the shift only
+	if (delta.y > 0)
+		invalidateArea(position, Vector(size.x, delta.y));
+	else if (delta.y < 0)
+		invalidateArea(Vector(position.x, position.y + size.y + delta.y), Vector(size.x, -delta.y));
+	if (delta.x > 0)
+		invalidateArea(position, Vector(delta.x, size.y));
+	else if (delta.x < 0)
+		invalidateArea(Vector(position.x + size.x + delta.x, position.y), Vector(-delta.x, size.y));
+
+	return true;
+}
+
+void CachableComponent::setAutomaticCaching(bool automaticCaching)
+{
+	ASSERTION_COBJECT(this);
+
+	if (this->automaticCaching == automaticCaching)
+		return;
+
+	this->automaticCaching = automaticCaching;
+
+	// Start with a new sliding window
+	for (int sampleNo = 0; sampleNo < GL_CACHING_SAMPLE_COUNT; sampleNo++)
+		cachingSamples[sampleNo].reset();
+	cachingSamplesTaken = 0;
+	cachingSampleStartTime = Desktop::getInstance()->getPlatformAdapter()->getTime();
+
+	if (!automaticCaching)
+		setCachingBytes(0);
+}
+
 void CachableComponent::setCaching(bool caching)
 {
 	ASSERTION_COBJECT(this);
 
+	setAutomaticCaching(false);
+	setCachingInternal(caching);
+}
+
+void CachableComponent::setCachingBytes(long cachingBytes)
+{
+	ASSERTION_COBJECT(this);
+
+	Desktop::getInstance()->automaticCachingBytes += cachingBytes - this->cachingBytes;
+	this->cachingBytes = cachingBytes;
+}
+
+void CachableComponent::setCachingInternal(bool caching)
+{
+	ASSERTION_COBJECT(this);
+
 	if (this->caching != caching)
 	{
 		this->caching = caching;
@@ -300,6 +399,72 @@ void CachableComponent::setWithAlphaChannel(bool withAlphaChannel)
 	}
 }
 
+void CachableComponent::updateAutomaticCaching()
+{
+	ASSERTION_COBJECT(this);
+
+	Desktop * desktop = Desktop::getInstance();
+	Vector size = getSize();
+	long bytes = (long) size.x * (long) size.y * 4;
+	long budget = (long) desktop->GetAutomaticCachingBudget() * 1024;
+	long otherBytes = desktop->getAutomaticCachingBytes() - cachingBytes;
+
+	// Translucent components and running effects require a surface to blend
+	bool required = GL_ALPHA_OF(getModulationColor()) < 255 || !getEffects().IsEmpty();
+
+	bool cache;
+	if (required)
+		cache = true;
+	else if (getCachingInvalidationRate() > CACHING_MAXIMUM_INVALIDATION_RATE
+		|| otherBytes + bytes > budget)
+		cache = false;
+	else
+	{
+		// Turn off at half the saved time only, to prevent flickering decisions
+		unsigned long savedTime = getCachingSavedTime();
+		cache = caching ? savedTime * 2 >= CACHING_MINIMUM_SAVED_TIME
+			: savedTime >= CACHING_MINIMUM_SAVED_TIME;
+	}
+
+	if (cache != caching)
+	{
+		LOGPRINTF3(LOG_DEBUG, "Automatically turning caching %s for %s (saved time %lu ms)",
+			cache ? "on" : "off", (const char *) toString(), getCachingSavedTime());
+	}
+
+	setCachingBytes(cache ? bytes : 0);
+	setCachingInternal(cache);
+}
+
+void CachableComponent::updateCachingSamples()
+{
+	ASSERTION_COBJECT(this);
+
+	unsigned long time = Desktop::getInstance()->getPlatformAdapter()->getTime();
+	if (time - cachingSampleStartTime < CACHING_SAMPLE_LENGTH)
+		return;
+
+	// Decide as soon as the sliding window is complete
+	if (cachingSamplesTaken + 1 >= GL_CACHING_SAMPLE_COUNT)
+		updateAutomaticCaching();
+
+	// Skip entire samples if the component has not been drawn for a while
+	unsigned long elapsedSamples = (time - cachingSampleStartTime) / CACHING_SAMPLE_LENGTH;
+	cachingSampleStartTime += elapsedSamples * CACHING_SAMPLE_LENGTH;
+	if (elapsedSamples > GL_CACHING_SAMPLE_COUNT)
+		elapsedSamples = GL_CACHING_SAMPLE_COUNT;
+
+	for (; elapsedSamples > 0; elapsedSamples--)
+	{
+		for (int sampleNo = GL_CACHING_SAMPLE_COUNT - 1; sampleNo > 0; sampleNo--)
+			cachingSamples[sampleNo] = cachingSamples[sampleNo - 1];
+		cachingSamples[0].reset();
+
+		if (cachingSamplesTaken < GL_CACHING_SAMPLE_COUNT)
+			cachingSamplesTaken++;
+	}
+}
+
 String CachableComponent::toString()
 {
 	ASSERTION_COBJECT(this);
@@ -311,13 +476,30 @@ String CachableComponent::toString()
 }
 
 
-CachableComponent::RedrawRegion::RedrawRegion(const Vector & position, const Vector & size)
+CachableComponent::CachingSample::CachingSample()
+{
+	ASSERTION_COBJECT(this);
+	reset();
+}
+
+void CachableComponent::CachingSample::operator =(const CachingSample & sample)
+{
+	ASSERTION_COBJECT(this);
+
+	contentDraws = sample.contentDraws;
+	contentDrawTime = sample.contentDrawTime;
+	drawnFrames = sample.drawnFrames;
+	invalidatedFrames = sample.invalidatedFrames;
+}
+
+void CachableComponent::CachingSample::reset()
 {
 	ASSERTION_COBJECT(this);
 
-	this->position = position;
-	this->size = size;
-	time = Desktop::getInstance()->getFrameTime();
+	contentDraws = 0;
+	contentDrawTime = 0;
+	drawnFrames = 0;
+	invalidatedFrames = 0;
 }
 
 
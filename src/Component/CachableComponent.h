@@ -18,26 +18,71 @@ namespace glaziery
 	 * receives invalidate() events when the model changes, or the implementation
 	 * of drawContent() calls invalidate() every time to declare that the content
 	 * must be drawn every frame, because the state does not depend on change events
-	 * or the events cannot be pushed into the application or game.
+	 * or the events cannot be pushed into the application or game.<br>
+	 *
+	 * Instead of deciding about caching manually, the component may use automatic caching.
+	 * It then measures the time for drawing its content and how often it is invalidated,
+	 * over a sliding window of GL_CACHING_SAMPLE_COUNT samples of CACHING_SAMPLE_LENGTH
+	 * milli seconds each. Caching is turned on when it would have saved at least
+	 * CACHING_MINIMUM_SAVED_TIME milli seconds within the window, and the surfaces of all
+	 * automatically caching components fit the desktop's AutomaticCachingBudget.
+	 * It is turned off again when it saves less than half of that, or when the component
+	 * is invalidated almost every frame anyway. Define GL_DEBUG_CACHING to frame
+	 * automatically caching components green (caching) or red (not caching).
 	 * @see Component::invalidate()
+	 * @see setAutomaticCaching()
 	 */
 	class CachableComponent : public Component
 	{
 		private:
 
+			/**
+			 * A sample of the automatic caching measurements.
+			 * @see setAutomaticCaching()
+			 */
 			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
-				class RedrawRegion : public CObject
+				class CachingSample : public CObject
 			#else
-				class RedrawRegion
+				class CachingSample
 			#endif
 			{
 				public:
 
-					Vector position;
-					Vector size;
-					unsigned long time;
+					/**
+					 * The number of content drawings, i.e. calls to drawContent().
+					 */
+					int contentDraws;
+
+					/**
+					 * The time spent drawing the content in milli seconds.
+					 */
+					unsigned long contentDrawTime;
+
+					/**
+					 * The number of frames the component has been drawn in.
+					 */
+					int drawnFrames;
+
+					/**
+					 * The number of frames the component has been drawn in while being invalid.
+					 */
+					int invalidatedFrames;
+
+					/**
+					 * Creates a new empty caching sample.
+					 */
+					CachingSample();
+
+					/**
+					 * Sets another sample's measurements into this sample.
+					 * @param sample The sample to be set.
+					 */
+					void operator =(const CachingSample & sample);
 
-					RedrawRegion(const Vector & position, const Vector & size);
+					/**
+					 * Resets the sample to be empty.
+					 */
+					void reset();
 			};
 
 			/**
@@ -72,6 +117,32 @@ namespace glaziery
 
 		private:
 
+			/**
+			 * The maximum percentage of drawn frames the component may be invalid in
+			 * to keep caching on automatically.
+			 * @see setAutomaticCaching()
+			 */
+			static const int CACHING_MAXIMUM_INVALIDATION_RATE;
+
+			/**
+			 * The minimum time in milli seconds caching must save within the sliding window
+			 * to turn caching on automatically.
+			 * @see setAutomaticCaching()
+			 */
+			static const unsigned long CACHING_MINIMUM_SAVED_TIME;
+
+			/**
+			 * The length of one automatic caching sample in milli seconds.
+			 * @see setAutomaticCaching()
+			 */
+			static const unsigned long CACHING_SAMPLE_LENGTH;
+
+			/**
+			 * Whether the caching is turned on and off automatically. Defaults to false.
+			 * @see setAutomaticCaching()
+			 */
+			bool automaticCaching;
+
 			/**
 			 * Whether to cache the content of this component. Defaults to true.
 			 * @warning Disabling the caching also results in graphical errors, because
@@ -79,6 +150,29 @@ namespace glaziery
 			 */
 			bool caching;
 
+			/**
+			 * The number of surface bytes accounted for this component in the desktop's
+			 * automatic caching bytes, or 0 if caching has not been turned on automatically.
+			 * @see Desktop::getAutomaticCachingBytes()
+			 */
+			long cachingBytes;
+
+			/**
+			 * The samples of the sliding automatic caching window, the current one first.
+			 * @see setAutomaticCaching()
+			 */
+			CachingSample cachingSamples[GL_CACHING_SAMPLE_COUNT];
+
+			/**
+			 * The number of samples taken since automatic caching has been turned on.
+			 */
+			int cachingSamplesTaken;
+
+			/**
+			 * The start time of the current automatic caching sample.
+			 */
+			unsigned long cachingSampleStartTime;
+
 			/**
 			 * The alpha blending value, defining the grade of transparency
 			 * of this component, if it has focus (is active).
@@ -95,10 +189,6 @@ namespace glaziery
 			 */
 			unsigned char nonFocusAlpha;
 
-			#ifdef GL_DEBUG_INVALIDATIONS
-				ArrayList<RedrawRegion> redrawRegions;
-			#endif
-
 			/**
 			 * The image rendering cache surface.
 			 * This surface is used to render the component to.
@@ -117,8 +207,8 @@ namespace glaziery
 			 * Any change to the component must be followed by a call to invalidate(),
 			 * setting the valid property to false. The next window surface
 			 * rendering then sets this property to true again.
-			 * If valid is false, the invalidAreaPosition and invalidAreaSize attributes
-			 * contain the area to be rerendered.
+			 * If valid is false, the invalidRegion attribute
+			 * contains the areas to be rerendered.
 			 */
 			bool valid;
 
@@ -136,19 +226,40 @@ namespace glaziery
 			 */
 			void onRenderTargetInvalidated(Image * renderTarget);
 
-		protected:
+			/**
+			 * Sets the number of surface bytes accounted for this component
+			 * in the desktop's automatic caching bytes.
+			 * @param cachingBytes The number of bytes.
+			 */
+			void setCachingBytes(long cachingBytes);
+
+			/**
+			 * Turns caching on or off, without affecting automatic caching.
+			 * @param caching Whether to cache the content of this component.
+			 */
+			void setCachingInternal(bool caching);
 
 			/**
-			 * The top-left position, relative to this component's position, of the invalid area,
-			 * if any area is invalid (the valid flag is set).
+			 * Turns caching on or off automatically,
+			 * based on the measurements of the sliding window.
+			 * @see setAutomaticCaching()
 			 */
-			Vector invalidAreaPosition;
+			void updateAutomaticCaching();
+
+			/**
+			 * Checks whether the current automatic caching sample is over, shifts the samples
+			 * accordingly, and updates the caching when the sliding window is complete.
+			 */
+			void updateCachingSamples();
+
+		protected:
 
 			/**
-			 * The top-left position, relative to this component's position, of the invalid area,
-			 * if any area is invalid (the valid flag is set).
+			 * The rectangles, relative to this component's position, to be rerendered,
+			 * if any area is invalid (the valid flag is not set).
+			 * The next drawing redraws each rectangle separately and clears the region.
 			 */
-			Vector invalidAreaSize;
+			Region invalidRegion;
 
 		// Runtime class macros require their own public section.
 		public:
@@ -196,7 +307,7 @@ namespace glaziery
 			 * @see CachableComponent::invalidate()
 			 * @see CachableComponent
 			 */
-			virtual void drawContent(DrawingContext & context) = NULL;
+			virtual void drawContent(DrawingContext & context) = 0;
 
 			/**
 			 * Returns the alpha blending value, defining the grade of transparency
@@ -208,6 +319,23 @@ namespace glaziery
 			 */
 			unsigned char getAlpha();
 
+			/**
+			 * Returns the percentage of drawn frames the component has been invalid in,
+			 * within the sliding window of automatic caching.
+			 * @return The invalidation rate in percent, or 0 if automatic caching is off.
+			 * @see setAutomaticCaching()
+			 */
+			int getCachingInvalidationRate();
+
+			/**
+			 * Returns the time caching saves (or would save) within the sliding window
+			 * of automatic caching, i.e. the average content drawing time multiplied by
+			 * the number of frames the component has been drawn in while being valid.
+			 * @return The saved time in milli seconds, or 0 if automatic caching is off.
+			 * @see setAutomaticCaching()
+			 */
+			unsigned long getCachingSavedTime();
+
 			/**
 			 * Returns the alpha blending value, defining the grade of transparency
 			 * of this component, if it has focus (is active).
@@ -248,6 +376,13 @@ namespace glaziery
 			 */
 			virtual void invalidateArea(Vector position, Vector size);
 
+			/**
+			 * Returns whether the caching is turned on and off automatically.
+			 * @return Whether the caching is automatic.
+			 * @see setAutomaticCaching()
+			 */
+			bool isAutomaticCaching();
+
 			/**
 			 * Returns whether to cache the content of this component. Defaults to true.
 			 * @warning Disabling the caching also results in graphical errors, because
@@ -256,6 +391,17 @@ namespace glaziery
 			 */
 			bool isCaching();
 
+			/**
+			 * Returns whether the component covers its entire rectangle with opaque pixels,
+			 * so that anything behind it need not be drawn. This is the case if the component
+			 * caches on an image without alpha channel, is not modulated with any transparency,
+			 * and no effects are running for it. Subclasses knowing better (e.g. using an alpha channel
+			 * but always drawing an opaque background) may override this method.
+			 * @return Whether the component is opaque.
+			 * @see Desktop::drawComposition()
+			 */
+			virtual bool isOpaque();
+
 			/**
 			 * Returns whether the component surface represents the current state
 			 * of the component, including the client area.
@@ -279,14 +425,45 @@ namespace glaziery
 			 * Invalidates and releases this component's internal caches (e.g. drawing caches).
 			 * This method should be called when it is unlikely that the cache will be needed
 			 * in the near future, to release system resources (e.g. when the component gets invisible).
+			 * The surface is returned to the platform adapter's render target pool, so showing
+			 * the component again usually reuses it without allocating.
+			 * @see PlatformAdapter::releaseRenderTarget()
 			 */
 			virtual void releaseCache();
 
+			/**
+			 * Shifts the already rendered content of an area of this component by a given delta.
+			 * If this component caches, the area is shifted on the surface, and only the exposed
+			 * strips are invalidated. This requires the area to be valid on the surface.
+			 * Otherwise, the request is delegated to the parent.
+			 * @param position The top-left position of the area, relative to this component.
+			 * @param size The size of the area.
+			 * @param delta The number of pixels to shift the content by
+			 * (positive values shift right resp. down).
+			 * @return Whether the content has been shifted. If not, the caller must invalidate the area.
+			 * @see PlatformAdapter::scrollImageArea()
+			 */
+			virtual bool scrollArea(Vector position, Vector size, Vector delta);
+
+			/**
+			 * Sets whether the caching is turned on and off automatically, depending on the
+			 * measured content drawing times and invalidation frequency. Defaults to false.
+			 * See the class comment for details. Components with an alpha value
+			 * below 255 or running effects always cache while automatic.
+			 * @param automaticCaching Whether the caching is automatic.
+			 * @see getCachingInvalidationRate()
+			 * @see getCachingSavedTime()
+			 * @see Desktop::getAutomaticCachingBytes()
+			 */
+			void setAutomaticCaching(bool automaticCaching);
+
 			/**
 			 * Sets whether to cache the content of this component. Defaults to true.
+			 * This turns automatic caching off.
 			 * @warning Disabling the caching also results in graphical errors, because
 			 * there is no image to create alpha blending effects on.
 			 * @param caching Whether to cache the content of this component.
+			 * @see setAutomaticCaching()
 			 */
 			void setCaching(bool caching);
 
@@ -13,6 +13,7 @@ Component::Component()
 {
 	ASSERTION_COBJECT(this);
 
+	displayList = NULL;
 	disposed = false;
 	maximumSize = Vector(4096, 4096);
 	minimumSize = Vector(0, 0);
@@ -32,6 +33,12 @@ Component::~Component()
 		effect->onComponentDestroying();
 		effect->release();
 	}
+
+	if (displayList != NULL) {delete displayList; displayList = NULL;}
+
+	Desktop * desktop = Desktop::getInstance();
+	if (desktop != NULL)
+		desktop->getInvalidationTracker().onComponentDestroyed(this);
 }
 
 void Component::addEffect(ComponentEffect * effect)
@@ -109,6 +116,45 @@ void Component::destroy()
 	onDestroying();
 }
 
+void Component::discardDisplayList()
+{
+	ASSERTION_COBJECT(this);
+
+	if (displayList != NULL)
+		displayList->clear();
+}
+
+void Component::drawRecorded(DrawingContext & context)
+{
+	ASSERTION_COBJECT(this);
+
+	if (displayList == NULL)
+	{
+		draw(context);
+		return;
+	}
+
+	if (displayList->isRecorded())
+	{
+		displayList->replay(context);
+		return;
+	}
+
+	// Record only complete drawings, the next replay may use a larger clipping area
+	Vector drawingOffset = context.getDrawingOffset();
+	if (!(context.getClippingOffset() <= drawingOffset)
+		|| !(drawingOffset + size <= context.getClippingOffset() + context.getClippingSize()))
+	{
+		draw(context);
+		return;
+	}
+
+	displayList->startRecording(context);
+	DrawingContext recordingContext(context, displayList);
+	draw(recordingContext);
+	displayList->stopRecording();
+}
+
 void Component::executeDeferrals()
 {
 	ASSERTION_COBJECT(this);
@@ -243,7 +289,15 @@ void Component::hide()
 void Component::hideDeferred()
 {
 	ASSERTION_COBJECT(this);
-	setVisibleDeferred(false);
+
+	Mutex * mutex = Desktop::getInstance()->getDeferralMutex();
+	if (!mutex->lock())
+		return;
+
+	visibleDeferred = false;
+	Desktop::getInstance()->deferObject(this);
+
+	mutex->release();
 }
 
 #if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
@@ -260,9 +314,21 @@ void Component::invalidateArea(Vector position, Vector size)
 {
 	ASSERTION_COBJECT(this);
 
+	GLAZIERY_INVALIDATIONSCOPE(this, size)
+	Desktop * desktop = Desktop::getInstance();
+
+	discardDisplayList();
+
 	Component * parent = getParent();
-	if (parent != NULL && parent->isChildVisible(this))
-		parent->invalidateArea(getPosition() + position, size);
+	if (parent != NULL)
+	{
+		if (parent->isChildVisible(this))
+			parent->invalidateArea(getPosition() + position, size);
+	}
+
+	// Top-level components (windows and popups) damage the desktop
+	else if (isVisible())
+		desktop->invalidateArea(getPosition() + position, size);
 }
 
 bool Component::isChildVisible(Component * child)
@@ -277,6 +343,12 @@ bool Component::isDisposed()
 	return disposed;
 }
 
+bool Component::isRecording()
+{
+	ASSERTION_COBJECT(this);
+	return displayList != NULL;
+}
+
 bool Component::isVisible()
 {
 	ASSERTION_COBJECT(this);
@@ -308,6 +380,7 @@ void Component::moveComponent(Component * relatedComponent, Vector position)
 bool Component::moveInternal(Vector position, bool notifyParent)
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_INVALIDATIONCAUSE(CAUSE_MOVE)
 
 	if (this->position == position)
 		return false;
@@ -561,6 +634,7 @@ bool Component::onEnter(bool option1, bool option2)
 void Component::onGotFocus(bool byParent)
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_INVALIDATIONCAUSE(CAUSE_FOCUS)
 
 	// First notify listeners of this component about focus gain
 	int listenersCount = listeners.GetCount();
@@ -612,6 +686,7 @@ bool Component::onKeyStroke(int keyCode, bool option1, bool option2)
 void Component::onLostFocus()
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_INVALIDATIONCAUSE(CAUSE_FOCUS)
 
 	// First notify child about focus loss
 	Component * focusChild = getFocusChild();
@@ -839,6 +914,24 @@ bool Component::resizeToMinimum()
 	return resizeInternal(minimumSize, true);
 }
 
+bool Component::scrollArea(Vector position, Vector size, Vector delta)
+{
+	ASSERTION_COBJECT(this);
+
+	// The recorded drawing shows the content before scrolling
+	discardDisplayList();
+
+	// Content clipped by this component cannot be shifted on an ancestor's surface
+	if (!(position >= Vector()) || !(position + size <= getSize()))
+		return false;
+
+	Component * parent = getParent();
+	if (parent == NULL || !parent->isChildVisible(this))
+		return false;
+
+	return parent->scrollArea(getPosition() + position, size, delta);
+}
+
 void Component::resizeComponent(Component * relatedComponent, Vector size)
 {
 	ASSERTION_COBJECT(this);
@@ -848,6 +941,7 @@ void Component::resizeComponent(Component * relatedComponent, Vector size)
 bool Component::resizeInternal(Vector size, bool notifyParent)
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_INVALIDATIONCAUSE(CAUSE_RESIZE)
 
 	size = Vector(size.x > maximumSize.x ? maximumSize.x : size.x,
 		size.y > maximumSize.y ? maximumSize.y : size.y);
@@ -969,6 +1063,22 @@ void Component::setMinimumSizeInternal(Vector minimumSize, bool notifyParent)
 			size.y < minimumSize.y ? minimumSize.y : size.y));
 }
 
+void Component::setRecording(bool recording)
+{
+	ASSERTION_COBJECT(this);
+
+	if (recording && displayList == NULL)
+	{
+		if ((displayList = new DisplayList) == NULL)
+			throw EOUTOFMEMORY;
+	}
+	else if (!recording && displayList != NULL)
+	{
+		delete displayList;
+		displayList = NULL;
+	}
+}
+
 void Component::setSkinData(SkinData * skinData)
 {
 	ASSERTION_COBJECT(this);
@@ -1042,7 +1152,7 @@ void Component::showDeferred()
 	if (!mutex->lock())
 		return;
 
-	visibleDeferred = visible;
+	visibleDeferred = true;
 	Desktop::getInstance()->deferObject(this);
 
 	mutex->release();
@@ -1062,7 +1172,6 @@ void Component::tutorialClick(PointerEffect::ButtonEffect buttonEffect, bool opt
 {
 	ASSERTION_COBJECT(this);
 
-	Desktop * desktop = Desktop::getInstance();
 	if (!Desktop::getInstance()->isTutorialMode())
 		throw EILLEGALSTATE("Use the tutorial methods in Tutorial::run() implementations only");
 
@@ -101,6 +101,13 @@ namespace glaziery
 
 		private:
 
+			/**
+			 * The display list recording the component's drawing,
+			 * or NULL if the component does not record its drawing.
+			 * @see setRecording()
+			 */
+			DisplayList * displayList;
+
 			/**
 			 * Whether the component has being destroyed by the destroy() method.
 			 * Is has been placed into the list of disposable components and
@@ -183,6 +190,15 @@ namespace glaziery
 			 */
 			void deleteChild(Component * child);
 
+			/**
+			 * Discards the recorded display list, if any, so that the component
+			 * is drawn by the skin again and re-recorded next time.
+			 * Component::invalidateArea() calls this method. Subclasses that override
+			 * invalidateArea() without super-calling must call it themselves.
+			 * @see setRecording()
+			 */
+			void discardDisplayList();
+
 			/**
 			 * Executes all deferred operations in this event target.
 			 * Override, but super-call if you provide any deferred operations.
@@ -424,7 +440,19 @@ namespace glaziery
 			 * if the component is invisible.
 			 * @see Desktop::getSkin()
 			 */
-			virtual void draw(DrawingContext & context) = NULL;
+			virtual void draw(DrawingContext & context) = 0;
+
+			/**
+			 * Draws the component like draw(), but replays the recorded display list instead,
+			 * if the component records its drawing and has been recorded since its last invalidation.
+			 * Otherwise, the component is drawn and recorded, if it is entirely within the clipping area.
+			 * @param context The drawing context that specifies the surface and clipping
+			 * rectangle for the drawing operation.
+			 * @note The caller is responsible for not calling this method
+			 * if the component is invisible.
+			 * @see setRecording()
+			 */
+			void drawRecorded(DrawingContext & context);
 
 			/**
 			 * Returns the absolute (Desktop relative) position of this component.
@@ -554,9 +582,13 @@ namespace glaziery
 			 * Invalidates a part of this component's internal caches (e.g. drawing caches).
 			 * This method should be called whenever its state changes.
 			 * The invalidation is propagated to the parent, if any.
+			 * Top-level components (windows and popups) damage the desktop instead.
+			 * Overrides that do not super-call must count the invalidation themselves,
+			 * using InvalidationTracker::beginInvalidation() and endInvalidation().
 			 * @param position The top-left position of the area to be invalidated,
 			 * relative to this component.
 			 * @param size The size of the area to be invalidated.
+			 * @see Desktop::invalidateArea()
 			 */
 			virtual void invalidateArea(Vector position, Vector size);
 
@@ -580,6 +612,14 @@ namespace glaziery
 			 */
 			bool isDisposed();
 
+			/**
+			 * Returns whether the component records its drawing into a display list
+			 * and replays it until the component is invalidated. Defaults to false.
+			 * @return Whether the component records its drawing.
+			 * @see setRecording()
+			 */
+			bool isRecording();
+
 			/**
 			 * Returns whether the component is visible (not hidden).
 			 * @return Whether the component is visible.
@@ -973,6 +1013,23 @@ namespace glaziery
 			 */
 			bool resizeToMinimum();
 
+			/**
+			 * Shifts the already rendered content of an area of this component by a given delta,
+			 * instead of redrawing it. This is possible only if the nearest caching ancestor
+			 * retains the area on its surface, and the area is entirely visible up to it.
+			 * The ancestor then redraws the strips exposed by the shift only.
+			 * The default implementation delegates to the parent.
+			 * @param position The top-left position of the area, relative to this component
+			 * (using the same coordinates as invalidateArea()).
+			 * @param size The size of the area.
+			 * @param delta The number of pixels to shift the content by
+			 * (positive values shift right resp. down).
+			 * @return Whether the content has been shifted. If not, the caller must invalidate the area.
+			 * @see invalidateArea()
+			 * @see CachableComponent::scrollArea()
+			 */
+			virtual bool scrollArea(Vector position, Vector size, Vector delta);
+
 			/**
 			 * Sets the maximum size of the component. Resize operation are limited by this value.
 			 * If the current size is bigger than the maximum size, the component is resized automatically.
@@ -987,6 +1044,20 @@ namespace glaziery
 			 */
 			void setMinimumSize(Vector minimumSize);
 
+			/**
+			 * Sets whether the component records its drawing into a display list
+			 * and replays it until the component is invalidated. Defaults to false.
+			 * Replaying skips the skin code, e.g. layouting and measuring texts,
+			 * so enable recording for components that are drawn often but change seldom,
+			 * especially if they are not part of a cached component.
+			 * @param recording Whether the component records its drawing.
+			 * @note The drawing of the component must depend on properties only
+			 * that invalidate the component when changed (as required for caching, too).
+			 * @see drawRecorded()
+			 * @see DisplayList
+			 */
+			void setRecording(bool recording);
+
 			/**
 			 * Sets the skin specific settings and other skin data.
 			 * The skin data is managed by the skin. If you want to implement a skin
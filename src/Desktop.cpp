@@ -15,6 +15,7 @@ const int Desktop::DEFAULT_MAXIMUM_FRAME_TIME = 500;
 Desktop * Desktop::singleton = NULL;
 
 // Configurable properties
+CF_INT_IMPL(Desktop, AutomaticCachingBudget)
 CF_STRINGLIST_IMPL(Desktop, OnceActions)
 
 Desktop::Desktop(PlatformAdapter * platformAdapter, Skin * skin,
@@ -31,6 +32,9 @@ Desktop::Desktop(PlatformAdapter * platformAdapter, Skin * skin,
 	activeScene = NULL;
 	applicationCloseReceived = false;
 	this->applicationName = applicationName;
+	automaticCachingBytes = 0;
+	AutomaticCachingBudget = 8192;
+	damageTracking = false;
 	deferralMutex = NULL;
 	doubleClickDelay = 300;
 	draggingSurrogate = NULL;
@@ -43,9 +47,12 @@ Desktop::Desktop(PlatformAdapter * platformAdapter, Skin * skin,
 	hourGlassCount = 0;
 	hoverFired = true;
 	hoverTime = 0;
+	idleWaiting = false;
+	idleWaitTime = 0;
 	initialized = false;
 	initTime = 0;
 	lastDrawTime = 0;
+	lastPointerType = NULL;
 	lastRunOnceTime = 0;
 	lastTime = 0;
 	this->manufacturer = manufacturer;
@@ -453,10 +460,86 @@ void Desktop::clearClipboard()
 	platformAdapter->clearClipboard();
 }
 
+void Desktop::collectCompositionDamage()
+{
+	ASSERTION_COBJECT(this);
+
+	// Compare the visible windows and popups in back-to-front order
+	// with the ones of the last frame, and damage both areas of any difference
+	int composedCount = 0;
+	int windowsCount = windows.GetCount();
+	int popupsCount = popups.GetCount();
+	for (int i=0; i<windowsCount + popupsCount; i++)
+	{
+		CachableComponent * component = i < windowsCount
+			? (CachableComponent *) windows.Get(i) : (CachableComponent *) popups.Get(i - windowsCount);
+		if (!component->isVisible())
+			continue;
+
+		ComposedComponent * composed;
+		if (composedCount < composedComponents.GetCount())
+			composed = composedComponents.Get(composedCount);
+		else
+		{
+			if ((composed = new ComposedComponent) == NULL)
+				throw EOUTOFMEMORY;
+			composedComponents.Append(composed);
+		}
+		composedCount++;
+
+		Vector position = component->getPosition();
+		Vector size = component->getSize();
+		unsigned long modulationColor = component->getModulationColor();
+		if (composed->component != component || composed->position != position
+			|| composed->size != size || composed->modulationColor != modulationColor)
+		{
+			if (composed->component != NULL)
+				invalidateArea(composed->position, composed->size);
+			invalidateArea(position, size);
+
+			composed->component = component;
+			composed->modulationColor = modulationColor;
+			composed->position = position;
+			composed->size = size;
+		}
+	}
+
+	// Damage the areas of windows and popups not visible anymore
+	while (composedComponents.GetCount() > composedCount)
+	{
+		ComposedComponent * composed = composedComponents.GetLast();
+		invalidateArea(composed->position, composed->size);
+		composedComponents.DeleteLast();
+	}
+
+	// Damage the old and new pointer areas, if the pointer has changed
+	PointerType * currentPointerType = isPointerCurrentlyShown() ? pointerType : NULL;
+	Vector pointerPosition = platformAdapter->getMouseHandler()->getPointerPosition();
+	if (currentPointerType != lastPointerType
+		|| (currentPointerType != NULL && pointerPosition != lastPointerPosition))
+	{
+		invalidateArea(lastPointerAreaPosition, lastPointerAreaSize);
+
+		lastPointerAreaPosition = pointerPosition;
+		lastPointerAreaSize = Vector();
+		if (currentPointerType != NULL)
+		{
+			if (currentPointerType->getDrawingArea(pointerPosition, lastPointerAreaPosition, lastPointerAreaSize))
+				invalidateArea(lastPointerAreaPosition, lastPointerAreaSize);
+			else
+				invalidate();
+		}
+
+		lastPointerPosition = pointerPosition;
+		lastPointerType = currentPointerType;
+	}
+}
+
 void Desktop::Configure(ConfigSection * section, bool write)
 {
 	ASSERTION_COBJECT(this);
 
+	section->Configure("AutomaticCachingBudget", AutomaticCachingBudget, write, 8192);
 	section->Configure("InputManager", inputManager, write);
 	section->Configure("OnceActions", OnceActions, write);
 	section->Configure("PlatformAdapter", platformAdapter, write);
@@ -522,6 +605,9 @@ void Desktop::deferObject(EventTarget * object)
 	deferredObjects.Append(object);
 
 	deferralMutex->release();
+
+	// Let an idle waiting main thread execute the deferral now
+	platformAdapter->wakeUp();
 }
 
 void Desktop::destroyInstance()
@@ -545,43 +631,141 @@ void Desktop::destroyInstance()
 void Desktop::draw()
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_PROFILERZONE("Desktop::draw")
 
 	unsigned long start = platformAdapter->getTime();
 
 	DrawingContext context(this);
 
+	if (!damageTracking)
+		drawComposition(context);
+	else
+	{
+		// Effects and drag-drop surrogates may draw anywhere, so draw entire frames while they run
+		collectCompositionDamage();
+		if (!effects.IsEmpty() || draggingSurrogate != NULL)
+			invalidate();
+
+		if (invalidationTracker.isOverlayShown())
+			invalidate();
+		else if (profiler.isOverlayShown())
+			invalidateArea(profiler.getOverlayPosition(), profiler.getOverlaySize());
+
+		// Skip the frame entirely, if nothing has changed since the last one
+		if (damagedRegion.isEmpty())
+		{
+			lastDrawTime = platformAdapter->getTime() - start;
+			return;
+		}
+
+		// Take over the damage before drawing, so that components invalidating
+		// while drawing are redrawn next frame
+		Region region = damagedRegion;
+		damagedRegion.clear();
+
+		// Recompose the damaged rectangles only, if the back buffer still contains the last frame
+		if (platformAdapter->isBackBufferRetained())
+			for (int i=0; i<region.getRectangleCount(); i++)
+			{
+				Vector position = region.getRectanglePosition(i);
+				DrawingContext rectangleContext(DrawingContext(context, position,
+					region.getRectangleSize(i)), -position);
+				drawComposition(rectangleContext);
+			}
+		else
+			drawComposition(context);
+	}
+
+	// Finally, draw the invalidation heat map and the profiler overlay, if shown
+	invalidationTracker.drawOverlay();
+	profiler.drawOverlay();
+
+	// Show the frame
+	{
+		GLAZIERY_PROFILERZONE("PlatformAdapter::showFrame")
+		Profiler::Phase phase = profiler.setPhase(Profiler::PHASE_PRESENT);
+		platformAdapter->showFrame();
+		profiler.setPhase(phase);
+	}
+
+	unsigned long end = platformAdapter->getTime();
+	lastDrawTime = end - start;
+}
+
+void Desktop::drawComposition(DrawingContext & context)
+{
+	ASSERTION_COBJECT(this);
+
 	// Let the skin draw the desktop background
-	skin->drawDesktop(context);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawDesktop")
+		skin->drawDesktop(context);
+	}
 
 	// Then let the scene draw it, too
 	if (activeScene != NULL)
+	{
+		GLAZIERY_PROFILERZONE("Scene::renderBackground")
 		activeScene->renderBackground(context);
+	}
 
-	// Now draw regular windows in back-to-front order
+	// Now draw regular windows and then popup windows in back-to-front order.
+	// Skip the parts covered by opaque windows and popups above (occlusion culling).
 	int windowsCount = windows.GetCount();
+	int componentsCount = windowsCount + popups.GetCount();
 	int i;
-	for (i=0; i<windowsCount; i++)
+	for (i=0; i<componentsCount; i++)
 	{
-		Window * window = windows.Get(i);
-		if (window->isVisible())
-			window->draw(DrawingContext(context, window));
-	}
+		CachableComponent * component = i < windowsCount
+			? (CachableComponent *) windows.Get(i) : (CachableComponent *) popups.Get(i - windowsCount);
+		if (!component->isVisible() || !context.isInClippingArea(component->getPosition(),
+			component->getPosition() + component->getSize() - Vector(1, 1)))
+			continue;
 
-	// Now draw popup windows in back-to-front order
-	int popupsCount = popups.GetCount();
-	for (i=0; i<popupsCount; i++)
-	{
-		Popup * popup = popups.Get(i);
-		if (popup->isVisible())
-			popup->draw(DrawingContext(context, popup));
+		Region visibleRegion;
+		visibleRegion.add(component->getPosition(), component->getSize());
+		for (int j=i+1; j<componentsCount && !visibleRegion.isEmpty(); j++)
+		{
+			CachableComponent * coveringComponent = j < windowsCount
+				? (CachableComponent *) windows.Get(j) : (CachableComponent *) popups.Get(j - windowsCount);
+			if (coveringComponent->isVisible() && coveringComponent->isOpaque())
+				visibleRegion.subtract(coveringComponent->getPosition(), coveringComponent->getSize());
+		}
+
+		// Caching components blit their surface, so they are drawn per visible rectangle.
+		// Others redraw their whole content per call, so they are drawn once,
+		// clipped to the bounds of the visible region.
+		if (component->isCaching())
+			for (int k=0; k<visibleRegion.getRectangleCount(); k++)
+			{
+				Vector position = visibleRegion.getRectanglePosition(k);
+				DrawingContext componentContext(DrawingContext(DrawingContext(context, position,
+					visibleRegion.getRectangleSize(k)), -position), component);
+				component->draw(componentContext);
+			}
+		else if (!visibleRegion.isEmpty())
+		{
+			Vector position;
+			Vector size;
+			visibleRegion.getBounds(position, size);
+			DrawingContext componentContext(DrawingContext(DrawingContext(context, position, size),
+				-position), component);
+			component->draw(componentContext);
+		}
 	}
 
 	// Let the scene draw the desktop foreground
 	if (activeScene != NULL)
+	{
+		GLAZIERY_PROFILERZONE("Scene::renderForeground")
 		activeScene->renderForeground(context);
+	}
 
 	// Draw the splash text/image
-	skin->drawSplash(context);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawSplash")
+		skin->drawSplash(context);
+	}
 
 	// Draw any effects
 	int effectCount = effects.GetCount();
@@ -595,21 +779,6 @@ void Desktop::draw()
 	// Draw the pointer
 	if (isPointerCurrentlyShown() && pointerType != NULL)
 		pointerType->draw(context, platformAdapter->getMouseHandler()->getPointerPosition());
-
-	// Finally, draw the CPU profile, if active
-	#ifdef GL_DEBUG_CPUPROFILER
-		profiler.setUsageType(CPUProfiler::OTHER);
-		profiler.drawProfile();
-	#endif
-
-	// Show the frame
-	#ifdef GL_DEBUG_CPUPROFILER
-		profiler.setUsageType(CPUProfiler::IDLE);
-	#endif
-	platformAdapter->showFrame();
-
-	unsigned long end = platformAdapter->getTime();
-	lastDrawTime = end - start;
 }
 
 void Desktop::end()
@@ -621,6 +790,7 @@ void Desktop::end()
 void Desktop::executeDeferrals()
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_PROFILERZONE("Desktop::executeDeferrals")
 
 	if (!deferralMutex->lock(100))
 		return;
@@ -638,6 +808,7 @@ void Desktop::executeDeferrals()
 void Desktop::executeEffects()
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_PROFILERZONE("Desktop::executeEffects")
 
 	DrawingContext context(this);
 
@@ -718,6 +889,12 @@ const String & Desktop::getApplicationName()
 	return applicationName;
 }
 
+long Desktop::getAutomaticCachingBytes()
+{
+	ASSERTION_COBJECT(this);
+	return automaticCachingBytes;
+}
+
 String Desktop::getClipboardText()
 {
 	ASSERTION_COBJECT(this);
@@ -881,6 +1058,12 @@ Desktop * Desktop::getInstance()
 	return singleton;
 }
 
+InvalidationTracker & Desktop::getInvalidationTracker()
+{
+	ASSERTION_COBJECT(this);
+	return invalidationTracker;
+}
+
 unsigned long Desktop::getLastDrawTime()
 {
 	ASSERTION_COBJECT(this);
@@ -917,6 +1100,48 @@ unsigned long Desktop::getMinimumFrameDuration()
 	return minimumFrameDuration;
 }
 
+long Desktop::getNextFrameDelay()
+{
+	ASSERTION_COBJECT(this);
+
+	// Anything pending or continuously changing needs the next frame
+	if (ending || !damageTracking || isDamaged() || !events.IsEmpty()
+		|| !deferredObjects.IsEmpty() || !disposableComponents.IsEmpty()
+		|| draggingSurrogate != NULL || primaryPressTarget != NULL)
+		return 0;
+
+	long nextFrameDelay = -1;
+	if (!hoverFired)
+	{
+		long hoverDelay = (long) (hoverTime + 600 - frameTime);
+		nextFrameDelay = hoverDelay > 0 ? hoverDelay : 0;
+	}
+
+	for (int i=0; i<effects.GetCount() && nextFrameDelay != 0; i++)
+	{
+		Effect * effect = effects.Get(i);
+		long effectDelay = effect->isCanceled() ? 0 : effect->getNextFrameDelay();
+		if (effectDelay >= 0 && (nextFrameDelay < 0 || effectDelay < nextFrameDelay))
+			nextFrameDelay = effectDelay;
+	}
+
+	if (activeScene != NULL && nextFrameDelay != 0)
+	{
+		long sceneDelay = activeScene->getNextFrameDelay();
+		if (sceneDelay >= 0 && (nextFrameDelay < 0 || sceneDelay < nextFrameDelay))
+			nextFrameDelay = sceneDelay;
+	}
+
+	if (nextFrameDelay != 0)
+	{
+		long skinDelay = skin->getNextFrameDelay();
+		if (skinDelay >= 0 && (nextFrameDelay < 0 || skinDelay < nextFrameDelay))
+			nextFrameDelay = skinDelay;
+	}
+
+	return nextFrameDelay;
+}
+
 int Desktop::getOnTopWindowsBoundary()
 {
 	ASSERTION_COBJECT(this);
@@ -965,12 +1190,11 @@ const ArrayList<Popup> & Desktop::getPopups()
 	return popups;
 }
 
-#ifdef GL_DEBUG_CPUPROFILER
-	CPUProfiler & Desktop::getProfiler()
-	{
-		return profiler;
-	}
-#endif
+Profiler & Desktop::getProfiler()
+{
+	ASSERTION_COBJECT(this);
+	return profiler;
+}
 
 Scene * Desktop::getScene(const char * id)
 {
@@ -1130,24 +1354,50 @@ void Desktop::initialize()
 
 	initialized = true;
 
-	// Reset the profiler
-
-	#ifdef GL_DEBUG_CPUPROFILER
-		profiler.reset();
-	#endif
-
 	// Enter initial scene
 
 	LOGPRINTF1(LOG_INFO, "Entering scene '%s'", activeScene->getId());
 	activeScene->onEnter();
 }
 
+void Desktop::invalidate()
+{
+	ASSERTION_COBJECT(this);
+	invalidateArea(Vector(), getSize());
+}
+
+void Desktop::invalidateArea(Vector position, Vector size)
+{
+	ASSERTION_COBJECT(this);
+
+	Vector screenSize = getSize();
+	Vector toPosition = position + size;
+	position.constrain(Vector(0, 0), screenSize);
+	toPosition.constrain(Vector(0, 0), screenSize);
+	if (!(toPosition > position))
+		return;
+
+	damagedRegion.add(position, toPosition - position);
+}
+
 bool Desktop::isApplicationFocused()
 {
 	ASSERTION_COBJECT(this);
 	return platformAdapter->isApplicationFocused();
 }
 
+bool Desktop::isDamaged()
+{
+	ASSERTION_COBJECT(this);
+	return !damagedRegion.isEmpty();
+}
+
+bool Desktop::isDamageTracking()
+{
+	ASSERTION_COBJECT(this);
+	return damageTracking;
+}
+
 bool Desktop::isDragging()
 {
 	ASSERTION_COBJECT(this);
@@ -1172,6 +1422,12 @@ bool Desktop::isFullScreen()
 	return platformAdapter->isFullScreen();
 }
 
+bool Desktop::isIdleWaiting()
+{
+	ASSERTION_COBJECT(this);
+	return idleWaiting;
+}
+
 bool Desktop::isInitialized()
 {
 	ASSERTION_COBJECT(this);
@@ -1316,6 +1572,7 @@ void Desktop::openUrl(const String & url)
 void Desktop::processDisposableComponents()
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_PROFILERZONE("Desktop::processDisposableComponents")
 
 	while (!disposableComponents.IsEmpty())
 	{
@@ -1336,12 +1593,16 @@ void Desktop::processDisposableEffects()
 void Desktop::processEvents()
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_PROFILERZONE("Desktop::processEvents")
 
 	// Process the event queue
 	while (!events.IsEmpty())
 	{
 		InputEvent * event = events.UnlinkFirst();
-		event->execute();
+		{
+			GLAZIERY_PROFILERZONE("InputEvent::execute")
+			event->execute();
+		}
 		delete event;
 	}
 
@@ -1436,76 +1697,61 @@ void Desktop::run()
 	while (!ending)
 	{
 		// First, remove last frame's disposables
-		#ifdef GL_DEBUG_CPUPROFILER
-			profiler.setUsageType(CPUProfiler::OTHER);
-		#endif
+		profiler.setPhase(Profiler::PHASE_OTHER);
 		processDisposableComponents();
 
 		// Update timing and wait if necessary
-		#ifdef GL_DEBUG_CPUPROFILER
-			profiler.setUsageType(CPUProfiler::IDLE);
-		#endif
+		profiler.setPhase(Profiler::PHASE_IDLE);
 		updateTimingAndWait();
 
 		// Now handle platform adapter's operations
-		#ifdef GL_DEBUG_CPUPROFILER
-			profiler.setUsageType(CPUProfiler::OTHER);
-		#endif
-		platformAdapter->update();
+		profiler.setPhase(Profiler::PHASE_INPUT);
+		{
+			GLAZIERY_PROFILERZONE("PlatformAdapter::update")
+			platformAdapter->update();
+		}
 
 		// Perform regular skin operations
-		#ifdef GL_DEBUG_CPUPROFILER
-			profiler.setUsageType(CPUProfiler::OTHER);
-		#endif
-		skin->update();
+		{
+			GLAZIERY_PROFILERZONE("Skin::update")
+			skin->update();
+		}
 
 		// And update the input manager
-		#ifdef GL_DEBUG_CPUPROFILER
-			profiler.setUsageType(CPUProfiler::IO);
-		#endif
-		inputManager.update();
+		{
+			GLAZIERY_PROFILERZONE("InputManager::update")
+			inputManager.update();
+		}
 
 		// Execute pending events now
 		// (issued by the platform adapter's input handlers)
-		#ifdef GL_DEBUG_CPUPROFILER
-			profiler.setUsageType(CPUProfiler::APPLICATION);
-		#endif
+		profiler.setPhase(Profiler::PHASE_EVENTS);
 		processEvents();
 
 		// Update the scene
 		if (activeScene != NULL)
 		{
-			#ifdef GL_DEBUG_CPUPROFILER
-				profiler.setUsageType(CPUProfiler::APPLICATION);
-			#endif
+			GLAZIERY_PROFILERZONE("Scene::update")
 			activeScene->update();
 		}
 
 		// Execute deferred operations
-		#ifdef GL_DEBUG_CPUPROFILER
-			profiler.setUsageType(CPUProfiler::APPLICATION);
-		#endif
+		profiler.setPhase(Profiler::PHASE_DEFERRALS);
 		executeDeferrals();
 
 		// Execute effects
-		#ifdef GL_DEBUG_CPUPROFILER
-			profiler.setUsageType(CPUProfiler::OTHER);
-		#endif
+		profiler.setPhase(Profiler::PHASE_EFFECTS);
 		executeEffects();
 
 		// Finally draw the entire desktop, if the scene is not suspended
-		#ifdef GL_DEBUG_CPUPROFILER
-			profiler.setUsageType(CPUProfiler::GRAPHICS);
-		#endif
+		profiler.setPhase(Profiler::PHASE_DRAW);
 		draw();
-		#ifdef GL_DEBUG_CPUPROFILER
-			profiler.setUsageType(CPUProfiler::OTHER);
-		#endif
 
-		// Calculate frame times
-		#ifdef GL_DEBUG_CPUPROFILER
-			profiler.onFrame();
-		#endif
+		// Calculate frame times and complete the renderer statistics
+		profiler.setPhase(Profiler::PHASE_OTHER);
+		profiler.onFrame();
+		invalidationTracker.onFrame();
+		platformAdapter->snapshotStatistics();
 	}
 
 	// End any running tutorial
@@ -1530,77 +1776,67 @@ void Desktop::runOnce(unsigned long minimumTime)
 	if (!initialized)
 		throw EILLEGALSTATE("Desktop::runOnce(20) is allowed only after (while) calling run()");
 
+	// Continue the caller's phase afterwards, e.g. the events phase of a modal loop
+	Profiler::Phase callerPhase = profiler.getPhase();
+
 	// Execute deferred operations
-	#ifdef GL_DEBUG_CPUPROFILER
-		profiler.setUsageType(CPUProfiler::APPLICATION);
-	#endif
+	profiler.setPhase(Profiler::PHASE_DEFERRALS);
 	executeDeferrals();
 
 	// Execute effects
-	#ifdef GL_DEBUG_CPUPROFILER
-		profiler.setUsageType(CPUProfiler::OTHER);
-	#endif
+	profiler.setPhase(Profiler::PHASE_EFFECTS);
 	executeEffects();
 
 	// Now draw the entire desktop, if the scene is not suspended
-	#ifdef GL_DEBUG_CPUPROFILER
-		profiler.setUsageType(CPUProfiler::GRAPHICS);
-	#endif
+	profiler.setPhase(Profiler::PHASE_DRAW);
 	draw();
-	#ifdef GL_DEBUG_CPUPROFILER
-		profiler.setUsageType(CPUProfiler::OTHER);
-	#endif
 
-	// Calculate frame times
-	#ifdef GL_DEBUG_CPUPROFILER
-		profiler.onFrame();
-	#endif
+	// Calculate frame times and complete the renderer statistics
+	profiler.setPhase(Profiler::PHASE_OTHER);
+	profiler.onFrame();
+	invalidationTracker.onFrame();
+	platformAdapter->snapshotStatistics();
 
 	// Remove disposable components issued above
-	#ifdef GL_DEBUG_CPUPROFILER
-		profiler.setUsageType(CPUProfiler::OTHER);
-	#endif
+	profiler.setPhase(Profiler::PHASE_OTHER);
 	processDisposableComponents();
 
 	// Update timing and wait if necessary
-	#ifdef GL_DEBUG_CPUPROFILER
-		profiler.setUsageType(CPUProfiler::IDLE);
-	#endif
+	profiler.setPhase(Profiler::PHASE_IDLE);
 	updateTimingAndWait();
 
 	// Now handle platform adapter's operations
-	#ifdef GL_DEBUG_CPUPROFILER
-		profiler.setUsageType(CPUProfiler::OTHER);
-	#endif
-	platformAdapter->update();
+	profiler.setPhase(Profiler::PHASE_INPUT);
+	{
+		GLAZIERY_PROFILERZONE("PlatformAdapter::update")
+		platformAdapter->update();
+	}
 
 	// Perform regular skin operations
-	#ifdef GL_DEBUG_CPUPROFILER
-		profiler.setUsageType(CPUProfiler::OTHER);
-	#endif
-	skin->update();
+	{
+		GLAZIERY_PROFILERZONE("Skin::update")
+		skin->update();
+	}
 
 	// And update the input manager
-	#ifdef GL_DEBUG_CPUPROFILER
-		profiler.setUsageType(CPUProfiler::IO);
-	#endif
-	getInputManager().update();
+	{
+		GLAZIERY_PROFILERZONE("InputManager::update")
+		getInputManager().update();
+	}
 
 	// Execute pending events now
 	// (issued by the platform adapter's input handlers)
-	#ifdef GL_DEBUG_CPUPROFILER
-		profiler.setUsageType(CPUProfiler::APPLICATION);
-	#endif
+	profiler.setPhase(Profiler::PHASE_EVENTS);
 	processEvents();
 
 	// Finally, update the scene
 	if (activeScene != NULL)
 	{
-		#ifdef GL_DEBUG_CPUPROFILER
-			profiler.setUsageType(CPUProfiler::APPLICATION);
-		#endif
+		GLAZIERY_PROFILERZONE("Scene::update")
 		activeScene->update();
 	}
+
+	profiler.setPhase(callerPhase);
 }
 
 void Desktop::saveConfig()
@@ -1629,6 +1865,7 @@ void Desktop::setActiveScene(Scene * scene)
 	}
 
 	activeScene = scene;
+	invalidate();
 
 	if (initialized)
 	{
@@ -1649,6 +1886,21 @@ void Desktop::setClipboardText(const String & text)
 	platformAdapter->setClipboardText(text);
 }
 
+void Desktop::setDamageTracking(bool damageTracking)
+{
+	ASSERTION_COBJECT(this);
+
+	if (this->damageTracking != damageTracking)
+	{
+		this->damageTracking = damageTracking;
+
+		composedComponents.DeleteAll();
+		lastPointerAreaSize = Vector();
+		lastPointerType = NULL;
+		invalidate();
+	}
+}
+
 void Desktop::setDoubleClickDelay(long doubleClickDelay)
 {
 	ASSERTION_COBJECT(this);
@@ -1676,6 +1928,12 @@ void Desktop::setFocusWindow(Window * focusWindow)
 	notifyPossibleFocusChange(previousFocusWindow);
 }
 
+void Desktop::setIdleWaiting(bool idleWaiting)
+{
+	ASSERTION_COBJECT(this);
+	this->idleWaiting = idleWaiting;
+}
+
 void Desktop::setFrameTime(bool noWarnings)
 {
 	ASSERTION_COBJECT(this);
@@ -1685,7 +1943,7 @@ void Desktop::setFrameTime(bool noWarnings)
 
 	// Just to make sure, if any real frameTime calculation takes
 	// longer than real frameTime, so that it cannot build up.
-	if (getTimeStep() > maximumFrameDuration)
+	if (getTimeStep() > maximumFrameDuration + idleWaitTime)
 	{
 		#ifdef _DEBUG
 			if (!noWarnings)
@@ -1694,8 +1952,9 @@ void Desktop::setFrameTime(bool noWarnings)
 			}
 		#endif
 
-		initTime += getTimeStep() - maximumFrameDuration;
-		frameTime -= getTimeStep() - maximumFrameDuration;
+		unsigned long exceedingTime = getTimeStep() - maximumFrameDuration - idleWaitTime;
+		initTime += exceedingTime;
+		frameTime -= exceedingTime;
 	}
 }
 
@@ -1816,6 +2075,21 @@ String Desktop::toString()
 	return "Desktop";
 }
 
+void Desktop::undeferObject(EventTarget * object)
+{
+	ASSERTION_COBJECT(this);
+
+	if (!deferralMutex->lock())
+		throw EILLEGALSTATE("Locking did not succeed");
+	SET_OWNER_THREAD(&deferredObjects);
+
+	for (int i = deferredObjects.GetCount() - 1; i >= 0; i--)
+		if (deferredObjects.Get(i) == object)
+			deferredObjects.Unlink(i);
+
+	deferralMutex->release();
+}
+
 void Desktop::updateModal()
 {
 	ASSERTION_COBJECT(this);
@@ -1881,8 +2155,23 @@ void Desktop::updatePointerType()
 void Desktop::updateTimingAndWait()
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_PROFILERZONE("Desktop::updateTimingAndWait")
+
+	idleWaitTime = 0;
 
 	#ifndef GL_DEBUG_NOSLEEP
+		// Sleep until anything needs a frame, if nothing has to be drawn
+		if (idleWaiting)
+		{
+			long nextFrameDelay = getNextFrameDelay();
+			if (nextFrameDelay != 0)
+			{
+				unsigned long waitStart = platformAdapter->getTime();
+				platformAdapter->waitForInput(nextFrameDelay);
+				idleWaitTime = platformAdapter->getTime() - waitStart;
+			}
+		}
+
 		if (extraFrameDuration > 0 && effects.IsEmpty())
 			platformAdapter->sleep(extraFrameDuration);
 
@@ -1898,6 +2187,15 @@ void Desktop::updateTimingAndWait()
 }
 
 
+Desktop::ComposedComponent::ComposedComponent()
+{
+	ASSERTION_COBJECT(this);
+
+	component = NULL;
+	modulationColor = 0;
+}
+
+
 VetoMode Desktop::Listener::onApplicationCloseReceived()
 {
 	ASSERTION_COBJECT(this);
@@ -102,6 +102,47 @@ namespace glaziery
 				POINTER_AUTOMATIC
 			};
 
+			/**
+			 * A window or popup as composed onto the display surface in the last drawn frame.
+			 * Used by the damage tracking to detect windows and popups that have been moved,
+			 * resized, reordered, shown, hidden, or faded since then.
+			 * @see Desktop::setDamageTracking()
+			 */
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				class ComposedComponent : public CObject
+			#else
+				class ComposedComponent
+			#endif
+			{
+				public:
+
+					/**
+					 * The composed window or popup. Used for comparison only,
+					 * it may have been destroyed already.
+					 */
+					CachableComponent * component;
+
+					/**
+					 * The modulation color the component has been drawn with.
+					 */
+					unsigned long modulationColor;
+
+					/**
+					 * The absolute position the component has been drawn at.
+					 */
+					Vector position;
+
+					/**
+					 * The size the component has been drawn with.
+					 */
+					Vector size;
+
+					/**
+					 * Creates a new composed component.
+					 */
+					ComposedComponent();
+			};
+
 		public:
 
 			/**
@@ -136,6 +177,7 @@ namespace glaziery
 					virtual void onTutorialStarted(Tutorial * tutorial);
 			};
 
+		friend CachableComponent;
 		friend CharacterEvent;
 		friend Component;
 		friend EffectFork;
@@ -153,6 +195,7 @@ namespace glaziery
 		friend Window;
 
 		// Configurable properties
+		CF_INT_DECL(AutomaticCachingBudget)
 		CF_STRINGLIST_DECL(OnceActions)
 
 		protected:
@@ -176,6 +219,20 @@ namespace glaziery
 			 */
 			String applicationName;
 
+			/**
+			 * The number of surface bytes of components that turned caching on automatically.
+			 * Limited by the AutomaticCachingBudget (in KB).
+			 * @see CachableComponent::setAutomaticCaching()
+			 */
+			long automaticCachingBytes;
+
+			/**
+			 * The windows and popups as composed onto the display surface in the last drawn frame,
+			 * in back-to-front order. Maintained only if damage tracking is enabled.
+			 * @see damageTracking
+			 */
+			ArrayList<ComposedComponent> composedComponents;
+
 			/**
 			 * The configuration of the application (or game).
 			 */
@@ -186,6 +243,21 @@ namespace glaziery
 			 */
 			String configFolder;
 
+			/**
+			 * The absolute areas of the desktop damaged since the last drawn frame.
+			 * If empty, and damage tracking is enabled, the next frame is skipped.
+			 * @see damageTracking
+			 */
+			Region damagedRegion;
+
+			/**
+			 * Whether the desktop only recomposites the areas damaged since the last frame,
+			 * and skips drawing and showing frames completely when nothing changed.
+			 * Defaults to false.
+			 * @see setDamageTracking()
+			 */
+			bool damageTracking;
+
 			/**
 			 * The time of the current frame since the program start in milli seconds.
 			 */
@@ -295,6 +367,20 @@ namespace glaziery
 			 */
 			unsigned long hoverTime;
 
+			/**
+			 * Whether the desktop waits for input, effect deadlines, or deferrals
+			 * instead of running frames while nothing needs to be drawn.
+			 * @see setIdleWaiting()
+			 */
+			bool idleWaiting;
+
+			/**
+			 * The time in milli seconds the desktop waited idle for input before the current frame.
+			 * This time does not count as loop time when the frame time is limited.
+			 * @see maximumFrameDuration
+			 */
+			unsigned long idleWaitTime;
+
 			/**
 			 * Whether the desktop is initialized already.
 			 * This is used in the run() method to determine
@@ -313,11 +399,41 @@ namespace glaziery
 			 */
 			InputManager inputManager;
 
+			/**
+			 * The invalidation tracker, turned off by default.
+			 */
+			InvalidationTracker invalidationTracker;
+
 			/**
 			 * The time, in milli-seconds, of the last draw() operation.
 			 */
 			unsigned long lastDrawTime;
 
+			/**
+			 * The top-left position of the screen area covered by the pointer in the last drawn frame.
+			 * Maintained only if damage tracking is enabled.
+			 */
+			Vector lastPointerAreaPosition;
+
+			/**
+			 * The size of the screen area covered by the pointer in the last drawn frame,
+			 * or a zero vector, if the pointer has not been drawn.
+			 * Maintained only if damage tracking is enabled.
+			 */
+			Vector lastPointerAreaSize;
+
+			/**
+			 * The position the pointer has been drawn at in the last drawn frame.
+			 * Maintained only if damage tracking is enabled.
+			 */
+			Vector lastPointerPosition;
+
+			/**
+			 * The pointer type drawn in the last drawn frame, or NULL, if the pointer has not been drawn.
+			 * Used for comparison only. Maintained only if damage tracking is enabled.
+			 */
+			PointerType * lastPointerType;
+
 			/**
 			 * The time the last runOnce operation was performed.
 			 * runOnce checks whether it has been called recently and skips too often calls.
@@ -424,12 +540,10 @@ namespace glaziery
 			 */
 			Vector primaryPressPosition;
 
-			#ifdef GL_DEBUG_CPUPROFILER
-				/**
-				 * The CPU usage times, for debugging purposes.
-				 */
-				CPUProfiler profiler;
-			#endif
+			/**
+			 * The profiler measuring the main loop, turned off by default.
+			 */
+			Profiler profiler;
 
 			/**
 			 * The registered scenes. Add scenes during initialization of the
@@ -512,6 +626,14 @@ namespace glaziery
 			 */
 			void addDisposable(Effect * effect);
 
+			/**
+			 * Compares the current windows, popups, and pointer with the ones composed
+			 * in the last drawn frame, and damages the areas that have changed since then.
+			 * Also memorizes the current state for the next frame.
+			 * @see damageTracking
+			 */
+			void collectCompositionDamage();
+
 			/**
 			 * Draws the whole desktop to the display surface.
 			 * @note Call the method only if the scene's rendering is not suspended.
@@ -520,6 +642,16 @@ namespace glaziery
 			 */
 			void draw();
 
+			/**
+			 * Composes the skin's desktop, the scene, windows, popups, effects,
+			 * and the pointer into a given drawing context, in back-to-front order.
+			 * Windows and popups outside the context's clipping area are skipped,
+			 * and so are the parts covered by opaque windows and popups above them.
+			 * @see CachableComponent::isOpaque()
+			 * @param context The drawing context, clipped to the area to be composed.
+			 */
+			void drawComposition(DrawingContext & context);
+
 			/**
 			 * Executes deferred operations.
 			 */
@@ -858,6 +990,14 @@ namespace glaziery
 			 */
 			const String & getApplicationName();
 
+			/**
+			 * Returns the number of surface bytes of components that turned caching on automatically.
+			 * Automatic caching keeps this value within the AutomaticCachingBudget (in KB).
+			 * @return The number of bytes.
+			 * @see CachableComponent::setAutomaticCaching()
+			 */
+			long getAutomaticCachingBytes();
+
 			/**
 			 * Returns a text version of the current content of the system's clipboard.
 			 * @return The clipboard text.
@@ -998,6 +1138,13 @@ namespace glaziery
 			 */
 			static Desktop * getInstance();
 
+			/**
+			 * Returns the invalidation tracker, e.g. to turn it on, to show its heat-map
+			 * overlay, or to find the components invalidating the most.
+			 * @return The invalidation tracker.
+			 */
+			InvalidationTracker & getInvalidationTracker();
+
 			/**
 			 * Returns the time, in milli-seconds, of the last draw() operation.
 			 * @return The time, in milli-seconds, of the last draw() operation.
@@ -1047,6 +1194,19 @@ namespace glaziery
 			 */
 			unsigned long getMinimumFrameDuration();
 
+			/**
+			 * Returns the time in milli seconds until the desktop needs its next frame,
+			 * if no input arrives before. This is the earliest deadline of the hover detection,
+			 * the running effects, the active scene, and the skin.
+			 * @return The time in milli seconds until the next frame, 0 for the next frame,
+			 * or -1 if no frame is needed without input.
+			 * @see setIdleWaiting()
+			 * @see Effect::getNextFrameDelay()
+			 * @see Scene::getNextFrameDelay()
+			 * @see Skin::getNextFrameDelay()
+			 */
+			long getNextFrameDelay();
+
 			/**
 			 * Returns the origin for relative position values.
 			 * E.g. for components, this is their absolute position,
@@ -1100,13 +1260,12 @@ namespace glaziery
 			 */
 			const ArrayList<Popup> & getPopups();
 
-			#ifdef GL_DEBUG_CPUPROFILER
-				/**
-				 * Returns the CPU usage times, for debugging purposes.
-				 * @return The CPU usage times, for debugging purposes.
-				 */
-				CPUProfiler & getProfiler();
-			#endif
+			/**
+			 * Returns the profiler measuring the main loop, e.g. to turn it on,
+			 * to show its overlay, or to capture a trace.
+			 * @return The profiler.
+			 */
+			Profiler & getProfiler();
 
 			/**
 			 * Returns a scene by its ID.
@@ -1244,12 +1403,51 @@ namespace glaziery
 			 */
 			void initialize();
 
+			/**
+			 * Damages the entire desktop, so that the next frame is fully redrawn.
+			 * Call this method when drawing outside of components has changed
+			 * (e.g. the scene background), if damage tracking is enabled.
+			 * Components report their damage automatically, when they are invalidated.
+			 * @see setDamageTracking()
+			 * @see Component::invalidate()
+			 */
+			void invalidate();
+
+			/**
+			 * Damages an area of the desktop, so that it is redrawn in the next frame.
+			 * Call this method when drawing outside of components has changed
+			 * (e.g. the scene background), if damage tracking is enabled.
+			 * Components report their damage automatically, when they are invalidated.
+			 * @param position The top-left absolute position of the damaged area.
+			 * @param size The size of the damaged area.
+			 * @see setDamageTracking()
+			 * @see Component::invalidateArea()
+			 */
+			void invalidateArea(Vector position, Vector size);
+
 			/**
 			 * Returns whether the application is currently focused.
 			 * @return Whether the application is currently focused.
 			 */
 			bool isApplicationFocused();
 
+			/**
+			 * Returns whether any area of the desktop has been damaged since the last drawn frame.
+			 * If not, and damage tracking is enabled, the next frame is skipped.
+			 * @return Whether any area has been damaged.
+			 * @see setDamageTracking()
+			 */
+			bool isDamaged();
+
+			/**
+			 * Returns whether the desktop only recomposites the areas damaged since the last frame,
+			 * and skips drawing and showing frames completely when nothing changed.
+			 * Defaults to false.
+			 * @return Whether damage tracking is enabled.
+			 * @see setDamageTracking()
+			 */
+			bool isDamageTracking();
+
 			/**
 			 * Returns whether the user is currently dragging an event target using the pointer.
 			 * @return Whether the user is currently dragging.
@@ -1283,6 +1481,15 @@ namespace glaziery
 			 */
 			bool isFullScreen();
 
+			/**
+			 * Returns whether the desktop waits for input, effect deadlines, or deferrals
+			 * instead of running frames while nothing needs to be drawn.
+			 * Defaults to false.
+			 * @return Whether idle waiting is enabled.
+			 * @see setIdleWaiting()
+			 */
+			bool isIdleWaiting();
+
 			/**
 			 * Returns whether the desktop is initialized already.
 			 * This is used in the run() method to determine
@@ -1480,6 +1687,24 @@ namespace glaziery
 			 */
 			void setClipboardText(const String & text);
 
+			/**
+			 * Sets whether the desktop only recomposites the areas damaged since the last frame,
+			 * and skips drawing and showing frames completely when nothing changed.
+			 * Defaults to false. Enable this for applications that are idle most of the time
+			 * (e.g. kiosk or menu screens), to relief the CPU and GPU.
+			 * The damage is collected from component invalidations, from windows and popups
+			 * being moved, resized, reordered, shown, hidden, or faded, and from pointer movements.
+			 * While any effect or a drag-drop operation is running, every frame is fully drawn.
+			 * @param damageTracking Whether to enable damage tracking.
+			 * @note The scene and the skin must call invalidate() or invalidateArea()
+			 * whenever their background or foreground drawing changes.
+			 * Scenes that render continuously (e.g. a 3D game scene) must not enable damage tracking.
+			 * @see invalidate()
+			 * @see invalidateArea()
+			 * @see PlatformAdapter::isBackBufferRetained()
+			 */
+			void setDamageTracking(bool damageTracking);
+
 			/**
 			 * Sets the maximum number of milli seconds to accept two presses
 			 * as a double click.
@@ -1508,6 +1733,21 @@ namespace glaziery
 			 */
 			void setFocusWindow(Window * focusWindow);
 
+			/**
+			 * Sets whether the desktop waits for input, effect deadlines, or deferrals
+			 * instead of running frames while nothing needs to be drawn.
+			 * Defaults to false. Idle waiting requires damage tracking, because the desktop
+			 * must know that nothing has changed. While waiting, the platform adapter blocks
+			 * until input arrives, deferObject() is called, or the next frame delay elapses.
+			 * @param idleWaiting Whether to enable idle waiting.
+			 * @note Scenes and skins that animate without invalidating must return
+			 * their next frame delay, otherwise their animations stall until the next input.
+			 * @see setDamageTracking()
+			 * @see getNextFrameDelay()
+			 * @see PlatformAdapter::waitForInput()
+			 */
+			void setIdleWaiting(bool idleWaiting);
+
 			/**
 			 * Sets the current master volume, which ranges from 0 to 255.
 			 * @param volume The current master volume.
@@ -1611,6 +1851,14 @@ namespace glaziery
 			 * @return The string representation.
 			 */
 			virtual String toString();
+
+			/**
+			 * Removes a given event target from the list of objects to execute operations on,
+			 * e.g. because it is being destroyed before its deferred operations have been executed.
+			 * @param object The event target.
+			 * @see deferObject()
+			 */
+			void undeferObject(EventTarget * object);
 	};
 }
 
@@ -316,7 +316,7 @@ namespace glaziery
 			 * @see onDialogStart()
 			 * @see showModally()
 			 */
-			virtual void setupContent(FieldsArea * area, GroupField * contentGroup) = NULL;
+			virtual void setupContent(FieldsArea * area, GroupField * contentGroup) = 0;
 
 		// Runtime class macros require their own public section.
 		public:
@@ -505,6 +505,9 @@ void FileDialog::onModalUpdate()
 			Directory & directory = directoryTask->directory;
 			int entryCount = directory.GetEntryCount();
 
+			// Add all entries as one update of the list field
+			fileListField->beginUpdate();
+
 			// Add directories, first
 			for (int entryNo=0; entryNo<entryCount; entryNo++)
 			{
@@ -544,6 +547,8 @@ void FileDialog::onModalUpdate()
 
 				createListRow(entry->CreatePathObject());
 			}
+
+			fileListField->endUpdate();
 		}
 
 		Desktop::getInstance()->hideHourGlass();
@@ -0,0 +1,315 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+DisplayList::DisplayList()
+{
+	ASSERTION_COBJECT(this);
+
+	commandCapacity = 0;
+	commandCount = 0;
+	commands = NULL;
+	recorded = false;
+}
+
+DisplayList::~DisplayList()
+{
+	ASSERTION_COBJECT(this);
+	if (commands != NULL) {delete[] commands; commands = NULL;}
+}
+
+DisplayList::Command & DisplayList::addCommand(DrawingContext & context, Command::Type type)
+{
+	ASSERTION_COBJECT(this);
+
+	if (commandCount >= commandCapacity)
+	{
+		int newCapacity = commandCapacity > 0 ? commandCapacity * 2 : 16;
+		Command * newCommands;
+		if ((newCommands = new Command[newCapacity]) == NULL)
+			throw EOUTOFMEMORY;
+
+		for (int i=0; i<commandCount; i++)
+			newCommands[i] = commands[i];
+
+		if (commands != NULL)
+			delete[] commands;
+		commands = newCommands;
+		commandCapacity = newCapacity;
+	}
+
+	Command & command = commands[commandCount++];
+	command.type = type;
+	command.clippingOffset = context.getClippingOffset() - origin;
+	command.clippingSize = context.getClippingSize();
+	command.drawingOffset = context.getDrawingOffset() - origin;
+	command.image = NULL;
+
+	return command;
+}
+
+void DisplayList::clear()
+{
+	ASSERTION_COBJECT(this);
+
+	commandCount = 0;
+	recorded = false;
+}
+
+int DisplayList::getCommandCount()
+{
+	ASSERTION_COBJECT(this);
+	return commandCount;
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(DisplayList, CObject);
+#endif
+
+bool DisplayList::isRecorded()
+{
+	ASSERTION_COBJECT(this);
+	return recorded;
+}
+
+void DisplayList::recordClear(DrawingContext & context, unsigned long fillColor)
+{
+	ASSERTION_COBJECT(this);
+
+	Command & command = addCommand(context, Command::CLEAR);
+	command.fillColor = fillColor;
+}
+
+void DisplayList::recordEllipse(DrawingContext & context, Vector center, Vector radius,
+	unsigned long fillColor, unsigned long borderColor)
+{
+	ASSERTION_COBJECT(this);
+
+	Command & command = addCommand(context, Command::ELLIPSE);
+	command.vectors[0] = center;
+	command.vectors[1] = radius;
+	command.fillColor = fillColor;
+	command.borderColor = borderColor;
+}
+
+void DisplayList::recordImage(DrawingContext & context, Image * image,
+	Vector sourcePosition, Vector sourceSize, Vector targetPosition, Vector targetSize,
+	unsigned long modulationColor, PlatformAdapter::BlendType blendType)
+{
+	ASSERTION_COBJECT(this);
+
+	Command & command = addCommand(context, Command::IMAGE);
+	command.image = image;
+	command.vectors[0] = sourcePosition;
+	command.vectors[1] = sourceSize;
+	command.vectors[2] = targetPosition;
+	command.vectors[3] = targetSize;
+	command.borderColor = modulationColor;
+	command.blendType = blendType;
+}
+
+void DisplayList::recordLine(DrawingContext & context, Vector from, Vector to, unsigned long color)
+{
+	ASSERTION_COBJECT(this);
+
+	Command & command = addCommand(context, Command::LINE);
+	command.vectors[0] = from;
+	command.vectors[1] = to;
+	command.fillColor = color;
+}
+
+void DisplayList::recordPixel(DrawingContext & context, Vector position, unsigned long color)
+{
+	ASSERTION_COBJECT(this);
+
+	Command & command = addCommand(context, Command::PIXEL);
+	command.vectors[0] = position;
+	command.fillColor = color;
+}
+
+void DisplayList::recordRect(DrawingContext & context, Vector from, Vector to,
+	unsigned long fillColor, unsigned long borderColor)
+{
+	ASSERTION_COBJECT(this);
+
+	Command & command = addCommand(context, Command::RECT);
+	command.vectors[0] = from;
+	command.vectors[1] = to;
+	command.fillColor = fillColor;
+	command.borderColor = borderColor;
+}
+
+void DisplayList::recordRotatedImage(DrawingContext & context, Image * image,
+	Vector sourcePosition, Vector sourceSize, Vector targetPosition, Vector targetSize,
+	Vector rotationAnchor, double rotationAngle,
+	unsigned long modulationColor, PlatformAdapter::BlendType blendType)
+{
+	ASSERTION_COBJECT(this);
+
+	Command & command = addCommand(context, Command::ROTATED_IMAGE);
+	command.image = image;
+	command.vectors[0] = sourcePosition;
+	command.vectors[1] = sourceSize;
+	command.vectors[2] = targetPosition;
+	command.vectors[3] = targetSize;
+	command.vectors[4] = rotationAnchor;
+	command.rotationAngle = rotationAngle;
+	command.borderColor = modulationColor;
+	command.blendType = blendType;
+}
+
+void DisplayList::recordTriangle(DrawingContext & context, Vector * vertices,
+	unsigned long fillColor, unsigned long borderColor)
+{
+	ASSERTION_COBJECT(this);
+
+	Command & command = addCommand(context, Command::TRIANGLE);
+	command.vectors[0] = vertices[0];
+	command.vectors[1] = vertices[1];
+	command.vectors[2] = vertices[2];
+	command.fillColor = fillColor;
+	command.borderColor = borderColor;
+}
+
+void DisplayList::replay(DrawingContext & context)
+{
+	ASSERTION_COBJECT(this);
+
+	PlatformAdapter * adapter = Desktop::getInstance()->getPlatformAdapter();
+	Vector replayOrigin = context.getDrawingOffset();
+	Vector replayClippingEnd = context.getClippingOffset() + context.getClippingSize();
+
+	// Consecutive commands usually share the drawing context state,
+	// so the command context is updated on changes only
+	DrawingContext commandContext(context);
+	Vector lastClippingOffset;
+	Vector lastClippingSize;
+	Vector lastDrawingOffset;
+	bool clipped = true;
+	for (int i=0; i<commandCount; i++)
+	{
+		Command & command = commands[i];
+		if (i == 0 || command.drawingOffset != lastDrawingOffset
+			|| command.clippingOffset != lastClippingOffset || command.clippingSize != lastClippingSize)
+		{
+			lastClippingOffset = command.clippingOffset;
+			lastClippingSize = command.clippingSize;
+			lastDrawingOffset = command.drawingOffset;
+
+			// Intersect the recorded clipping rectangle with the replay context's one
+			Vector clippingOffset = replayOrigin + command.clippingOffset;
+			Vector clippingEnd = clippingOffset + command.clippingSize;
+			Vector replayClippingOffset = context.getClippingOffset();
+			if (clippingOffset.x < replayClippingOffset.x)
+				clippingOffset.x = replayClippingOffset.x;
+			if (clippingOffset.y < replayClippingOffset.y)
+				clippingOffset.y = replayClippingOffset.y;
+			if (clippingEnd.x > replayClippingEnd.x)
+				clippingEnd.x = replayClippingEnd.x;
+			if (clippingEnd.y > replayClippingEnd.y)
+				clippingEnd.y = replayClippingEnd.y;
+
+			clipped = clippingEnd.x <= clippingOffset.x || clippingEnd.y <= clippingOffset.y;
+			commandContext.clippingOffset = clippingOffset;
+			commandContext.clippingSize = clippingEnd - clippingOffset;
+			commandContext.drawingOffset = replayOrigin + command.drawingOffset;
+		}
+
+		if (clipped)
+			continue;
+
+		switch (command.type)
+		{
+			case Command::CLEAR:
+				adapter->clear(commandContext, command.fillColor);
+				break;
+
+			case Command::ELLIPSE:
+				adapter->drawEllipse(commandContext, command.vectors[0], command.vectors[1],
+					command.fillColor, command.borderColor);
+				break;
+
+			case Command::IMAGE:
+				adapter->drawImage(commandContext, command.image, command.vectors[0], command.vectors[1],
+					command.vectors[2], command.vectors[3], command.borderColor, command.blendType);
+				break;
+
+			case Command::LINE:
+				adapter->drawLine(commandContext, command.vectors[0], command.vectors[1], command.fillColor);
+				break;
+
+			case Command::PIXEL:
+				adapter->drawPixel(commandContext, command.vectors[0], command.fillColor);
+				break;
+
+			case Command::RECT:
+				adapter->drawRect(commandContext, command.vectors[0], command.vectors[1],
+					command.fillColor, command.borderColor);
+				break;
+
+			case Command::ROTATED_IMAGE:
+				adapter->drawRotatedImage(commandContext, command.image, command.vectors[0],
+					command.vectors[1], command.vectors[2], command.vectors[3], command.vectors[4],
+					command.rotationAngle, command.borderColor, command.blendType);
+				break;
+
+			case Command::TRIANGLE:
+				adapter->drawTriangle(commandContext, command.vectors,
+					command.fillColor, command.borderColor);
+				break;
+		}
+	}
+}
+
+void DisplayList::startRecording(DrawingContext & context)
+{
+	ASSERTION_COBJECT(this);
+
+	commandCount = 0;
+	origin = context.getDrawingOffset();
+	recorded = false;
+}
+
+void DisplayList::stopRecording()
+{
+	ASSERTION_COBJECT(this);
+	recorded = true;
+}
+
+
+DisplayList::Command::Command()
+{
+	ASSERTION_COBJECT(this);
+
+	blendType = PlatformAdapter::BLENDTYPE_NORMAL;
+	borderColor = 0;
+	fillColor = 0;
+	image = NULL;
+	rotationAngle = 0.0;
+	type = CLEAR;
+}
+
+void DisplayList::Command::operator =(const Command & command)
+{
+	ASSERTION_COBJECT(this);
+
+	blendType = command.blendType;
+	borderColor = command.borderColor;
+	clippingOffset = command.clippingOffset;
+	clippingSize = command.clippingSize;
+	drawingOffset = command.drawingOffset;
+	fillColor = command.fillColor;
+	image = command.image;
+	rotationAngle = command.rotationAngle;
+	type = command.type;
+	for (int i=0; i<5; i++)
+		vectors[i] = command.vectors[i];
+}
@@ -0,0 +1,315 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_DISPLAYLIST_H
+#define __GLAZIERY_DISPLAYLIST_H
+
+
+namespace glaziery
+{
+	/**
+	 * The display list is a recorded sequence of platform adapter drawing primitives,
+	 * together with the drawing and clipping state of the drawing context each one
+	 * has been performed with. Replaying the list draws the same output as the recorded
+	 * drawing, without running the skin and component code again (layouting, measuring
+	 * texts, shortening texts for ellipses, choosing colors and images, etc.).
+	 * Texts are recorded as the glyph images drawn by the platform adapter.
+	 * The list stores its commands relative to the drawing offset it has been started with,
+	 * so it may be replayed at any other position (e.g. after the component has been moved).
+	 * Recording is performed by the platform adapter for each drawing context
+	 * that has a display list. Sub contexts inherit the display list.
+	 * @note Images are referenced, not copied. The recorder must discard the list
+	 * before a referenced image is changed or destroyed.
+	 * @see DrawingContext::getDisplayList()
+	 * @see Component::setRecording()
+	 */
+	#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+		class DisplayList : public CObject
+	#else
+		class DisplayList
+	#endif
+	{
+		private:
+
+			/**
+			 * A recorded drawing primitive.
+			 */
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				class Command : public CObject
+			#else
+				class Command
+			#endif
+			{
+				public:
+
+					/**
+					 * The type of a command, i.e. the platform adapter method to call.
+					 */
+					enum Type
+					{
+						/**
+						 * PlatformAdapter::clear().
+						 */
+						CLEAR,
+
+						/**
+						 * PlatformAdapter::drawEllipse().
+						 */
+						ELLIPSE,
+
+						/**
+						 * PlatformAdapter::drawImage().
+						 */
+						IMAGE,
+
+						/**
+						 * PlatformAdapter::drawLine().
+						 */
+						LINE,
+
+						/**
+						 * PlatformAdapter::drawPixel().
+						 */
+						PIXEL,
+
+						/**
+						 * PlatformAdapter::drawRect().
+						 */
+						RECT,
+
+						/**
+						 * PlatformAdapter::drawRotatedImage().
+						 */
+						ROTATED_IMAGE,
+
+						/**
+						 * PlatformAdapter::drawTriangle().
+						 */
+						TRIANGLE
+					};
+
+					/**
+					 * The blend type of image commands.
+					 */
+					PlatformAdapter::BlendType blendType;
+
+					/**
+					 * The border color, or the modulation color of image commands.
+					 */
+					unsigned long borderColor;
+
+					/**
+					 * The clipping offset of the drawing context, relative to the list's origin.
+					 */
+					Vector clippingOffset;
+
+					/**
+					 * The clipping size of the drawing context.
+					 */
+					Vector clippingSize;
+
+					/**
+					 * The drawing offset of the drawing context, relative to the list's origin.
+					 */
+					Vector drawingOffset;
+
+					/**
+					 * The fill color, or the color of line and pixel commands.
+					 */
+					unsigned long fillColor;
+
+					/**
+					 * The image of image commands, or NULL.
+					 */
+					Image * image;
+
+					/**
+					 * The rotation angle of rotated image commands.
+					 */
+					double rotationAngle;
+
+					/**
+					 * The type of the command.
+					 */
+					Type type;
+
+					/**
+					 * The position, size, and vertex parameters of the command, in the order
+					 * of the respective platform adapter method.
+					 */
+					Vector vectors[5];
+
+					/**
+					 * Creates a new empty command.
+					 */
+					Command();
+
+					/**
+					 * Sets another command's properties into this command.
+					 * @param command The command to be set.
+					 */
+					void operator =(const Command & command);
+			};
+
+			/**
+			 * The number of commands allocated.
+			 */
+			int commandCapacity;
+
+			/**
+			 * The number of commands recorded.
+			 */
+			int commandCount;
+
+			/**
+			 * The recorded commands.
+			 */
+			Command * commands;
+
+			/**
+			 * The drawing offset of the context the recording has been started with.
+			 * All commands are stored relative to this offset.
+			 */
+			Vector origin;
+
+			/**
+			 * Whether the recording has been completed, so the list may be replayed.
+			 */
+			bool recorded;
+
+			/**
+			 * Appends a new command, storing the state of the given drawing context.
+			 * @param context The drawing context of the recorded primitive.
+			 * @param type The type of the command.
+			 * @return The new command, to fill in the parameters.
+			 */
+			Command & addCommand(DrawingContext & context, Command::Type type);
+
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(DisplayList);
+			#endif
+
+		public:
+
+			/**
+			 * Creates a new empty display list.
+			 */
+			DisplayList();
+
+			/**
+			 * Destroys the display list.
+			 */
+			~DisplayList();
+
+			/**
+			 * Removes all commands, so that the list must be recorded again before replaying.
+			 */
+			void clear();
+
+			/**
+			 * Returns the number of recorded commands.
+			 * @return The number of commands.
+			 */
+			int getCommandCount();
+
+			/**
+			 * Returns whether the recording has been completed, so the list may be replayed.
+			 * @return Whether the list has been recorded.
+			 */
+			bool isRecorded();
+
+			/**
+			 * Records a PlatformAdapter::clear() operation.
+			 * @see PlatformAdapter::clear()
+			 */
+			void recordClear(DrawingContext & context, unsigned long fillColor);
+
+			/**
+			 * Records a PlatformAdapter::drawEllipse() operation.
+			 * @see PlatformAdapter::drawEllipse()
+			 */
+			void recordEllipse(DrawingContext & context, Vector center, Vector radius,
+				unsigned long fillColor, unsigned long borderColor);
+
+			/**
+			 * Records a PlatformAdapter::drawImage() operation.
+			 * @see PlatformAdapter::drawImage()
+			 */
+			void recordImage(DrawingContext & context, Image * image,
+				Vector sourcePosition, Vector sourceSize, Vector targetPosition, Vector targetSize,
+				unsigned long modulationColor, PlatformAdapter::BlendType blendType);
+
+			/**
+			 * Records a PlatformAdapter::drawLine() operation.
+			 * @see PlatformAdapter::drawLine()
+			 */
+			void recordLine(DrawingContext & context, Vector from, Vector to, unsigned long color);
+
+			/**
+			 * Records a PlatformAdapter::drawPixel() operation.
+			 * @see PlatformAdapter::drawPixel()
+			 */
+			void recordPixel(DrawingContext & context, Vector position, unsigned long color);
+
+			/**
+			 * Records a PlatformAdapter::drawRect() operation.
+			 * @see PlatformAdapter::drawRect()
+			 */
+			void recordRect(DrawingContext & context, Vector from, Vector to,
+				unsigned long fillColor, unsigned long borderColor);
+
+			/**
+			 * Records a PlatformAdapter::drawRotatedImage() operation.
+			 * @see PlatformAdapter::drawRotatedImage()
+			 */
+			void recordRotatedImage(DrawingContext & context, Image * image,
+				Vector sourcePosition, Vector sourceSize, Vector targetPosition, Vector targetSize,
+				Vector rotationAnchor, double rotationAngle,
+				unsigned long modulationColor, PlatformAdapter::BlendType blendType);
+
+			/**
+			 * Records a PlatformAdapter::drawTriangle() operation.
+			 * @see PlatformAdapter::drawTriangle()
+			 */
+			void recordTriangle(DrawingContext & context, Vector * vertices,
+				unsigned long fillColor, unsigned long borderColor);
+
+			/**
+			 * Performs all recorded commands on a given drawing context.
+			 * The commands are translated by the context's drawing offset,
+			 * and clipped by both the recorded and the context's clipping rectangle.
+			 * If the given context records into another display list,
+			 * the replayed commands are recorded there as well.
+			 * @param context The drawing context to be used.
+			 */
+			void replay(DrawingContext & context);
+
+			/**
+			 * Starts a new recording, removing all commands recorded so far.
+			 * Then, draw using a drawing context that records into this list,
+			 * and call stopRecording().
+			 * @param context The drawing context the recording is performed with.
+			 * Its drawing offset becomes the origin of the list.
+			 * @see DrawingContext::DrawingContext(const DrawingContext &, DisplayList *)
+			 * @see stopRecording()
+			 */
+			void startRecording(DrawingContext & context);
+
+			/**
+			 * Completes the recording, so the list may be replayed.
+			 * @see startRecording()
+			 */
+			void stopRecording();
+	};
+}
+
+
+#endif
@@ -14,6 +14,7 @@ DrawingContext::DrawingContext()
 {
 	ASSERTION_COBJECT(this);
 
+	displayList = NULL;
 	target = NULL;
 }
 
@@ -22,6 +23,7 @@ DrawingContext::DrawingContext(Desktop * desktop)
 	ASSERTION_COBJECT(this);
 
 	clippingSize = desktop->getPlatformAdapter()->getScreenSize();
+	displayList = NULL;
 	target = NULL;
 }
 
@@ -30,6 +32,7 @@ DrawingContext::DrawingContext(Image * target)
 	ASSERTION_COBJECT(this);
 
 	clippingSize = target->getSize();
+	displayList = NULL;
 	this->target = target;
 }
 
@@ -39,6 +42,7 @@ DrawingContext::DrawingContext(const DrawingContext & context)
 
 	clippingOffset = context.clippingOffset;
 	clippingSize = context.clippingSize;
+	displayList = context.displayList;
 	drawingOffset = context.drawingOffset;
 	target = context.target;
 }
@@ -49,6 +53,7 @@ DrawingContext::DrawingContext(const DrawingContext & context, Vector offset)
 
 	clippingOffset = context.clippingOffset;
 	clippingSize = context.clippingSize;
+	displayList = context.displayList;
 	drawingOffset = context.drawingOffset + offset;
 	target = context.target;
 }
@@ -59,6 +64,7 @@ DrawingContext::DrawingContext(const DrawingContext & context, Vector offset, Ve
 
 	clippingOffset = context.clippingOffset;
 	clippingSize = context.clippingSize;
+	displayList = context.displayList;
 	drawingOffset = context.drawingOffset;
 	target = context.target;
 
@@ -71,17 +77,30 @@ DrawingContext::DrawingContext(const DrawingContext & context, Component * compo
 
 	clippingOffset = context.clippingOffset;
 	clippingSize = context.clippingSize;
+	displayList = context.displayList;
 	drawingOffset = context.drawingOffset;
 	target = context.target;
 
 	clipTo(component->getPosition(), component->getSize());
 }
 
+DrawingContext::DrawingContext(const DrawingContext & context, DisplayList * displayList)
+{
+	ASSERTION_COBJECT(this);
+
+	clippingOffset = context.clippingOffset;
+	clippingSize = context.clippingSize;
+	this->displayList = displayList;
+	drawingOffset = context.drawingOffset;
+	target = context.target;
+}
+
 void DrawingContext::operator =(const DrawingContext & drawingContext)
 {
 	ASSERTION_COBJECT(this);
 
 	target = drawingContext.target;
+	displayList = drawingContext.displayList;
 	drawingOffset = drawingContext.drawingOffset;
 	clippingOffset = drawingContext.clippingOffset;
 	clippingSize = drawingContext.clippingSize;
@@ -28,6 +28,8 @@ namespace glaziery
 		class DrawingContext
 	#endif
 	{
+		friend DisplayList;
+
 		private:
 
 			/**
@@ -44,6 +46,13 @@ namespace glaziery
 			 */
 			Vector clippingSize;
 
+			/**
+			 * The display list the platform adapter records all drawing operations into,
+			 * in addition to performing them, or NULL if the operations are not recorded.
+			 * Sub contexts inherit the display list of their outer context.
+			 */
+			DisplayList * displayList;
+
 			/**
 			 * The drawing offset, absolute to the target's origin.
 			 * All drawing operations on the target are translated by this offset
@@ -162,6 +171,15 @@ namespace glaziery
 			 */
 			DrawingContext(const DrawingContext & context, Component * component);
 
+			/**
+			 * Creates a drawing context from a given one, recording all drawing operations
+			 * into a display list, in addition to performing them.
+			 * @param context The context template.
+			 * @param displayList The display list to record into, or NULL to stop recording.
+			 * @see DisplayList::startRecording()
+			 */
+			DrawingContext(const DrawingContext & context, DisplayList * displayList);
+
 			/**
 			 * Sets all the surface, clipping, and drawing properties
 			 * of the drawing context to those of another one.
@@ -201,6 +219,12 @@ namespace glaziery
 			 */
 			inline Vector getClippingSize();
 
+			/**
+			 * Returns the display list the platform adapter records all drawing operations into.
+			 * @return The display list or NULL, if the drawing operations are not recorded.
+			 */
+			inline DisplayList * getDisplayList();
+
 			/**
 			 * Returns the drawing offset. All drawing operations on the target
 			 * are translated by this offset (i.e. originated there).
@@ -20,6 +20,11 @@ inline Vector DrawingContext::getClippingSize()
 	return clippingSize;
 }
 
+inline DisplayList * DrawingContext::getDisplayList()
+{
+	return displayList;
+}
+
 inline Vector DrawingContext::getDrawingOffset()
 {
 	return drawingOffset;
@@ -43,6 +43,12 @@ void Effect::draw(DrawingContext & context)
 	ASSERTION_COBJECT(this);
 }
 
+long Effect::getNextFrameDelay()
+{
+	ASSERTION_COBJECT(this);
+	return 0;
+}
+
 #if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
 	IMPLEMENT_DYNAMIC(Effect, SharedObject);
 #endif
@@ -77,7 +77,7 @@ namespace glaziery
 			 * @return Whether to continue the effect. false will destroy it.
 			 * @note This method is called by the Desktop. Do not call it directly.
 			 */
-			virtual bool execute(DrawingContext & context, long time) = NULL;
+			virtual bool execute(DrawingContext & context, long time) = 0;
 
 			/**
 			 * Performs operations when the effect is added to the Desktop.
@@ -118,6 +118,16 @@ namespace glaziery
 			 */
 			virtual void draw(DrawingContext & context);
 
+			/**
+			 * Returns the time in milli seconds until the effect needs its next frame.
+			 * Idle waiting desktops sleep that long, unless input arrives earlier.
+			 * The default implementation returns 0, i.e. the effect changes something every frame.
+			 * @return The time in milli seconds until the next frame, 0 for the next frame,
+			 * or -1 if the effect does not need any frame.
+			 * @see Desktop::setIdleWaiting()
+			 */
+			virtual long getNextFrameDelay();
+
 			/**
 			 * Returns whether the effect has been canceled.
 			 * Canceled effects are not executed anymore
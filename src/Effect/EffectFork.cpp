@@ -68,6 +68,30 @@ const ArrayList<Effect> & EffectFork::getEffects()
 	return effects;
 }
 
+long EffectFork::getNextFrameDelay()
+{
+	ASSERTION_COBJECT(this);
+
+	// Forks without running effects end with the next frame
+	long nextFrameDelay = 0;
+	bool anyEffectRunning = false;
+	for (int i=0; i<effects.GetCount(); i++)
+	{
+		Effect * effect = effects.Get(i);
+		if (effect->isEnded())
+			continue;
+		if (effect->isCanceled())
+			return 0;
+
+		long effectDelay = effect->getNextFrameDelay();
+		if (!anyEffectRunning || (effectDelay >= 0 && (nextFrameDelay < 0 || effectDelay < nextFrameDelay)))
+			nextFrameDelay = effectDelay;
+		anyEffectRunning = true;
+	}
+
+	return nextFrameDelay;
+}
+
 #if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
 	IMPLEMENT_DYNAMIC(EffectFork, Effect);
 #endif
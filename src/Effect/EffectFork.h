@@ -69,6 +69,13 @@ namespace glaziery
 			void addEffect(Effect * effect);
 
 			const ArrayList<Effect> & getEffects();
+
+			/**
+			 * Returns the time in milli seconds until any running effect of the fork needs its next frame.
+			 * @return The time in milli seconds until the next frame, 0 for the next frame,
+			 * or -1 if no effect needs any frame.
+			 */
+			virtual long getNextFrameDelay();
 	};
 }
 
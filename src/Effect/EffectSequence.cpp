@@ -73,6 +73,20 @@ const ArrayList<Effect> & EffectSequence::getEffects()
 	return effects;
 }
 
+long EffectSequence::getNextFrameDelay()
+{
+	ASSERTION_COBJECT(this);
+
+	if (effects.IsEmpty())
+		return 0;
+
+	Effect * effect = effects.GetFirst();
+	if (effect->isEnded() || effect->isCanceled())
+		return 0;
+
+	return effect->getNextFrameDelay();
+}
+
 #if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
 	IMPLEMENT_DYNAMIC(EffectSequence, Effect);
 #endif
@@ -72,6 +72,13 @@ namespace glaziery
 
 			const ArrayList<Effect> & getEffects();
 
+			/**
+			 * Returns the time in milli seconds until the current effect of the sequence needs its next frame.
+			 * @return The time in milli seconds until the next frame, 0 for the next frame,
+			 * or -1 if the effect does not need any frame.
+			 */
+			virtual long getNextFrameDelay();
+
 			void insertEffect(int position, Effect * effect);
 
 			void prependEffect(Effect * effect);
@@ -16,6 +16,14 @@ IdleEffect::IdleEffect(long time)
 	ASSERTION_COBJECT(this);
 }
 
+long IdleEffect::getNextFrameDelay()
+{
+	ASSERTION_COBJECT(this);
+
+	long remainingTime = getRemainingTime();
+	return remainingTime > 0 ? remainingTime : 0;
+}
+
 #if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
 	IMPLEMENT_DYNAMIC(IdleEffect, TimedEffect);
 #endif
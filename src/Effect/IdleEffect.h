@@ -33,6 +33,14 @@ namespace glaziery
 			 * @see Desktop::addEffect()
 			 */
 			IdleEffect(long time = 0);
+
+			/**
+			 * Returns the time in milli seconds until the effect needs its next frame.
+			 * Idle effects do not change anything, so this is the remaining time.
+			 * @return The time in milli seconds until the next frame.
+			 * @see Desktop::setIdleWaiting()
+			 */
+			virtual long getNextFrameDelay();
 	};
 }
 
@@ -68,7 +68,7 @@ void IntCycleEffect::onAdded()
 
 	if (component != NULL)
 	{
-		*valuePointer = NULL;
+		*valuePointer = 0;
 		component->invalidate();
 	}
 }
@@ -25,8 +25,8 @@ namespace glaziery
 
 			virtual ~TimeCurve();
 
-			virtual double transform(double raw) = NULL;
-			virtual double untransform(double transformed) = NULL;
+			virtual double transform(double raw) = 0;
+			virtual double untransform(double transformed) = 0;
 	};
 }
 
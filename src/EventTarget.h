@@ -423,14 +423,14 @@ namespace glaziery
 			 * E.g. for components, this is their absolute position,
 			 * and for widgets, it is the absolute position of their component.
 			 */
-			virtual Vector getOrigin() = NULL;
+			virtual Vector getOrigin() = 0;
 
 			/**
 			 * Returns the parent component, usually the container
 			 * (e.g. the window for the client area).
 			 * @return The parent component.
 			 */
-			virtual Component * getParent() = NULL;
+			virtual Component * getParent() = 0;
 
 			/**
 			 * Returns the tooltip, a text that appears in a popup when the pointer is hovered over the event target.
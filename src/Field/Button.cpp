@@ -61,7 +61,10 @@ bool Button::consumingEnter()
 void Button::draw(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
-	Desktop::getInstance()->getSkin()->drawButton(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawButton")
+		Desktop::getInstance()->getSkin()->drawButton(context, this);
+	}
 }
 
 Image * Button::getImage()
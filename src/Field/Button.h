@@ -16,9 +16,9 @@
 	if ((variable = new Button) == NULL) \
 		throw EOUTOFMEMORY; \
 	if (area != NULL) \
-		((FieldsArea *) area)->appendField(variable); \
+		((FieldsArea *) (void *) (area))->appendField(variable); \
 	if (groupField != NULL) \
-		((GroupField *) groupField)->appendField(variable); \
+		((GroupField *) (void *) (groupField))->appendField(variable); \
 	variable->setText(text); \
 	if (image != NULL) \
 		variable->setImage(image);
@@ -81,9 +81,9 @@
 	if ((variable = new Button) == NULL) \
 		throw EOUTOFMEMORY; \
 	if (area != NULL) \
-		((FieldsArea *) area)->appendField(variable); \
+		((FieldsArea *) (void *) (area))->appendField(variable); \
 	if (groupField != NULL) \
-		((GroupField *) groupField)->appendField(variable); \
+		((GroupField *) (void *) (groupField))->appendField(variable); \
 	variable->setText(text); \
 	variable->setImageId(imageId);
 
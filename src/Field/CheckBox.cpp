@@ -31,7 +31,10 @@ CheckBox::~CheckBox()
 void CheckBox::draw(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
-	Desktop::getInstance()->getSkin()->drawCheckBox(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawCheckBox")
+		Desktop::getInstance()->getSkin()->drawCheckBox(context, this);
+	}
 }
 
 CheckBox::State CheckBox::getState()
@@ -16,11 +16,11 @@
 	if ((variable = new CheckBox) == NULL) \
 		throw EOUTOFMEMORY; \
 	if (area != NULL) \
-		((FieldsArea *) area)->appendField(variable); \
+		((FieldsArea *) (void *) (area))->appendField(variable); \
 	if (groupField != NULL) \
-		((GroupField *) groupField)->appendField(variable); \
+		((GroupField *) (void *) (groupField))->appendField(variable); \
 	variable->setText(text); \
-	variable->setState(CheckBox::##state);
+	variable->setState(CheckBox::state);
 
 #define GLAZIERY_CHECKBOX_P(variable, area, groupField, px, py, \
 	text, state) \
@@ -37,12 +37,16 @@ void FieldElement::drawElements(DrawingContext & elementContext, const ArrayList
 		bool textElement = dynamic_cast<TextElement *>(element) != NULL;
 		if (textElement && textElements || !textElement && nonTextElements)
 		{
+			int y;
 			if (element->getAlignment() == FieldElement::ALIGN_CENTER)
-				element->draw(DrawingContext(elementContext, Vector(x, (height - elementSize.y) / 2)));
+				y = (height - elementSize.y) / 2;
 			else if (element->getAlignment() == FieldElement::ALIGN_TOP)
-				element->draw(DrawingContext(elementContext, Vector(x, 0)));
+				y = 0;
 			else
-				element->draw(DrawingContext(elementContext, Vector(x, height - elementSize.y)));
+				y = height - elementSize.y;
+
+			DrawingContext context(elementContext, Vector(x, y));
+			element->draw(context);
 		}
 
 		x += elementSize.x;
@@ -98,7 +98,7 @@ namespace glaziery
 			 * (e.g. list field column).
 			 * @see Desktop::getSkin()
 			 */
-			virtual void draw(DrawingContext & context) = NULL;
+			virtual void draw(DrawingContext & context) = 0;
 
 			/**
 			 * Draws a number of field elements, respecting their vertical alignments.
@@ -125,7 +125,7 @@ namespace glaziery
 			 * Setting a scrolling field enables the popup to move if the scrolling field is scrolled.
 			 * Defaults to NULL.
 			 */
-			virtual void edit(Vector position, Vector size, ScrollingField * scrollingField) = NULL;
+			virtual void edit(Vector position, Vector size, ScrollingField * scrollingField) = 0;
 
 			/**
 			 * Returns the vertical alignment of the element within the list or tree field cell.
@@ -151,7 +151,7 @@ namespace glaziery
 			 * Returns the size of the field element.
 			 * @return The size of the field element.
 			 */
-			virtual Vector getSize() = NULL;
+			virtual Vector getSize() = 0;
 
 			/**
 			 * Returns whether the user can edit this field element.
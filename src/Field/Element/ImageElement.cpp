@@ -28,7 +28,10 @@ void ImageElement::draw(DrawingContext & context)
 	ASSERTION_COBJECT(this);
 
 	if (image != NULL)
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawImageElement")
 		Desktop::getInstance()->getSkin()->drawImageElement(context, this);
+	}
 }
 
 void ImageElement::edit(Vector position, Vector size, ScrollingField * scrollingField)
@@ -30,7 +30,10 @@ TextElement::~TextElement()
 void TextElement::draw(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
-	Desktop::getInstance()->getSkin()->drawTextElement(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawTextElement")
+		Desktop::getInstance()->getSkin()->drawTextElement(context, this);
+	}
 }
 
 void TextElement::edit(Vector position, Vector size, ScrollingField * scrollingField)
@@ -170,12 +173,10 @@ void TextElement::EditPopup::moveDown()
 	if (listField != NULL)
 	{
 		ListField::Cell * cell = (ListField::Cell *) element->getParent();
-		ListField::Column * column = (ListField::Column *) cell->getColumn();
-		int columnNo = listField->getColumnNo(column);
 		ListField::Row * row = (ListField::Row *) cell->getRow();
 		int rowNo = listField->getRowNo(row);
 
-		if (rowNo < listField->getRows().GetCount() - 1)
+		if (rowNo < listField->getRowCount() - 1)
 			rowNo++;
 		else
 			return;
@@ -252,7 +253,7 @@ void TextElement::EditPopup::moveRight()
 		{
 			if (columnNo < columns.GetCount() - 1)
 				columnNo++;
-			else if (rowNo < listField->getRows().GetCount() - 1)
+			else if (rowNo < listField->getRowCount() - 1)
 			{
 				rowNo++;
 				columnNo = 0;
@@ -283,8 +284,6 @@ void TextElement::EditPopup::moveUp()
 	if (listField != NULL)
 	{
 		ListField::Cell * cell = (ListField::Cell *) element->getParent();
-		ListField::Column * column = (ListField::Column *) cell->getColumn();
-		int columnNo = listField->getColumnNo(column);
 		ListField::Row * row = (ListField::Row *) cell->getRow();
 		int rowNo = listField->getRowNo(row);
 
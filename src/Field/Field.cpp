@@ -90,7 +90,10 @@ void Field::destroy()
 	ASSERTION_COBJECT(this);
 
 	if (groupField != NULL)
+	{
 		groupField->fields.Unlink(this);
+		groupField->fieldIndex.invalidate();
+	}
 
 	Component::destroy();
 }
@@ -321,6 +324,7 @@ bool Field::isLikeTitle(Vector position)
 bool Field::moveInternal(Vector position, bool notifyParent)
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_INVALIDATIONCAUSE(CAUSE_MOVE)
 
 	if (Component::moveInternal(position, notifyParent))
 	{
@@ -448,6 +452,7 @@ void Field::removeHotKey(unsigned char hotKey)
 bool Field::resizeInternal(Vector size, bool notifyParent)
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_INVALIDATIONCAUSE(CAUSE_RESIZE)
 
 	if (Component::resizeInternal(size, notifyParent))
 	{
@@ -587,6 +592,7 @@ void Field::setLikeTitle(bool likeTitle)
 void Field::setText(const String & text)
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_INVALIDATIONCAUSE(CAUSE_TEXT)
 
 	String * textAttribute = getTextAttribute();
 	if (textAttribute == NULL)
@@ -0,0 +1,218 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+const int FieldIndex::BAND_HEIGHT = 32;
+const int FieldIndex::MINIMUM_FIELD_COUNT = 32;
+
+FieldIndex::FieldIndex()
+{
+	ASSERTION_COBJECT(this);
+
+	bandCount = 0;
+	bandEntries = NULL;
+	bandStarts = NULL;
+	cursors = NULL;
+	fieldCount = 0;
+	groupField = NULL;
+	linear = true;
+	queryFirstBand = 0;
+	queryLastBand = -1;
+	queryLastFieldNo = -1;
+	valid = false;
+}
+
+FieldIndex::~FieldIndex()
+{
+	ASSERTION_COBJECT(this);
+	release();
+}
+
+void FieldIndex::build(const ArrayList<Field> & fields)
+{
+	ASSERTION_COBJECT(this);
+
+	release();
+
+	fieldCount = fields.GetCount();
+	valid = true;
+
+	int maximumBottom = 1;
+	int fieldNo;
+	for (fieldNo = 0; fieldNo < fieldCount; fieldNo++)
+	{
+		Field * field = fields.Get(fieldNo);
+		if (isIndexed(field) && field->getPosition().y + field->getSize().y > maximumBottom)
+			maximumBottom = field->getPosition().y + field->getSize().y;
+	}
+
+	bandCount = (maximumBottom - 1) / BAND_HEIGHT + 1;
+	if ((bandStarts = new int[bandCount + 1]) == NULL)
+		throw EOUTOFMEMORY;
+	if ((cursors = new int[bandCount]) == NULL)
+		throw EOUTOFMEMORY;
+
+	// First pass: Count the entries per band (into the cursors temporarily)
+	int band;
+	for (band = 0; band < bandCount; band++)
+		cursors[band] = 0;
+
+	int entryCount = 0;
+	for (fieldNo = 0; fieldNo < fieldCount; fieldNo++)
+	{
+		Field * field = fields.Get(fieldNo);
+		if (!isIndexed(field) || field->getSize().y <= 0)
+			continue;
+
+		int top = field->getPosition().y;
+		int bottom = top + field->getSize().y - 1;
+		if (bottom < 0)
+			continue;
+
+		int lastBand = bottom / BAND_HEIGHT;
+		for (band = top > 0 ? top / BAND_HEIGHT : 0; band <= lastBand; band++)
+		{
+			cursors[band]++;
+			entryCount++;
+		}
+	}
+
+	bandStarts[0] = 0;
+	for (band = 0; band < bandCount; band++)
+	{
+		bandStarts[band + 1] = bandStarts[band] + cursors[band];
+		cursors[band] = bandStarts[band];
+	}
+
+	// Second pass: Fill the bands in ascending field order
+	if ((bandEntries = new int[entryCount > 0 ? entryCount : 1]) == NULL)
+		throw EOUTOFMEMORY;
+
+	for (fieldNo = 0; fieldNo < fieldCount; fieldNo++)
+	{
+		Field * field = fields.Get(fieldNo);
+		if (!isIndexed(field) || field->getSize().y <= 0)
+			continue;
+
+		int top = field->getPosition().y;
+		int bottom = top + field->getSize().y - 1;
+		if (bottom < 0)
+			continue;
+
+		int lastBand = bottom / BAND_HEIGHT;
+		for (band = top > 0 ? top / BAND_HEIGHT : 0; band <= lastBand; band++)
+			bandEntries[cursors[band]++] = fieldNo;
+	}
+}
+
+int FieldIndex::getNextFieldNo(const ArrayList<Field> & fields)
+{
+	ASSERTION_COBJECT(this);
+
+	if (linear)
+	{
+		while (++queryLastFieldNo < fields.GetCount())
+		{
+			Field * field = fields.Get(queryLastFieldNo);
+			if (isIndexed(field) && isInQuery(field))
+				return queryLastFieldNo;
+		}
+
+		return -1;
+	}
+
+	// Merge the bands of the query, dropping duplicates of fields spanning multiple bands
+	while (true)
+	{
+		int fieldNo = -1;
+		int band;
+		for (band = queryFirstBand; band <= queryLastBand; band++)
+			if (cursors[band] < bandStarts[band + 1]
+				&& (fieldNo < 0 || bandEntries[cursors[band]] < fieldNo))
+				fieldNo = bandEntries[cursors[band]];
+
+		if (fieldNo < 0)
+			return -1;
+
+		for (band = queryFirstBand; band <= queryLastBand; band++)
+			if (cursors[band] < bandStarts[band + 1] && bandEntries[cursors[band]] == fieldNo)
+				cursors[band]++;
+
+		if (isInQuery(fields.Get(fieldNo)))
+			return fieldNo;
+	}
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(FieldIndex, CObject);
+#endif
+
+void FieldIndex::invalidate()
+{
+	ASSERTION_COBJECT(this);
+	valid = false;
+}
+
+bool FieldIndex::isIndexed(Field * field)
+{
+	ASSERTION_COBJECT(this);
+	return field->getGroupField() == groupField;
+}
+
+bool FieldIndex::isInQuery(Field * field)
+{
+	ASSERTION_COBJECT(this);
+
+	Vector position = field->getPosition();
+	return position < queryPosition + querySize && queryPosition < position + field->getSize();
+}
+
+void FieldIndex::release()
+{
+	ASSERTION_COBJECT(this);
+
+	if (bandEntries != NULL) {delete[] bandEntries; bandEntries = NULL;}
+	if (bandStarts != NULL) {delete[] bandStarts; bandStarts = NULL;}
+	if (cursors != NULL) {delete[] cursors; cursors = NULL;}
+	bandCount = 0;
+}
+
+void FieldIndex::startQuery(const ArrayList<Field> & fields, GroupField * groupField, Vector position, Vector size)
+{
+	ASSERTION_COBJECT(this);
+
+	queryPosition = position;
+	querySize = size;
+	queryLastFieldNo = -1;
+
+	if (this->groupField != groupField)
+	{
+		this->groupField = groupField;
+		valid = false;
+	}
+
+	linear = fields.GetCount() < MINIMUM_FIELD_COUNT;
+	if (linear)
+		return;
+
+	if (!valid || fieldCount != fields.GetCount())
+		build(fields);
+
+	queryFirstBand = position.y > 0 ? position.y / BAND_HEIGHT : 0;
+	queryLastBand = (position.y + size.y - 1) / BAND_HEIGHT;
+	if (queryLastBand >= bandCount)
+		queryLastBand = bandCount - 1;
+	if (size.x <= 0 || size.y <= 0 || position.y + size.y <= 0)
+		queryLastBand = queryFirstBand - 1;
+
+	for (int band = queryFirstBand; band <= queryLastBand; band++)
+		cursors[band] = bandStarts[band];
+}
@@ -0,0 +1,185 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_FIELDINDEX_H
+#define __GLAZIERY_FIELDINDEX_H
+
+
+namespace glaziery
+{
+	/**
+	 * The field index is a spatial index over the fields of a fields area or a group field.
+	 * It answers which fields overlap a given rectangle (usually the clipping area while drawing)
+	 * without visiting all fields. Fields are sorted into horizontal bands of BAND_HEIGHT pixels,
+	 * each listing the numbers of the fields overlapping it in ascending order, so that a query
+	 * returns the fields in their original (drawing) order.
+	 * Containers with less than MINIMUM_FIELD_COUNT fields are scanned linearly instead.
+	 * The index is rebuilt lazily with the next query after it has been invalidated,
+	 * so the container must invalidate it whenever fields are added, removed, moved, or resized.
+	 */
+	#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+		class FieldIndex : public CObject
+	#else
+		class FieldIndex
+	#endif
+	{
+		private:
+
+			/**
+			 * The height of a band in pixels.
+			 */
+			static const int BAND_HEIGHT;
+
+			/**
+			 * The minimum number of fields to build an index for.
+			 */
+			static const int MINIMUM_FIELD_COUNT;
+
+			/**
+			 * The number of bands of the index.
+			 */
+			int bandCount;
+
+			/**
+			 * The field numbers of all bands, ascending within each band.
+			 * The entries of band i range from bandStarts[i] to bandStarts[i+1] - 1.
+			 */
+			int * bandEntries;
+
+			/**
+			 * The entry offsets of all bands, plus the end offset (bandCount + 1 entries).
+			 */
+			int * bandStarts;
+
+			/**
+			 * The current query's next entry offset of each band.
+			 */
+			int * cursors;
+
+			/**
+			 * The number of fields in the container when the index has been built.
+			 */
+			int fieldCount;
+
+			/**
+			 * The group field whose fields are indexed, or NULL for
+			 * the fields of the area that are not part of a group field.
+			 */
+			GroupField * groupField;
+
+			/**
+			 * Whether the current query scans all fields linearly.
+			 */
+			bool linear;
+
+			/**
+			 * The current query's first band.
+			 */
+			int queryFirstBand;
+
+			/**
+			 * The current query's last band.
+			 */
+			int queryLastBand;
+
+			/**
+			 * The current query's last field number returned.
+			 */
+			int queryLastFieldNo;
+
+			/**
+			 * The top-left position of the current query's rectangle.
+			 */
+			Vector queryPosition;
+
+			/**
+			 * The size of the current query's rectangle.
+			 */
+			Vector querySize;
+
+			/**
+			 * Whether the index represents the current fields, their positions, and sizes.
+			 */
+			bool valid;
+
+			/**
+			 * Rebuilds the bands from the current fields.
+			 * @param fields The fields of the container.
+			 */
+			void build(const ArrayList<Field> & fields);
+
+			/**
+			 * Returns whether a field is indexed (member of the group field, resp. of no group).
+			 * @param field The field to be checked.
+			 * @return Whether the field is indexed.
+			 */
+			bool isIndexed(Field * field);
+
+			/**
+			 * Returns whether a field overlaps the current query's rectangle.
+			 * @param field The field to be checked.
+			 * @return Whether the field overlaps.
+			 */
+			bool isInQuery(Field * field);
+
+			/**
+			 * Releases the bands.
+			 */
+			void release();
+
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(FieldIndex);
+			#endif
+
+		public:
+
+			/**
+			 * Creates a new field index.
+			 */
+			FieldIndex();
+
+			/**
+			 * Destroys the field index.
+			 */
+			~FieldIndex();
+
+			/**
+			 * Returns the number of the next field overlapping the current query's rectangle,
+			 * in ascending order. Invisible fields are returned, too.
+			 * @param fields The fields of the container, as passed to startQuery().
+			 * @return The field number, or -1 if there are no more fields.
+			 * @see startQuery()
+			 */
+			int getNextFieldNo(const ArrayList<Field> & fields);
+
+			/**
+			 * Invalidates the index, so that it is rebuilt with the next query.
+			 * Call this method whenever a field is added, removed, moved, or resized.
+			 */
+			void invalidate();
+
+			/**
+			 * Starts a query for the fields overlapping a given rectangle.
+			 * Then, call getNextFieldNo() until it returns -1.
+			 * @param fields The fields of the container.
+			 * @param groupField The group field whose fields are queried, or NULL for
+			 * the fields of the area that are not part of a group field.
+			 * @param position The top-left position of the rectangle,
+			 * relative to the container's fields.
+			 * @param size The size of the rectangle.
+			 * @see getNextFieldNo()
+			 */
+			void startQuery(const ArrayList<Field> & fields, GroupField * groupField, Vector position, Vector size);
+	};
+}
+
+
+#endif
@@ -42,6 +42,11 @@ GroupField::~GroupField()
 			field->parent = getClientArea();
 	}
 
+	// The fields are drawn by the fields area again
+	FieldsArea * fieldsArea = getFieldsArea();
+	if (fieldsArea != NULL)
+		fieldsArea->fieldIndex.invalidate();
+
 	if (groupLayoutData != NULL) {delete groupLayoutData; groupLayoutData = NULL;}
 }
 
@@ -55,15 +60,22 @@ void GroupField::draw(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
 
-	Desktop::getInstance()->getSkin()->drawGroupField(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawGroupField")
+		Desktop::getInstance()->getSkin()->drawGroupField(context, this);
+	}
 
 	#ifdef GL_DEBUG_FIELDBOUNDS
 		PlatformAdapter * adapter = Desktop::getInstance()->getPlatformAdapter();
 	#endif
 
-	for (int i=0; i<fields.GetCount(); i++)
+	// Draw only the fields within the clipping area (e.g. the invalid area of the window)
+	fieldIndex.startQuery(fields, this, context.getClippingOffset() - context.getDrawingOffset(),
+		context.getClippingSize());
+	int fieldNo;
+	while ((fieldNo = fieldIndex.getNextFieldNo(fields)) >= 0)
 	{
-		Field * field = fields.Get(i);
+		Field * field = fields.Get(fieldNo);
 		if (field->isVisible())
 		{
 			DrawingContext fieldContext(context, field);
@@ -73,7 +85,7 @@ void GroupField::draw(DrawingContext & context)
 					GL_TRANSPARENCY, GL_RGBA(128, 160, 128, 128));
 			#endif
 
-			field->draw(fieldContext);
+			field->drawRecorded(fieldContext);
 		}
 	}
 }
@@ -134,13 +146,18 @@ void GroupField::insertField(int position, Field * field)
 		throw EILLEGALARGUMENT("The field has already been added to another group field");
 
 	fields.Insert(field, position);
+	fieldIndex.invalidate();
 	field->groupField = this;
 	unsetComponentParent(field);
 	setComponentParent(field);
 
+	// The field is not drawn by its fields area anymore
 	FieldsArea * fieldsArea = getFieldsArea();
 	if (fieldsArea != NULL)
+	{
+		fieldsArea->fieldIndex.invalidate();
 		fieldsArea->layoutIfAutomatic();
+	}
 
 	invalidate();
 }
@@ -157,6 +174,22 @@ bool GroupField::isBordered()
 	return bordered;
 }
 
+void GroupField::onChildMoved(Component * child, Vector oldPosition)
+{
+	ASSERTION_COBJECT(this);
+
+	Field::onChildMoved(child, oldPosition);
+	fieldIndex.invalidate();
+}
+
+void GroupField::onChildResized(Component * child, Vector oldSize)
+{
+	ASSERTION_COBJECT(this);
+
+	Field::onChildResized(child, oldSize);
+	fieldIndex.invalidate();
+}
+
 void GroupField::prependField(Field * field)
 {
 	ASSERTION_COBJECT(this);
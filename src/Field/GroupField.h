@@ -15,9 +15,9 @@
 	if ((variable = new GroupField) == NULL) \
 		throw EOUTOFMEMORY; \
 	if (area != NULL) \
-		((FieldsArea *) area)->appendField(variable); \
+		((FieldsArea *) (void *) (area))->appendField(variable); \
 	if (groupField != NULL) \
-		((GroupField *) groupField)->appendField(variable); \
+		((GroupField *) (void *) (groupField))->appendField(variable); \
 	variable->getGroupLayoutData()->setTopLeftMargin(Vector()); \
 	variable->getGroupLayoutData()->setBottomRightMargin(Vector());
 
@@ -66,9 +66,9 @@
 	if ((variable = new GroupField) == NULL) \
 		throw EOUTOFMEMORY; \
 	if (area != NULL) \
-		((FieldsArea *) area)->appendField(variable); \
+		((FieldsArea *) (void *) (area))->appendField(variable); \
 	if (groupField != NULL) \
-		((GroupField *) groupField)->appendField(variable); \
+		((GroupField *) (void *) (groupField))->appendField(variable); \
 	variable->setBordered(true); \
 	variable->setText(text);
 
@@ -141,6 +141,11 @@ namespace glaziery
 			 */
 			bool bordered;
 
+			/**
+			 * The spatial index of the fields, used to draw only the fields within the clipping area.
+			 */
+			FieldIndex fieldIndex;
+
 			/**
 			 * The fields contained in this group field.
 			 */
@@ -277,6 +282,26 @@ namespace glaziery
 			 */
 			bool isBordered();
 
+			/**
+			 * Performs operations necessary when a child component
+			 * has been moved within this parent. E.g. move the parent,
+			 * too, if the child uses all the area of the parent, or
+			 * ignore the event if the child can move freely.
+			 * @param child The child component that moved.
+			 * @param oldPosition The position of the child before the move.
+			 */
+			virtual void onChildMoved(Component * child, Vector oldPosition);
+
+			/**
+			 * Performs operations necessary when a child component
+			 * has been resized within this parent. E.g. resize the parent,
+			 * too, if the child uses all the area of the parent, or
+			 * ignore the event if the child can resize freely.
+			 * @param child The child component that resized.
+			 * @param oldSize The size of the child before the resize.
+			 */
+			virtual void onChildResized(Component * child, Vector oldSize);
+
 			/**
 			 * Prepends a field at the beginning of the fields list of this group field.
 			 * @param field The field to be added.
@@ -27,7 +27,10 @@ ImageField::~ImageField()
 void ImageField::draw(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
-	Desktop::getInstance()->getSkin()->drawImageField(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawImageField")
+		Desktop::getInstance()->getSkin()->drawImageField(context, this);
+	}
 }
 
 Image * ImageField::getImage()
@@ -16,9 +16,9 @@
 	if ((variable = new ImageField) == NULL) \
 		throw EOUTOFMEMORY; \
 	if (area != NULL) \
-		((FieldsArea *) area)->appendField(variable); \
+		((FieldsArea *) (void *) (area))->appendField(variable); \
 	if (groupField != NULL) \
-		((GroupField *) groupField)->appendField(variable); \
+		((GroupField *) (void *) (groupField))->appendField(variable); \
 	if (image != NULL) \
 		variable->setImage(image);
 
@@ -74,9 +74,9 @@
 	if ((variable = new ImageField) == NULL) \
 		throw EOUTOFMEMORY; \
 	if (area != NULL) \
-		((FieldsArea *) area)->appendField(variable); \
+		((FieldsArea *) (void *) (area))->appendField(variable); \
 	if (groupField != NULL) \
-		((GroupField *) groupField)->appendField(variable); \
+		((GroupField *) (void *) (groupField))->appendField(variable); \
 	variable->setImageId(imageId);
 
 #define GLAZIERY_IMAGEFIELD_IP(variable, area, groupField, px, py, \
@@ -25,7 +25,10 @@ KeyStrokeField::KeyStrokeField()
 void KeyStrokeField::draw(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
-	Desktop::getInstance()->getSkin()->drawKeyStrokeField(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawKeyStrokeField")
+		Desktop::getInstance()->getSkin()->drawKeyStrokeField(context, this);
+	}
 }
 
 int KeyStrokeField::getKeyCode()
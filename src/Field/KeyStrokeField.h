@@ -15,9 +15,9 @@
 	if ((variable = new KeyStrokeField) == NULL) \
 		throw EOUTOFMEMORY; \
 	if (area != NULL) \
-		((FieldsArea *) area)->appendField(variable); \
+		((FieldsArea *) (void *) (area))->appendField(variable); \
 	if (groupField != NULL) \
-		((GroupField *) groupField)->appendField(variable);
+		((GroupField *) (void *) (groupField))->appendField(variable);
 
 #define GLAZIERY_KEYSTROKEFIELD_P(variable, area, groupField, px, py) \
 	GLAZIERY_KEYSTROKEFIELD(variable, area, groupField) \
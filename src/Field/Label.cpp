@@ -38,7 +38,10 @@ void Label::autoResize()
 void Label::draw(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
-	Desktop::getInstance()->getSkin()->drawLabel(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawLabel")
+		Desktop::getInstance()->getSkin()->drawLabel(context, this);
+	}
 }
 
 Label::UrlPosition * Label::getUrlPositionAt(Vector position)
@@ -15,9 +15,9 @@
 	if ((variable = new Label) == NULL) \
 		throw EOUTOFMEMORY; \
 	if (area != NULL) \
-		((FieldsArea *) area)->appendField(variable); \
+		((FieldsArea *) (void *) (area))->appendField(variable); \
 	if (groupField != NULL) \
-		((GroupField *) groupField)->appendField(variable); \
+		((GroupField *) (void *) (groupField))->appendField(variable); \
 	variable->setText(text);
 
 #define GLAZIERY_LABEL_P(variable, area, groupField, px, py, text) \
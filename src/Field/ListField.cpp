@@ -19,13 +19,32 @@ ListField::ListField()
 
 	columnsMovable = false;
 	columnsResizable = true;
+	filterColumnCount = 0;
+	filterColumnNos = NULL;
+	filterIndex = NULL;
+	filterTextBuffer = NULL;
+	filterTextBufferSize = 0;
 	focusColumnNo = 0;
 	focusRowNo = 0;
 	headlined = true;
 	horizontallyScrollable = true;
+	materializing = false;
+	modelBucketCount = 0;
+	modelBuckets = NULL;
+	modelRowCount = 0;
+	provider = NULL;
+	providerRowCount = 0;
 	rangeStartRowNo = 0;
 	rowsRemovable = true;
+	selectedRowsVersion = -1;
+	sortJob = NULL;
+	memset(transientRows, 0, sizeof(transientRows));
 	type = TYPE_MANY;
+	updateAddedRowCount = 0;
+	updateAddedRowNo = 0;
+	updateDepth = 0;
+	updateRowsRemoved = false;
+	updateSelectionChanged = false;
 	verticallyScrollable = true;
 
 	adjustRowsField();
@@ -38,6 +57,28 @@ ListField::ListField()
 ListField::~ListField()
 {
 	ASSERTION_COBJECT(this);
+
+	// Wait for all worker threads, since they defer this list field when finishing
+	cancelSortJob();
+	canceledSortJobs.DeleteAll();
+	Desktop * desktop = Desktop::getInstance();
+	if (desktop != NULL)
+		desktop->undeferObject(this);
+
+	// The visible rows are destroyed with the rows, the hidden ones are owned by the filter
+	filterPendingRows.UnlinkAll();
+	filterRowPositions.clear();
+	for (int i = filterRows.GetCount() - 1; i >= 0; i--)
+		if (filterRows.Get(i)->hidden)
+			filterRows.Delete(i);
+	filterRows.UnlinkAll();
+	destroyFilterIndex();
+	if (filterColumnNos != NULL) {delete[] filterColumnNos; filterColumnNos = NULL;}
+	if (filterTextBuffer != NULL) {delete[] filterTextBuffer; filterTextBuffer = NULL;}
+
+	destroyTransientRows();
+	if (provider != NULL) {provider->release(); provider = NULL;}
+	if (modelBuckets != NULL) {delete[] modelBuckets; modelBuckets = NULL;}
 	selectedRows.RemoveAll();
 }
 
@@ -72,7 +113,8 @@ void ListField::adjustAutoColumns()
 	int contentViewWidth = rowsField.getContentViewSize().x;
 	int autoColumns = 0;
 	for (int i=0; i<columns.GetCount(); i++)
-		if (columns.Get(i)->isVisible() && columns.Get(i)->isAutoResizing())
+		if (columns.Get(i)->isVisible() && columns.Get(i)->isAutoResizing()
+			&& !columns.Get(i)->isFittingContent())
 			autoColumns++;
 		else
 			contentViewWidth -= columns.Get(i)->getActualWidth();
@@ -81,7 +123,8 @@ void ListField::adjustAutoColumns()
 		contentViewWidth = 0;
 
 	for (int i=0; i<columns.GetCount(); i++)
-		if (columns.Get(i)->isVisible() && columns.Get(i)->isAutoResizing())
+		if (columns.Get(i)->isVisible() && columns.Get(i)->isAutoResizing()
+			&& !columns.Get(i)->isFittingContent())
 		{
 			int width = contentViewWidth / autoColumns;
 			columns.Get(i)->setWidth(width);
@@ -116,27 +159,241 @@ void ListField::appendRow(ListField::Row * row)
 	insertRow(rows.GetCount(), row);
 }
 
+void ListField::applyFilterToPendingRows()
+{
+	ASSERTION_COBJECT(this);
+
+	// Within an update, the rows are tested when it ends
+	if (filterPendingRows.IsEmpty() || updateDepth > 0)
+		return;
+
+	char * query = RowTextIndex::toLowerCase((const char *) filterText);
+	bool hiding = false;
+	for (int i=0; i<filterPendingRows.GetCount(); i++)
+	{
+		Row * row = filterPendingRows.Get(i);
+		row->filterPending = false;
+		if (!matchesFilter(row, query))
+		{
+			unindexRowModel(row);
+			row->hidden = true;
+			hiding = true;
+		}
+	}
+	filterPendingRows.UnlinkAll();
+	delete[] query;
+
+	if (hiding)
+		showFilteredRows();
+}
+
+void ListField::applySortJob(SortJob * job)
+{
+	ASSERTION_COBJECT(this);
+	ASSERTION(job->rowCount == rows.GetCount());
+
+	Row * focusRow = getFocusRow();
+	Row * rangeStartRow = getRow(rangeStartRowNo);
+
+	Row ** sortedRows;
+	if ((sortedRows = new Row *[job->rowCount]) == NULL)
+		throw EOUTOFMEMORY;
+
+	int * selectedRowNos;
+	if ((selectedRowNos = new int[selection.getCount() + 1]) == NULL)
+		throw EOUTOFMEMORY;
+
+	int i;
+	int selectedRowCount = 0;
+	for (i=0; i<job->rowCount; i++)
+	{
+		sortedRows[i] = rows.Get(job->order[i]);
+		if (selection.contains(job->order[i]))
+			selectedRowNos[selectedRowCount++] = i;
+	}
+	rows.UnlinkAll();
+	for (i=0; i<job->rowCount; i++)
+		rows.Append(sortedRows[i]);
+	delete[] sortedRows;
+	repositionRows();
+
+	// The selection follows the rows to their new numbers
+	selection.clear();
+	for (i=0; i<selectedRowCount; i++)
+		selection.select(selectedRowNos[i]);
+	delete[] selectedRowNos;
+
+	syncFilterRows();
+
+	if (focusRow != NULL)
+		focusRowNo = getRowNo(focusRow);
+	if (rangeStartRow != NULL)
+		rangeStartRowNo = getRowNo(rangeStartRow);
+
+	ensureFocusVisible();
+	invalidate();
+}
+
+void ListField::beginUpdate()
+{
+	ASSERTION_COBJECT(this);
+	updateDepth++;
+}
+
+void ListField::cancelSortJob()
+{
+	ASSERTION_COBJECT(this);
+
+	if (sortJob == NULL)
+		return;
+
+	Mutex * mutex = Desktop::getInstance()->getDeferralMutex();
+	if (!mutex->lock())
+		throw EILLEGALSTATE("Locking did not succeed");
+	sortJob->canceled = true;
+	mutex->release();
+
+	canceledSortJobs.Append(sortJob);
+	sortJob = NULL;
+
+	destroyFinishedSortJobs();
+}
+
+void ListField::deleteRows(const int * rowNos, int rowCount)
+{
+	ASSERTION_COBJECT(this);
+
+	if (rowCount <= 0)
+		return;
+
+	Row ** deletedRows;
+	if ((deletedRows = new Row *[rowCount]) == NULL)
+		throw EOUTOFMEMORY;
+
+	Row ** keptRows;
+	if ((keptRows = new Row *[(isFiltered() ? filterRows.GetCount() : rows.GetCount()) + 1]) == NULL)
+	{
+		delete[] deletedRows;
+		throw EOUTOFMEMORY;
+	}
+
+	int i;
+	int deletedRowCount = 0;
+	int keptRowCount = 0;
+	bool pendingDeleted = false;
+	for (i=0; i<rows.GetCount(); i++)
+	{
+		Row * row = rows.Get(i);
+		if (deletedRowCount < rowCount && rowNos[deletedRowCount] == i)
+		{
+			unindexRowModel(row);
+			deletedRows[deletedRowCount++] = row;
+			if (row->filterPending)
+			{
+				row->filterPending = false;
+				pendingDeleted = true;
+			}
+		}
+		else
+			keptRows[keptRowCount++] = row;
+	}
+
+	rows.UnlinkAll();
+	for (i=0; i<keptRowCount; i++)
+		rows.Append(keptRows[i]);
+	repositionRows();
+
+	// The deleted rows are not positioned anymore, unlike the kept and the hidden ones
+	if (isFiltered())
+	{
+		keptRowCount = 0;
+		for (i=0; i<filterRows.GetCount(); i++)
+		{
+			Row * row = filterRows.Get(i);
+			if (row->hidden || getRowNo(row) >= 0)
+				keptRows[keptRowCount++] = row;
+			else if (filterIndex != NULL)
+				filterIndex->removeRow(row->filterIndexRowNo);
+		}
+
+		filterRows.UnlinkAll();
+		for (i=0; i<keptRowCount; i++)
+			filterRows.Append(keptRows[i]);
+		repositionFilterRows();
+	}
+
+	if (pendingDeleted)
+	{
+		keptRowCount = 0;
+		for (i=0; i<filterPendingRows.GetCount(); i++)
+			if (filterPendingRows.Get(i)->filterPending)
+				keptRows[keptRowCount++] = filterPendingRows.Get(i);
+
+		filterPendingRows.UnlinkAll();
+		for (i=0; i<keptRowCount; i++)
+			filterPendingRows.Append(keptRows[i]);
+	}
+	delete[] keptRows;
+
+	for (i=0; i<deletedRowCount; i++)
+		delete deletedRows[i];
+	delete[] deletedRows;
+}
+
+void ListField::destroyFilterIndex()
+{
+	ASSERTION_COBJECT(this);
+
+	if (filterIndex != NULL)
+	{
+		delete filterIndex;
+		filterIndex = NULL;
+	}
+}
+
+void ListField::destroyFinishedSortJobs()
+{
+	ASSERTION_COBJECT(this);
+
+	for (int i = canceledSortJobs.GetCount() - 1; i >= 0; i--)
+		if (canceledSortJobs.Get(i)->isFinished())
+			canceledSortJobs.Delete(i);
+}
+
+void ListField::destroyTransientRows()
+{
+	ASSERTION_COBJECT(this);
+
+	for (int i=0; i<GL_LISTFIELD_TRANSIENTROWS; i++)
+		if (transientRows[i] != NULL) {delete transientRows[i]; transientRows[i] = NULL;}
+}
+
 void ListField::draw(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
 
 	Skin * skin = Desktop::getInstance()->getSkin();
-	skin->drawListField(DrawingContext(context, Vector(-rowsField.getScrollPositionNow().x, 0)), this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawListField")
+		DrawingContext scrolledContext(context, Vector(-rowsField.getScrollPositionNow().x, 0));
+		skin->drawListField(scrolledContext, this);
+	}
 
-	rowsField.draw(DrawingContext(context, &rowsField));
+	DrawingContext rowsContext(context, &rowsField);
+	rowsField.draw(rowsContext);
 }
 
 void ListField::ensureCellVisible(int rowNo, int columnNo, bool now)
 {
 	ASSERTION_COBJECT(this);
 
-	if (columns.IsEmpty() || rows.IsEmpty())
+	if (columns.IsEmpty() || getRowCount() == 0)
 		return;
 
 	if (rowNo < 0)
 		rowNo = 0;
-	if (rowNo > rows.GetCount() - 1)
-		rowNo = rows.GetCount() - 1;
+	if (rowNo > getRowCount() - 1)
+		rowNo = getRowCount() - 1;
 	if (columnNo < 0)
 		columnNo = 0;
 	if (columnNo > columns.GetCount() - 1)
@@ -177,43 +434,117 @@ void ListField::ensureCellVisible(int rowNo, int columnNo, bool now)
 		rowsField.ensureVisibleNow(topLeftVector, bottomRightVector);
 }
 
+void ListField::endUpdate()
+{
+	ASSERTION_COBJECT(this);
+
+	if (updateDepth <= 0)
+		throw EILLEGALSTATE("The list field is not being updated");
+	if (--updateDepth > 0)
+		return;
+
+	fitColumns();
+	rowsField.updateContentSize();
+	if (updateRowsRemoved)
+		ensureFocusVisible();
+	invalidate();
+
+	flushAddedRows();
+	applyFilterToPendingRows();
+	if (updateRowsRemoved)
+	{
+		updateRowsRemoved = false;
+		notifyRowsRemoved();
+	}
+	if (updateSelectionChanged)
+	{
+		updateSelectionChanged = false;
+		notifySelectionChanged();
+	}
+}
+
+void ListField::ensureFilterTextBufferSize(int size)
+{
+	ASSERTION_COBJECT(this);
+
+	if (size <= filterTextBufferSize)
+		return;
+
+	int newSize = filterTextBufferSize + filterTextBufferSize / 2;
+	if (newSize < size)
+		newSize = size;
+	if (newSize < 256)
+		newSize = 256;
+
+	char * newBuffer;
+	if ((newBuffer = new char[newSize]) == NULL)
+		throw EOUTOFMEMORY;
+
+	if (filterTextBuffer != NULL)
+	{
+		memcpy(newBuffer, filterTextBuffer, filterTextBufferSize);
+		delete[] filterTextBuffer;
+	}
+
+	filterTextBuffer = newBuffer;
+	filterTextBufferSize = newSize;
+}
+
 void ListField::ensureFocusVisible(bool now)
 {
 	ASSERTION_COBJECT(this);
 	ensureCellVisible(getFocusRowNo(), getFocusColumnNo(), now);
 }
 
+void ListField::executeDeferrals()
+{
+	ASSERTION_COBJECT(this);
+
+	InputField::executeDeferrals();
+
+	applyFilterToPendingRows();
+
+	destroyFinishedSortJobs();
+	if (sortJob != NULL && sortJob->deferred)
+	{
+		SortJob * job = sortJob;
+		sortJob = NULL;
+		applySortJob(job);
+		delete job;
+	}
+}
+
 void ListField::finishRowRemoval(bool selectionChanged)
 {
 	ASSERTION_COBJECT(this);
 
-	if (rows.IsEmpty())
+	if (getRowCount() == 0)
 	{
 		focusRowNo = 0;
 		rangeStartRowNo = 0;
 	}
 	else
 	{
-		if (type == TYPE_ONE && selectedRows.IsEmpty())
+		if (type == TYPE_ONE && getSelectedRowCount() == 0
+			&& focusRowNo >= 0 && focusRowNo < getRowCount())
 		{
-			Row * row = rows.Get(focusRowNo);
-			if (row != NULL)
-			{
-				selectedRows.Add(row);
-				selectionChanged = true;
-			}
+			selectRowInternal(focusRowNo);
+			selectionChanged = true;
 		}
 	}
 
-	int listenersCount = listeners.GetCount();
-	for (int i=0; i<listenersCount; i++)
+	// Within an update, the listeners are notified when it ends
+	if (updateDepth > 0)
 	{
-		ListField::Listener * listFieldListener
-			= dynamic_cast<ListField::Listener *>(listeners.Get(i));
-		if (listFieldListener != NULL)
-			listFieldListener->onRowsRemoved(this);
+		updateRowsRemoved = true;
+		if (selectionChanged)
+			updateSelectionChanged = true;
+		return;
 	}
 
+	fitColumns();
+	notifyRowsRemoved();
+
 	rowsField.updateContentSize();
 	ensureFocusVisible();
 	if (selectionChanged)
@@ -221,11 +552,46 @@ void ListField::finishRowRemoval(bool selectionChanged)
 	invalidate();
 }
 
+void ListField::fitColumn(Column * column)
+{
+	ASSERTION_COBJECT(this);
+
+	if (!column->isFittingContent())
+		return;
+
+	int paddingWidth = Desktop::getInstance()->getSkin()->getListFieldColumnPaddingWidth(this);
+	int width = getFont()->getWidth(column->getHeading(), isCaps());
+	if (width < column->getContentWidth())
+		width = column->getContentWidth();
+	column->setWidth(width + 2 * paddingWidth);
+}
+
+void ListField::fitColumns()
+{
+	ASSERTION_COBJECT(this);
+
+	for (int i=0; i<columns.GetCount(); i++)
+		fitColumn(columns.Get(i));
+}
+
+void ListField::flushAddedRows()
+{
+	ASSERTION_COBJECT(this);
+
+	if (updateAddedRowCount == 0)
+		return;
+
+	int rowNo = updateAddedRowNo;
+	int rowCount = updateAddedRowCount;
+	updateAddedRowCount = 0;
+	notifyRowsAdded(rowNo, rowCount);
+}
+
 ListField::Cell * ListField::getCell(int rowNo, int cellNo)
 {
 	ASSERTION_COBJECT(this);
 
-	ListField::Row * row = rows.Get(rowNo);
+	ListField::Row * row = getRow(rowNo);
 	return row != NULL ? row->getCell(cellNo) : NULL;
 }
 
@@ -292,6 +658,76 @@ EventTarget * ListField::getEventTargetAt(Vector position)
 	return this;
 }
 
+const String & ListField::getFilter()
+{
+	ASSERTION_COBJECT(this);
+	return filterText;
+}
+
+RowTextIndex * ListField::getFilterIndex()
+{
+	ASSERTION_COBJECT(this);
+
+	if (filterIndex == NULL)
+	{
+		if ((filterIndex = new RowTextIndex) == NULL)
+			throw EOUTOFMEMORY;
+
+		for (int i=0; i<filterRows.GetCount(); i++)
+		{
+			Row * row = filterRows.Get(i);
+			row->filterIndexRowNo = filterIndex->addRow(getFilterText(row));
+		}
+	}
+
+	return filterIndex;
+}
+
+int ListField::getFilterRowNo(Row * row)
+{
+	ASSERTION_COBJECT(this);
+	return filterRowPositions.getPosition(&row->filterPosition);
+}
+
+const char * ListField::getFilterText(Row * row)
+{
+	ASSERTION_COBJECT(this);
+
+	int columnCount = filterColumnNos != NULL ? filterColumnCount : columns.GetCount();
+	const ArrayList<Cell> & cells = row->getCells();
+
+	// Like the cell texts, but lower-cased into the buffer instead of allocating strings
+	int length = 0;
+	for (int i=0; i<columnCount; i++)
+	{
+		int columnNo = filterColumnNos != NULL ? filterColumnNos[i] : i;
+		if (columnNo >= 0 && columnNo < cells.GetCount())
+		{
+			const ArrayList<FieldElement> & elements = cells.Get(columnNo)->elements;
+			for (int j=0; j<elements.GetCount(); j++)
+			{
+				TextElement * element = dynamic_cast<TextElement *>(elements.Get(j));
+				if (element == NULL)
+					continue;
+
+				const char * text = (const char *) element->getText();
+				int textLength = element->getText().GetLength();
+				ensureFilterTextBufferSize(length + textLength + 2);
+				for (int k=0; k<textLength; k++)
+					filterTextBuffer[length++] = (char) tolower((unsigned char) text[k]);
+			}
+		}
+
+		ensureFilterTextBufferSize(length + 2);
+		filterTextBuffer[length++] = '\n';
+	}
+
+	ensureFilterTextBufferSize(length + 1);
+	filterTextBuffer[length] = 0;
+
+	return filterTextBuffer;
+}
+
 ListField::Cell * ListField::getFocusCell()
 {
 	ASSERTION_COBJECT(this);
@@ -324,7 +760,7 @@ int ListField::getFocusColumnNo()
 ListField::Row * ListField::getFocusRow()
 {
 	ASSERTION_COBJECT(this);
-	return rows.Get(focusRowNo);
+	return getRow(focusRowNo);
 }
 
 int ListField::getFocusRowNo()
@@ -363,16 +799,41 @@ void ListField::getHeadlineColumnForPosition(Vector position, int & columnNo)
 	if (columnNo > columns.GetCount()) columnNo = columns.GetCount();
 }
 
+int ListField::getModelBucket(void * model)
+{
+	ASSERTION_COBJECT(this);
+
+	// Fibonacci hashing of the address
+	return (int) ((((size_t) model >> 3) * 2654435761UL) & (modelBucketCount - 1));
+}
+
+int ListField::getNextSelectedRowNo(int rowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	return selection.getNext(rowNo);
+}
+
+ListField::Provider * ListField::getProvider()
+{
+	ASSERTION_COBJECT(this);
+	return provider;
+}
+
 ListField::Row * ListField::getRow(int rowNo)
 {
 	ASSERTION_COBJECT(this);
+
+	if (provider != NULL)
+		return rowNo >= 0 && rowNo < providerRowCount ? materializeRow(rowNo) : NULL;
+
 	return rows.Get(rowNo);
 }
 
 int ListField::getRowCount()
 {
 	ASSERTION_COBJECT(this);
-	return rows.GetCount();
+	return provider != NULL ? providerRowCount : rows.GetCount();
 }
 
 int ListField::getRowNo(ListField::Row * row)
@@ -382,22 +843,48 @@ int ListField::getRowNo(ListField::Row * row)
 	if (row == NULL)
 		return -1;
 
-	for (int rowNo = 0; rowNo < rows.GetCount(); rowNo++)
-		if (rows.Get(rowNo) == row)
-			return rowNo;
+	if (provider != NULL)
+		return row->field == this ? row->transientRowNo : -1;
 
-	return -1;
+	if (row->field != this || row->hidden)
+		return -1;
+
+	return rowPositions.getPosition(&row->position);
 }
 
 int ListField::getRowNoByModel(void * model)
 {
 	ASSERTION_COBJECT(this);
 
-	for (int rowNo = 0; rowNo < rows.GetCount(); rowNo++)
-		if (rows.Get(rowNo)->getModel() == model)
-			return rowNo;
+	if (provider != NULL)
+	{
+		int rowNo = provider->getRowNoByModel(this, model);
+		return rowNo >= 0 && rowNo < providerRowCount ? rowNo : -1;
+	}
 
-	return -1;
+	if (model == NULL)
+	{
+		for (int rowNo = 0; rowNo < rows.GetCount(); rowNo++)
+			if (rows.Get(rowNo)->getModel() == NULL)
+				return rowNo;
+
+		return -1;
+	}
+
+	if (modelBuckets == NULL)
+		return -1;
+
+	// Several rows may have the same model, use the first one
+	int firstRowNo = -1;
+	for (Row * row = modelBuckets[getModelBucket(model)]; row != NULL; row = row->nextModelRow)
+		if (row->getModel() == model)
+		{
+			int rowNo = getRowNo(row);
+			if (firstRowNo < 0 || rowNo < firstRowNo)
+				firstRowNo = rowNo;
+		}
+
+	return firstRowNo;
 }
 
 const ArrayList<ListField::Row> & ListField::getRows()
@@ -441,19 +928,43 @@ ListField::Row * ListField::getSelectedRow()
 {
 	ASSERTION_COBJECT(this);
 
-	if (selectedRows.GetCount() != 1)
+	if (selection.getCount() != 1)
 		return NULL;
 
-	PointeredList * rowsList = selectedRows.GetAll();
-	Row * row = (Row *) rowsList->GetFirst()->GetData();
-	delete rowsList;
+	return getRow(selection.getNext(-1));
+}
 
-	return row;
+int ListField::getSelectedRowCount()
+{
+	ASSERTION_COBJECT(this);
+	return selection.getCount();
 }
 
 const HashSet & ListField::getSelectedRows()
 {
 	ASSERTION_COBJECT(this);
+
+	if (provider != NULL)
+		throw EILLEGALSTATE("Virtual list fields do not support row sets, use getNextSelectedRowNo() instead");
+
+	// Derive the set from the selection only when it has changed since
+	if (selectedRowsVersion != selection.getVersion())
+	{
+		selectedRows.RemoveAll();
+
+		int fromRowNo;
+		int toRowNo;
+		int rowNo = -1;
+		while (selection.getNextRange(rowNo, fromRowNo, toRowNo))
+		{
+			for (rowNo = fromRowNo; rowNo <= toRowNo; rowNo++)
+				selectedRows.Add(rows.Get(rowNo));
+			rowNo = toRowNo;
+		}
+
+		selectedRowsVersion = selection.getVersion();
+	}
+
 	return selectedRows;
 }
 
@@ -461,15 +972,21 @@ ArrayList<ListField::Row> * ListField::getSelectedRowsInOrder()
 {
 	ASSERTION_COBJECT(this);
 
+	if (provider != NULL)
+		throw EILLEGALSTATE("Virtual list fields do not support row sets, use getNextSelectedRowNo() instead");
+
 	ArrayList<ListField::Row> * selectedArray;
 	if ((selectedArray = new ArrayList<ListField::Row>) == NULL)
 		throw EOUTOFMEMORY;
 
-	for (int rowNo=0; rowNo<rows.GetCount(); rowNo++)
+	int fromRowNo;
+	int toRowNo;
+	int rowNo = -1;
+	while (selection.getNextRange(rowNo, fromRowNo, toRowNo))
 	{
-		ListField::Row * row = rows.Get(rowNo);
-		if (selectedRows.Contains(row))
-			selectedArray->Append(row);
+		for (rowNo = fromRowNo; rowNo <= toRowNo; rowNo++)
+			selectedArray->Append(rows.Get(rowNo));
+		rowNo = toRowNo;
 	}
 
 	return selectedArray;
@@ -481,11 +998,51 @@ ListField::Type ListField::getType()
 	return type;
 }
 
-#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
-	IMPLEMENT_DYNAMIC(ListField, ScrollingField);
-#endif
+int ListField::getUnfilteredRowCount()
+{
+	ASSERTION_COBJECT(this);
+	return isFiltered() ? filterRows.GetCount() : getRowCount();
+}
 
-void ListField::insertColumn(int position, ListField::Column * column)
+void ListField::getVisibleRowNos(int & firstRowNo, int & lastRowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	int rowHeight = Desktop::getInstance()->getSkin()->getListFieldRowHeight(this);
+	Vector scrollPosition = rowsField.getScrollPositionNow();
+
+	firstRowNo = scrollPosition.y / rowHeight;
+	if (firstRowNo < 0)
+		firstRowNo = 0;
+	lastRowNo = (scrollPosition.y + rowsField.getContentViewSize().y) / rowHeight;
+	if (lastRowNo > getRowCount() - 1)
+		lastRowNo = getRowCount() - 1;
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(ListField, ScrollingField);
+#endif
+
+void ListField::indexRowModel(Row * row)
+{
+	ASSERTION_COBJECT(this);
+
+	if (row->getModel() == NULL)
+		return;
+
+	if (modelRowCount >= modelBucketCount)
+		resizeModelIndex(modelBucketCount > 0 ? modelBucketCount * 2 : GL_LISTFIELD_MODELBUCKETS);
+
+	int bucket = getModelBucket(row->getModel());
+	row->previousModelRow = NULL;
+	row->nextModelRow = modelBuckets[bucket];
+	if (row->nextModelRow != NULL)
+		row->nextModelRow->previousModelRow = row;
+	modelBuckets[bucket] = row;
+	modelRowCount++;
+}
+
+void ListField::insertColumn(int position, ListField::Column * column)
 {
 	ASSERTION_COBJECT(this);
 
@@ -499,7 +1056,11 @@ void ListField::insertColumn(int position, ListField::Column * column)
 
 	column->setField(this);
 	columns.Insert(column, position);
+	destroyTransientRows();
+	destroyFilterIndex();
 
+	// The column has no cells yet, but may fit its heading
+	fitColumns();
 	rowsField.updateContentSize();
 	adjustAutoColumns();
 	invalidate();
@@ -511,11 +1072,37 @@ void ListField::insertRow(int position, ListField::Row * row)
 {
 	ASSERTION_COBJECT(this);
 
+	if (provider != NULL)
+		throw EILLEGALSTATE("Virtual list fields do not support inserting rows, use the provider instead");
 	if (row->getField() != NULL)
 		throw EILLEGALSTATE("The row is already contained in a list field");
 	if (position < 0 || position > rows.GetCount())
 		throw EILLEGALSTATE("The row position is out of range");
 
+	cancelSortJob();
+
+	// While filtering, keep the unfiltered order next to the row the new one is inserted before
+	if (isFiltered())
+	{
+		Row * nextRow = position < rows.GetCount() ? rows.Get(position) : NULL;
+		int filterRowNo = nextRow != NULL ? getFilterRowNo(nextRow) : filterRows.GetCount();
+		filterRows.Insert(row, filterRowNo);
+		filterRowPositions.insert(filterRowNo, &row->filterPosition);
+		if (filterIndex != NULL)
+			row->filterIndexRowNo = filterIndex->addRow(getFilterText(row));
+
+		// The row has no cells yet, it is tested when they have been added
+		row->filterPending = true;
+		filterPendingRows.Append(row);
+		if (filterPendingRows.GetCount() == 1)
+			Desktop::getInstance()->deferObject(this);
+	}
+
+	// Within an update, consecutive rows are notified at once
+	if (updateAddedRowCount > 0 && (position < updateAddedRowNo
+		|| position > updateAddedRowNo + updateAddedRowCount))
+		flushAddedRows();
+
 	bool wasEmpty = rows.IsEmpty();
 
 	if (focusRowNo >= position && focusRowNo < rows.GetCount())
@@ -525,19 +1112,145 @@ void ListField::insertRow(int position, ListField::Row * row)
 
 	row->setField(this);
 	rows.Insert(row, position);
+	rowPositions.insert(position, &row->position);
+	indexRowModel(row);
 
+	selection.insertRows(position, 1);
 	if (type == TYPE_ONE && wasEmpty)
-		selectedRows.Add(row);
+		selection.select(position);
 
+	if (updateDepth > 0)
+	{
+		if (updateAddedRowCount == 0)
+			updateAddedRowNo = position;
+		updateAddedRowCount++;
+		if (type == TYPE_ONE && wasEmpty)
+			updateSelectionChanged = true;
+		return;
+	}
+
+	// Only the rows from the insertion point on move, and the scrollers change
 	rowsField.updateContentSize();
-	invalidate();
+	rowsField.invalidateContentViewFrame();
+	invalidateRows(position, rows.GetCount() - 1);
 
-	notifyRowAdded(position);
+	notifyRowsAdded(position, 1);
 
 	if (type == TYPE_ONE && wasEmpty)
 		notifySelectionChanged();
 }
 
+void ListField::insertRows(int position, Row ** newRows, int rowCount)
+{
+	ASSERTION_COBJECT(this);
+
+	if (position < 0 || position > rows.GetCount())
+		throw EILLEGALSTATE("The row position is out of range");
+
+	beginUpdate();
+	try
+	{
+		for (int i=0; i<rowCount; i++)
+			insertRow(position + i, newRows[i]);
+	}
+	catch (...)
+	{
+		endUpdate();
+		throw;
+	}
+	endUpdate();
+}
+
+void ListField::invalidateFocusChange(int oldFocusRowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	if (oldFocusRowNo != focusRowNo)
+		invalidateRows(oldFocusRowNo, oldFocusRowNo);
+	invalidateRows(focusRowNo, focusRowNo);
+}
+
+void ListField::invalidateRow(Row * row)
+{
+	ASSERTION_COBJECT(this);
+
+	// The row's texts and widths may have changed
+	if (filterIndex != NULL)
+	{
+		filterIndex->removeRow(row->filterIndexRowNo);
+		row->filterIndexRowNo = filterIndex->addRow(getFilterText(row));
+	}
+	measureRow(row);
+
+	if (updateDepth > 0)
+		return;
+
+	// Rows scrolled out of view are drawn when they are scrolled into view
+	int firstRowNo;
+	int lastRowNo;
+	getVisibleRowNos(firstRowNo, lastRowNo);
+	int rowNo = getRowNo(row);
+	if (rowNo >= firstRowNo && rowNo <= lastRowNo)
+		invalidateRows(rowNo, rowNo);
+}
+
+void ListField::invalidateRows(int fromRowNo, int toRowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	// Within an update, the whole list field is invalidated when it ends
+	if (updateDepth > 0)
+		return;
+
+	if (fromRowNo < 0)
+		fromRowNo = 0;
+	if (toRowNo > getRowCount() - 1)
+		toRowNo = getRowCount() - 1;
+	if (fromRowNo > toRowNo)
+		return;
+
+	int rowHeight = Desktop::getInstance()->getSkin()->getListFieldRowHeight(this);
+	rowsField.invalidateContentArea(Vector(0, rowHeight * fromRowNo),
+		Vector(getRowWidth(), rowHeight * (toRowNo - fromRowNo + 1)));
+}
+
+void ListField::invalidateSelectionChange(int fromRowNo, int toRowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	int firstVisibleRowNo;
+	int lastVisibleRowNo;
+	getVisibleRowNos(firstVisibleRowNo, lastVisibleRowNo);
+
+	// Invalidate each run of visible rows changing their selection state at once
+	int changedRowNo = -1;
+	for (int rowNo = firstVisibleRowNo; rowNo <= lastVisibleRowNo + 1; rowNo++)
+	{
+		bool changed = rowNo <= lastVisibleRowNo
+			&& isRowSelected(rowNo) != (rowNo >= fromRowNo && rowNo <= toRowNo);
+		if (changed && changedRowNo < 0)
+			changedRowNo = rowNo;
+		else if (!changed && changedRowNo >= 0)
+		{
+			invalidateRows(changedRowNo, rowNo - 1);
+			changedRowNo = -1;
+		}
+	}
+}
+
+void ListField::invertSelection()
+{
+	ASSERTION_COBJECT(this);
+
+	if (type != TYPE_MANY || getRowCount() == 0)
+		return;
+
+	selection.invert();
+
+	notifySelectionChanged();
+	invalidate();
+}
+
 bool ListField::isColumnsMovable()
 {
 	ASSERTION_COBJECT(this);
@@ -553,7 +1266,13 @@ bool ListField::isColumnsResizable()
 bool ListField::isEmpty()
 {
 	ASSERTION_COBJECT(this);
-	return rows.IsEmpty();
+	return getRowCount() == 0;
+}
+
+bool ListField::isFiltered()
+{
+	ASSERTION_COBJECT(this);
+	return !filterText.IsEmpty();
 }
 
 bool ListField::isHeadlined()
@@ -571,13 +1290,13 @@ bool ListField::isHorizontallyScrollable()
 bool ListField::isRowSelected(int rowNo)
 {
 	ASSERTION_COBJECT(this);
-	return selectedRows.Contains(rows.Get(rowNo));
+	return selection.contains(rowNo);
 }
 
 bool ListField::isRowSelected(Row * row)
 {
 	ASSERTION_COBJECT(this);
-	return selectedRows.Contains(row);
+	return selection.contains(getRowNo(row));
 }
 
 bool ListField::isRowsRemovable()
@@ -586,22 +1305,187 @@ bool ListField::isRowsRemovable()
 	return rowsRemovable;
 }
 
+bool ListField::isUpdating()
+{
+	ASSERTION_COBJECT(this);
+	return updateDepth > 0;
+}
+
+bool ListField::isSorting()
+{
+	ASSERTION_COBJECT(this);
+	return sortJob != NULL;
+}
+
 bool ListField::isVerticallyScrollable()
 {
 	ASSERTION_COBJECT(this);
 	return verticallyScrollable;
 }
 
+bool ListField::isVirtual()
+{
+	ASSERTION_COBJECT(this);
+	return provider != NULL;
+}
+
+ListField::Row * ListField::materializeRow(int rowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	int slot = rowNo % GL_LISTFIELD_TRANSIENTROWS;
+	Row * row = transientRows[slot];
+	if (row != NULL && row->transientRowNo == rowNo)
+		return row;
+
+	if (row == NULL)
+	{
+		if ((row = new Row) == NULL)
+			throw EOUTOFMEMORY;
+		row->setField(this);
+		transientRows[slot] = row;
+	}
+
+	materializing = true;
+
+	row->transientRowNo = rowNo;
+	row->active = provider->isRowActive(this, rowNo);
+	row->setModel(provider->getRowModel(this, rowNo));
+
+	// Each cell consists of a recycled image element and text element
+	for (int columnNo = 0; columnNo < columns.GetCount(); columnNo++)
+	{
+		Cell * cell = row->cells.Get(columnNo);
+		if (cell == NULL)
+		{
+			if ((cell = new Cell) == NULL)
+				throw EOUTOFMEMORY;
+			row->cells.Append(cell);
+			cell->setColumn(columns.Get(columnNo));
+			cell->setRow(row);
+
+			ImageElement * imageElement;
+			if ((imageElement = new ImageElement) == NULL)
+				throw EOUTOFMEMORY;
+			cell->elements.Append(imageElement);
+			imageElement->setFieldAndParent(this, cell);
+
+			TextElement * textElement;
+			if ((textElement = new TextElement) == NULL)
+				throw EOUTOFMEMORY;
+			cell->elements.Append(textElement);
+			textElement->setFieldAndParent(this, cell);
+		}
+
+		((ImageElement *) cell->elements.Get(0))->setImage(provider->getCellImage(this, rowNo, columnNo));
+		((TextElement *) cell->elements.Get(1))->setText(provider->getCellText(this, rowNo, columnNo));
+	}
+
+	materializing = false;
+
+	return row;
+}
+
+bool ListField::matchesFilter(Row * row, const char * query)
+{
+	ASSERTION_COBJECT(this);
+
+	if (filterIndex != NULL)
+		return filterIndex->matches(row->filterIndexRowNo, query);
+
+	return strstr(getFilterText(row), query) != NULL;
+}
+
+void ListField::measureCell(Cell * cell)
+{
+	ASSERTION_COBJECT(this);
+
+	if (cell->contentWidth >= 0)
+	{
+		cell->column->removeContentWidth(cell->contentWidth);
+		cell->contentWidth = -1;
+	}
+
+	if (provider != NULL || !cell->column->isFittingContent())
+		return;
+
+	int width = 0;
+	for (int i=0; i<cell->elements.GetCount(); i++)
+		width += cell->elements.Get(i)->getSize().x;
+
+	cell->contentWidth = width;
+	cell->column->addContentWidth(width);
+}
+
+void ListField::measureColumn(Column * column)
+{
+	ASSERTION_COBJECT(this);
+
+	ArrayList<Row> & allRows = isFiltered() ? filterRows : rows;
+	for (int i=0; i<allRows.GetCount(); i++)
+	{
+		Row * row = allRows.Get(i);
+		for (int j=0; j<row->cells.GetCount(); j++)
+			if (row->cells.Get(j)->column == column)
+				measureCell(row->cells.Get(j));
+	}
+
+	if (!column->isFittingContent())
+		column->clearContentWidths();
+
+	fitColumns();
+}
+
+void ListField::measureRow(Row * row)
+{
+	ASSERTION_COBJECT(this);
+
+	if (provider != NULL)
+		return;
+
+	// Only the cells of this row are measured, the other ones are counted already.
+	// Only the columns whose widest cell changed are fitted, within an update when it ends.
+	for (int i=0; i<row->cells.GetCount(); i++)
+	{
+		Cell * cell = row->cells.Get(i);
+		if (cell->contentWidth >= 0 || cell->column->isFittingContent())
+		{
+			int contentWidth = cell->column->getContentWidth();
+			measureCell(cell);
+			if (updateDepth == 0 && cell->column->getContentWidth() != contentWidth)
+				fitColumn(cell->column);
+		}
+	}
+}
+
 void ListField::moveRow(int fromPosition, int toPosition)
 {
 	ASSERTION_COBJECT(this);
 
+	if (provider != NULL)
+		throw EILLEGALSTATE("Virtual list fields do not support moving rows, use the provider instead");
+
 	if (fromPosition < 0 || fromPosition >= rows.GetCount()
 		|| toPosition < 0 || toPosition > rows.GetCount()
 		|| fromPosition == toPosition)
 		return;
 
-	rows.Insert(rows.Unlink(fromPosition), toPosition);
+	cancelSortJob();
+
+	bool selected = selection.contains(fromPosition);
+	selection.removeRows(fromPosition, 1);
+
+	Row * row = rows.Unlink(fromPosition);
+	rowPositions.remove(&row->position);
+	rows.Insert(row, toPosition);
+	rowPositions.insert(toPosition, &row->position);
+
+	int newPosition = getRowNo(row);
+	selection.insertRows(newPosition, 1);
+	if (selected)
+		selection.select(newPosition);
+
+	syncFilterRows();
 	invalidate();
 }
 
@@ -647,7 +1531,35 @@ void ListField::notifyColumnRemoving(int columnNo)
 	}
 }
 
-void ListField::notifyRowAdded(int rowNo)
+void ListField::notifyFilterChanged()
+{
+	ASSERTION_COBJECT(this);
+
+	int listenersCount = listeners.GetCount();
+	for (int i=0; i<listenersCount; i++)
+	{
+		ListField::Listener * listFieldListener
+			= dynamic_cast<ListField::Listener *>(listeners.Get(i));
+		if (listFieldListener != NULL)
+			listFieldListener->onFilterChanged(this);
+	}
+}
+
+void ListField::notifyRowsAdded(int rowNo, int rowCount)
+{
+	ASSERTION_COBJECT(this);
+
+	int listenersCount = listeners.GetCount();
+	for (int i=0; i<listenersCount; i++)
+	{
+		ListField::Listener * listFieldListener
+			= dynamic_cast<ListField::Listener *>(listeners.Get(i));
+		if (listFieldListener != NULL)
+			listFieldListener->onRowsAdded(this, rowNo, rowCount);
+	}
+}
+
+void ListField::notifyRowsRemoved()
 {
 	ASSERTION_COBJECT(this);
 
@@ -657,7 +1569,7 @@ void ListField::notifyRowAdded(int rowNo)
 		ListField::Listener * listFieldListener
 			= dynamic_cast<ListField::Listener *>(listeners.Get(i));
 		if (listFieldListener != NULL)
-			listFieldListener->onRowAdded(this, rowNo);
+			listFieldListener->onRowsRemoved(this);
 	}
 }
 
@@ -775,6 +1687,24 @@ DraggingSurrogate * ListField::onDragStart(int rowNo, int columnNo)
 	return NULL;
 }
 
+void ListField::onElementChanged(FieldElement * element)
+{
+	ASSERTION_COBJECT(this);
+
+	if (materializing)
+		return;
+
+	// Only the row of the element changes
+	Cell * cell = (Cell *) element->getParent();
+	invalidateRow(cell->getRow());
+	int rowNo = getRowNo(cell->getRow());
+
+	// Pass edited texts of transient rows to the provider
+	TextElement * textElement = dynamic_cast<TextElement *>(element);
+	if (provider != NULL && textElement != NULL && rowNo >= 0)
+		provider->setCellText(this, rowNo, getColumnNo(cell->getColumn()), textElement->getText());
+}
+
 void ListField::onHover()
 {
 	ASSERTION_COBJECT(this);
@@ -820,6 +1750,101 @@ void ListField::onMinimumSizeChanged(Vector oldMinimumSize)
 	rowsField.setMinimumSizeInternal(getMinimumSize() - Vector(0, headingHeight), false);
 }
 
+void ListField::onProviderRowsChanged()
+{
+	ASSERTION_COBJECT(this);
+
+	if (provider == NULL)
+		throw EILLEGALSTATE("The list field is not virtual");
+
+	int rowCount = provider->getRowCount(this);
+	bool selectionChanged = selection.setRowCount(rowCount);
+	providerRowCount = rowCount;
+
+	if (focusRowNo >= rowCount)
+		focusRowNo = rowCount > 0 ? rowCount - 1 : 0;
+	if (rangeStartRowNo >= rowCount)
+		rangeStartRowNo = focusRowNo;
+
+	if (type == TYPE_ONE && selection.getCount() == 0 && rowCount > 0)
+	{
+		selectRowInternal(focusRowNo);
+		selectionChanged = true;
+	}
+
+	recycleTransientRows();
+	rowsField.updateContentSize();
+	ensureFocusVisible();
+	invalidate();
+
+	if (selectionChanged)
+		notifySelectionChanged();
+}
+
+void ListField::onProviderRowsInserted(int position, int count)
+{
+	ASSERTION_COBJECT(this);
+
+	if (provider == NULL)
+		throw EILLEGALSTATE("The list field is not virtual");
+	if (position < 0 || position > providerRowCount)
+		throw EILLEGALSTATE("The row position is out of range");
+	if (count <= 0)
+		return;
+
+	bool wasEmpty = providerRowCount == 0;
+
+	if (focusRowNo >= position && focusRowNo < providerRowCount)
+		focusRowNo += count;
+	if (rangeStartRowNo >= position && rangeStartRowNo < providerRowCount)
+		rangeStartRowNo += count;
+
+	selection.insertRows(position, count);
+	providerRowCount += count;
+
+	if (type == TYPE_ONE && wasEmpty)
+		selectRowInternal(focusRowNo);
+
+	recycleTransientRows();
+	rowsField.updateContentSize();
+	invalidate();
+
+	notifyRowsAdded(position, count);
+
+	if (type == TYPE_ONE && wasEmpty)
+		notifySelectionChanged();
+}
+
+void ListField::onProviderRowsRemoved(int position, int count)
+{
+	ASSERTION_COBJECT(this);
+
+	if (provider == NULL)
+		throw EILLEGALSTATE("The list field is not virtual");
+	if (position < 0 || count < 0 || position + count > providerRowCount)
+		throw EILLEGALSTATE("The row positions are out of range");
+	if (count == 0)
+		return;
+
+	int nextSelectedRowNo = selection.getNext(position - 1);
+	bool selectionChanged = nextSelectedRowNo >= 0 && nextSelectedRowNo < position + count;
+
+	selection.removeRows(position, count);
+	providerRowCount -= count;
+
+	if (focusRowNo >= position + count)
+		focusRowNo -= count;
+	else if (focusRowNo >= position)
+		focusRowNo = position < providerRowCount ? position : providerRowCount - 1;
+	if (rangeStartRowNo >= position + count)
+		rangeStartRowNo -= count;
+	else if (rangeStartRowNo >= position)
+		rangeStartRowNo = focusRowNo;
+
+	recycleTransientRows();
+	finishRowRemoval(selectionChanged);
+}
+
 void ListField::prependColumn(ListField::Column * column)
 {
 	ASSERTION_COBJECT(this);
@@ -838,8 +1863,12 @@ void ListField::removeColumn(int position)
 
 	notifyColumnRemoving(position);
 
-	for (int i=0; i<rows.GetCount(); i++)
-		rows.Get(i)->removeCell(position);
+	// Rows hidden by the filter lose the cell as well, the filter index is rebuilt when required
+	destroyFilterIndex();
+	ArrayList<Row> & allRows = isFiltered() ? filterRows : rows;
+	for (int i=0; i<allRows.GetCount(); i++)
+		allRows.Get(i)->removeCell(position);
+	destroyTransientRows();
 
 	columns.Delete(position);
 
@@ -863,8 +1892,11 @@ void ListField::removeColumns()
 	for (int i=0; i<columns.GetCount(); i++)
 		notifyColumnRemoving(i);
 
-	for (int i=0; i<rows.GetCount(); i++)
-		rows.Get(i)->removeCells();
+	destroyFilterIndex();
+	ArrayList<Row> & allRows = isFiltered() ? filterRows : rows;
+	for (int i=0; i<allRows.GetCount(); i++)
+		allRows.Get(i)->removeCells();
+	destroyTransientRows();
 
 	columns.DeleteAll();
 
@@ -878,28 +1910,41 @@ void ListField::removeColumns()
 	notifyColumnRemoved();
 }
 
-bool ListField::removeRow(int position)
+void ListField::recycleTransientRows()
 {
 	ASSERTION_COBJECT(this);
 
-	if (position < 0 || position >= rows.GetCount())
+	for (int i=0; i<GL_LISTFIELD_TRANSIENTROWS; i++)
+		if (transientRows[i] != NULL)
+			transientRows[i]->transientRowNo = -1;
+}
+
+bool ListField::removeRow(int position)
+{
+	ASSERTION_COBJECT(this);
+
+	if (provider != NULL)
+		throw EILLEGALSTATE("Virtual list fields do not support removing rows, use the provider instead");
+
+	if (position < 0 || position >= rows.GetCount())
 		return false;
 
+	flushAddedRows();
+
 	int positions[1];
 	positions[0] = position;
 	if (!notifyRowsRemoving(positions, 1))
 		return false;
 
+	cancelSortJob();
+
 	Row * row = getRow(position);
-	bool selectionChanged;
-	if (selectedRows.Contains(row))
-	{
-		selectedRows.Remove(row);
-		selectionChanged = true;
-	}
-	else
-		selectionChanged = false;
+	bool selectionChanged = selection.contains(position);
+	selection.removeRows(position, 1);
 
+	unindexRowModel(row);
+	unlinkFilterRow(row);
+	rowPositions.remove(&row->position);
 	rows.Delete(position);
 	if (focusRowNo > position)
 		focusRowNo--;
@@ -910,34 +1955,98 @@ bool ListField::removeRow(int position)
 	return true;
 }
 
+bool ListField::removeRowRange(int position, int rowCount)
+{
+	ASSERTION_COBJECT(this);
+
+	if (provider != NULL)
+		throw EILLEGALSTATE("Virtual list fields do not support removing rows, use the provider instead");
+
+	if (position < 0 || rowCount <= 0 || position + rowCount > rows.GetCount())
+		return false;
+
+	flushAddedRows();
+
+	int * positions;
+	if ((positions = new int[rowCount]) == NULL)
+		throw EOUTOFMEMORY;
+
+	int i;
+	for (i=0; i<rowCount; i++)
+		positions[i] = position + i;
+
+	if (!notifyRowsRemoving(positions, rowCount))
+	{
+		delete[] positions;
+		return false;
+	}
+
+	cancelSortJob();
+
+	int nextSelectedRowNo = selection.getNext(position - 1);
+	bool selectionChanged = nextSelectedRowNo >= 0 && nextSelectedRowNo < position + rowCount;
+	selection.removeRows(position, rowCount);
+
+	deleteRows(positions, rowCount);
+	delete[] positions;
+
+	if (focusRowNo >= position + rowCount)
+		focusRowNo -= rowCount;
+	else if (focusRowNo >= position)
+		focusRowNo = position < rows.GetCount() ? position : rows.GetCount() - 1;
+	if (rangeStartRowNo >= position + rowCount)
+		rangeStartRowNo -= rowCount;
+	else if (rangeStartRowNo >= position)
+		rangeStartRowNo = focusRowNo;
+
+	finishRowRemoval(selectionChanged);
+
+	return true;
+}
+
 bool ListField::removeRows()
 {
 	ASSERTION_COBJECT(this);
 
+	if (provider != NULL)
+		throw EILLEGALSTATE("Virtual list fields do not support removing rows, use the provider instead");
+
 	int * positions;
 	if ((positions = new int[rows.GetCount()]) == NULL)
 		throw EOUTOFMEMORY;
 
-	for (int i=0; i<rows.GetCount(); i++)
+	int i;
+	for (i=0; i<rows.GetCount(); i++)
 		positions[i] = i;
 
+	flushAddedRows();
 	if (!notifyRowsRemoving(positions, rows.GetCount()))
 	{
-		delete positions;
+		delete[] positions;
 		return false;
 	}
-	delete positions;
+	delete[] positions;
 
-	bool selectionChanged;
-	if (!selectedRows.IsEmpty())
-	{
-		selectedRows.RemoveAll();
-		selectionChanged = true;
-	}
-	else
-		selectionChanged = false;
+	cancelSortJob();
 
+	bool selectionChanged = selection.getCount() > 0;
+	selection.clear();
+	selection.setRowCount(0);
+
+	// The rows hidden by the filter are removed as well, the filter remains
+	filterPendingRows.UnlinkAll();
+	filterRowPositions.clear();
+	for (i = filterRows.GetCount() - 1; i >= 0; i--)
+		if (filterRows.Get(i)->hidden)
+			filterRows.Delete(i);
+	filterRows.UnlinkAll();
+	destroyFilterIndex();
+
+	rowPositions.clear();
 	rows.DeleteAll();
+	if (modelBuckets != NULL)
+		memset(modelBuckets, 0, modelBucketCount * sizeof(Row *));
+	modelRowCount = 0;
 	finishRowRemoval(selectionChanged);
 
 	return true;
@@ -947,55 +2056,69 @@ bool ListField::removeSelectedRows()
 {
 	ASSERTION_COBJECT(this);
 
-	int selectedRowCount = selectedRows.GetCount();
+	if (provider != NULL)
+		throw EILLEGALSTATE("Virtual list fields do not support removing rows, use the provider instead");
+
+	int selectedRowCount = selection.getCount();
 
 	int * selectedRowNos;
 	if ((selectedRowNos = new int[selectedRowCount]) == NULL)
 		throw EOUTOFMEMORY;
 
-	PointeredList * selectedRowsList = selectedRows.GetAll();
-	PointeredListItem * selectedRowsListItem = selectedRowsList->GetFirst();
-	for (int i=0; selectedRowsListItem != NULL; i++)
-	{
-		Row * row = (Row *) selectedRowsListItem->GetData();
-		selectedRowNos[i] = rows.Find(row);
-		selectedRowsListItem = selectedRowsListItem->GetNext();
-	}
-	delete selectedRowsList;
+	int i;
+	int rowNo = -1;
+	for (i=0; i<selectedRowCount; i++)
+		selectedRowNos[i] = rowNo = selection.getNext(rowNo);
 
+	flushAddedRows();
 	if (!notifyRowsRemoving(selectedRowNos, selectedRowCount))
 	{
-		delete selectedRowNos;
+		delete[] selectedRowNos;
 		return false;
 	}
 
-	bool selectionChanged = false;
-	for (int i=0; i<selectedRowCount; i++)
-	{
-		int rowNo = selectedRowNos[i];
-		Row * row = getRow(rowNo);
-		if (selectedRows.Contains(row))
-		{
-			selectedRows.Remove(row);
-			selectionChanged = true;
-		}
+	cancelSortJob();
 
-		if (rowNo >= 0)
-		{
-			rows.Delete(rowNo);
-			if (focusRowNo > rowNo)
-				focusRowNo--;
-			if (rangeStartRowNo > rowNo)
-				rangeStartRowNo--;
-		}
+	bool selectionChanged = selectedRowCount > 0;
+	deleteRows(selectedRowNos, selectedRowCount);
+
+	// Go from the back, so the focus moves by the number of removed rows before it
+	for (i = selectedRowCount - 1; i >= 0; i--)
+	{
+		rowNo = selectedRowNos[i];
+		if (focusRowNo > rowNo)
+			focusRowNo--;
+		if (rangeStartRowNo > rowNo)
+			rangeStartRowNo--;
 	}
-	delete selectedRowNos;
+	delete[] selectedRowNos;
+
+	selection.clear();
+	selection.setRowCount(rows.GetCount());
 
 	finishRowRemoval(selectionChanged);
 
 	return true;
 }
 
+void ListField::repositionFilterRows()
+{
+	ASSERTION_COBJECT(this);
+
+	filterRowPositions.clear();
+	for (int i=0; i<filterRows.GetCount(); i++)
+		filterRowPositions.append(&filterRows.Get(i)->filterPosition);
+}
+
+void ListField::repositionRows()
+{
+	ASSERTION_COBJECT(this);
+
+	rowPositions.clear();
+	for (int i=0; i<rows.GetCount(); i++)
+		rowPositions.append(&rows.Get(i)->position);
+}
+
 bool ListField::resizeInternal(Vector size, bool notifyParent)
 {
 	ASSERTION_COBJECT(this);
@@ -1011,6 +2134,41 @@ bool ListField::resizeInternal(Vector size, bool notifyParent)
 		return false;
 }
 
+void ListField::resizeModelIndex(int bucketCount)
+{
+	ASSERTION_COBJECT(this);
+
+	Row ** oldModelBuckets = modelBuckets;
+	int oldModelBucketCount = modelBucketCount;
+
+	if ((modelBuckets = new Row *[bucketCount]) == NULL)
+		throw EOUTOFMEMORY;
+	memset(modelBuckets, 0, bucketCount * sizeof(Row *));
+	modelBucketCount = bucketCount;
+
+	// Rechain the rows of the old buckets
+	for (int oldBucket = 0; oldBucket < oldModelBucketCount; oldBucket++)
+	{
+		Row * row = oldModelBuckets[oldBucket];
+		while (row != NULL)
+		{
+			Row * nextRow = row->nextModelRow;
+
+			int bucket = getModelBucket(row->getModel());
+			row->previousModelRow = NULL;
+			row->nextModelRow = modelBuckets[bucket];
+			if (row->nextModelRow != NULL)
+				row->nextModelRow->previousModelRow = row;
+			modelBuckets[bucket] = row;
+
+			row = nextRow;
+		}
+	}
+
+	if (oldModelBuckets != NULL)
+		delete[] oldModelBuckets;
+}
+
 BalloonPopup * ListField::showBalloonPopup(const String & text)
 {
 	ASSERTION_COBJECT(this);
@@ -1027,7 +2185,7 @@ BalloonPopup * ListField::showBalloonPopup(int rowNo, int columnNo, int elementN
 {
 	ASSERTION_COBJECT(this);
 
-	if (columns.IsEmpty() || rows.IsEmpty())
+	if (columns.IsEmpty() || getRowCount() == 0)
 		return NULL;
 
 	Cell * cell = getCell(rowNo, columnNo);
@@ -1074,6 +2232,59 @@ BalloonPopup * ListField::showBalloonPopup(int rowNo, int columnNo, int elementN
 	return popup;
 }
 
+void ListField::showFilteredRows()
+{
+	ASSERTION_COBJECT(this);
+
+	Row * focusRow = getFocusRow();
+	Row * rangeStartRow = getRow(rangeStartRowNo);
+
+	Row ** selectedRowsArray;
+	if ((selectedRowsArray = new Row *[selection.getCount() + 1]) == NULL)
+		throw EOUTOFMEMORY;
+
+	int i;
+	int selectedRowCount = selection.getCount();
+	int rowNo = -1;
+	for (i=0; i<selectedRowCount; i++)
+		selectedRowsArray[i] = rows.Get(rowNo = selection.getNext(rowNo));
+
+	rows.UnlinkAll();
+	for (i=0; i<filterRows.GetCount(); i++)
+		if (!filterRows.Get(i)->hidden)
+			rows.Append(filterRows.Get(i));
+	repositionRows();
+
+	// Selected rows that have been hidden are unselected
+	selection.clear();
+	selection.setRowCount(rows.GetCount());
+	for (i=0; i<selectedRowCount; i++)
+		selection.select(getRowNo(selectedRowsArray[i]));
+	delete[] selectedRowsArray;
+	bool selectionChanged = selection.getCount() != selectedRowCount;
+
+	focusRowNo = getRowNo(focusRow);
+	if (focusRowNo < 0)
+		focusRowNo = 0;
+	rangeStartRowNo = getRowNo(rangeStartRow);
+	if (rangeStartRowNo < 0)
+		rangeStartRowNo = focusRowNo;
+
+	if (type == TYPE_ONE && selection.getCount() == 0 && !rows.IsEmpty())
+	{
+		selectRowInternal(focusRowNo);
+		selectionChanged = true;
+	}
+
+	rowsField.updateContentSize();
+	ensureFocusVisible();
+	invalidate();
+
+	notifyFilterChanged();
+	if (selectionChanged)
+		notifySelectionChanged();
+}
+
 void ListField::selectAllRows()
 {
 	ASSERTION_COBJECT(this);
@@ -1081,9 +2292,7 @@ void ListField::selectAllRows()
 	if (type != TYPE_MANY)
 		return;
 
-	selectedRows.RemoveAll();
-	for (int i=0; i<rows.GetCount(); i++)
-		selectedRows.Add(rows.Get(i));
+	selection.selectAll();
 
 	notifySelectionChanged();
 	invalidate();
@@ -1093,29 +2302,37 @@ void ListField::selectRow(int rowNo)
 {
 	ASSERTION_COBJECT(this);
 
-	Row * row = rows.Get(rowNo);
-	if (row != NULL)
-		selectRow(row);
+	if (rowNo < 0 || rowNo >= getRowCount() || isRowSelected(rowNo))
+		return;
+
+	if (type != TYPE_MANY)
+	{
+		invalidateSelectionChange(rowNo, rowNo);
+		unselectRowsInternal();
+
+		int oldFocusRowNo = focusRowNo;
+		this->focusRowNo = rowNo;
+		invalidateFocusChange(oldFocusRowNo);
+		ensureFocusVisible();
+	}
+	else
+		invalidateRows(rowNo, rowNo);
+
+	selectRowInternal(rowNo);
+
+	notifySelectionChanged();
 }
 
 void ListField::selectRow(Row * row)
 {
 	ASSERTION_COBJECT(this);
+	selectRow(getRowNo(row));
+}
 
-	if (!selectedRows.Contains(row))
-	{
-		if (type != TYPE_MANY)
-		{
-			selectedRows.RemoveAll();
-			this->focusRowNo = getRowNo(row);
-			ensureFocusVisible();
-		}
-
-		selectedRows.Add(row);
-
-		notifySelectionChanged();
-		invalidate();
-	}
+void ListField::selectRowInternal(int rowNo)
+{
+	ASSERTION_COBJECT(this);
+	selection.select(rowNo);
 }
 
 void ListField::setActive(bool active)
@@ -1144,6 +2361,145 @@ void ListField::setColumnsResizable(bool columnsResizable)
 	invalidate();
 }
 
+void ListField::setFilter(const String & text)
+{
+	ASSERTION_COBJECT(this);
+
+	if (provider != NULL)
+		throw EILLEGALSTATE("Virtual list fields do not support filtering, filter the provider's rows instead");
+
+	char * query = RowTextIndex::toLowerCase((const char *) text);
+	char * oldQuery = RowTextIndex::toLowerCase((const char *) filterText);
+	bool wasFiltered = isFiltered();
+	bool changed = strcmp(query, oldQuery) != 0;
+
+	// A query containing the previous one matches a subset of the visible rows
+	bool narrowing = wasFiltered && strstr(query, oldQuery) != NULL;
+	delete[] oldQuery;
+
+	filterText = text;
+	if (!changed)
+	{
+		delete[] query;
+		return;
+	}
+
+	flushAddedRows();
+	cancelSortJob();
+
+	// All rows are tested against the new filter
+	int i;
+	for (i=0; i<filterPendingRows.GetCount(); i++)
+		filterPendingRows.Get(i)->filterPending = false;
+	filterPendingRows.UnlinkAll();
+
+	if (!wasFiltered)
+	{
+		for (i=0; i<rows.GetCount(); i++)
+			filterRows.Append(rows.Get(i));
+		repositionFilterRows();
+	}
+
+	if (!isFiltered())
+	{
+		for (i=0; i<filterRows.GetCount(); i++)
+		{
+			Row * row = filterRows.Get(i);
+			if (row->hidden)
+			{
+				row->hidden = false;
+				indexRowModel(row);
+			}
+		}
+	}
+	else if (narrowing)
+	{
+		for (i=0; i<rows.GetCount(); i++)
+		{
+			Row * row = rows.Get(i);
+			if (!matchesFilter(row, query))
+			{
+				unindexRowModel(row);
+				row->hidden = true;
+			}
+		}
+	}
+	else
+	{
+		RowTextIndex * index = getFilterIndex();
+
+		int * candidateRowNos;
+		if ((candidateRowNos = new int[index->getRowNoCount() + 1]) == NULL)
+			throw EOUTOFMEMORY;
+		bool * matching;
+		if ((matching = new bool[index->getRowNoCount() + 1]) == NULL)
+			throw EOUTOFMEMORY;
+		memset(matching, 0, index->getRowNoCount() * sizeof(bool));
+
+		int candidateCount = index->findCandidates(query, candidateRowNos);
+		for (i=0; i<candidateCount; i++)
+			if (index->matches(candidateRowNos[i], query))
+				matching[candidateRowNos[i]] = true;
+		delete[] candidateRowNos;
+
+		for (i=0; i<filterRows.GetCount(); i++)
+		{
+			Row * row = filterRows.Get(i);
+			bool rowMatching = matching[row->filterIndexRowNo];
+			if (row->hidden == rowMatching)
+			{
+				if (rowMatching)
+				{
+					row->hidden = false;
+					indexRowModel(row);
+				}
+				else
+				{
+					unindexRowModel(row);
+					row->hidden = true;
+				}
+			}
+		}
+		delete[] matching;
+	}
+	delete[] query;
+
+	showFilteredRows();
+
+	if (!isFiltered())
+	{
+		filterRowPositions.clear();
+		filterRows.UnlinkAll();
+		destroyFilterIndex();
+	}
+}
+
+void ListField::setFilterColumns(const int * columnNos, int columnCount)
+{
+	ASSERTION_COBJECT(this);
+
+	if (filterColumnNos != NULL) {delete[] filterColumnNos; filterColumnNos = NULL;}
+	filterColumnCount = 0;
+
+	if (columnNos != NULL && columnCount > 0)
+	{
+		if ((filterColumnNos = new int[columnCount]) == NULL)
+			throw EOUTOFMEMORY;
+		memcpy(filterColumnNos, columnNos, columnCount * sizeof(int));
+		filterColumnCount = columnCount;
+	}
+
+	destroyFilterIndex();
+
+	// Apply the current filter again, searching all rows
+	if (isFiltered())
+	{
+		String text = filterText;
+		setFilter(String());
+		setFilter(text);
+	}
+}
+
 void ListField::setFocusColumnNo(int focusColumnNo)
 {
 	ASSERTION_COBJECT(this);
@@ -1158,8 +2514,8 @@ void ListField::setFocusColumnNo(int focusColumnNo)
 
 	this->focusColumnNo = focusColumnNo;
 
+	invalidateRows(focusRowNo, focusRowNo);
 	ensureFocusVisible();
-	invalidate();
 }
 
 void ListField::setFocusRowNo(int focusRowNo)
@@ -1168,28 +2524,29 @@ void ListField::setFocusRowNo(int focusRowNo)
 
 	if (focusRowNo < 0)
 		focusRowNo = 0;
-	else if (focusRowNo >= rows.GetCount() - 1)
-		focusRowNo = rows.GetCount() - 1;
+	else if (focusRowNo >= getRowCount() - 1)
+		focusRowNo = getRowCount() - 1;
 
 	if (this->focusRowNo == focusRowNo)
 		return;
 
+	int oldFocusRowNo = this->focusRowNo;
 	this->focusRowNo = focusRowNo;
+	invalidateFocusChange(oldFocusRowNo);
 
 	if (type == TYPE_ONE)
 	{
-		selectedRows.RemoveAll();
+		invalidateSelectionChange(focusRowNo, focusRowNo);
+		unselectRowsInternal();
 
-		Row * row = rows.Get(focusRowNo);
-		if (row != NULL)
+		if (focusRowNo >= 0 && focusRowNo < getRowCount())
 		{
-			selectedRows.Add(row);
+			selectRowInternal(focusRowNo);
 			notifySelectionChanged();
 		}
 	}
 
 	ensureFocusVisible();
-	invalidate();
 }
 
 void ListField::setHeadlined(bool headlined)
@@ -1212,69 +2569,104 @@ void ListField::setHorizontallyScrollable(bool horizontallyScrollable)
 	invalidate();
 }
 
-void ListField::setRowsRemovable(bool rowsRemovable)
+void ListField::setProvider(Provider * provider)
 {
 	ASSERTION_COBJECT(this);
-	this->rowsRemovable = rowsRemovable;
+
+	if (this->provider == provider)
+		return;
+
+	if (!rows.IsEmpty())
+		throw EILLEGALSTATE("The list field must not contain any rows when setting a provider");
+	if (isFiltered())
+		throw EILLEGALSTATE("The list field must not be filtered when setting a provider");
+
+	bool selectionChanged = getSelectedRowCount() > 0;
+	unselectRowsInternal();
+	destroyTransientRows();
+
+	if (this->provider != NULL) {this->provider->release(); this->provider = NULL;}
+	selection.setRowCount(0);
+	providerRowCount = 0;
+
+	this->provider = provider;
+	if (provider != NULL)
+	{
+		provider->addReference();
+
+		int rowCount = provider->getRowCount(this);
+		selection.setRowCount(rowCount);
+		providerRowCount = rowCount;
+	}
+
+	focusRowNo = 0;
+	rangeStartRowNo = 0;
+	if (type == TYPE_ONE && getRowCount() > 0)
+	{
+		selectRowInternal(0);
+		selectionChanged = true;
+	}
+
+	rowsField.updateContentSize();
+	ensureFocusVisible();
+	invalidate();
+
+	if (selectionChanged)
+		notifySelectionChanged();
 }
 
-void ListField::setSelectedRow(int rowNo)
+void ListField::setRowsRemovable(bool rowsRemovable)
 {
 	ASSERTION_COBJECT(this);
-	setSelectedRow(rows.Get(rowNo));
+	this->rowsRemovable = rowsRemovable;
 }
 
-void ListField::setSelectedRow(Row * row)
+void ListField::setSelectedRow(int rowNo)
 {
 	ASSERTION_COBJECT(this);
 
-	if (selectedRows.GetCount() <= 1)
-	{
-		Row * selectedRow = NULL;
-		if (!selectedRows.IsEmpty())
-		{
-			PointeredList * selectedRowsList = selectedRows.GetAll();
-			PointeredListItem * selectedRowsListItem = selectedRowsList->GetFirst();
-			Row * selectedRow = selectedRowsListItem != NULL ? (Row *) selectedRowsListItem->GetData() : NULL;
-			delete selectedRowsList;
-		}
+	if (rowNo < 0 || rowNo >= getRowCount())
+		rowNo = -1;
 
-		if (selectedRow == row)
-			return;
-	}
+	if (getSelectedRowCount() <= 1 && getNextSelectedRowNo(-1) == rowNo)
+		return;
 
-	selectedRows.RemoveAll();
-	if (row != NULL && rows.Contains(row))
+	invalidateSelectionChange(rowNo, rowNo);
+	unselectRowsInternal();
+	if (rowNo >= 0)
 	{
-		selectedRows.Add(row);
+		selectRowInternal(rowNo);
 
-		if (type != TYPE_MANY)
+		if (type != TYPE_MANY && this->focusRowNo != rowNo)
 		{
-			int focusRowNo = getRowNo(row);
-			if (this->focusRowNo != focusRowNo)
-			{
-				this->focusRowNo = focusRowNo;
-				ensureFocusVisible();
-			}
+			int oldFocusRowNo = focusRowNo;
+			this->focusRowNo = rowNo;
+			invalidateFocusChange(oldFocusRowNo);
+			ensureFocusVisible();
 		}
 	}
 
 	notifySelectionChanged();
-	invalidate();
+}
+
+void ListField::setSelectedRow(Row * row)
+{
+	ASSERTION_COBJECT(this);
+	setSelectedRow(getRowNo(row));
 }
 
 void ListField::setSelectedRows(const HashSet & selectedRows)
 {
 	ASSERTION_COBJECT(this);
 
-	if (this->selectedRows.GetCount() == selectedRows.GetCount())
+	if (getSelectedRowCount() == selectedRows.GetCount())
 	{
-		PointeredList * selectedRowsList = this->selectedRows.GetAll();
+		PointeredList * selectedRowsList = selectedRows.GetAll();
 		PointeredListItem * selectedRowsListItem = selectedRowsList->GetFirst();
 		while (selectedRowsListItem != NULL)
 		{
 			Row * selectedRow = (Row *) selectedRowsListItem->GetData();
-			if (!selectedRows.Contains(selectedRow))
+			if (!isRowSelected(selectedRow))
 				break;
 
 			selectedRowsListItem = selectedRowsListItem->GetNext();
@@ -1285,7 +2677,7 @@ void ListField::setSelectedRows(const HashSet & selectedRows)
 			return;
 	}
 
-	this->selectedRows.RemoveAll();
+	unselectRowsInternal();
 
 	if (!selectedRows.IsEmpty())
 	{
@@ -1294,7 +2686,7 @@ void ListField::setSelectedRows(const HashSet & selectedRows)
 		while (selectedRowsListItem != NULL)
 		{
 			Row * selectedRow = (Row *) selectedRowsListItem->GetData();
-			this->selectedRows.Add(selectedRow);
+			selectRowInternal(getRowNo(selectedRow));
 
 			// Use only one, if type is not many, but focus it
 			if (type != TYPE_MANY)
@@ -1314,6 +2706,49 @@ void ListField::setSelectedRows(const HashSet & selectedRows)
 	invalidate();
 }
 
+void ListField::setSelectedRows(int fromRowNo, int toRowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	if (fromRowNo > toRowNo)
+	{
+		int swap = fromRowNo;
+		fromRowNo = toRowNo;
+		toRowNo = swap;
+	}
+	if (fromRowNo < 0)
+		fromRowNo = 0;
+	if (toRowNo > getRowCount() - 1)
+		toRowNo = getRowCount() - 1;
+	if (type != TYPE_MANY)
+		toRowNo = fromRowNo;
+
+	// Nothing to do if the selection already equals the range
+	int rowCount = toRowNo >= fromRowNo ? toRowNo - fromRowNo + 1 : 0;
+	if (selection.getCount() == rowCount)
+	{
+		int selectedFromRowNo;
+		int selectedToRowNo;
+		if (rowCount == 0 || (selection.getNextRange(-1, selectedFromRowNo, selectedToRowNo)
+			&& selectedFromRowNo == fromRowNo && selectedToRowNo == toRowNo))
+			return;
+	}
+
+	invalidateSelectionChange(fromRowNo, toRowNo);
+	unselectRowsInternal();
+	selection.selectRange(fromRowNo, toRowNo);
+
+	if (type != TYPE_MANY && rowCount > 0)
+	{
+		int oldFocusRowNo = focusRowNo;
+		this->focusRowNo = fromRowNo;
+		invalidateFocusChange(oldFocusRowNo);
+		ensureFocusVisible();
+	}
+
+	notifySelectionChanged();
+}
+
 void ListField::setType(Type type)
 {
 	ASSERTION_COBJECT(this);
@@ -1325,24 +2760,23 @@ void ListField::setType(Type type)
 
 	if (type == TYPE_ONE)
 	{
-		selectedRows.RemoveAll();
+		unselectRowsInternal();
 
-		Row * focusRow = getFocusRow();
-		if (focusRow != NULL)
-			selectedRows.Add(focusRow);
+		if (focusRowNo >= 0 && focusRowNo < getRowCount())
+			selectRowInternal(focusRowNo);
 
 		notifySelectionChanged();
 	}
 	else if (type == TYPE_ONE_OR_NONE)
 	{
-		if (selectedRows.GetCount() > 1)
+		if (getSelectedRowCount() > 1)
 		{
-			selectedRows.RemoveAll();
+			unselectRowsInternal();
 			notifySelectionChanged();
 		}
-		else if (selectedRows.GetCount() == 1)
+		else if (getSelectedRowCount() == 1)
 		{
-			this->focusRowNo = getRowNo(getSelectedRow());
+			this->focusRowNo = getNextSelectedRowNo(-1);
 			ensureFocusVisible();
 		}
 	}
@@ -1364,8 +2798,104 @@ void ListField::sortRows(int (*compare)(Row * row1, Row * row2))
 {
 	ASSERTION_COBJECT(this);
 
-	rows.Sort((int (*)(const Row * row1, const Row * row2)) compare);
-	invalidate();
+	if (provider != NULL)
+		throw EILLEGALSTATE("Virtual list fields do not support sorting rows, use the provider instead");
+
+	cancelSortJob();
+
+	Row * focusRow = getFocusRow();
+	Row * rangeStartRow = getRow(rangeStartRowNo);
+
+	Row ** selectedRowsArray;
+	if ((selectedRowsArray = new Row *[selection.getCount() + 1]) == NULL)
+		throw EOUTOFMEMORY;
+
+	int i;
+	int selectedRowCount = selection.getCount();
+	int rowNo = -1;
+	for (i=0; i<selectedRowCount; i++)
+		selectedRowsArray[i] = rows.Get(rowNo = selection.getNext(rowNo));
+
+	rows.Sort((int (*)(const Row * row1, const Row * row2)) compare);
+	repositionRows();
+
+	// The selection follows the rows to their new numbers
+	selection.clear();
+	for (i=0; i<selectedRowCount; i++)
+		selection.select(getRowNo(selectedRowsArray[i]));
+	delete[] selectedRowsArray;
+
+	syncFilterRows();
+
+	if (focusRow != NULL)
+		focusRowNo = getRowNo(focusRow);
+	if (rangeStartRow != NULL)
+		rangeStartRowNo = getRowNo(rangeStartRow);
+
+	ensureFocusVisible();
+	invalidate();
+}
+
+void ListField::sortRows(int columnNo, bool descending, bool background)
+{
+	ASSERTION_COBJECT(this);
+	sortRows(&columnNo, &descending, 1, background);
+}
+
+void ListField::sortRows(const int * columnNos, const bool * descending, int columnCount,
+	bool background)
+{
+	ASSERTION_COBJECT(this);
+
+	if (provider != NULL)
+		throw EILLEGALSTATE("Virtual list fields do not support sorting rows, use the provider instead");
+
+	cancelSortJob();
+	if (rows.GetCount() < 2 || columnCount <= 0)
+		return;
+
+	SortJob * job;
+	if ((job = new SortJob(this, columnNos, descending, columnCount)) == NULL)
+		throw EOUTOFMEMORY;
+
+	if (background && rows.GetCount() >= GL_LISTFIELD_BACKGROUNDSORTROWS)
+	{
+		sortJob = job;
+		job->start();
+	}
+	else
+	{
+		job->execute();
+		applySortJob(job);
+		delete job;
+	}
+}
+
+void ListField::syncFilterRows()
+{
+	ASSERTION_COBJECT(this);
+
+	if (!isFiltered())
+		return;
+
+	Row ** unfilteredRows;
+	if ((unfilteredRows = new Row *[filterRows.GetCount() + 1]) == NULL)
+		throw EOUTOFMEMORY;
+
+	int i;
+	int rowNo = 0;
+	int unfilteredRowCount = filterRows.GetCount();
+	for (i=0; i<unfilteredRowCount; i++)
+	{
+		Row * row = filterRows.Get(i);
+		unfilteredRows[i] = row->hidden ? row : rows.Get(rowNo++);
+	}
+
+	filterRows.UnlinkAll();
+	for (i=0; i<unfilteredRowCount; i++)
+		filterRows.Append(unfilteredRows[i]);
+	delete[] unfilteredRows;
+	repositionFilterRows();
 }
 
 String ListField::toString()
@@ -1390,7 +2920,7 @@ void ListField::tutorialClick(int rowNo, int columnNo, int elementNo,
 {
 	ASSERTION_COBJECT(this);
 
-	if (columns.IsEmpty() || rows.IsEmpty())
+	if (columns.IsEmpty() || getRowCount() == 0)
 		return;
 
 	Cell * cell = getCell(rowNo, columnNo);
@@ -1462,16 +2992,43 @@ void ListField::updateSelectionFromFocus(bool option1, bool option2)
 		rangeStartRowNo = focusRowNo;
 
 	if (!option2 || type != TYPE_MANY)
-	{
-		HashSet rowsToSelect;
-		if (rangeStartRowNo <= focusRowNo)
-			for (int i=rangeStartRowNo; i<=focusRowNo; i++)
-				rowsToSelect.Add(rows.Get(i));
-		else
-			for (int i=focusRowNo; i<=rangeStartRowNo; i++)
-				rowsToSelect.Add(rows.Get(i));
+		setSelectedRows(rangeStartRowNo, focusRowNo);
+}
+
+void ListField::unindexRowModel(Row * row)
+{
+	ASSERTION_COBJECT(this);
+
+	if (row->getModel() == NULL)
+		return;
+
+	if (row->previousModelRow != NULL)
+		row->previousModelRow->nextModelRow = row->nextModelRow;
+	else
+		modelBuckets[getModelBucket(row->getModel())] = row->nextModelRow;
+	if (row->nextModelRow != NULL)
+		row->nextModelRow->previousModelRow = row->previousModelRow;
+
+	row->nextModelRow = NULL;
+	row->previousModelRow = NULL;
+	modelRowCount--;
+}
+
+void ListField::unlinkFilterRow(Row * row)
+{
+	ASSERTION_COBJECT(this);
 
-		setSelectedRows(rowsToSelect);
+	if (isFiltered())
+	{
+		filterRows.Unlink(getFilterRowNo(row));
+		filterRowPositions.remove(&row->filterPosition);
+		if (filterIndex != NULL)
+			filterIndex->removeRow(row->filterIndexRowNo);
+		if (row->filterPending)
+		{
+			filterPendingRows.Unlink(filterPendingRows.Find(row));
+			row->filterPending = false;
+		}
 	}
 }
 
@@ -1479,38 +3036,56 @@ void ListField::unselectRow(Row * row)
 {
 	ASSERTION_COBJECT(this);
 
-	if (selectedRows.Contains(row))
+	if (isRowSelected(row))
 	{
-		selectedRows.Remove(row);
+		int rowNo = getRowNo(row);
+		unselectRowInternal(rowNo);
 		notifySelectionChanged();
-		invalidate();
+		invalidateRows(rowNo, rowNo);
 	}
 }
 
+void ListField::unselectRowInternal(int rowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	selection.unselect(rowNo);
+}
+
 void ListField::unselectRows()
 {
 	ASSERTION_COBJECT(this);
 
-	if (!selectedRows.IsEmpty())
+	if (getSelectedRowCount() > 0)
 	{
-		selectedRows.RemoveAll();
+		unselectRowsInternal();
 		notifySelectionChanged();
 		invalidate();
 	}
 }
 
+void ListField::unselectRowsInternal()
+{
+	ASSERTION_COBJECT(this);
+	selection.clear();
+}
+
 
 ListField::Cell::Cell()
 {
 	ASSERTION_COBJECT(this);
 
 	column = NULL;
+	contentWidth = -1;
 	row = NULL;
 }
 
 ListField::Cell::~Cell()
 {
 	ASSERTION_COBJECT(this);
+
+	if (contentWidth >= 0)
+		column->removeContentWidth(contentWidth);
 }
 
 void ListField::Cell::appendElement(FieldElement * element)
@@ -1525,7 +3100,7 @@ void ListField::Cell::appendElement(FieldElement * element)
 
 	elements.Append(element);
 	element->setFieldAndParent(row->getField(), this);
-	row->getField()->invalidate();
+	row->getField()->invalidateRow(row);
 }
 
 FieldElement * ListField::Cell::edit()
@@ -1638,7 +3213,7 @@ void ListField::Cell::insertElement(int position, FieldElement * element)
 
 	elements.Insert(element, position);
 	element->setFieldAndParent(getField(), this);
-	getField()->invalidate();
+	getField()->invalidateRow(row);
 }
 
 void ListField::Cell::prependElement(FieldElement * element)
@@ -1653,7 +3228,7 @@ void ListField::Cell::prependElement(FieldElement * element)
 
 	elements.Prepend(element);
 	element->setFieldAndParent(getField(), this);
-	getField()->invalidate();
+	getField()->invalidateRow(row);
 }
 
 void ListField::Cell::removeElement(int position)
@@ -1664,7 +3239,7 @@ void ListField::Cell::removeElement(int position)
 		throw EILLEGALSTATE("The cell must be added to a row before using it");
 
 	elements.Delete(position);
-	getField()->invalidate();
+	getField()->invalidateRow(row);
 }
 
 void ListField::Cell::removeElements()
@@ -1675,7 +3250,7 @@ void ListField::Cell::removeElements()
 		throw EILLEGALSTATE("The cell must be added to a row before using it");
 
 	elements.DeleteAll();
-	getField()->invalidate();
+	getField()->invalidateRow(row);
 }
 
 void ListField::Cell::setColumn(Column * column)
@@ -1704,8 +3279,12 @@ ListField::Column::Column()
 	alignment = ListField::ALIGN_LEFT;
 	autoEditing = false;
 	autoResizing = false;
+	contentWidth = 0;
+	contentWidthCounts = NULL;
+	contentWidthCountsSize = 0;
 	editable = true;
 	field = NULL;
+	fittingContent = false;
 	heading = "";
 	maximumWidth = 0;
 	minimumWidth = 16;
@@ -1716,6 +3295,45 @@ ListField::Column::Column()
 ListField::Column::~Column()
 {
 	ASSERTION_COBJECT(this);
+	clearContentWidths();
+}
+
+void ListField::Column::addContentWidth(int width)
+{
+	ASSERTION_COBJECT(this);
+
+	if (width >= contentWidthCountsSize)
+	{
+		int newSize = contentWidthCountsSize > 0 ? contentWidthCountsSize * 2 : 256;
+		while (newSize <= width)
+			newSize *= 2;
+
+		int * newCounts;
+		if ((newCounts = new int[newSize]) == NULL)
+			throw EOUTOFMEMORY;
+		memset(newCounts, 0, newSize * sizeof(int));
+		if (contentWidthCounts != NULL)
+		{
+			memcpy(newCounts, contentWidthCounts, contentWidthCountsSize * sizeof(int));
+			delete[] contentWidthCounts;
+		}
+
+		contentWidthCounts = newCounts;
+		contentWidthCountsSize = newSize;
+	}
+
+	contentWidthCounts[width]++;
+	if (width > contentWidth)
+		contentWidth = width;
+}
+
+void ListField::Column::clearContentWidths()
+{
+	ASSERTION_COBJECT(this);
+
+	if (contentWidthCounts != NULL) {delete[] contentWidthCounts; contentWidthCounts = NULL;}
+	contentWidthCountsSize = 0;
+	contentWidth = 0;
 }
 
 int ListField::Column::getActualWidth()
@@ -1730,6 +3348,12 @@ ListField::Alignment ListField::Column::getAlignment()
 	return alignment;
 }
 
+int ListField::Column::getContentWidth()
+{
+	ASSERTION_COBJECT(this);
+	return contentWidth;
+}
+
 ListField * ListField::Column::getField()
 {
 	ASSERTION_COBJECT(this);
@@ -1778,12 +3402,30 @@ bool ListField::Column::isEditable()
 	return editable;
 }
 
+bool ListField::Column::isFittingContent()
+{
+	ASSERTION_COBJECT(this);
+	return fittingContent;
+}
+
 bool ListField::Column::isVisible()
 {
 	ASSERTION_COBJECT(this);
 	return visible;
 }
 
+void ListField::Column::removeContentWidth(int width)
+{
+	ASSERTION_COBJECT(this);
+
+	contentWidthCounts[width]--;
+
+	// Only the widths below the removed largest one can be the largest one now
+	if (width == contentWidth)
+		while (contentWidth > 0 && contentWidthCounts[contentWidth] == 0)
+			contentWidth--;
+}
+
 void ListField::Column::setAlignment(ListField::Alignment alignment)
 {
 	ASSERTION_COBJECT(this);
@@ -1839,6 +3481,22 @@ void ListField::Column::setField(ListField * field)
 	this->field = field;
 }
 
+void ListField::Column::setFittingContent(bool fittingContent)
+{
+	ASSERTION_COBJECT(this);
+
+	if (this->fittingContent == fittingContent)
+		return;
+
+	this->fittingContent = fittingContent;
+
+	if (field != NULL)
+	{
+		field->measureColumn(this);
+		field->adjustAutoColumns();
+	}
+}
+
 void ListField::Column::setHeading(const String & heading)
 {
 	ASSERTION_COBJECT(this);
@@ -1849,7 +3507,11 @@ void ListField::Column::setHeading(const String & heading)
 	this->heading = heading;
 
 	if (field != NULL)
+	{
+		if (fittingContent)
+			field->fitColumns();
 		field->invalidate();
+	}
 }
 
 void ListField::Column::setMaximumWidth(int maximumWidth)
@@ -1995,6 +3657,11 @@ void ListField::Listener::onColumnResized(ListField * field, int columnNo, int o
 	ASSERTION_COBJECT(this);
 }
 
+void ListField::Listener::onFilterChanged(ListField * field)
+{
+	ASSERTION_COBJECT(this);
+}
+
 void ListField::Listener::onHeadlineHover(ListField * field, int columnNo)
 {
 	ASSERTION_COBJECT(this);
@@ -2005,6 +3672,14 @@ void ListField::Listener::onRowAdded(ListField * field, int rowNo)
 	ASSERTION_COBJECT(this);
 }
 
+void ListField::Listener::onRowsAdded(ListField * field, int rowNo, int rowCount)
+{
+	ASSERTION_COBJECT(this);
+
+	for (int i=0; i<rowCount; i++)
+		onRowAdded(field, rowNo + i);
+}
+
 void ListField::Listener::onRowsRemoved(ListField * field)
 {
 	ASSERTION_COBJECT(this);
@@ -2022,11 +3697,70 @@ void ListField::Listener::onSelectionChanged(ListField * field)
 }
 
 
+ListField::Provider::~Provider()
+{
+	ASSERTION_COBJECT(this);
+}
+
+Image * ListField::Provider::getCellImage(ListField * field, int rowNo, int columnNo)
+{
+	ASSERTION_COBJECT(this);
+	return NULL;
+}
+
+String ListField::Provider::getCellText(ListField * field, int rowNo, int columnNo)
+{
+	ASSERTION_COBJECT(this);
+	return String();
+}
+
+int ListField::Provider::getRowCount(ListField * field)
+{
+	ASSERTION_COBJECT(this);
+	return 0;
+}
+
+void * ListField::Provider::getRowModel(ListField * field, int rowNo)
+{
+	ASSERTION_COBJECT(this);
+	return NULL;
+}
+
+int ListField::Provider::getRowNoByModel(ListField * field, void * model)
+{
+	ASSERTION_COBJECT(this);
+
+	int rowCount = field->getRowCount();
+	for (int rowNo = 0; rowNo < rowCount; rowNo++)
+		if (getRowModel(field, rowNo) == model)
+			return rowNo;
+
+	return -1;
+}
+
+bool ListField::Provider::isRowActive(ListField * field, int rowNo)
+{
+	ASSERTION_COBJECT(this);
+	return true;
+}
+
+void ListField::Provider::setCellText(ListField * field, int rowNo, int columnNo, const String & text)
+{
+	ASSERTION_COBJECT(this);
+}
+
+
 ListField::Row::Row()
 {
 	ASSERTION_COBJECT(this);
 	active = true;
 	field = NULL;
+	filterIndexRowNo = -1;
+	filterPending = false;
+	hidden = false;
+	nextModelRow = NULL;
+	previousModelRow = NULL;
+	transientRowNo = -1;
 }
 
 ListField::Row::~Row()
@@ -2078,7 +3812,7 @@ void ListField::Row::insertCell(int position, ListField::Cell * cell)
 	cells.Insert(cell, position);
 	cell->setColumn(column);
 	cell->setRow(this);
-	field->invalidate();
+	field->invalidateRow(this);
 }
 
 bool ListField::Row::isActive()
@@ -2094,7 +3828,7 @@ bool ListField::Row::isSelected()
 	if (field == NULL)
 		throw EILLEGALSTATE("The row must be added to a list field before using it");
 
-	return field->getSelectedRows().Contains(this);
+	return field->isRowSelected(this);
 }
 
 void ListField::Row::prependCell(ListField::Cell * cell)
@@ -2111,7 +3845,7 @@ void ListField::Row::removeCell(int position)
 		throw EILLEGALSTATE("The row must be added to a list field before using it");
 
 	cells.Delete(position);
-	field->invalidate();
+	field->invalidateRow(this);
 }
 
 void ListField::Row::removeCells()
@@ -2122,7 +3856,7 @@ void ListField::Row::removeCells()
 		throw EILLEGALSTATE("The row must be added to a list field before using it");
 
 	cells.DeleteAll();
-	field->invalidate();
+	field->invalidateRow(this);
 }
 
 void ListField::Row::select()
@@ -2144,7 +3878,7 @@ void ListField::Row::setActive(bool active)
 
 	this->active = active;
 
-	while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo < field->rows.GetCount() - 1)
+	while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo < field->getRowCount() - 1)
 	   field->focusRowNo++;
 	while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo > 0)
 	   field->focusRowNo--;
@@ -2163,6 +3897,21 @@ void ListField::Row::setField(ListField * field)
 	this->field = field;
 }
 
+void ListField::Row::setModel(void * model, void (*modelDestructor)(void * model))
+{
+	ASSERTION_COBJECT(this);
+
+	// Transient rows of virtual list fields and rows hidden by the filter are not indexed
+	bool indexed = field != NULL && field->provider == NULL && !hidden;
+	if (indexed)
+		field->unindexRowModel(this);
+
+	GlazieryObject::setModel(model, modelDestructor);
+
+	if (indexed)
+		field->indexRowModel(this);
+}
+
 void ListField::Row::unselect()
 {
 	ASSERTION_COBJECT(this);
@@ -2204,7 +3953,10 @@ void ListField::RowsField::drawContent(DrawingContext & context)
 	ASSERTION_COBJECT(this);
 
 	Skin * skin = Desktop::getInstance()->getSkin();
-	skin->drawListFieldRowsField(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawListFieldRowsField")
+		skin->drawListFieldRowsField(context, this);
+	}
 }
 
 void ListField::RowsField::getColumnAndRowForPosition(Vector position,
@@ -2217,7 +3969,6 @@ void ListField::RowsField::getColumnAndRowForPosition(Vector position,
 	int columnBorderWidth = skin->getListFieldColumnBorderWidth(field);
 	int rowHeight = skin->getListFieldRowHeight(field);
 	const ArrayList<Column> & columns = field->columns;
-	const ArrayList<Row> & rows = field->rows;
 
 	columnPos = 0;
 	for (columnNo = 0; columnNo < columns.GetCount(); columnNo++)
@@ -2236,7 +3987,7 @@ void ListField::RowsField::getColumnAndRowForPosition(Vector position,
 	if (columnNo < 0) columnNo = -1;
 	if (columnNo > columns.GetCount()) columnNo = columns.GetCount();
 	if (rowNo < 0) rowNo = -1;
-	if (rowNo > rows.GetCount()) rowNo = rows.GetCount();
+	if (rowNo > field->getRowCount()) rowNo = field->getRowCount();
 }
 
 ListField * ListField::RowsField::getListField()
@@ -2364,7 +4115,7 @@ void ListField::RowsField::onContentDoubleClick(Vector position, bool option1, b
 	if (editEffect != NULL) {editEffect->cancel(); editEffect = NULL;}
 
 	ListField * field = getListField();
-	Row * row = field->rows.Get(lastClickRowNo);
+	Row * row = field->getRow(lastClickRowNo);
 	if (row == NULL)
 		return;
 
@@ -2415,6 +4166,7 @@ void ListField::RowsField::onContentPress(Vector position, bool option1, bool op
 
 	ListField * field = getListField();
 	Skin * skin = Desktop::getInstance()->getSkin();
+	int oldFocusRowNo = field->focusRowNo;
 
 	if (columnNo >= 0 && columnNo < field->getColumnCount()
 		&& rowNo >= 0 && rowNo < field->getRowCount())
@@ -2465,7 +4217,7 @@ void ListField::RowsField::onContentPress(Vector position, bool option1, bool op
 		{
 			field->focusColumnNo = columnNo;
 			field->focusRowNo = rowNo;
-			while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo < field->rows.GetCount() - 1)
+			while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo < field->getRowCount() - 1)
 	     		field->focusRowNo++;
 			while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo > 0)
 	     		field->focusRowNo--;
@@ -2487,14 +4239,15 @@ void ListField::RowsField::onContentPress(Vector position, bool option1, bool op
 	}
 	else if (!option1 && !option2 && field->getType() != ListField::TYPE_ONE)
 	{
-		if (!field->selectedRows.IsEmpty())
+		if (field->getSelectedRowCount() > 0)
 		{
-			field->selectedRows.RemoveAll();
+			field->invalidateSelectionChange(0, -1);
+			field->unselectRowsInternal();
 			field->notifySelectionChanged();
 		}
 	}
 
-	invalidate();
+	field->invalidateFocusChange(oldFocusRowNo);
 }
 
 void ListField::RowsField::onContextClick(Vector position, bool option1, bool option2)
@@ -2526,7 +4279,7 @@ void ListField::RowsField::onContextClick(Vector position, bool option1, bool op
 	getColumnAndRowForPosition(positionWithinContent, columnNo, columnPos, rowNo);
 
 	ListField * field = getListField();
-	Skin * skin = Desktop::getInstance()->getSkin();
+	int oldFocusRowNo = field->focusRowNo;
 
 	if (columnNo >= 0 && columnNo < field->getColumnCount()
 		&& rowNo >= 0 && rowNo < field->getRowCount())
@@ -2543,14 +4296,15 @@ void ListField::RowsField::onContextClick(Vector position, bool option1, bool op
 	}
 	else if (field->getType() != ListField::TYPE_ONE)
 	{
-		if (!field->selectedRows.IsEmpty())
+		if (field->getSelectedRowCount() > 0)
 		{
-			field->selectedRows.RemoveAll();
+			field->invalidateSelectionChange(0, -1);
+			field->unselectRowsInternal();
 			field->notifySelectionChanged();
 		}
 	}
 
-	invalidate();
+	field->invalidateFocusChange(oldFocusRowNo);
 
 	ScrollingField::onContextClick(position, option1, option2);
 }
@@ -2565,7 +4319,11 @@ bool ListField::RowsField::onDelete()
 	if (!field->isEditable() || !field->isRowsRemovable())
 		return true;
 
-	if (field->selectedRows.IsEmpty() && !field->rows.IsEmpty())
+	// Virtual list fields remove rows using their provider
+	if (field->isVirtual())
+		return true;
+
+	if (field->getSelectedRowCount() == 0 && !field->rows.IsEmpty())
 		field->removeRow(field->focusRowNo);
 	else
 		field->removeSelectedRows();
@@ -2656,17 +4414,18 @@ bool ListField::RowsField::onMoveDown(bool option1, bool option2)
 	ScrollingField::onMoveDown(option1, option2);
 
 	ListField * field = getListField();
-	if (field->focusRowNo < field->rows.GetCount() - 1)
+	int oldFocusRowNo = field->focusRowNo;
+	if (field->focusRowNo < field->getRowCount() - 1)
 	{
 		field->focusRowNo++;
-		while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo < field->rows.GetCount() - 1)
+		while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo < field->getRowCount() - 1)
 	     	field->focusRowNo++;
 		while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo > 0)
 	     	field->focusRowNo--;
 
 		field->updateSelectionFromFocus(option1, option2);
+		field->invalidateFocusChange(oldFocusRowNo);
 		field->ensureFocusVisible();
-		invalidate();
 	}
 
 	return true;
@@ -2683,8 +4442,8 @@ bool ListField::RowsField::onMoveLeft(bool option1, bool option2)
 		if (field->columns.Get(i)->isVisible())
 		{
 			field->focusColumnNo = i;
+			field->invalidateRows(field->focusRowNo, field->focusRowNo);
 			field->ensureFocusVisible();
-			invalidate();
 			return true;
 		}
 
@@ -2702,8 +4461,8 @@ bool ListField::RowsField::onMoveRight(bool option1, bool option2)
 		if (field->columns.Get(i)->isVisible())
 		{
 			field->focusColumnNo = i;
+			field->invalidateRows(field->focusRowNo, field->focusRowNo);
 			field->ensureFocusVisible();
-			invalidate();
 			return true;
 		}
 
@@ -2717,15 +4476,16 @@ bool ListField::RowsField::onMoveToEnd(bool option1, bool option2)
 	ScrollingField::onMoveToEnd(option1, option2);
 
 	ListField * field = getListField();
-	if (field->focusRowNo < field->rows.GetCount() - 1)
+	int oldFocusRowNo = field->focusRowNo;
+	if (field->focusRowNo < field->getRowCount() - 1)
 	{
-		field->focusRowNo = field->rows.GetCount() - 1;
+		field->focusRowNo = field->getRowCount() - 1;
 		while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo > 0)
 	     	field->focusRowNo--;
 
 		field->updateSelectionFromFocus(option1, option2);
+		field->invalidateFocusChange(oldFocusRowNo);
 		field->ensureFocusVisible();
-		invalidate();
 	}
 
 	return true;
@@ -2738,15 +4498,16 @@ bool ListField::RowsField::onMoveToStart(bool option1, bool option2)
 	ScrollingField::onMoveToStart(option1, option2);
 
 	ListField * field = getListField();
+	int oldFocusRowNo = field->focusRowNo;
 	if (field->focusRowNo > 0)
 	{
 		field->focusRowNo = 0;
-		while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo < field->rows.GetCount() - 1)
+		while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo < field->getRowCount() - 1)
 	     	field->focusRowNo++;
 
 		field->updateSelectionFromFocus(option1, option2);
+		field->invalidateFocusChange(oldFocusRowNo);
 		field->ensureFocusVisible();
-		invalidate();
 	}
 
 	return true;
@@ -2759,17 +4520,18 @@ bool ListField::RowsField::onMoveUp(bool option1, bool option2)
 	ScrollingField::onMoveUp(option1, option2);
 
 	ListField * field = getListField();
+	int oldFocusRowNo = field->focusRowNo;
 	if (field->focusRowNo > 0)
 	{
      	field->focusRowNo--;
 		while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo > 0)
 	     	field->focusRowNo--;
-		while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo < field->rows.GetCount() - 1)
+		while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo < field->getRowCount() - 1)
 	     	field->focusRowNo++;
 
 		field->updateSelectionFromFocus(option1, option2);
+		field->invalidateFocusChange(oldFocusRowNo);
 		field->ensureFocusVisible();
-		invalidate();
 	}
 
 	return true;
@@ -2782,19 +4544,20 @@ bool ListField::RowsField::onPageDown(bool option1, bool option2)
 	ScrollingField::onPageDown(option1, option2);
 
 	ListField * field = getListField();
-	if (field->focusRowNo < field->rows.GetCount() - 1)
+	int oldFocusRowNo = field->focusRowNo;
+	if (field->focusRowNo < field->getRowCount() - 1)
 	{
 		field->focusRowNo += getPageLinesCount();
-		if (field->focusRowNo > field->rows.GetCount() - 1)
-			field->focusRowNo = field->rows.GetCount() - 1;
-		while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo < field->rows.GetCount() - 1)
+		if (field->focusRowNo > field->getRowCount() - 1)
+			field->focusRowNo = field->getRowCount() - 1;
+		while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo < field->getRowCount() - 1)
 	     	field->focusRowNo++;
 		while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo > 0)
 	     	field->focusRowNo--;
 
 		field->updateSelectionFromFocus(option1, option2);
+		field->invalidateFocusChange(oldFocusRowNo);
 		field->ensureFocusVisible();
-		invalidate();
 	}
 
 	return true;
@@ -2807,6 +4570,7 @@ bool ListField::RowsField::onPageUp(bool option1, bool option2)
 	ScrollingField::onPageUp(option1, option2);
 
 	ListField * field = getListField();
+	int oldFocusRowNo = field->focusRowNo;
 	if (field->focusRowNo > 0)
 	{
 		field->focusRowNo -= getPageLinesCount();
@@ -2814,12 +4578,12 @@ bool ListField::RowsField::onPageUp(bool option1, bool option2)
 			field->focusRowNo = 0;
 		while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo > 0)
 	     	field->focusRowNo--;
-		while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo < field->rows.GetCount() - 1)
+		while (!field->getRow(field->focusRowNo)->isActive() && field->focusRowNo < field->getRowCount() - 1)
 	     	field->focusRowNo++;
 
 		field->updateSelectionFromFocus(option1, option2);
+		field->invalidateFocusChange(oldFocusRowNo);
 		field->ensureFocusVisible();
-		invalidate();
 	}
 
 	return true;
@@ -2886,33 +4650,35 @@ void ListField::RowsField::toggleSelection()
 	ASSERTION_COBJECT(this);
 
 	ListField * field = getListField();
-	if (field->rows.IsEmpty())
+	if (field->getRowCount() == 0)
 		return;
 
-	Row * row = field->rows.Get(field->focusRowNo);
+	int rowNo = field->focusRowNo;
 
 	if (field->getType() == ListField::TYPE_ONE)
 	{
-		field->selectedRows.RemoveAll();
-		field->selectedRows.Add(row);
+		field->invalidateSelectionChange(rowNo, rowNo);
+		field->unselectRowsInternal();
+		field->selectRowInternal(rowNo);
 	}
 	else if (field->getType() == ListField::TYPE_ONE_OR_NONE)
 	{
-		bool focusEqualsSelection = field->selectedRows.GetCount() == 1 && field->selectedRows.Contains(row);
-		field->selectedRows.RemoveAll();
+		bool focusEqualsSelection = field->getSelectedRowCount() == 1 && field->isRowSelected(rowNo);
+		field->invalidateSelectionChange(rowNo, focusEqualsSelection ? rowNo - 1 : rowNo);
+		field->unselectRowsInternal();
 		if (!focusEqualsSelection)
-			field->selectedRows.Add(row);
+			field->selectRowInternal(rowNo);
 	}
 	else
 	{
-		if (field->selectedRows.Contains(row))
-			field->selectedRows.Remove(row);
+		field->invalidateRows(rowNo, rowNo);
+		if (field->isRowSelected(rowNo))
+			field->unselectRowInternal(rowNo);
 		else
-			field->selectedRows.Add(row);
+			field->selectRowInternal(rowNo);
 	}
 
 	field->notifySelectionChanged();
-	invalidate();
 }
 
 String ListField::RowsField::toString()
@@ -2931,9 +4697,252 @@ void ListField::RowsField::updateContentSize()
 
 	ListField * field = getListField();
 	Skin * skin = Desktop::getInstance()->getSkin();
-	int columnBorderWidth = skin->getListFieldColumnBorderWidth(field);
 	int rowHeight = skin->getListFieldRowHeight(field);
 
 	contentSize = Vector(field->getRowWidth(),
-		rowHeight * field->rows.GetCount());
+		rowHeight * field->getRowCount());
+}
+
+
+ListField::SortJob::SortJob(ListField * field, const int * columnNos, const bool * descending, int keyCount)
+{
+	ASSERTION_COBJECT(this);
+
+	buffer = NULL;
+	canceled = false;
+	deferred = false;
+	this->descending = NULL;
+	this->field = field;
+	finishedThreadCount = 0;
+	this->keyCount = keyCount;
+	keys = NULL;
+	order = NULL;
+	rowCount = field->rows.GetCount();
+	texts = NULL;
+	textsCapacity = 0;
+	textsSize = 0;
+	threadCount = 0;
+	memset(threads, 0, sizeof(threads));
+
+	if ((this->descending = new bool[keyCount]) == NULL)
+		throw EOUTOFMEMORY;
+	if ((keys = new Key[rowCount * keyCount]) == NULL)
+		throw EOUTOFMEMORY;
+	if ((order = new int[rowCount]) == NULL)
+		throw EOUTOFMEMORY;
+	if ((buffer = new int[rowCount]) == NULL)
+		throw EOUTOFMEMORY;
+
+	int i;
+	for (i=0; i<keyCount; i++)
+		this->descending[i] = descending != NULL && descending[i];
+
+	// Extract the keys once, so sorting does not access the rows anymore
+	Key * key = keys;
+	for (int rowNo = 0; rowNo < rowCount; rowNo++)
+	{
+		order[rowNo] = rowNo;
+
+		Row * row = field->rows.Get(rowNo);
+		for (i=0; i<keyCount; i++)
+		{
+			Cell * cell = row->getCell(columnNos[i]);
+			addKey(key++, cell != NULL ? cell->getText() : String());
+		}
+	}
+}
+
+ListField::SortJob::~SortJob()
+{
+	ASSERTION_COBJECT(this);
+
+	for (int i=0; i<threadCount; i++)
+		if (threads[i] != NULL)
+		{
+			while (!threads[i]->isFinished())
+				Desktop::getInstance()->sleep(1);
+			delete threads[i];
+			threads[i] = NULL;
+		}
+
+	if (buffer != NULL) {delete[] buffer; buffer = NULL;}
+	if (descending != NULL) {delete[] descending; descending = NULL;}
+	if (keys != NULL) {delete[] keys; keys = NULL;}
+	if (order != NULL) {delete[] order; order = NULL;}
+	if (texts != NULL) {delete[] texts; texts = NULL;}
+}
+
+void ListField::SortJob::addKey(Key * key, const String & text)
+{
+	ASSERTION_COBJECT(this);
+
+	const char * characters = (const char *) text;
+	int length = text.GetLength();
+
+	if (textsSize + length + 1 > textsCapacity)
+	{
+		int newCapacity = textsCapacity > 0 ? textsCapacity * 2 : 4096;
+		while (newCapacity < textsSize + length + 1)
+			newCapacity *= 2;
+
+		char * newTexts;
+		if ((newTexts = new char[newCapacity]) == NULL)
+			throw EOUTOFMEMORY;
+		if (texts != NULL)
+		{
+			memcpy(newTexts, texts, textsSize);
+			delete[] texts;
+		}
+
+		texts = newTexts;
+		textsCapacity = newCapacity;
+	}
+
+	key->textOffset = textsSize;
+	for (int i=0; i<length; i++)
+		texts[textsSize++] = (char) tolower((unsigned char) characters[i]);
+	texts[textsSize++] = 0;
+
+	char * end;
+	key->number = strtod(characters, &end);
+	key->numeric = length > 0 && end == characters + length && key->number == key->number;
+}
+
+int ListField::SortJob::compare(int rowNo1, int rowNo2)
+{
+	ASSERTION_COBJECT(this);
+
+	const Key * key1 = keys + rowNo1 * keyCount;
+	const Key * key2 = keys + rowNo2 * keyCount;
+	for (int i=0; i<keyCount; i++, key1++, key2++)
+	{
+		int result;
+		if (key1->numeric && key2->numeric)
+			result = key1->number < key2->number ? -1 : key1->number > key2->number ? 1 : 0;
+		else if (key1->numeric != key2->numeric)
+			result = key1->numeric ? -1 : 1;
+		else
+			result = strcmp(texts + key1->textOffset, texts + key2->textOffset);
+
+		if (result != 0)
+			return descending[i] ? -result : result;
+	}
+
+	return 0;
+}
+
+void ListField::SortJob::execute()
+{
+	ASSERTION_COBJECT(this);
+	sort(0, rowCount);
+}
+
+bool ListField::SortJob::isFinished()
+{
+	ASSERTION_COBJECT(this);
+
+	for (int i=0; i<threadCount; i++)
+		if (threads[i] != NULL && !threads[i]->isFinished())
+			return false;
+
+	return true;
+}
+
+void ListField::SortJob::merge(const int * from, int * to, int start, int middle, int end)
+{
+	ASSERTION_COBJECT(this);
+
+	// Take the left row on equality, which makes the sort stable
+	int left = start;
+	int right = middle;
+	int target = start;
+	while (left < middle && right < end)
+		to[target++] = compare(from[right], from[left]) < 0 ? from[right++] : from[left++];
+	while (left < middle)
+		to[target++] = from[left++];
+	while (right < end)
+		to[target++] = from[right++];
+}
+
+void ListField::SortJob::sort(int start, int end)
+{
+	ASSERTION_COBJECT(this);
+
+	// Bottom-up merge sort, alternating between the order and the buffer
+	int * from = order;
+	int * to = buffer;
+	for (int width = 1; width < end - start; width *= 2)
+	{
+		for (int left = start; left < end; left += width * 2)
+		{
+			int middle = left + width < end ? left + width : end;
+			int right = left + width * 2 < end ? left + width * 2 : end;
+			merge(from, to, left, middle, right);
+		}
+
+		int * swapped = from;
+		from = to;
+		to = swapped;
+	}
+
+	if (from != order)
+		memcpy(order + start, from + start, (end - start) * sizeof(int));
+}
+
+void ListField::SortJob::start()
+{
+	ASSERTION_COBJECT(this);
+
+	threadCount = GL_LISTFIELD_SORTTHREADS;
+	int chunkSize = (rowCount + threadCount - 1) / threadCount;
+
+	int i;
+	for (i=0; i<threadCount; i++)
+	{
+		chunks[i].job = this;
+		chunks[i].start = i * chunkSize < rowCount ? i * chunkSize : rowCount;
+		chunks[i].end = (i + 1) * chunkSize < rowCount ? (i + 1) * chunkSize : rowCount;
+	}
+
+	for (i=0; i<threadCount; i++)
+	{
+		threads[i] = Desktop::getInstance()->createThread(&startInternal, false, &chunks[i]);
+		threads[i]->resume();
+	}
+}
+
+int ListField::SortJob::startInternal(Thread & thread, void * parameter)
+{
+	Chunk * chunk = (Chunk *) parameter;
+	SortJob * job = chunk->job;
+
+	job->sort(chunk->start, chunk->end);
+
+	Mutex * mutex = Desktop::getInstance()->getDeferralMutex();
+	if (!mutex->lock())
+		return 0;
+	job->finishedThreadCount++;
+	bool last = job->finishedThreadCount == job->threadCount;
+	bool canceled = job->canceled;
+	mutex->release();
+
+	if (!last)
+		return 0;
+
+	// The last worker thread merges the chunks into the order
+	if (!canceled)
+		for (int i=1; i<job->threadCount; i++)
+		{
+			job->merge(job->order, job->buffer, 0, job->chunks[i].start, job->chunks[i].end);
+			memcpy(job->order, job->buffer, job->chunks[i].end * sizeof(int));
+		}
+
+	// Let the list field apply the result, or destroy the job, if it has been canceled
+	if (!mutex->lock())
+		return 0;
+	job->deferred = true;
+	Desktop::getInstance()->deferObject(job->field);
+	mutex->release();
+
+	return 0;
 }
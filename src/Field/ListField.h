@@ -17,9 +17,9 @@
 	if ((variable = new ListField) == NULL) \
 		throw EOUTOFMEMORY; \
 	if (area != NULL) \
-		((FieldsArea *) area)->appendField(variable); \
+		((FieldsArea *) (void *) (area))->appendField(variable); \
 	if (groupField != NULL) \
-		((GroupField *) groupField)->appendField(variable); \
+		((GroupField *) (void *) (groupField))->appendField(variable); \
 	variable->setHorizontallyScrollable(horizontallyScrollable); \
 	variable->setVerticallyScrollable(verticallyScrollable); \
 	variable->setType(ListField::TYPE_##type);
@@ -153,7 +153,14 @@ namespace glaziery
 	 * like a table. The list field also has a heading, a row that displays
 	 * the name of each column.
 	 * The list field supports scrolling, which can be disabled by setting
-	 * the respective properties.
+	 * the respective properties.<br>
+	 *
+	 * For large lists, the list field may be virtual: Instead of holding a Row
+	 * for each entry, it asks a provider for the row count and the cell contents
+	 * on demand, and materializes only the rows that are actually used (e.g. the
+	 * visible ones), recycling a fixed number of transient rows. Selection and focus
+	 * then work by row number.
+	 * @see setProvider()
 	 */
 	class ListField : public InputField
 	{
@@ -163,8 +170,10 @@ namespace glaziery
 			class Column;
 			class EditEffect;
 			class Listener;
+			class Provider;
 			class Row;
 			class RowsField;
+			class SortJob;
 
 			enum Alignment
 			{
@@ -192,6 +201,7 @@ namespace glaziery
 			class Cell : public GlazieryObject
 			{
 				friend ArrayList<Cell>;
+				friend ListField;
 				friend Row;
 
 				private:
@@ -211,6 +221,12 @@ namespace glaziery
 					 */
 					Column * column;
 
+					/**
+					 * The width of the cell's elements as counted by the content widths
+					 * of its column, or -1, if the cell is not counted.
+					 */
+					int contentWidth;
+
 					/**
 					 * Sets the column this cell belongs to.
 					 * An exception is thrown, if the property has already been set.
@@ -328,6 +344,7 @@ namespace glaziery
 			class Column : public GlazieryObject
 			{
 				friend ArrayList<Column>;
+				friend Cell;
 				friend ListField;
 
 				private:
@@ -350,6 +367,23 @@ namespace glaziery
 					 */
 					bool autoResizing;
 
+					/**
+					 * The largest width of the elements of this column's cells in pixels,
+					 * if the column fits its content.
+					 */
+					int contentWidth;
+
+					/**
+					 * The histogram of the widths of the elements of this column's cells,
+					 * if the column fits its content. For each width in pixels, the number of cells.
+					 */
+					int * contentWidthCounts;
+
+					/**
+					 * The number of widths the content width histogram has room for.
+					 */
+					int contentWidthCountsSize;
+
 					/**
 					 * Whether the cells of this column can be edited.
 					 */
@@ -360,6 +394,11 @@ namespace glaziery
 					 */
 					ListField * field;
 
+					/**
+					 * Whether the width of this column follows the widest cell.
+					 */
+					bool fittingContent;
+
 					/**
 					 * The heading text describing this column.
 					 * It is displayed above all rows in the heading row.
@@ -391,6 +430,24 @@ namespace glaziery
 					 */
 					~Column();
 
+					/**
+					 * Counts the width of a cell's elements in the content width histogram.
+					 * @param width The width in pixels.
+					 */
+					void addContentWidth(int width);
+
+					/**
+					 * Clears the content width histogram.
+					 */
+					void clearContentWidths();
+
+					/**
+					 * Uncounts the width of a cell's elements from the content width histogram.
+					 * If it was the largest one, the next smaller width counted becomes the largest.
+					 * @param width The width in pixels, as counted before.
+					 */
+					void removeContentWidth(int width);
+
 					/**
 					 * Sets the field property of the column to a given value.
 					 * An exception is thrown, if the column field is not NULL.
@@ -419,6 +476,13 @@ namespace glaziery
 					 */
 					Alignment getAlignment();
 
+					/**
+					 * Returns the largest width of the elements of this column's cells in pixels,
+					 * excluding the padding, if the column fits its content, otherwise returns 0.
+					 * @return The content width of this column.
+					 */
+					int getContentWidth();
+
 					/**
 					 * Returns the list field this column belongs to.
 					 * @return The list field this column belongs to.
@@ -470,6 +534,13 @@ namespace glaziery
 					 */
 					bool isEditable();
 
+					/**
+					 * Returns whether the width of this column follows the widest cell.
+					 * Defaults to false.
+					 * @return Whether this column fits its content.
+					 */
+					bool isFittingContent();
+
 					/**
 					 * Returns whether this column is currently visible. Defaults to true.
 					 * @return Whether this column is currently visible.
@@ -503,6 +574,19 @@ namespace glaziery
 					 */
 					void setEditable(bool editable);
 
+					/**
+					 * Sets whether the width of this column follows the widest cell.
+					 * The column is then as wide as its widest cell or its heading, including
+					 * the padding, and within the minimum and maximum width. The widths of the cells
+					 * are counted in a histogram, which is updated when a row is inserted, removed,
+					 * or changed, so the width follows the content without measuring all rows.
+					 * Rows hidden by a filter are counted as well. Virtual list fields
+					 * (having a row provider) are not measured, the width is then kept.
+					 * Defaults to false. A column that fits its content does not auto-resize.
+					 * @param fittingContent Whether this column fits its content.
+					 */
+					void setFittingContent(bool fittingContent);
+
 					/**
 					 * Sets the heading text describing this column.
 					 * It is displayed above all rows in the heading row.
@@ -662,6 +746,14 @@ namespace glaziery
 					 */
 					virtual void onColumnResized(ListField * field, int columnNo, int oldWidth);
 
+					/**
+					 * Called when the filter of a list field has just changed, showing and hiding rows.
+					 * The row numbers of the list field have changed then.
+					 * @param field The list field that changed.
+					 * @see setFilter()
+					 */
+					virtual void onFilterChanged(ListField * field);
+
 					/**
 					 * Called when the pointer is hovered over the headline of the list field for a while.
 					 * @param field The list field that received the event.
@@ -676,6 +768,16 @@ namespace glaziery
 					 */
 					virtual void onRowAdded(ListField * field, int rowNo);
 
+					/**
+					 * Called when one or more consecutive rows of a list field have just been added,
+					 * e.g. by insertRows() or within an update (see beginUpdate()).
+					 * The default implementation calls onRowAdded() for each row.
+					 * @param field The list field that received the event.
+					 * @param rowNo The number of the first row that has been added.
+					 * @param rowCount The number of rows that have been added.
+					 */
+					virtual void onRowsAdded(ListField * field, int rowNo, int rowCount);
+
 					/**
 					 * Called when one or more rows have been removed.
 					 * @param field The list field that received the event.
@@ -702,6 +804,95 @@ namespace glaziery
 					virtual void onSelectionChanged(ListField * field);
 			};
 
+			/**
+			 * The provider supplies the rows of a virtual list field on demand.
+			 * Each cell of a virtual list field consists of an optional image and a text.
+			 * Override the methods to supply your data, the default implementation
+			 * provides no rows. When the data changes, call the list field's
+			 * onProviderRowsInserted(), onProviderRowsRemoved(), or onProviderRowsChanged().
+			 * @warning Providers are auto-deleting when no list field uses them anymore.
+			 * So you should not hold any references to them.
+			 * @see ListField::setProvider()
+			 */
+			class Provider : public SharedObject
+			{
+				protected:
+
+					/**
+					 * Destroys the provider.
+					 * Since providers are managed automatically,
+					 * you do not need to destroy them by yourself.
+					 */
+					virtual ~Provider();
+
+				public:
+
+					/**
+					 * Returns the image of a cell. Defaults to NULL.
+					 * @param field The list field that requests the image.
+					 * @param rowNo The 0-indexed number of the row.
+					 * @param columnNo The 0-indexed number of the column.
+					 * @return The image, or NULL, if the cell has no image.
+					 */
+					virtual Image * getCellImage(ListField * field, int rowNo, int columnNo);
+
+					/**
+					 * Returns the text of a cell. Defaults to an empty text.
+					 * @param field The list field that requests the text.
+					 * @param rowNo The 0-indexed number of the row.
+					 * @param columnNo The 0-indexed number of the column.
+					 * @return The text.
+					 */
+					virtual String getCellText(ListField * field, int rowNo, int columnNo);
+
+					/**
+					 * Returns the number of rows. Defaults to 0.
+					 * @param field The list field that requests the row count.
+					 * @return The number of rows.
+					 */
+					virtual int getRowCount(ListField * field);
+
+					/**
+					 * Returns the identity of a row, i.e. the application (or game) defined data
+					 * that is set as model of the materialized row. Defaults to NULL.
+					 * @param field The list field that requests the model.
+					 * @param rowNo The 0-indexed number of the row.
+					 * @return The row's model.
+					 * @see GlazieryObject::getModel()
+					 * @see ListField::getRowNoByModel()
+					 */
+					virtual void * getRowModel(ListField * field, int rowNo);
+
+					/**
+					 * Returns the 0-indexed number of a row with a given model.
+					 * Defaults to calling getRowModel() for each row, which takes linear time.
+					 * Override it to look up the model in an index of your data instead.
+					 * @param field The list field that requests the row number.
+					 * @param model The row's model to be searched.
+					 * @return The 0-indexed row number or -1, if the model cannot be found.
+					 * @see ListField::getRowNoByModel()
+					 */
+					virtual int getRowNoByModel(ListField * field, void * model);
+
+					/**
+					 * Returns whether a row is active, i.e. it may be selected. Defaults to true.
+					 * @param field The list field that requests the state.
+					 * @param rowNo The 0-indexed number of the row.
+					 * @return Whether the row is active.
+					 */
+					virtual bool isRowActive(ListField * field, int rowNo);
+
+					/**
+					 * Called when the user has edited the text of a cell.
+					 * By default, the new text is ignored.
+					 * @param field The list field that has been edited.
+					 * @param rowNo The 0-indexed number of the row.
+					 * @param columnNo The 0-indexed number of the column.
+					 * @param text The new text.
+					 */
+					virtual void setCellText(ListField * field, int rowNo, int columnNo, const String & text);
+			};
+
 			class Row : public GlazieryObject
 			{
 				friend ArrayList<Row>;
@@ -728,6 +919,53 @@ namespace glaziery
 					 */
 					ListField * field;
 
+					/**
+					 * While the list field has a filter index,
+					 * the number of the row within the index.
+					 */
+					int filterIndexRowNo;
+
+					/**
+					 * Whether the row has been inserted while filtering
+					 * and has not been tested against the filter yet.
+					 */
+					bool filterPending;
+
+					/**
+					 * While filtering, the position of the row within
+					 * the unfiltered rows of its list field.
+					 */
+					RowPositions::Entry filterPosition;
+
+					/**
+					 * Whether the filter of the list field hides the row.
+					 * Hidden rows are not part of the list field's rows, but kept for the filter.
+					 */
+					bool hidden;
+
+					/**
+					 * The next row in the same model index bucket of the list field, or NULL.
+					 */
+					Row * nextModelRow;
+
+					/**
+					 * The position of the row within its list field,
+					 * not positioned while the filter hides the row.
+					 */
+					RowPositions::Entry position;
+
+					/**
+					 * The previous row in the same model index bucket of the list field, or NULL.
+					 */
+					Row * previousModelRow;
+
+					/**
+					 * For transient rows of virtual list fields, the 0-indexed number
+					 * of the row currently materialized, or -1, if the row is not in use.
+					 * Always -1 for regular rows.
+					 */
+					int transientRowNo;
+
 					/**
 					 * Destroys the row.
 					 */
@@ -847,6 +1085,17 @@ namespace glaziery
 					 */
 					void setActive(bool active);
 
+					/**
+					 * Sets the application (or game) defined data, keeping the
+					 * model index of the list field up to date.
+					 * @param model The application (or game) defined data.
+					 * @param modelDestructor An optional static method that is called, whenever the
+					 * row is destroyed or when a new model is set.
+					 * @see GlazieryObject::setModel()
+					 * @see ListField::getRowNoByModel()
+					 */
+					void setModel(void * model, void (*modelDestructor)(void * model) = NULL);
+
 					/**
 					 * Removes this row from the set of selected rows.
 					 */
@@ -1244,6 +1493,230 @@ namespace glaziery
 					virtual void updateContentSize();
 			};
 
+			/**
+			 * A sort job sorts the rows of a list field by the texts of one or more columns.
+			 * The sort keys are extracted once from the cells, lower-cased and with numbers
+			 * parsed, and are stored contiguously, so the sort compares them without accessing
+			 * the rows. The job sorts an array of row numbers, stable, using a merge sort.
+			 * Large jobs are split into chunks, sorted by worker threads and merged by the last one.
+			 * The result is applied by the list field in the main thread.
+			 * @see ListField::sortRows()
+			 */
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				class SortJob : public CObject
+			#else
+				class SortJob
+			#endif
+			{
+				friend ArrayList<SortJob>;
+				friend ListField;
+
+				protected:
+
+					/**
+					 * A range of the row numbers sorted by one worker thread.
+					 */
+					class Chunk
+					{
+						public:
+
+							/**
+							 * The index of the first row number after the chunk.
+							 */
+							int end;
+
+							/**
+							 * The sort job the chunk belongs to.
+							 */
+							SortJob * job;
+
+							/**
+							 * The index of the first row number of the chunk.
+							 */
+							int start;
+					};
+
+					/**
+					 * The sort key of a cell.
+					 */
+					class Key
+					{
+						public:
+
+							/**
+							 * The number parsed from the text, if the text is numeric.
+							 */
+							double number;
+
+							/**
+							 * Whether the text is a number. Numbers are compared numerically,
+							 * and they are sorted before texts.
+							 */
+							bool numeric;
+
+							/**
+							 * The offset of the lower-cased, null-terminated text in the texts buffer.
+							 */
+							int textOffset;
+					};
+
+					/**
+					 * A buffer of the same size as the order, used for merging.
+					 */
+					int * buffer;
+
+					/**
+					 * Whether the job has been canceled, e.g. because the rows have been changed
+					 * meanwhile. Guarded by the deferral mutex of the desktop.
+					 */
+					bool canceled;
+
+					/**
+					 * The chunks sorted by the worker threads, one per thread.
+					 */
+					Chunk chunks[GL_LISTFIELD_SORTTHREADS];
+
+					/**
+					 * Whether the list field has been deferred to apply the result.
+					 * Guarded by the deferral mutex of the desktop.
+					 */
+					bool deferred;
+
+					/**
+					 * For each key, whether it is sorted in descending order.
+					 */
+					bool * descending;
+
+					/**
+					 * The list field whose rows are sorted.
+					 */
+					ListField * field;
+
+					/**
+					 * The number of worker threads that have sorted their chunks.
+					 * Guarded by the deferral mutex of the desktop.
+					 */
+					int finishedThreadCount;
+
+					/**
+					 * The number of keys per row.
+					 */
+					int keyCount;
+
+					/**
+					 * The keys of all rows, keyCount keys per row, in the order of the rows.
+					 */
+					Key * keys;
+
+					/**
+					 * The row numbers, sorted when the job is finished.
+					 */
+					int * order;
+
+					/**
+					 * The number of rows sorted.
+					 */
+					int rowCount;
+
+					/**
+					 * The lower-cased texts of the keys, each null-terminated.
+					 */
+					char * texts;
+
+					/**
+					 * The size of the texts buffer in bytes.
+					 */
+					int textsCapacity;
+
+					/**
+					 * The number of bytes of the texts buffer used.
+					 */
+					int textsSize;
+
+					/**
+					 * The number of worker threads, 0 for jobs executed in the main thread.
+					 */
+					int threadCount;
+
+					/**
+					 * The worker threads.
+					 */
+					Thread * threads[GL_LISTFIELD_SORTTHREADS];
+
+					/**
+					 * Creates a new sort job, extracting the keys of the rows of a list field.
+					 * @param field The list field.
+					 * @param columnNos The 0-indexed numbers of the columns to sort by, most significant first.
+					 * @param descending For each column, whether it is sorted in descending order.
+					 * May be NULL to sort all columns in ascending order.
+					 * @param keyCount The number of columns to sort by.
+					 */
+					SortJob(ListField * field, const int * columnNos, const bool * descending, int keyCount);
+
+					/**
+					 * Destroys the sort job, waiting for its worker threads to finish.
+					 */
+					~SortJob();
+
+					/**
+					 * Adds the sort key of a cell text.
+					 * @param key The key to be set.
+					 * @param text The text of the cell.
+					 */
+					void addKey(Key * key, const String & text);
+
+					/**
+					 * Compares two rows by their keys.
+					 * @param rowNo1 The number of the first row.
+					 * @param rowNo2 The number of the second row.
+					 * @return A negative value, if the first row is sorted before the second,
+					 * 0, if the rows are equal, or a positive value otherwise.
+					 */
+					int compare(int rowNo1, int rowNo2);
+
+					/**
+					 * Executes the job in the main thread.
+					 */
+					void execute();
+
+					/**
+					 * Returns whether all worker threads of the job have finished.
+					 * @return Whether the worker threads have finished.
+					 */
+					bool isFinished();
+
+					/**
+					 * Merges two adjacent sorted ranges of row numbers.
+					 * @param from The row numbers to be merged.
+					 * @param to The array to receive the merged row numbers at the same indexes.
+					 * @param start The index of the first row number of the first range.
+					 * @param middle The index of the first row number of the second range.
+					 * @param end The index of the first row number after the second range.
+					 */
+					void merge(const int * from, int * to, int start, int middle, int end);
+
+					/**
+					 * Sorts a range of the row numbers.
+					 * @param start The index of the first row number of the range.
+					 * @param end The index of the first row number after the range.
+					 */
+					void sort(int start, int end);
+
+					/**
+					 * Starts the worker threads of the job. When the last one has finished,
+					 * the list field is deferred to apply the result.
+					 */
+					void start();
+
+					/**
+					 * The main function of a worker thread.
+					 * @param thread The worker thread.
+					 * @param parameter The chunk to be sorted.
+					 * @return The exit code, always 0.
+					 */
+					static int startInternal(Thread & thread, void * parameter);
+			};
+
 			enum Type
 			{
 				/**
@@ -1267,6 +1740,11 @@ namespace glaziery
 
 		private:
 
+			/**
+			 * The sort jobs canceled whose worker threads may still be running.
+			 */
+			ArrayList<SortJob> canceledSortJobs;
+
 			/**
 			 * Whether the user can resize the columns, e.g. dragging the heading column border.
 			 * The actual UI is defined by the skin. Defaults to false.
@@ -1286,6 +1764,57 @@ namespace glaziery
 			 */
 			ArrayList<Column> columns;
 
+			/**
+			 * The number of columns the filter searches, 0 for all columns.
+			 */
+			int filterColumnCount;
+
+			/**
+			 * The 0-indexed numbers of the columns the filter searches, NULL for all columns.
+			 */
+			int * filterColumnNos;
+
+			/**
+			 * The index of the texts of all rows while filtering, or NULL,
+			 * if it has not been built yet or the columns have changed since.
+			 * Inserted, removed, and changed rows update it row by row.
+			 */
+			RowTextIndex * filterIndex;
+
+			/**
+			 * The rows inserted while filtering that have not been tested against
+			 * the filter yet, since their cells are added after inserting them.
+			 * The rows are owned by the rows, not by this list.
+			 */
+			ArrayList<Row> filterPendingRows;
+
+			/**
+			 * While filtering, the positions of the rows within the unfiltered rows.
+			 */
+			RowPositions filterRowPositions;
+
+			/**
+			 * While filtering, all rows in their unfiltered order, including the hidden ones.
+			 * Empty if the list field is not filtered.
+			 */
+			ArrayList<Row> filterRows;
+
+			/**
+			 * The text the rows are filtered by, empty if the list field is not filtered.
+			 */
+			String filterText;
+
+			/**
+			 * The buffer getFilterText() returns the text of a row in,
+			 * reused for all rows, or NULL, if no text has been requested yet.
+			 */
+			char * filterTextBuffer;
+
+			/**
+			 * The size of the filter text buffer in bytes.
+			 */
+			int filterTextBufferSize;
+
 			/**
 			 * The 0-indexed column number that has the focus (the cursor is own).
 			 */
@@ -1307,11 +1836,50 @@ namespace glaziery
 			 */
 			bool horizontallyScrollable;
 
+			/**
+			 * Whether transient rows are currently being materialized,
+			 * so the changes of their elements must not be handled.
+			 */
+			bool materializing;
+
+			/**
+			 * The number of buckets of the model index, a power of two, or 0.
+			 */
+			int modelBucketCount;
+
+			/**
+			 * The model index of regular list fields: The buckets of rows by their model
+			 * (rows without a model are not indexed), chained using the rows' nextModelRow
+			 * and previousModelRow. NULL, if no row has been indexed yet.
+			 */
+			Row ** modelBuckets;
+
+			/**
+			 * The number of rows in the model index.
+			 */
+			int modelRowCount;
+
+			/**
+			 * The provider of a virtual list field, or NULL for regular list fields.
+			 */
+			Provider * provider;
+
+			/**
+			 * For virtual list fields, the number of rows of the provider.
+			 */
+			int providerRowCount;
+
 			/**
 			 * The 0-indexed row number where the range selection starts.
 			 */
 			int rangeStartRowNo;
 
+			/**
+			 * The positions of the rows, updated with each insertion and removal,
+			 * so the row numbers are known without searching or renumbering the rows.
+			 */
+			RowPositions rowPositions;
+
 			/**
 			 * Whether the user may remove rows (e.g. by pressing the delete key).
 			 * Defaults to true.
@@ -1330,15 +1898,65 @@ namespace glaziery
 			RowsField rowsField;
 
 			/**
-			 * The currently selected rows of this list field.
+			 * The selected rows of regular list fields as a set, derived from the selection
+			 * when requested by getSelectedRows(). Always empty for virtual list fields.
 			 */
 			HashSet selectedRows;
 
+			/**
+			 * The version of the selection the selectedRows set has been derived from,
+			 * -1 if it has not been derived yet.
+			 */
+			int selectedRowsVersion;
+
+			/**
+			 * The numbers of the selected rows, as ranges of rows or a bitset.
+			 */
+			RowSelection selection;
+
+			/**
+			 * For virtual list fields, the recycled transient rows, indexed by the
+			 * row number modulo GL_LISTFIELD_TRANSIENTROWS. NULL, if not created yet.
+			 */
+			Row * transientRows[GL_LISTFIELD_TRANSIENTROWS];
+
+			/**
+			 * The running background sort job, or NULL.
+			 */
+			SortJob * sortJob;
+
 			/**
 			 * The selection type (e.g. whether to select multiple rows). Defaults to TYPE_MANY.
 			 */
 			Type type;
 
+			/**
+			 * Within an update, the number of consecutive rows added but not notified yet.
+			 * @see beginUpdate()
+			 */
+			int updateAddedRowCount;
+
+			/**
+			 * Within an update, the number of the first row added but not notified yet.
+			 * @see beginUpdate()
+			 */
+			int updateAddedRowNo;
+
+			/**
+			 * The nesting depth of beginUpdate() calls, 0 if not updating.
+			 */
+			int updateDepth;
+
+			/**
+			 * Whether rows have been removed within the current update.
+			 */
+			bool updateRowsRemoved;
+
+			/**
+			 * Whether the selection has changed within the current update.
+			 */
+			bool updateSelectionChanged;
+
 			/**
 			 * Whether the list field can be scrolled vertically. Defaults to true.
 			 * If not, the content is resized together with the list field.
@@ -1358,12 +1976,113 @@ namespace glaziery
 			 */
 			void adjustAutoColumns();
 
+			/**
+			 * Tests the rows inserted while filtering against the filter,
+			 * hiding the ones that do not match. Called when the update ends
+			 * or, outside updates, when the list field's deferrals are executed.
+			 */
+			void applyFilterToPendingRows();
+
+			/**
+			 * Applies the result of a finished sort job to the rows,
+			 * preserving the focus, the range start, and the selection.
+			 * @param job The sort job.
+			 */
+			void applySortJob(SortJob * job);
+
+			/**
+			 * Cancels the running background sort job, if any. Its worker threads
+			 * continue in the background, the job is destroyed when they have finished.
+			 * Called before changing the rows.
+			 */
+			void cancelSortJob();
+
+			/**
+			 * Destroys rows and compacts the rows and the unfiltered rows once,
+			 * so removing many rows takes linear time. The rows are removed
+			 * from the model index, but not from the selection.
+			 * @param rowNos The ascending numbers of the rows to be destroyed.
+			 * @param rowCount The number of rows to be destroyed.
+			 */
+			void deleteRows(const int * rowNos, int rowCount);
+
+			/**
+			 * Destroys the filter index, if any, e.g. because rows have changed.
+			 * It is built again when the filter changes next.
+			 */
+			void destroyFilterIndex();
+
+			/**
+			 * Destroys the transient rows of a virtual list field,
+			 * e.g. because the columns have changed.
+			 */
+			void destroyTransientRows();
+
+			/**
+			 * Destroys the canceled sort jobs whose worker threads have finished.
+			 */
+			void destroyFinishedSortJobs();
+
+			/**
+			 * Ensures that the filter text buffer has room for a given number of bytes,
+			 * keeping its contents.
+			 * @param size The number of bytes.
+			 */
+			void ensureFilterTextBufferSize(int size);
+
+			/**
+			 * Executes all deferred operations in this event target.
+			 * Applies the result of a finished background sort job.
+			 * @see Desktop::executeDeferrals()
+			 */
+			virtual void executeDeferrals();
+
 			/**
 			 * Performs final operations when removing rows.
 			 * @param selectionChanged Whether the selection changed.
 			 */
 			void finishRowRemoval(bool selectionChanged);
 
+			/**
+			 * Sets the width of a column fitting its content to its widest cell
+			 * or heading, using the content widths counted. Does not measure any row.
+			 * @param column The column.
+			 */
+			void fitColumn(Column * column);
+
+			/**
+			 * Sets the width of all columns fitting their content to their widest cell
+			 * or heading, using the content widths counted. Does not measure any row.
+			 */
+			void fitColumns();
+
+			/**
+			 * Notifies the listeners about the rows added within the current update
+			 * but not notified yet, if any.
+			 */
+			void flushAddedRows();
+
+			/**
+			 * Returns the filter index, building it from all rows, if required.
+			 * @return The filter index.
+			 */
+			RowTextIndex * getFilterIndex();
+
+			/**
+			 * Returns the position of a row within the unfiltered rows while filtering.
+			 * @param row The row, which must be contained in the unfiltered rows.
+			 * @return The 0-indexed position.
+			 */
+			int getFilterRowNo(Row * row);
+
+			/**
+			 * Returns the lower case text of a row the filter searches,
+			 * i.e. the texts of the filter columns' cells, separated by line feeds.
+			 * @param row The row.
+			 * @return The text, in the filter text buffer. It is valid until the next call.
+			 */
+			const char * getFilterText(Row * row);
+
 			/**
 			 * Fills a column and row variable with the indexes of the element at a given position.
 			 * If the position is out of range, both variables are filled with -1.
@@ -1376,6 +2095,88 @@ namespace glaziery
 			void getColumnAndRowForPosition(Vector position,
 				int & columnNo, int & columnPos, int & rowNo);
 
+			/**
+			 * Returns the model index bucket of a model.
+			 * @param model The model, which must not be NULL.
+			 * @return The 0-indexed bucket.
+			 */
+			int getModelBucket(void * model);
+
+			/**
+			 * Adds a row to the model index, if it has a model.
+			 * @param row The row.
+			 */
+			void indexRowModel(Row * row);
+
+			/**
+			 * Invalidates the rows that lost and gained the focus.
+			 * @param oldFocusRowNo The 0-indexed number of the row that had the focus.
+			 */
+			void invalidateFocusChange(int oldFocusRowNo);
+
+			/**
+			 * Invalidates the area of a row, if it is contained in this list field.
+			 * Since its content may have changed, the row is measured again.
+			 * @param row The row.
+			 */
+			void invalidateRow(Row * row);
+
+			/**
+			 * Invalidates a range of rows. Rows scrolled out of view are not invalidated.
+			 * @param fromRowNo The 0-indexed number of the first row to be invalidated.
+			 * @param toRowNo The 0-indexed number of the last row to be invalidated.
+			 */
+			void invalidateRows(int fromRowNo, int toRowNo);
+
+			/**
+			 * Invalidates the visible rows whose selection state changes when solely
+			 * selecting a range of rows. Call this method before changing the selection.
+			 * @param fromRowNo The 0-indexed number of the first row to be selected.
+			 * @param toRowNo The 0-indexed number of the last row to be selected,
+			 * or fromRowNo - 1 if no row is to be selected.
+			 */
+			void invalidateSelectionChange(int fromRowNo, int toRowNo);
+
+			/**
+			 * Returns the transient row of a virtual list field for a given row number,
+			 * filling a recycled one from the provider, if it is not materialized yet.
+			 * @param rowNo The 0-indexed row number, which must be in range.
+			 * @return The transient row.
+			 */
+			Row * materializeRow(int rowNo);
+
+			/**
+			 * Returns whether the text of a row contains a given query.
+			 * @param row The row.
+			 * @param query The lower case query.
+			 * @return Whether the row matches.
+			 */
+			bool matchesFilter(Row * row, const char * query);
+
+			/**
+			 * Counts the width of a cell's elements in the content widths of its column,
+			 * if the column fits its content, replacing the width counted before, if any.
+			 * Virtual list fields do not count any cells.
+			 * @param cell The cell.
+			 */
+			void measureCell(Cell * cell);
+
+			/**
+			 * Counts the cells of all rows, including the ones hidden by the filter,
+			 * in the content widths of a column, or uncounts them, if the column
+			 * does not fit its content anymore. Then fits the columns.
+			 * @param column The column.
+			 */
+			void measureColumn(Column * column);
+
+			/**
+			 * Counts the cells of a row in the content widths of their columns,
+			 * replacing the widths counted before. Then fits the columns,
+			 * unless the list field is being updated.
+			 * @param row The row.
+			 */
+			void measureRow(Row * row);
+
 			/**
 			 * Notifies all listeners about that a column has just been added.
 			 * @param columnNo The number of the column that has been added.
@@ -1394,10 +2195,21 @@ namespace glaziery
 			void notifyColumnRemoving(int columnNo);
 
 			/**
-			 * Notifies all listeners about that a row has just been added.
-			 * @param rowNo The number of the row that has been added.
+			 * Notifies all listeners about that the filter has just changed.
+			 */
+			void notifyFilterChanged();
+
+			/**
+			 * Notifies all listeners about that consecutive rows have just been added.
+			 * @param rowNo The number of the first row that has been added.
+			 * @param rowCount The number of rows that have been added.
+			 */
+			void notifyRowsAdded(int rowNo, int rowCount);
+
+			/**
+			 * Notifies all listeners about that rows have just been removed.
 			 */
-			void notifyRowAdded(int rowNo);
+			void notifyRowsRemoved();
 
 			/**
 			 * Notifies all listeners about rows about to be removed.
@@ -1471,6 +2283,28 @@ namespace glaziery
 			 */
 			virtual void onMinimumSizeChanged(Vector oldMinimumSize);
 
+			/**
+			 * Marks all transient rows of a virtual list field as not in use,
+			 * so they are filled from the provider again when used next.
+			 */
+			void recycleTransientRows();
+
+			/**
+			 * Positions all unfiltered rows again, after they have been reordered at once.
+			 */
+			void repositionFilterRows();
+
+			/**
+			 * Positions all rows again, after they have been reordered at once.
+			 */
+			void repositionRows();
+
+			/**
+			 * Rehashes the model index into a given number of buckets.
+			 * @param bucketCount The new number of buckets, a power of two.
+			 */
+			void resizeModelIndex(int bucketCount);
+
 			/**
 			 * Resizes the component and handles listeners.
 			 * This method is called internally by the resize overload,
@@ -1487,6 +2321,48 @@ namespace glaziery
 			 */
 			virtual bool resizeInternal(Vector size, bool notifyParent);
 
+			/**
+			 * Adds a row to the selection, without notifying or invalidating.
+			 * @param rowNo The 0-indexed row number.
+			 */
+			void selectRowInternal(int rowNo);
+
+			/**
+			 * Rebuilds the rows from the unfiltered ones that are not hidden,
+			 * keeping the focus, the range start and the selection of the rows still visible.
+			 */
+			void showFilteredRows();
+
+			/**
+			 * Reorders the visible rows within the unfiltered rows the same way as the rows,
+			 * after moving or sorting them while filtering. The hidden rows keep their places.
+			 */
+			void syncFilterRows();
+
+			/**
+			 * Removes a row from the model index, if it has a model.
+			 * @param row The row.
+			 */
+			void unindexRowModel(Row * row);
+
+			/**
+			 * Removes a row about to be removed from the list field from the unfiltered rows,
+			 * if the list field is filtered.
+			 * @param row The row.
+			 */
+			void unlinkFilterRow(Row * row);
+
+			/**
+			 * Removes a row from the selection, without notifying or invalidating.
+			 * @param rowNo The 0-indexed row number.
+			 */
+			void unselectRowInternal(int rowNo);
+
+			/**
+			 * Clears the selection, without notifying or invalidating.
+			 */
+			void unselectRowsInternal();
+
 			/**
 			 * Updates the selected rows and range selection start after the
 			 * focus row having moved.
@@ -1582,6 +2458,17 @@ namespace glaziery
 			 */
 			void appendRow(Row * row);
 
+			/**
+			 * Begins an update of the list field. Until the matching endUpdate(),
+			 * row insertions and removals and cell changes neither update the content size
+			 * nor invalidate the list field, and the listeners are notified about added rows,
+			 * removed rows, and selection changes once, when the update ends.
+			 * Only onRowsRemoving() is still called per removal, to allow vetoing.
+			 * Updates may be nested, only the outermost one is effective.
+			 * @see endUpdate()
+			 */
+			void beginUpdate();
+
 			/**
 			 * Draws the component to the display surface.
 			 * This is usually achieved by delegating to the current skin.
@@ -1600,6 +2487,14 @@ namespace glaziery
 			 */
 			void ensureCellVisible(int rowNo, int columnNo, bool now = false);
 
+			/**
+			 * Ends an update begun by beginUpdate(). Ending the outermost update notifies
+			 * the listeners about the pending changes, updates the content size,
+			 * and invalidates the list field.
+			 * @see beginUpdate()
+			 */
+			void endUpdate();
+
 			/**
 			 * Ensures that the focus is entirely visible by setting the scroll position.
 			 * If the focus cannot be shown entirely, then the top-left corner is ensured to be shown.
@@ -1663,6 +2558,13 @@ namespace glaziery
 			 */
 			virtual EventTarget * getEventTargetAt(Vector position);
 
+			/**
+			 * Returns the text the rows are filtered by.
+			 * @return The filter text, empty if the list field is not filtered.
+			 * @see setFilter()
+			 */
+			const String & getFilter();
+
 			/**
 			 * Returns the child component that has focus within this parent.
 			 * @return The child component that has focus within this parent
@@ -1709,10 +2611,27 @@ namespace glaziery
 			 */
 			void getHeadlineColumnForPosition(Vector position, int & columnNo);
 
+			/**
+			 * Returns the number of the next selected row after a given row.
+			 * Use this method to iterate over the selection of virtual list fields.
+			 * @param rowNo The 0-indexed number of the row to start after,
+			 * or -1 to start at the beginning.
+			 * @return The 0-indexed number of the next selected row, or -1, if there is none.
+			 */
+			int getNextSelectedRowNo(int rowNo);
+
+			/**
+			 * Returns the provider of a virtual list field.
+			 * @return The provider, or NULL for regular list fields.
+			 */
+			Provider * getProvider();
+
 			/**
 			 * Returns a row at a given position.
 			 * @param rowNo The 0-indexed row number.
 			 * @return The row or NULL, if the row number is out of range.
+			 * @note For virtual list fields, the row is transient. It is recycled when
+			 * other rows are materialized, so do not keep it.
 			 */
 			Row * getRow(int rowNo);
 
@@ -1723,27 +2642,44 @@ namespace glaziery
 			int getRowCount();
 
 			/**
-			 * Returns the 0-indexed number of a given row by linearily searching through the rows.
+			 * Returns the 0-indexed number of a given row in constant time.
+			 * The row positions are kept in blocks that are updated with each
+			 * insertion and removal, so no rows are renumbered when looking them up.
 			 * @param row The row to be searched.
 			 * @return The 0-indexed row number or -1, if the row cannot be found.
-			 * @warn The method searched linearily through the rows. Avoid on large lists.
 			 */
 			int getRowNo(Row * row);
 
 			/**
-			 * Returns the 0-indexed number of a row with a given model by linearily searching through the rows.
+			 * Returns the 0-indexed number of a row with a given model. If several rows
+			 * have the model, the first one is returned. Regular list fields look up
+			 * the model using a hash index, which requires the models to be set using
+			 * Row::setModel(), not GlazieryObject::setModel().
 			 * @param model The row's model to be searched.
 			 * @return The 0-indexed row number or -1, if the model cannot be found.
-			 * @warn The method searched linearily through the rows. Avoid on large lists.
+			 * Virtual list fields ask the provider, see Provider::getRowNoByModel().
+			 * @warn For NULL models and for virtual list fields whose provider does
+			 * not override Provider::getRowNoByModel(), the method searches
+			 * linearily through the rows. Avoid on large lists.
 			 */
 			int getRowNoByModel(void * model);
 
 			/**
 			 * Returns the rows of this list field.
 			 * @return The rows of this list field.
+			 * @note Virtual list fields do not hold their rows, the list is always empty.
+			 * Use getRowCount() and getRow() instead.
+			 * @note While filtering, the list contains the visible rows only.
 			 */
 			const ArrayList<Row> & getRows();
 
+			/**
+			 * Returns the number of rows including the ones hidden by the filter.
+			 * @return The number of rows including the hidden ones.
+			 * @see setFilter()
+			 */
+			int getUnfilteredRowCount();
+
 			/**
 			 * Returns the scrolling field that displays the rows of
 			 * the list field. It is a child of the list field.
@@ -1766,22 +2702,31 @@ namespace glaziery
 			 */
 			Row * getSelectedRow();
 
+			/**
+			 * Returns the number of currently selected rows.
+			 * @return The number of selected rows.
+			 */
+			int getSelectedRowCount();
+
 			/**
 			 * Returns the currently selected rows of this list field in no particular order.
-			 * @note This method is fast, as it returns the internal set of selected rows.
+			 * @note The set is derived from the selected row ranges when the selection has changed
+			 * since the last call, which costs one hash insertion per selected row.
+			 * Prefer getNextSelectedRowNo() to iterate large selections.
 			 * Use getSelectedRowsInOrder() to get the rows in the list field's order.
 			 * @return The currently selected rows of this list field.
+			 * @note Not supported by virtual list fields, use getNextSelectedRowNo() instead.
 			 */
 			const HashSet & getSelectedRows();
 
 			/**
 			 * Returns the currently selected rows of this list field ordered by the list field rows' order.
-			 * @note This method is slow, as it iterates over the list field rows.
-			 * Use getSelectedRows() on large lists, where no order is necessary.
+			 * @note This method iterates over the selected rows only.
 			 * @warn The method creates a new ArrayList and expects that the caller unlinks all elements
 			 * and then destroys the list after use.
 			 * @return The currently selected rows of this list field.
 			 * UnlinkAll elements and delete the ArrayList after use.
+			 * @note Not supported by virtual list fields, use getNextSelectedRowNo() instead.
 			 */
 			ArrayList<ListField::Row> * getSelectedRowsInOrder();
 
@@ -1791,6 +2736,14 @@ namespace glaziery
 			 */
 			Type getType();
 
+			/**
+			 * Returns the range of rows that are at least partially visible in the rows field.
+			 * @param firstRowNo Set to the 0-indexed number of the first visible row.
+			 * @param lastRowNo Set to the 0-indexed number of the last visible row,
+			 * or less than firstRowNo if no row is visible.
+			 */
+			void getVisibleRowNos(int & firstRowNo, int & lastRowNo);
+
 			/**
 			 * Inserts a column at a given position.
 			 * @param position The 0-indexed position of the column.
@@ -1806,9 +2759,28 @@ namespace glaziery
 			 * @param row The row to be added.
 			 * @note After the call, the memory is owned by this object.
 			 * You should not delete it, it will be done automatically.
+			 * @note Not supported by virtual list fields, use the provider instead.
 			 */
 			void insertRow(int position, Row * row);
 
+			/**
+			 * Inserts a number of rows at a given position, as one update.
+			 * @param position The 0-indexed position of the first row.
+			 * @param newRows The rows to be added, in their new order.
+			 * @param rowCount The number of rows to be added.
+			 * @note After the call, the memory of the rows is owned by this object.
+			 * You should not delete them, it will be done automatically.
+			 * @note Not supported by virtual list fields, use the provider instead.
+			 * @see beginUpdate()
+			 */
+			void insertRows(int position, Row ** newRows, int rowCount);
+
+			/**
+			 * Selects all unselected rows and unselects all selected ones.
+			 * If this is no multi select list field, the method does nothing.
+			 */
+			void invertSelection();
+
 			/**
 			 * Returns whether the user can move the columns, e.g. dragging a column heading.
 			 * The actual UI is defined by the skin. Defaults to false.
@@ -1829,6 +2801,13 @@ namespace glaziery
 			 */
 			bool isEmpty();
 
+			/**
+			 * Returns whether the list field is filtered, i.e. hides rows not matching a text.
+			 * @return Whether the list field is filtered.
+			 * @see setFilter()
+			 */
+			bool isFiltered();
+
 			/**
 			 * Returns whether to display the column headers line. Defaults to true.
 			 * @return Whether to display the column headers line.
@@ -1864,6 +2843,20 @@ namespace glaziery
 			 */
 			bool isRowsRemovable();
 
+			/**
+			 * Returns whether a background sort job is running.
+			 * @return Whether the rows are being sorted.
+			 * @see sortRows()
+			 */
+			bool isSorting();
+
+			/**
+			 * Returns whether the list field is currently being updated.
+			 * @return Whether an update has begun and not ended yet.
+			 * @see beginUpdate()
+			 */
+			bool isUpdating();
+
 			/**
 			 * Returns whether the list field displays a horizontal scroller.
 			 * The skin's created widgets return act and the scroller sizes
@@ -1872,10 +2865,18 @@ namespace glaziery
 			 */
 			bool isVerticallyScrollable();
 
+			/**
+			 * Returns whether the list field is virtual, i.e. its rows are supplied by a provider.
+			 * @return Whether the list field is virtual.
+			 * @see setProvider()
+			 */
+			bool isVirtual();
+
 			/**
 			 * Moves a row from a given position to another position.
 			 * @param fromPosition The from position of the row.
 			 * @param toPosition The to position of the row.
+			 * @note Not supported by virtual list fields, use the provider instead.
 			 */
 			void moveRow(int fromPosition, int toPosition);
 
@@ -1944,11 +2945,45 @@ namespace glaziery
 			 */
 			virtual DraggingSurrogate * onDragStart(int rowNo, int columnNo);
 
+			/**
+			 * Handles the event this an element of this field has changed.
+			 * By default, invalidates the field. For virtual list fields,
+			 * passes edited texts to the provider.
+			 * @param element The element that changed.
+			 */
+			virtual void onElementChanged(FieldElement * element);
+
 			/**
 			 * Handles the event that the pointer is hovered over the event target for a while.
 			 */
 			virtual void onHover();
 
+			/**
+			 * Handles the event that the rows of the provider of a virtual list field
+			 * have changed in an arbitrary way, e.g. their contents, order, or count.
+			 * Re-reads the row count, the selection and the focus remain at their row numbers.
+			 * Call this method after changing the provider's data.
+			 */
+			void onProviderRowsChanged();
+
+			/**
+			 * Handles the event that rows have been inserted into the provider of a virtual
+			 * list field. The selection and the focus are moved with their rows.
+			 * Call this method after inserting the rows into the provider's data.
+			 * @param position The 0-indexed position of the first row inserted.
+			 * @param count The number of rows inserted.
+			 */
+			void onProviderRowsInserted(int position, int count);
+
+			/**
+			 * Handles the event that rows have been removed from the provider of a virtual
+			 * list field. The selection and the focus are moved with their rows.
+			 * Call this method after removing the rows from the provider's data.
+			 * @param position The 0-indexed position of the first row removed.
+			 * @param count The number of rows removed.
+			 */
+			void onProviderRowsRemoved(int position, int count);
+
 			/**
 			 * Prepends a column at the beginning of the columns.
 			 * @param column The column to be added.
@@ -1980,18 +3015,30 @@ namespace glaziery
 			 * Removes a row at a given position from the list field.
 			 * @param position The position of the row to be deleted.
 			 * @return Whether the removal was performed. Any veto results in false.
+			 * @note Not supported by virtual list fields, use the provider instead.
 			 */
 			bool removeRow(int position);
 
+			/**
+			 * Removes a range of consecutive rows from the list field, asking the listeners once.
+			 * @param position The position of the first row to be deleted.
+			 * @param rowCount The number of rows to be deleted.
+			 * @return Whether the removal was performed. Any veto results in false.
+			 * @note Not supported by virtual list fields, use the provider instead.
+			 */
+			bool removeRowRange(int position, int rowCount);
+
 			/**
 			 * Removes all rows from the list field.
 			 * @return Whether the removal was performed. Any veto results in false.
+			 * @note Not supported by virtual list fields, use the provider instead.
 			 */
 			bool removeRows();
 
 			/**
 			 * Removes all currently selected rows from the list field.
 			 * @return Whether the removal was performed. Any veto results in false.
+			 * @note Not supported by virtual list fields, use the provider instead.
 			 */
 			bool removeSelectedRows();
 
@@ -2038,6 +3085,34 @@ namespace glaziery
 			 */
 			void setColumnsResizable(bool columnsResizable);
 
+			/**
+			 * Filters the rows by a text, e.g. typed by the user. Only rows containing the text
+			 * in one of the filter columns' cells remain visible, ignoring the case. The other
+			 * rows are hidden, but not destroyed. All row numbers, the focus and the selection
+			 * refer to the visible rows then. Selected rows that become hidden are unselected.<br>
+			 *
+			 * The texts of all rows are indexed by their trigrams when filtering the first time.
+			 * A text containing the previous one, e.g. when the user types another character,
+			 * narrows the visible rows only, without searching the hidden ones.<br>
+			 *
+			 * Rows inserted while filtering are tested against the filter after their cells
+			 * have been added, i.e. when the update ends, or, outside updates, when the deferrals
+			 * are executed next. Until then, they are visible. Changing the cells of rows
+			 * does not update their visibility until the filter changes again.
+			 * @param text The filter text. Pass an empty text to show all rows again.
+			 * @note Not supported by virtual list fields, filter the provider's rows instead.
+			 * @see setFilterColumns()
+			 */
+			void setFilter(const String & text);
+
+			/**
+			 * Sets the columns the filter searches. Defaults to all columns.
+			 * A current filter is applied again.
+			 * @param columnNos The 0-indexed column numbers, or NULL for all columns.
+			 * @param columnCount The number of column numbers.
+			 */
+			void setFilterColumns(const int * columnNos, int columnCount);
+
 			/**
 			 * Sets the 0-indexed column number that has the focus (the cursor is own).
 			 * @param focusColumnNo The 0-indexed column number that has the focus.
@@ -2063,6 +3138,16 @@ namespace glaziery
 			 */
 			void setHorizontallyScrollable(bool horizontallyScrollable);
 
+			/**
+			 * Sets the provider that supplies the rows, making this list field virtual.
+			 * The selection is cleared and the focus moves to the first row.
+			 * @param provider The provider, or NULL to make the list field regular again.
+			 * @note The list field must not contain any regular rows.
+			 * @note After the call, the provider is referenced by this object.
+			 * You should not delete it, it will be done automatically.
+			 */
+			void setProvider(Provider * provider);
+
 			/**
 			 * Sets whether the user may remove rows (e.g. by pressing the delete key).
 			 * Defaults to true.
@@ -2092,6 +3177,14 @@ namespace glaziery
 			 */
 			void setSelectedRows(const HashSet & selectedRows);
 
+			/**
+			 * Sets the selected rows of this list field to a range of rows.
+			 * If this is no multi select list field, only the first row is selected.
+			 * @param fromRowNo The 0-indexed number of the first row to be selected.
+			 * @param toRowNo The 0-indexed number of the last row to be selected.
+			 */
+			void setSelectedRows(int fromRowNo, int toRowNo);
+
 			/**
 			 * Sets the selection type (e.g. whether to select multiple rows). Defaults to TYPE_MANY.
 			 * @param type The selection type.
@@ -2137,9 +3230,38 @@ namespace glaziery
 			 * @param compare A functions that compares two rows and returns -1,
 			 * if the first is before the second, 0, if both rows are equal and 1,
 			 * if the first is after than the second.
+			 * @note Not supported by virtual list fields, use the provider instead.
 			 */
 			void sortRows(int (*compare)(Row * row1, Row * row2));
 
+			/**
+			 * Sorts the rows by the texts of a column. Texts are compared ignoring their case,
+			 * numeric texts are compared numerically and before other texts.
+			 * The sort is stable, rows with equal texts keep their order.
+			 * The focus, the range start, and the selection are preserved.
+			 * @param columnNo The 0-indexed number of the column to sort by.
+			 * @param descending Whether to sort in descending order.
+			 * @param background Whether to sort at least GL_LISTFIELD_BACKGROUNDSORTROWS rows
+			 * by worker threads. The result is applied in the main thread when they have finished,
+			 * unless rows are inserted, removed, moved, or sorted meanwhile, which cancels it.
+			 * Cell changes meanwhile are not considered.
+			 * @note Not supported by virtual list fields, use the provider instead.
+			 * @see isSorting()
+			 */
+			void sortRows(int columnNo, bool descending = false, bool background = false);
+
+			/**
+			 * Sorts the rows by the texts of one or more columns, see sortRows(int, bool, bool).
+			 * @param columnNos The 0-indexed numbers of the columns to sort by, most significant first.
+			 * @param descending For each column, whether to sort in descending order.
+			 * May be NULL to sort all columns in ascending order.
+			 * @param columnCount The number of columns to sort by.
+			 * @param background Whether to sort large numbers of rows by worker threads.
+			 * @note Not supported by virtual list fields, use the provider instead.
+			 */
+			void sortRows(const int * columnNos, const bool * descending, int columnCount,
+				bool background = false);
+
 			/**
 			 * Returns a string reprensentation of this object.
 			 * @return The string representation.
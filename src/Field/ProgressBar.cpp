@@ -37,7 +37,10 @@ ProgressBar::~ProgressBar()
 void ProgressBar::draw(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
-	Desktop::getInstance()->getSkin()->drawProgressBar(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawProgressBar")
+		Desktop::getInstance()->getSkin()->drawProgressBar(context, this);
+	}
 }
 
 void ProgressBar::executeDeferrals()
@@ -31,7 +31,10 @@ RadioBox::~RadioBox()
 void RadioBox::draw(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
-	Desktop::getInstance()->getSkin()->drawRadioBox(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawRadioBox")
+		Desktop::getInstance()->getSkin()->drawRadioBox(context, this);
+	}
 }
 
 int RadioBox::getPositionInGroup()
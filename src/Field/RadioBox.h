@@ -16,9 +16,9 @@
 	if ((variable = new RadioBox) == NULL) \
 		throw EOUTOFMEMORY; \
 	if (area != NULL) \
-		((FieldsArea *) area)->appendField(variable); \
+		((FieldsArea *) (void *) (area))->appendField(variable); \
 	if (groupField != NULL) \
-		((GroupField *) groupField)->appendField(variable); \
+		((GroupField *) (void *) (groupField))->appendField(variable); \
 	radioGroup->addRadioBox(variable); \
 	variable->setText(text); \
 	variable->setChecked(checked);
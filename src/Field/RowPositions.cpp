@@ -0,0 +1,269 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+const int RowPositions::BLOCK_SIZE = 256;
+const int RowPositions::MAXIMUM_BLOCK_SIZE = 512;
+
+RowPositions::RowPositions()
+{
+	ASSERTION_COBJECT(this);
+
+	blockCount = 0;
+	blocks = NULL;
+	blocksCapacity = 0;
+	count = 0;
+}
+
+RowPositions::~RowPositions()
+{
+	ASSERTION_COBJECT(this);
+
+	for (int index = 0; index < blockCount; index++)
+		destroyBlock(blocks[index]);
+	blockCount = 0;
+	if (blocks != NULL) {delete[] blocks; blocks = NULL;}
+}
+
+void RowPositions::append(Entry * entry)
+{
+	ASSERTION_COBJECT(this);
+	insert(count, entry);
+}
+
+void RowPositions::clear()
+{
+	ASSERTION_COBJECT(this);
+
+	for (int index = 0; index < blockCount; index++)
+	{
+		Block * block = blocks[index];
+		for (int offset = 0; offset < block->count; offset++)
+		{
+			block->entries[offset]->block = NULL;
+			block->entries[offset]->offset = 0;
+		}
+		destroyBlock(block);
+	}
+
+	blockCount = 0;
+	count = 0;
+}
+
+RowPositions::Block * RowPositions::createBlock(int start)
+{
+	Block * block;
+	if ((block = new Block) == NULL)
+		throw EOUTOFMEMORY;
+	if ((block->entries = new Entry *[MAXIMUM_BLOCK_SIZE]) == NULL)
+	{
+		delete block;
+		throw EOUTOFMEMORY;
+	}
+
+	block->count = 0;
+	block->start = start;
+
+	return block;
+}
+
+void RowPositions::destroyBlock(Block * block)
+{
+	delete[] block->entries;
+	delete block;
+}
+
+int RowPositions::findBlock(int position)
+{
+	ASSERTION_COBJECT(this);
+
+	int low = 0;
+	int high = blockCount - 1;
+	while (low <= high)
+	{
+		int middle = (low + high) / 2;
+		if (blocks[middle]->start <= position)
+			low = middle + 1;
+		else
+			high = middle - 1;
+	}
+
+	return high;
+}
+
+int RowPositions::getCount()
+{
+	ASSERTION_COBJECT(this);
+	return count;
+}
+
+int RowPositions::getPosition(const Entry * entry)
+{
+	ASSERTION_COBJECT(this);
+	return entry->block != NULL ? entry->block->start + entry->offset : -1;
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(RowPositions, CObject);
+#endif
+
+void RowPositions::insert(int position, Entry * entry)
+{
+	ASSERTION_COBJECT(this);
+
+	if (position < 0 || position > count)
+		throw EILLEGALARGUMENT("The position is out of range");
+	if (entry->block != NULL)
+		throw EILLEGALSTATE("The entry is already positioned");
+
+	// Appending to a full last block starts a new one, so appended blocks are filled completely
+	int index = findBlock(position);
+	if (index < 0 || (position == count && blocks[index]->count == MAXIMUM_BLOCK_SIZE))
+		insertBlock(++index, createBlock(count));
+	else if (blocks[index]->count == MAXIMUM_BLOCK_SIZE)
+	{
+		splitBlock(index);
+		if (position >= blocks[index + 1]->start)
+			index++;
+	}
+
+	Block * block = blocks[index];
+	int offset = position - block->start;
+	memmove(block->entries + offset + 1, block->entries + offset,
+		(block->count - offset) * sizeof(Entry *));
+	block->entries[offset] = entry;
+	block->count++;
+	renumber(block, offset);
+
+	for (index++; index < blockCount; index++)
+		blocks[index]->start++;
+	count++;
+}
+
+void RowPositions::insertBlock(int index, Block * block)
+{
+	ASSERTION_COBJECT(this);
+
+	if (blockCount == blocksCapacity)
+	{
+		int newCapacity = blocksCapacity + blocksCapacity / 2;
+		if (newCapacity < 8)
+			newCapacity = 8;
+
+		Block ** newBlocks;
+		if ((newBlocks = new Block *[newCapacity]) == NULL)
+		{
+			destroyBlock(block);
+			throw EOUTOFMEMORY;
+		}
+
+		if (blocks != NULL)
+		{
+			memcpy(newBlocks, blocks, blockCount * sizeof(Block *));
+			delete[] blocks;
+		}
+
+		blocks = newBlocks;
+		blocksCapacity = newCapacity;
+	}
+
+	memmove(blocks + index + 1, blocks + index, (blockCount - index) * sizeof(Block *));
+	blocks[index] = block;
+	blockCount++;
+}
+
+void RowPositions::mergeBlock(int index)
+{
+	ASSERTION_COBJECT(this);
+
+	Block * previousBlock = blocks[index - 1];
+	Block * block = blocks[index];
+
+	int offset = previousBlock->count;
+	memcpy(previousBlock->entries + offset, block->entries, block->count * sizeof(Entry *));
+	previousBlock->count += block->count;
+	renumber(previousBlock, offset);
+
+	removeBlock(index);
+}
+
+void RowPositions::remove(Entry * entry)
+{
+	ASSERTION_COBJECT(this);
+
+	Block * block = entry->block;
+	if (block == NULL)
+		return;
+
+	// The blocks are not empty, so their starts are unique
+	int index = findBlock(block->start);
+	int offset = entry->offset;
+	memmove(block->entries + offset, block->entries + offset + 1,
+		(block->count - offset - 1) * sizeof(Entry *));
+	block->count--;
+	renumber(block, offset);
+
+	entry->block = NULL;
+	entry->offset = 0;
+
+	for (int nextIndex = index + 1; nextIndex < blockCount; nextIndex++)
+		blocks[nextIndex]->start--;
+	count--;
+
+	// Merge small blocks, so the number of blocks stays proportional to the number of entries
+	if (block->count == 0)
+		removeBlock(index);
+	else if (index + 1 < blockCount && block->count + blocks[index + 1]->count <= BLOCK_SIZE)
+		mergeBlock(index + 1);
+	else if (index > 0 && blocks[index - 1]->count + block->count <= BLOCK_SIZE)
+		mergeBlock(index);
+}
+
+void RowPositions::removeBlock(int index)
+{
+	ASSERTION_COBJECT(this);
+
+	destroyBlock(blocks[index]);
+	memmove(blocks + index, blocks + index + 1, (blockCount - index - 1) * sizeof(Block *));
+	blockCount--;
+}
+
+void RowPositions::renumber(Block * block, int offset)
+{
+	for (; offset < block->count; offset++)
+	{
+		block->entries[offset]->block = block;
+		block->entries[offset]->offset = offset;
+	}
+}
+
+void RowPositions::splitBlock(int index)
+{
+	ASSERTION_COBJECT(this);
+
+	Block * block = blocks[index];
+	int half = block->count / 2;
+
+	Block * newBlock = createBlock(block->start + half);
+	memcpy(newBlock->entries, block->entries + half, (block->count - half) * sizeof(Entry *));
+	newBlock->count = block->count - half;
+	insertBlock(index + 1, newBlock);
+
+	block->count = half;
+	renumber(newBlock, 0);
+}
+
+
+RowPositions::Entry::Entry()
+{
+	block = NULL;
+	offset = 0;
+}
@@ -0,0 +1,238 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_ROWPOSITIONS_H
+#define __GLAZIERY_ROWPOSITIONS_H
+
+
+namespace glaziery
+{
+	/**
+	 * The row positions keep the 0-indexed positions of the rows of a list
+	 * (e.g. of a list field) up to date while rows are inserted and removed.
+	 * Each row owns an entry, and the entries are split into consecutive blocks
+	 * of at most MAXIMUM_BLOCK_SIZE entries. An entry knows its block and its offset
+	 * within it, and a block knows the position of its first entry. So a position
+	 * is looked up in constant time, and inserting or removing a row renumbers
+	 * the offsets of its block and moves the start positions of the blocks behind it,
+	 * instead of renumbering all rows behind it.<br>
+	 *
+	 * Mirror each insertion into and removal from the list of rows,
+	 * and after reordering many rows at once, call clear() and append all entries again.
+	 */
+	#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+		class RowPositions : public CObject
+	#else
+		class RowPositions
+	#endif
+	{
+		public:
+
+			class Entry;
+
+		private:
+
+			/**
+			 * A range of consecutive entries.
+			 */
+			class Block
+			{
+				public:
+
+					/**
+					 * The number of entries of the block.
+					 */
+					int count;
+
+					/**
+					 * The entries of the block, with room for MAXIMUM_BLOCK_SIZE entries.
+					 */
+					Entry ** entries;
+
+					/**
+					 * The position of the first entry of the block.
+					 */
+					int start;
+			};
+
+		public:
+
+			/**
+			 * The position of a row, to be owned by the row.
+			 */
+			class Entry
+			{
+				friend RowPositions;
+
+				protected:
+
+					/**
+					 * The block containing the entry, or NULL, if it is not positioned.
+					 */
+					Block * block;
+
+					/**
+					 * The offset of the entry within its block.
+					 */
+					int offset;
+
+				public:
+
+					/**
+					 * Creates a new entry that is not positioned.
+					 */
+					Entry();
+			};
+
+		private:
+
+			/**
+			 * The number of entries a block shrinks to, before it is merged with a neighbour.
+			 */
+			static const int BLOCK_SIZE;
+
+			/**
+			 * The number of entries a block grows to, before it is split.
+			 */
+			static const int MAXIMUM_BLOCK_SIZE;
+
+			/**
+			 * The number of blocks.
+			 */
+			int blockCount;
+
+			/**
+			 * The blocks, ordered by their start positions. No block is empty.
+			 */
+			Block ** blocks;
+
+			/**
+			 * The number of blocks the blocks array has room for.
+			 */
+			int blocksCapacity;
+
+			/**
+			 * The number of entries.
+			 */
+			int count;
+
+			/**
+			 * Creates a new, empty block.
+			 * @param start The position of the first entry of the block.
+			 * @return The block.
+			 */
+			static Block * createBlock(int start);
+
+			/**
+			 * Destroys a block, but not its entries.
+			 * @param block The block.
+			 */
+			static void destroyBlock(Block * block);
+
+			/**
+			 * Returns the index of the last block starting at or before a given position.
+			 * @param position The position, at least 0.
+			 * @return The block index, or -1, if there are no blocks.
+			 */
+			int findBlock(int position);
+
+			/**
+			 * Inserts a block into the blocks array.
+			 * @param index The index of the new block.
+			 * @param block The block.
+			 */
+			void insertBlock(int index, Block * block);
+
+			/**
+			 * Moves the entries of a block to its predecessor and removes the block.
+			 * @param index The index of the block, at least 1.
+			 */
+			void mergeBlock(int index);
+
+			/**
+			 * Removes a block from the blocks array and destroys it.
+			 * @param index The index of the block.
+			 */
+			void removeBlock(int index);
+
+			/**
+			 * Updates the block and the offsets of the entries of a block.
+			 * @param block The block.
+			 * @param offset The offset of the first entry to be updated.
+			 */
+			static void renumber(Block * block, int offset);
+
+			/**
+			 * Moves the second half of the entries of a block into a new block behind it.
+			 * @param index The index of the block.
+			 */
+			void splitBlock(int index);
+
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(RowPositions);
+			#endif
+
+		public:
+
+			/**
+			 * Creates new, empty row positions.
+			 */
+			RowPositions();
+
+			/**
+			 * Destroys the row positions. The entries are left alone,
+			 * since their rows may have been destroyed already.
+			 */
+			~RowPositions();
+
+			/**
+			 * Appends an entry behind all other entries.
+			 * @param entry The entry, which must not be positioned.
+			 */
+			void append(Entry * entry);
+
+			/**
+			 * Removes all entries, so they are not positioned anymore.
+			 * The rows owning the entries must still exist.
+			 */
+			void clear();
+
+			/**
+			 * Returns the number of entries.
+			 * @return The number of entries.
+			 */
+			int getCount();
+
+			/**
+			 * Returns the position of an entry.
+			 * @param entry The entry.
+			 * @return The 0-indexed position, or -1, if the entry is not positioned.
+			 */
+			int getPosition(const Entry * entry);
+
+			/**
+			 * Inserts an entry, moving the entries from the position on behind it.
+			 * @param position The position of the new entry, from 0 to getCount().
+			 * @param entry The entry, which must not be positioned.
+			 */
+			void insert(int position, Entry * entry);
+
+			/**
+			 * Removes an entry, moving the entries behind it to the front.
+			 * Entries that are not positioned are ignored.
+			 * @param entry The entry.
+			 */
+			void remove(Entry * entry);
+	};
+}
+
+
+#endif
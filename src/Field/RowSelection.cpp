@@ -0,0 +1,535 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+const int RowSelection::MINIMUM_BITSET_RANGES = 32;
+
+RowSelection::RowSelection()
+{
+	ASSERTION_COBJECT(this);
+
+	bits = NULL;
+	bitsSize = 0;
+	count = 0;
+	rangeCount = 0;
+	ranges = NULL;
+	rangesCapacity = 0;
+	rowCount = 0;
+	version = 0;
+}
+
+RowSelection::~RowSelection()
+{
+	ASSERTION_COBJECT(this);
+
+	if (bits != NULL) {delete[] bits; bits = NULL;}
+	if (ranges != NULL) {delete[] ranges; ranges = NULL;}
+}
+
+void RowSelection::clear()
+{
+	ASSERTION_COBJECT(this);
+
+	if (bits != NULL) {delete[] bits; bits = NULL;}
+	bitsSize = 0;
+	count = 0;
+	rangeCount = 0;
+	version++;
+}
+
+bool RowSelection::contains(int rowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	if (rowNo < 0 || rowNo >= rowCount)
+		return false;
+
+	if (bits != NULL)
+		return isBitSet(rowNo);
+
+	int index = findRange(rowNo);
+	return index < rangeCount && ranges[index * 2] <= rowNo;
+}
+
+void RowSelection::convertToBits()
+{
+	ASSERTION_COBJECT(this);
+
+	int size = (rowCount + 7) / 8;
+	if (size < 1)
+		size = 1;
+
+	if ((bits = new unsigned char[size]) == NULL)
+		throw EOUTOFMEMORY;
+	memset(bits, 0, size);
+	bitsSize = size;
+
+	for (int index = 0; index < rangeCount; index++)
+		for (int rowNo = ranges[index * 2]; rowNo < ranges[index * 2 + 1]; rowNo++)
+			setBit(rowNo, true);
+	rangeCount = 0;
+}
+
+void RowSelection::ensureBitsSize()
+{
+	ASSERTION_COBJECT(this);
+
+	int size = (rowCount + 7) / 8;
+	if (size <= bitsSize)
+		return;
+
+	// Grow by half at least, so appending rows one by one stays linear
+	int newSize = bitsSize + bitsSize / 2;
+	if (newSize < size)
+		newSize = size;
+
+	unsigned char * newBits;
+	if ((newBits = new unsigned char[newSize]) == NULL)
+		throw EOUTOFMEMORY;
+	memset(newBits, 0, newSize);
+
+	if (bits != NULL)
+	{
+		memcpy(newBits, bits, bitsSize);
+		delete[] bits;
+	}
+
+	bits = newBits;
+	bitsSize = newSize;
+}
+
+void RowSelection::ensureRangesCapacity(int capacity)
+{
+	ASSERTION_COBJECT(this);
+
+	if (capacity <= rangesCapacity)
+		return;
+
+	int newCapacity = rangesCapacity + rangesCapacity / 2;
+	if (newCapacity < capacity)
+		newCapacity = capacity;
+	if (newCapacity < 8)
+		newCapacity = 8;
+
+	int * newRanges;
+	if ((newRanges = new int[newCapacity * 2]) == NULL)
+		throw EOUTOFMEMORY;
+
+	if (ranges != NULL)
+	{
+		memcpy(newRanges, ranges, rangeCount * 2 * sizeof(int));
+		delete[] ranges;
+	}
+
+	ranges = newRanges;
+	rangesCapacity = newCapacity;
+}
+
+int RowSelection::findRange(int rowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	int low = 0;
+	int high = rangeCount;
+	while (low < high)
+	{
+		int middle = (low + high) / 2;
+		if (ranges[middle * 2 + 1] > rowNo)
+			high = middle;
+		else
+			low = middle + 1;
+	}
+
+	return low;
+}
+
+int RowSelection::getCount()
+{
+	ASSERTION_COBJECT(this);
+	return count;
+}
+
+int RowSelection::getNext(int rowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	if (rowNo < -1)
+		rowNo = -1;
+	rowNo++;
+
+	if (bits != NULL)
+	{
+		for (; rowNo < rowCount; rowNo++)
+		{
+			// Skip bytes without selected rows at once
+			if ((rowNo & 7) == 0)
+				while (rowNo < rowCount && bits[rowNo >> 3] == 0)
+					rowNo += 8;
+
+			if (rowNo < rowCount && isBitSet(rowNo))
+				return rowNo;
+		}
+
+		return -1;
+	}
+
+	int index = findRange(rowNo);
+	if (index >= rangeCount)
+		return -1;
+
+	return ranges[index * 2] > rowNo ? ranges[index * 2] : rowNo;
+}
+
+bool RowSelection::getNextRange(int rowNo, int & fromRowNo, int & toRowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	int firstRowNo = getNext(rowNo);
+	if (firstRowNo < 0)
+		return false;
+
+	fromRowNo = firstRowNo;
+	if (bits != NULL)
+	{
+		int endRowNo = firstRowNo + 1;
+		while (endRowNo < rowCount && isBitSet(endRowNo))
+			endRowNo++;
+		toRowNo = endRowNo - 1;
+	}
+	else
+		toRowNo = ranges[findRange(firstRowNo) * 2 + 1] - 1;
+
+	return true;
+}
+
+int RowSelection::getRowCount()
+{
+	ASSERTION_COBJECT(this);
+	return rowCount;
+}
+
+int RowSelection::getVersion()
+{
+	ASSERTION_COBJECT(this);
+	return version;
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(RowSelection, CObject);
+#endif
+
+void RowSelection::insertRows(int position, int insertedCount)
+{
+	ASSERTION_COBJECT(this);
+
+	if (position < 0 || position > rowCount || insertedCount <= 0)
+		return;
+
+	rowCount += insertedCount;
+
+	if (bits != NULL)
+	{
+		ensureBitsSize();
+
+		int rowNo;
+		for (rowNo = rowCount - 1; rowNo >= position + insertedCount; rowNo--)
+			setBit(rowNo, isBitSet(rowNo - insertedCount));
+		for (rowNo = position; rowNo < position + insertedCount; rowNo++)
+			setBit(rowNo, false);
+	}
+	else
+	{
+		// Split the range containing the position, then move the ranges behind it
+		int index = findRange(position);
+		if (index < rangeCount && ranges[index * 2] < position)
+		{
+			int newRanges[4] = {ranges[index * 2], position, position, ranges[index * 2 + 1]};
+			replaceRanges(index, 1, newRanges, 2);
+			index++;
+		}
+
+		for (; index < rangeCount; index++)
+		{
+			ranges[index * 2] += insertedCount;
+			ranges[index * 2 + 1] += insertedCount;
+		}
+	}
+
+	version++;
+}
+
+void RowSelection::invert()
+{
+	ASSERTION_COBJECT(this);
+
+	if (bits != NULL)
+	{
+		int size = (rowCount + 7) / 8;
+		for (int i=0; i<size; i++)
+			bits[i] = (unsigned char) ~bits[i];
+		if ((rowCount & 7) != 0)
+			bits[rowCount >> 3] &= (unsigned char) ((1 << (rowCount & 7)) - 1);
+	}
+	else
+	{
+		// The gaps between the ranges become the new ranges
+		int * newRanges;
+		if ((newRanges = new int[(rangeCount + 1) * 2]) == NULL)
+			throw EOUTOFMEMORY;
+
+		int newCount = 0;
+		int gapStart = 0;
+		for (int index = 0; index < rangeCount; index++)
+		{
+			if (ranges[index * 2] > gapStart)
+			{
+				newRanges[newCount * 2] = gapStart;
+				newRanges[newCount * 2 + 1] = ranges[index * 2];
+				newCount++;
+			}
+			gapStart = ranges[index * 2 + 1];
+		}
+		if (gapStart < rowCount)
+		{
+			newRanges[newCount * 2] = gapStart;
+			newRanges[newCount * 2 + 1] = rowCount;
+			newCount++;
+		}
+
+		replaceRanges(0, rangeCount, newRanges, newCount);
+		delete[] newRanges;
+	}
+
+	count = rowCount - count;
+	version++;
+}
+
+bool RowSelection::isBitSet(int rowNo)
+{
+	ASSERTION_COBJECT(this);
+	return (bits[rowNo >> 3] & (1 << (rowNo & 7))) != 0;
+}
+
+bool RowSelection::isBitset()
+{
+	ASSERTION_COBJECT(this);
+	return bits != NULL;
+}
+
+void RowSelection::removeRows(int position, int removedCount)
+{
+	ASSERTION_COBJECT(this);
+
+	if (position < 0 || position >= rowCount || removedCount <= 0)
+		return;
+	if (removedCount > rowCount - position)
+		removedCount = rowCount - position;
+
+	setRange(position, position + removedCount, false);
+
+	if (bits != NULL)
+	{
+		int rowNo;
+		for (rowNo = position; rowNo < rowCount - removedCount; rowNo++)
+			setBit(rowNo, isBitSet(rowNo + removedCount));
+		for (; rowNo < rowCount; rowNo++)
+			setBit(rowNo, false);
+	}
+	else
+	{
+		// Move the ranges behind the removed rows, then join the ones meeting now
+		int index = findRange(position);
+		for (int i = index; i < rangeCount; i++)
+		{
+			ranges[i * 2] -= removedCount;
+			ranges[i * 2 + 1] -= removedCount;
+		}
+
+		if (index > 0 && index < rangeCount && ranges[(index - 1) * 2 + 1] == ranges[index * 2])
+		{
+			int newRange[2] = {ranges[(index - 1) * 2], ranges[index * 2 + 1]};
+			replaceRanges(index - 1, 2, newRange, 1);
+		}
+	}
+
+	rowCount -= removedCount;
+	version++;
+}
+
+void RowSelection::replaceRanges(int index, int oldCount, const int * newRanges, int newCount)
+{
+	ASSERTION_COBJECT(this);
+
+	ensureRangesCapacity(rangeCount - oldCount + newCount);
+
+	memmove(ranges + (index + newCount) * 2, ranges + (index + oldCount) * 2,
+		(rangeCount - index - oldCount) * 2 * sizeof(int));
+	memcpy(ranges + index * 2, newRanges, newCount * 2 * sizeof(int));
+	rangeCount += newCount - oldCount;
+}
+
+void RowSelection::select(int rowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	if (rowNo >= 0 && rowNo < rowCount && !contains(rowNo))
+		setRange(rowNo, rowNo + 1, true);
+}
+
+void RowSelection::selectAll()
+{
+	ASSERTION_COBJECT(this);
+
+	clear();
+	if (rowCount > 0)
+	{
+		ensureRangesCapacity(1);
+		ranges[0] = 0;
+		ranges[1] = rowCount;
+		rangeCount = 1;
+		count = rowCount;
+	}
+}
+
+void RowSelection::selectRange(int fromRowNo, int toRowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	if (fromRowNo < 0)
+		fromRowNo = 0;
+	if (toRowNo > rowCount - 1)
+		toRowNo = rowCount - 1;
+
+	if (fromRowNo <= toRowNo)
+		setRange(fromRowNo, toRowNo + 1, true);
+}
+
+void RowSelection::setBit(int rowNo, bool selected)
+{
+	ASSERTION_COBJECT(this);
+
+	if (selected)
+		bits[rowNo >> 3] |= (unsigned char) (1 << (rowNo & 7));
+	else
+		bits[rowNo >> 3] &= (unsigned char) ~(1 << (rowNo & 7));
+}
+
+void RowSelection::setRange(int fromRowNo, int endRowNo, bool selected)
+{
+	ASSERTION_COBJECT(this);
+
+	if (bits != NULL)
+	{
+		for (int rowNo = fromRowNo; rowNo < endRowNo; rowNo++)
+			if (isBitSet(rowNo) != selected)
+			{
+				setBit(rowNo, selected);
+				count += selected ? 1 : -1;
+			}
+	}
+	else if (selected)
+	{
+		// Join all ranges overlapping or adjacent to the new one
+		int index = findRange(fromRowNo - 1);
+		int endIndex = index;
+		int newRange[2] = {fromRowNo, endRowNo};
+		for (; endIndex < rangeCount && ranges[endIndex * 2] <= endRowNo; endIndex++)
+		{
+			if (ranges[endIndex * 2] < newRange[0])
+				newRange[0] = ranges[endIndex * 2];
+			if (ranges[endIndex * 2 + 1] > newRange[1])
+				newRange[1] = ranges[endIndex * 2 + 1];
+			count -= ranges[endIndex * 2 + 1] - ranges[endIndex * 2];
+		}
+
+		count += newRange[1] - newRange[0];
+		replaceRanges(index, endIndex - index, newRange, 1);
+
+		// Fall back to a bitset when the ranges take more memory than one bit per row
+		if (rangeCount >= MINIMUM_BITSET_RANGES && rangeCount > rowCount / 64)
+			convertToBits();
+	}
+	else
+	{
+		// Keep the parts of the first and last overlapping ranges outside the range
+		int index = findRange(fromRowNo);
+		int endIndex = index;
+		int newRanges[4];
+		int newCount = 0;
+		for (; endIndex < rangeCount && ranges[endIndex * 2] < endRowNo; endIndex++)
+		{
+			int rangeStart = ranges[endIndex * 2];
+			int rangeEnd = ranges[endIndex * 2 + 1];
+			if (rangeStart < fromRowNo)
+			{
+				newRanges[newCount * 2] = rangeStart;
+				newRanges[newCount * 2 + 1] = fromRowNo;
+				newCount++;
+			}
+			if (rangeEnd > endRowNo)
+			{
+				newRanges[newCount * 2] = endRowNo;
+				newRanges[newCount * 2 + 1] = rangeEnd;
+				newCount++;
+			}
+
+			count -= (rangeEnd < endRowNo ? rangeEnd : endRowNo)
+				- (rangeStart > fromRowNo ? rangeStart : fromRowNo);
+		}
+
+		replaceRanges(index, endIndex - index, newRanges, newCount);
+	}
+
+	version++;
+}
+
+bool RowSelection::setRowCount(int rowCount)
+{
+	ASSERTION_COBJECT(this);
+
+	if (rowCount < 0)
+		rowCount = 0;
+
+	bool cut = false;
+	if (rowCount < this->rowCount && getNext(rowCount - 1) >= 0)
+	{
+		setRange(rowCount, this->rowCount, false);
+		cut = true;
+	}
+
+	this->rowCount = rowCount;
+	if (bits != NULL)
+		ensureBitsSize();
+
+	version++;
+	return cut;
+}
+
+void RowSelection::unselect(int rowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	if (contains(rowNo))
+		setRange(rowNo, rowNo + 1, false);
+}
+
+void RowSelection::unselectRange(int fromRowNo, int toRowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	if (fromRowNo < 0)
+		fromRowNo = 0;
+	if (toRowNo > rowCount - 1)
+		toRowNo = rowCount - 1;
+
+	if (fromRowNo <= toRowNo)
+		setRange(fromRowNo, toRowNo + 1, false);
+}
@@ -0,0 +1,270 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_ROWSELECTION_H
+#define __GLAZIERY_ROWSELECTION_H
+
+
+namespace glaziery
+{
+	/**
+	 * The row selection is a compact set of selected row numbers, e.g. of a list field.
+	 * It stores the selection as a sorted array of disjoint ranges, so selecting all rows
+	 * or a range of rows costs a single range, and testing a row is a binary search.
+	 * When the selection becomes scattered, i.e. the ranges would take more memory
+	 * than one bit per row, it falls back to a bitset. Clearing the selection,
+	 * selecting all rows, and inverting a selection of ranges return to ranges.<br>
+	 *
+	 * The selection knows the number of rows, and moves the selected row numbers
+	 * when rows are inserted or removed. Row numbers out of range are never selected.
+	 */
+	#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+		class RowSelection : public CObject
+	#else
+		class RowSelection
+	#endif
+	{
+		private:
+
+			/**
+			 * The minimum number of ranges to fall back to a bitset.
+			 */
+			static const int MINIMUM_BITSET_RANGES;
+
+			/**
+			 * The bitset of the selected rows, one bit per row,
+			 * or NULL, if the selection consists of ranges.
+			 */
+			unsigned char * bits;
+
+			/**
+			 * The size of the bitset in bytes.
+			 */
+			int bitsSize;
+
+			/**
+			 * The number of selected rows.
+			 */
+			int count;
+
+			/**
+			 * The number of ranges, 0 if the selection is a bitset.
+			 */
+			int rangeCount;
+
+			/**
+			 * The ranges of selected rows, sorted and neither overlapping nor adjacent.
+			 * For each range, the first row number and the row number after the range.
+			 */
+			int * ranges;
+
+			/**
+			 * The number of ranges the ranges array has room for.
+			 */
+			int rangesCapacity;
+
+			/**
+			 * The number of rows.
+			 */
+			int rowCount;
+
+			/**
+			 * The number of changes of the selection so far.
+			 */
+			int version;
+
+			/**
+			 * Converts the ranges into a bitset.
+			 */
+			void convertToBits();
+
+			/**
+			 * Ensures that the bitset has room for the current number of rows,
+			 * clearing the bits added.
+			 */
+			void ensureBitsSize();
+
+			/**
+			 * Ensures that the ranges array has room for a given number of ranges.
+			 * @param capacity The number of ranges.
+			 */
+			void ensureRangesCapacity(int capacity);
+
+			/**
+			 * Returns the index of the first range that ends after a given row,
+			 * i.e. that contains the row or follows it.
+			 * @param rowNo The row number.
+			 * @return The range index, or rangeCount, if there is no such range.
+			 */
+			int findRange(int rowNo);
+
+			/**
+			 * Returns whether a row is selected in the bitset.
+			 * @param rowNo The row number, in range.
+			 * @return Whether the row is selected.
+			 */
+			bool isBitSet(int rowNo);
+
+			/**
+			 * Replaces ranges of the ranges array by other ranges.
+			 * @param index The index of the first range to be replaced.
+			 * @param oldCount The number of ranges to be replaced.
+			 * @param newRanges The new ranges (first row numbers and row numbers after the ranges).
+			 * @param newCount The number of new ranges.
+			 */
+			void replaceRanges(int index, int oldCount, const int * newRanges, int newCount);
+
+			/**
+			 * Sets a bit of the bitset, without counting.
+			 * @param rowNo The row number, in range.
+			 * @param selected Whether the row is selected.
+			 */
+			void setBit(int rowNo, bool selected);
+
+			/**
+			 * Selects or unselects a range of rows.
+			 * @param fromRowNo The first row number, in range.
+			 * @param endRowNo The row number after the range, in range.
+			 * @param selected Whether to select the rows.
+			 */
+			void setRange(int fromRowNo, int endRowNo, bool selected);
+
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(RowSelection);
+			#endif
+
+		public:
+
+			/**
+			 * Creates a new, empty row selection for no rows.
+			 */
+			RowSelection();
+
+			/**
+			 * Destroys the row selection.
+			 */
+			~RowSelection();
+
+			/**
+			 * Unselects all rows. The number of rows is kept.
+			 */
+			void clear();
+
+			/**
+			 * Returns whether a row is selected.
+			 * @param rowNo The row number.
+			 * @return Whether the row is selected.
+			 */
+			bool contains(int rowNo);
+
+			/**
+			 * Returns the number of selected rows.
+			 * @return The number of selected rows.
+			 */
+			int getCount();
+
+			/**
+			 * Returns the next selected row after a given row.
+			 * @param rowNo The row number to search after, -1 to search from the start.
+			 * @return The next selected row number, or -1, if there is none.
+			 */
+			int getNext(int rowNo);
+
+			/**
+			 * Returns the next range of consecutive selected rows after a given row.
+			 * Use it to iterate the selection by ranges, continuing after the last row found.
+			 * @param rowNo The row number to search after, -1 to search from the start.
+			 * @param fromRowNo Set to the first row number of the range.
+			 * @param toRowNo Set to the last row number of the range.
+			 * @return Whether there is such a range.
+			 */
+			bool getNextRange(int rowNo, int & fromRowNo, int & toRowNo);
+
+			/**
+			 * Returns the number of rows.
+			 * @return The number of rows.
+			 */
+			int getRowCount();
+
+			/**
+			 * Returns the number of changes of the selection so far,
+			 * e.g. to detect whether views derived from it are up to date.
+			 * @return The version.
+			 */
+			int getVersion();
+
+			/**
+			 * Inserts unselected rows, moving the selected rows behind them.
+			 * @param position The number of the first row inserted.
+			 * @param insertedCount The number of rows inserted.
+			 */
+			void insertRows(int position, int insertedCount);
+
+			/**
+			 * Selects all unselected rows and unselects all selected ones.
+			 */
+			void invert();
+
+			/**
+			 * Returns whether the selection currently is a bitset.
+			 * @return Whether the selection is a bitset, false for ranges.
+			 */
+			bool isBitset();
+
+			/**
+			 * Removes rows, moving the selected rows behind them.
+			 * @param position The number of the first row removed.
+			 * @param removedCount The number of rows removed.
+			 */
+			void removeRows(int position, int removedCount);
+
+			/**
+			 * Selects a row.
+			 * @param rowNo The row number. Row numbers out of range are ignored.
+			 */
+			void select(int rowNo);
+
+			/**
+			 * Selects all rows.
+			 */
+			void selectAll();
+
+			/**
+			 * Selects a range of rows.
+			 * @param fromRowNo The first row number. It is clipped to the rows.
+			 * @param toRowNo The last row number. It is clipped to the rows.
+			 */
+			void selectRange(int fromRowNo, int toRowNo);
+
+			/**
+			 * Sets the number of rows, unselecting rows that are cut.
+			 * @param rowCount The number of rows.
+			 * @return Whether selected rows have been cut.
+			 */
+			bool setRowCount(int rowCount);
+
+			/**
+			 * Unselects a row.
+			 * @param rowNo The row number. Row numbers out of range are ignored.
+			 */
+			void unselect(int rowNo);
+
+			/**
+			 * Unselects a range of rows.
+			 * @param fromRowNo The first row number. It is clipped to the rows.
+			 * @param toRowNo The last row number. It is clipped to the rows.
+			 */
+			void unselectRange(int fromRowNo, int toRowNo);
+	};
+}
+
+
+#endif
@@ -0,0 +1,382 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+const int RowTextIndex::MINIMUM_BUCKETS = 1024;
+const int RowTextIndex::MINIMUM_PURGED_ROWS = 1024;
+
+RowTextIndex::RowTextIndex()
+{
+	ASSERTION_COBJECT(this);
+
+	addCount = 0;
+	bucketCount = 0;
+	bucketCapacities = NULL;
+	bucketCounts = NULL;
+	bucketKeys = NULL;
+	bucketPostings = NULL;
+	bucketStamps = NULL;
+	freeRowNoCount = 0;
+	freeRowNos = NULL;
+	keyCount = 0;
+	offsets = NULL;
+	offsetsCapacity = 0;
+	removedRowCount = 0;
+	removedTextsSize = 0;
+	rowCount = 0;
+	rowNoCount = 0;
+	texts = NULL;
+	textsCapacity = 0;
+	textsSize = 0;
+}
+
+RowTextIndex::~RowTextIndex()
+{
+	ASSERTION_COBJECT(this);
+
+	if (bucketPostings != NULL)
+	{
+		for (int bucket = 0; bucket < bucketCount; bucket++)
+			if (bucketPostings[bucket] != NULL)
+				delete[] bucketPostings[bucket];
+		delete[] bucketPostings;
+		bucketPostings = NULL;
+	}
+
+	if (bucketCapacities != NULL) {delete[] bucketCapacities; bucketCapacities = NULL;}
+	if (bucketCounts != NULL) {delete[] bucketCounts; bucketCounts = NULL;}
+	if (bucketKeys != NULL) {delete[] bucketKeys; bucketKeys = NULL;}
+	if (bucketStamps != NULL) {delete[] bucketStamps; bucketStamps = NULL;}
+	if (freeRowNos != NULL) {delete[] freeRowNos; freeRowNos = NULL;}
+	if (offsets != NULL) {delete[] offsets; offsets = NULL;}
+	if (texts != NULL) {delete[] texts; texts = NULL;}
+}
+
+void RowTextIndex::addPosting(int bucket, int rowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	if (bucketCounts[bucket] >= bucketCapacities[bucket])
+	{
+		int newCapacity = bucketCapacities[bucket] > 0 ? bucketCapacities[bucket] * 2 : 4;
+
+		int * newPostings;
+		if ((newPostings = new int[newCapacity]) == NULL)
+			throw EOUTOFMEMORY;
+		if (bucketPostings[bucket] != NULL)
+		{
+			memcpy(newPostings, bucketPostings[bucket], bucketCounts[bucket] * sizeof(int));
+			delete[] bucketPostings[bucket];
+		}
+
+		bucketPostings[bucket] = newPostings;
+		bucketCapacities[bucket] = newCapacity;
+	}
+
+	bucketPostings[bucket][bucketCounts[bucket]++] = rowNo;
+}
+
+int RowTextIndex::addRow(const char * text)
+{
+	ASSERTION_COBJECT(this);
+
+	if (freeRowNoCount == 0 && rowNoCount >= offsetsCapacity)
+	{
+		int newCapacity = offsetsCapacity > 0 ? offsetsCapacity * 2 : 256;
+
+		int * newOffsets;
+		if ((newOffsets = new int[newCapacity]) == NULL)
+			throw EOUTOFMEMORY;
+		int * newFreeRowNos;
+		if ((newFreeRowNos = new int[newCapacity]) == NULL)
+		{
+			delete[] newOffsets;
+			throw EOUTOFMEMORY;
+		}
+
+		if (offsets != NULL)
+		{
+			memcpy(newOffsets, offsets, rowNoCount * sizeof(int));
+			delete[] offsets;
+		}
+		if (freeRowNos != NULL)
+			delete[] freeRowNos;
+
+		offsets = newOffsets;
+		freeRowNos = newFreeRowNos;
+		offsetsCapacity = newCapacity;
+	}
+
+	int length = (int) strlen(text);
+	if (textsSize + length + 1 > textsCapacity)
+	{
+		int newCapacity = textsCapacity > 0 ? textsCapacity * 2 : 4096;
+		while (newCapacity < textsSize + length + 1)
+			newCapacity *= 2;
+
+		char * newTexts;
+		if ((newTexts = new char[newCapacity]) == NULL)
+			throw EOUTOFMEMORY;
+		if (texts != NULL)
+		{
+			memcpy(newTexts, texts, textsSize);
+			delete[] texts;
+		}
+
+		texts = newTexts;
+		textsCapacity = newCapacity;
+	}
+
+	if (bucketCount == 0)
+		growBuckets();
+
+	int rowNo = freeRowNoCount > 0 ? freeRowNos[--freeRowNoCount] : rowNoCount++;
+	offsets[rowNo] = textsSize;
+	rowCount++;
+	addCount++;
+
+	char * rowText = texts + textsSize;
+	for (int i=0; i<length; i++)
+		texts[textsSize++] = (char) tolower((unsigned char) text[i]);
+	texts[textsSize++] = 0;
+
+	for (int i = 0; rowText[i] != 0 && rowText[i + 1] != 0 && rowText[i + 2] != 0; i++)
+	{
+		int key = getKey(rowText + i);
+		int bucket = findBucket(key);
+		if (bucketKeys[bucket] == 0)
+		{
+			if ((keyCount + 1) * 2 > bucketCount)
+			{
+				growBuckets();
+				bucket = findBucket(key);
+			}
+
+			bucketKeys[bucket] = key;
+			keyCount++;
+		}
+
+		if (bucketStamps[bucket] != addCount)
+		{
+			bucketStamps[bucket] = addCount;
+			addPosting(bucket, rowNo);
+		}
+	}
+
+	return rowNo;
+}
+
+int RowTextIndex::findBucket(int key)
+{
+	ASSERTION_COBJECT(this);
+
+	int bucket = (int) ((((unsigned int) key * 2654435761U) >> 8) & (bucketCount - 1));
+	while (bucketKeys[bucket] != 0 && bucketKeys[bucket] != key)
+		bucket = (bucket + 1) & (bucketCount - 1);
+
+	return bucket;
+}
+
+int RowTextIndex::findCandidates(const char * query, int * rowNos)
+{
+	ASSERTION_COBJECT(this);
+
+	int length = (int) strlen(query);
+	int count = 0;
+	int i;
+	if (length < 3)
+	{
+		for (i=0; i<rowNoCount; i++)
+			if (offsets[i] >= 0)
+				rowNos[count++] = i;
+		return count;
+	}
+
+	if (bucketCount == 0)
+		return 0;
+
+	// The rows containing the query are a subset of the rows of its rarest trigram
+	int rarestBucket = -1;
+	for (i=0; i <= length - 3; i++)
+	{
+		int bucket = findBucket(getKey(query + i));
+		if (bucketKeys[bucket] == 0)
+			return 0;
+
+		if (rarestBucket < 0 || bucketCounts[bucket] < bucketCounts[rarestBucket])
+			rarestBucket = bucket;
+	}
+
+	const int * postings = bucketPostings[rarestBucket];
+	for (i=0; i<bucketCounts[rarestBucket]; i++)
+		if (offsets[postings[i]] >= 0)
+			rowNos[count++] = postings[i];
+
+	return count;
+}
+
+int RowTextIndex::getKey(const char * characters)
+{
+	return ((unsigned char) characters[0] << 16)
+		| ((unsigned char) characters[1] << 8)
+		| (unsigned char) characters[2];
+}
+
+int RowTextIndex::getRowCount()
+{
+	ASSERTION_COBJECT(this);
+	return rowCount;
+}
+
+int RowTextIndex::getRowNoCount()
+{
+	ASSERTION_COBJECT(this);
+	return rowNoCount;
+}
+
+const char * RowTextIndex::getText(int rowNo)
+{
+	ASSERTION_COBJECT(this);
+	return texts + offsets[rowNo];
+}
+
+void RowTextIndex::growBuckets()
+{
+	ASSERTION_COBJECT(this);
+
+	int oldBucketCount = bucketCount;
+	int * oldBucketCapacities = bucketCapacities;
+	int * oldBucketCounts = bucketCounts;
+	int * oldBucketKeys = bucketKeys;
+	int ** oldBucketPostings = bucketPostings;
+	int * oldBucketStamps = bucketStamps;
+
+	bucketCount = oldBucketCount > 0 ? oldBucketCount * 2 : MINIMUM_BUCKETS;
+	if ((bucketCapacities = new int[bucketCount]) == NULL)
+		throw EOUTOFMEMORY;
+	if ((bucketCounts = new int[bucketCount]) == NULL)
+		throw EOUTOFMEMORY;
+	if ((bucketKeys = new int[bucketCount]) == NULL)
+		throw EOUTOFMEMORY;
+	if ((bucketPostings = new int *[bucketCount]) == NULL)
+		throw EOUTOFMEMORY;
+	if ((bucketStamps = new int[bucketCount]) == NULL)
+		throw EOUTOFMEMORY;
+	memset(bucketCapacities, 0, bucketCount * sizeof(int));
+	memset(bucketCounts, 0, bucketCount * sizeof(int));
+	memset(bucketKeys, 0, bucketCount * sizeof(int));
+	memset(bucketPostings, 0, bucketCount * sizeof(int *));
+	memset(bucketStamps, 0, bucketCount * sizeof(int));
+
+	// The postings move to the new buckets, they are not copied
+	for (int oldBucket = 0; oldBucket < oldBucketCount; oldBucket++)
+		if (oldBucketKeys[oldBucket] != 0)
+		{
+			int bucket = findBucket(oldBucketKeys[oldBucket]);
+			bucketCapacities[bucket] = oldBucketCapacities[oldBucket];
+			bucketCounts[bucket] = oldBucketCounts[oldBucket];
+			bucketKeys[bucket] = oldBucketKeys[oldBucket];
+			bucketPostings[bucket] = oldBucketPostings[oldBucket];
+			bucketStamps[bucket] = oldBucketStamps[oldBucket];
+		}
+
+	if (oldBucketCapacities != NULL) delete[] oldBucketCapacities;
+	if (oldBucketCounts != NULL) delete[] oldBucketCounts;
+	if (oldBucketKeys != NULL) delete[] oldBucketKeys;
+	if (oldBucketPostings != NULL) delete[] oldBucketPostings;
+	if (oldBucketStamps != NULL) delete[] oldBucketStamps;
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(RowTextIndex, CObject);
+#endif
+
+bool RowTextIndex::matches(int rowNo, const char * query)
+{
+	ASSERTION_COBJECT(this);
+	return strstr(texts + offsets[rowNo], query) != NULL;
+}
+
+void RowTextIndex::purge()
+{
+	ASSERTION_COBJECT(this);
+
+	for (int bucket = 0; bucket < bucketCount; bucket++)
+	{
+		int * postings = bucketPostings[bucket];
+		int count = 0;
+		for (int i=0; i<bucketCounts[bucket]; i++)
+			if (offsets[postings[i]] >= 0)
+				postings[count++] = postings[i];
+		bucketCounts[bucket] = count;
+	}
+
+	int newCapacity = (textsSize - removedTextsSize) * 2;
+	if (newCapacity < 4096)
+		newCapacity = 4096;
+
+	char * newTexts;
+	if ((newTexts = new char[newCapacity]) == NULL)
+		throw EOUTOFMEMORY;
+
+	// Free the row numbers from the back, so the lowest ones are reused first
+	int newTextsSize = 0;
+	freeRowNoCount = 0;
+	for (int rowNo = rowNoCount - 1; rowNo >= 0; rowNo--)
+		if (offsets[rowNo] >= 0)
+		{
+			int size = (int) strlen(texts + offsets[rowNo]) + 1;
+			memcpy(newTexts + newTextsSize, texts + offsets[rowNo], size);
+			offsets[rowNo] = newTextsSize;
+			newTextsSize += size;
+		}
+		else
+			freeRowNos[freeRowNoCount++] = rowNo;
+
+	delete[] texts;
+	texts = newTexts;
+	textsCapacity = newCapacity;
+	textsSize = newTextsSize;
+
+	removedRowCount = 0;
+	removedTextsSize = 0;
+}
+
+void RowTextIndex::removeRow(int rowNo)
+{
+	ASSERTION_COBJECT(this);
+
+	if (rowNo < 0 || rowNo >= rowNoCount || offsets[rowNo] < 0)
+		throw EILLEGALARGUMENT("The row is not contained in the index");
+
+	removedTextsSize += (int) strlen(texts + offsets[rowNo]) + 1;
+	offsets[rowNo] = -1;
+	rowCount--;
+	removedRowCount++;
+
+	if (removedRowCount >= MINIMUM_PURGED_ROWS && removedRowCount > rowCount)
+		purge();
+}
+
+char * RowTextIndex::toLowerCase(const char * text)
+{
+	int length = (int) strlen(text);
+
+	char * lowerCase;
+	if ((lowerCase = new char[length + 1]) == NULL)
+		throw EOUTOFMEMORY;
+
+	for (int i=0; i<length; i++)
+		lowerCase[i] = (char) tolower((unsigned char) text[i]);
+	lowerCase[length] = 0;
+
+	return lowerCase;
+}
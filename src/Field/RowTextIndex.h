@@ -0,0 +1,259 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_ROWTEXTINDEX_H
+#define __GLAZIERY_ROWTEXTINDEX_H
+
+
+namespace glaziery
+{
+	/**
+	 * The row text index finds the rows whose text contains a given substring,
+	 * e.g. to filter a list field while the user types. It stores one lower case
+	 * text per row and, for each trigram (sequence of three characters) occurring
+	 * in the texts, the numbers of the rows containing it.
+	 * A query of three characters or more only needs to check the rows
+	 * of its rarest trigram, shorter queries check all rows.<br>
+	 *
+	 * Rows are added and removed one by one, so the index follows changing rows
+	 * without being rebuilt: To change the text of a row, remove it and add it again.
+	 * Removing a row only marks its number as removed. The removed rows' row numbers,
+	 * trigram entries, and texts are purged at once, when there are more removed rows
+	 * than rows. Only then, their row numbers are reused.
+	 */
+	#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+		class RowTextIndex : public CObject
+	#else
+		class RowTextIndex
+	#endif
+	{
+		private:
+
+			/**
+			 * The minimum number of buckets of the trigram hash table.
+			 */
+			static const int MINIMUM_BUCKETS;
+
+			/**
+			 * The minimum number of removed rows to purge.
+			 */
+			static const int MINIMUM_PURGED_ROWS;
+
+			/**
+			 * The number of rows added so far, identifying the row being added.
+			 */
+			int addCount;
+
+			/**
+			 * The number of buckets of the trigram hash table, a power of 2,
+			 * or 0, if no row has been added yet.
+			 */
+			int bucketCount;
+
+			/**
+			 * For each bucket, the number of row numbers its postings have room for.
+			 */
+			int * bucketCapacities;
+
+			/**
+			 * For each bucket, the number of row numbers in its postings,
+			 * including the ones of removed rows not purged yet.
+			 */
+			int * bucketCounts;
+
+			/**
+			 * For each bucket, the trigram, or 0, if the bucket is empty.
+			 */
+			int * bucketKeys;
+
+			/**
+			 * For each bucket, the numbers of the rows containing the trigram, or NULL.
+			 */
+			int ** bucketPostings;
+
+			/**
+			 * For each bucket, the add count of the row the trigram has been posted for last,
+			 * so a row is posted once per trigram.
+			 */
+			int * bucketStamps;
+
+			/**
+			 * The number of free row numbers.
+			 */
+			int freeRowNoCount;
+
+			/**
+			 * The row numbers purged, to be reused by rows added.
+			 * It has room for offsetsCapacity row numbers.
+			 */
+			int * freeRowNos;
+
+			/**
+			 * The number of used buckets.
+			 */
+			int keyCount;
+
+			/**
+			 * For each row number, the offset of its text within the texts,
+			 * or -1, if the row has been removed.
+			 */
+			int * offsets;
+
+			/**
+			 * The number of row numbers the offsets array has room for.
+			 */
+			int offsetsCapacity;
+
+			/**
+			 * The number of rows removed since the last purge.
+			 */
+			int removedRowCount;
+
+			/**
+			 * The number of bytes of the texts of the rows removed since the last purge.
+			 */
+			int removedTextsSize;
+
+			/**
+			 * The number of rows.
+			 */
+			int rowCount;
+
+			/**
+			 * The number of row numbers used so far, i.e. the highest row number plus 1.
+			 */
+			int rowNoCount;
+
+			/**
+			 * The lower case texts of the rows, each terminated by 0.
+			 */
+			char * texts;
+
+			/**
+			 * The size of the texts buffer in bytes.
+			 */
+			int textsCapacity;
+
+			/**
+			 * The number of bytes of the texts buffer used.
+			 */
+			int textsSize;
+
+			/**
+			 * Appends a row number to the postings of a bucket.
+			 * @param bucket The bucket.
+			 * @param rowNo The row number.
+			 */
+			void addPosting(int bucket, int rowNo);
+
+			/**
+			 * Returns the bucket of a trigram.
+			 * @param key The trigram.
+			 * @return The bucket of the trigram, or the empty bucket it would use.
+			 */
+			int findBucket(int key);
+
+			/**
+			 * Returns the trigram starting at a given character.
+			 * @param characters The characters, at least three.
+			 * @return The trigram.
+			 */
+			static int getKey(const char * characters);
+
+			/**
+			 * Doubles the number of buckets, rehashing the trigrams.
+			 */
+			void growBuckets();
+
+			/**
+			 * Drops the removed rows from the postings and the texts,
+			 * and frees their row numbers.
+			 */
+			void purge();
+
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(RowTextIndex);
+			#endif
+
+		public:
+
+			/**
+			 * Creates a new, empty row text index.
+			 */
+			RowTextIndex();
+
+			/**
+			 * Destroys the row text index.
+			 */
+			~RowTextIndex();
+
+			/**
+			 * Adds a row to the index.
+			 * @param text The text of the row. It is matched case-insensitively.
+			 * @return The number of the row within the index.
+			 */
+			int addRow(const char * text);
+
+			/**
+			 * Finds the rows that may contain a given query. Use matches()
+			 * to check each row, since not all of them actually contain the query.
+			 * @param query The lower case query.
+			 * @param rowNos Set to the row numbers, in no particular order.
+			 * It must have room for getRowNoCount() row numbers.
+			 * @return The number of rows found.
+			 */
+			int findCandidates(const char * query, int * rowNos);
+
+			/**
+			 * Returns the number of rows.
+			 * @return The number of rows.
+			 */
+			int getRowCount();
+
+			/**
+			 * Returns the number of row numbers used, i.e. the highest row number plus 1,
+			 * e.g. to allocate arrays indexed by row number.
+			 * @return The number of row numbers.
+			 */
+			int getRowNoCount();
+
+			/**
+			 * Returns the lower case text of a row.
+			 * @param rowNo The row number.
+			 * @return The text.
+			 */
+			const char * getText(int rowNo);
+
+			/**
+			 * Returns whether the text of a row contains a given query.
+			 * @param rowNo The row number.
+			 * @param query The lower case query.
+			 * @return Whether the row matches.
+			 */
+			bool matches(int rowNo, const char * query);
+
+			/**
+			 * Removes a row from the index. Its number may be reused by rows added later.
+			 * @param rowNo The row number.
+			 */
+			void removeRow(int rowNo);
+
+			/**
+			 * Returns a lower case copy of a text, as required for queries.
+			 * @param text The text.
+			 * @return The lower case text. Delete it using delete[] after use.
+			 */
+			static char * toLowerCase(const char * text);
+	};
+}
+
+
+#endif
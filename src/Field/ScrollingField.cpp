@@ -65,10 +65,14 @@ void ScrollingField::draw(DrawingContext & context)
 	ASSERTION_COBJECT(this);
 
 	Skin * skin = Desktop::getInstance()->getSkin();
-	skin->drawScrollingField(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawScrollingField")
+		skin->drawScrollingField(context, this);
+	}
 
-	drawContent(DrawingContext(DrawingContext(context, borderSize + outerPaddingSize,
-		getContentViewSize()), -scrollPositionNow));
+	DrawingContext contentContext(DrawingContext(context, borderSize + outerPaddingSize,
+		getContentViewSize()), -scrollPositionNow);
+	drawContent(contentContext);
 }
 
 void ScrollingField::ensureVisible(Vector point)
@@ -149,7 +153,6 @@ Vector ScrollingField::getContentViewSize()
 {
 	ASSERTION_COBJECT(this);
 
-	Skin * skin = Desktop::getInstance()->getSkin();
 	return getSize() - getScrollerSizes() - borderSize * 2 - outerPaddingSize - getEffectiveInnerPaddingSize();
 }
 
@@ -252,13 +255,48 @@ Vector ScrollingField::getScrollPositionNow()
 	IMPLEMENT_DYNAMIC(ScrollingField, InputField);
 #endif
 
+void ScrollingField::invalidateContentArea(Vector position, Vector size)
+{
+	ASSERTION_COBJECT(this);
+
+	Vector viewSize = getContentViewSize();
+	Vector from = position - scrollPositionNow;
+	Vector to = from + size;
+	from.constrain(Vector(), viewSize);
+	to.constrain(Vector(), viewSize);
+
+	if (to.x > from.x && to.y > from.y)
+		invalidateArea(borderSize + outerPaddingSize + from, to - from);
+}
+
+void ScrollingField::invalidateContentViewFrame()
+{
+	ASSERTION_COBJECT(this);
+
+	Vector size = getSize();
+	Vector viewPosition = borderSize + outerPaddingSize;
+	Vector viewEnd = viewPosition + getContentViewSize();
+
+	invalidateArea(Vector(), Vector(size.x, viewPosition.y));
+	invalidateArea(Vector(0, viewEnd.y), Vector(size.x, size.y - viewEnd.y));
+	invalidateArea(Vector(0, viewPosition.y), Vector(viewPosition.x, viewEnd.y - viewPosition.y));
+	invalidateArea(Vector(viewEnd.x, viewPosition.y), Vector(size.x - viewEnd.x, viewEnd.y - viewPosition.y));
+}
+
 void ScrollingField::invalidateArea(Vector position, Vector size)
 {
 	ASSERTION_COBJECT(this);
 
-	Component * parent = getParent();
-	if (parent != NULL && parent->isChildVisible(this))
-		parent->invalidateArea(getPosition() + position, size);
+	// Constraining the scroll position below is tracked as an invalidation of its own
+	{
+		GLAZIERY_INVALIDATIONSCOPE(this, size)
+
+		discardDisplayList();
+
+		Component * parent = getParent();
+		if (parent != NULL && parent->isChildVisible(this))
+			parent->invalidateArea(getPosition() + position, size);
+	}
 
 	if (getParent() == NULL)
 		return;
@@ -270,7 +308,6 @@ bool ScrollingField::isWithinContent(Vector position)
 {
 	ASSERTION_COBJECT(this);
 
-	Skin * skin = Desktop::getInstance()->getSkin();
 	return position >= borderSize + outerPaddingSize
 		&& position < getSize() - getScrollerSizes() - borderSize - getEffectiveInnerPaddingSize();
 }
@@ -481,6 +518,7 @@ void ScrollingField::scrollTo(Vector scrollPosition)
 void ScrollingField::scrollToNow(Vector scrollPositionNow)
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_INVALIDATIONCAUSE(CAUSE_SCROLL)
 
 	if (inScrollToNow)
 		return;
@@ -508,7 +546,11 @@ void ScrollingField::scrollToNow(Vector scrollPositionNow)
 	Vector previousPosition = this->scrollPositionNow;
 	this->scrollPositionNow = scrollPositionNow;
 
-	invalidate();
+	// Shift the content view, if possible, instead of redrawing it
+	if (scrollArea(borderSize + outerPaddingSize, getContentViewSize(), previousPosition - scrollPositionNow))
+		invalidateContentViewFrame();
+	else
+		invalidate();
 	onScrollPositionNowChanged(previousPosition);
 
 	inScrollToNow = false;
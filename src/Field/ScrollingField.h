@@ -249,7 +249,7 @@ namespace glaziery
 			 * return in getContentSize().
 			 * @see Desktop::getSkin()
 			 */
-			virtual void drawContent(DrawingContext & context) = NULL;
+			virtual void drawContent(DrawingContext & context) = 0;
 
 			/**
 			 * For a given position within the field, returns the position relative
@@ -266,6 +266,22 @@ namespace glaziery
 			 */
 			Vector getScrollerSizes();
 
+			/**
+			 * Invalidates an area of the content. The area is clipped to the content view,
+			 * so parts that are scrolled out of view are not invalidated.
+			 * @param position The top-left position of the area, relative to the content.
+			 * @param size The size of the area.
+			 */
+			void invalidateContentArea(Vector position, Vector size);
+
+			/**
+			 * Invalidates the parts of the scrolling field around the content view,
+			 * i.e. the border, the padding, and the scrollers.
+			 * This is required after the content view has been scrolled by shifting it.
+			 * @see scrollToNow()
+			 */
+			void invalidateContentViewFrame();
+
 			/**
 			 * Returns whether a position is within the content area of the scrolling field,
 			 * i.e. not within a scroller.
@@ -479,7 +495,7 @@ namespace glaziery
 			 * should adjust according to this information. It may change during run.
 			 * @return Whether the scrolling field displays a horizontal scroller.
 			 */
-			virtual bool isHorizontallyScrollable() = NULL;
+			virtual bool isHorizontallyScrollable() = 0;
 
 			/**
 			 * Returns whether the scrolling field displays a horizontal scroller.
@@ -487,7 +503,7 @@ namespace glaziery
 			 * should adjust according to this information. It may change during run.
 			 * @return Whether the scrolling field displays a horizontal scroller.
 			 */
-			virtual bool isVerticallyScrollable() = NULL;
+			virtual bool isVerticallyScrollable() = 0;
 
 			/**
 			 * Handles the event that the event target is clicked
@@ -779,7 +795,7 @@ namespace glaziery
 			 * that might change the its size.
 			 * @see contentSize
 			 */
-			virtual void updateContentSize() = NULL;
+			virtual void updateContentSize() = 0;
 	};
 }
 
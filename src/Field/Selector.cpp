@@ -76,7 +76,10 @@ void Selector::autoResize()
 void Selector::draw(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
-	Desktop::getInstance()->getSkin()->drawSelector(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawSelector")
+		Desktop::getInstance()->getSkin()->drawSelector(context, this);
+	}
 }
 
 const ArrayList<Selector::Option> & Selector::getOptions()
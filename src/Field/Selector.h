@@ -15,9 +15,9 @@
 	if ((variable = new Selector) == NULL) \
 		throw EOUTOFMEMORY; \
 	if (area != NULL) \
-		((FieldsArea *) area)->appendField(variable); \
+		((FieldsArea *) (void *) (area))->appendField(variable); \
 	if (groupField != NULL) \
-		((GroupField *) groupField)->appendField(variable);
+		((GroupField *) (void *) (groupField))->appendField(variable);
 
 #define GLAZIERY_SELECTOR_P(variable, area, groupField, px, py) \
 	GLAZIERY_SELECTOR(variable, area, groupField) \
@@ -434,7 +434,7 @@ namespace glaziery
 			/**
 			 * This value indicates that there is no selection.
 			 */
-			static const int Selector::NONE;
+			static const int NONE;
 
 			Selector();
 
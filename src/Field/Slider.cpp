@@ -63,7 +63,10 @@ void Slider::detachStringList()
 void Slider::draw(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
-	Desktop::getInstance()->getSkin()->drawSlider(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawSlider")
+		Desktop::getInstance()->getSkin()->drawSlider(context, this);
+	}
 }
 
 long Slider::getConstrainedCurrent()
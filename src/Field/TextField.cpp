@@ -189,7 +189,10 @@ bool TextField::deleteSelection()
 void TextField::drawContent(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
-	Desktop::getInstance()->getSkin()->drawTextField(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawTextField")
+		Desktop::getInstance()->getSkin()->drawTextField(context, this);
+	}
 }
 
 void TextField::ensureCursorVisible()
@@ -572,6 +575,7 @@ bool TextField::onBackSpace()
 bool TextField::onCharacter(char character, bool option1, bool option2)
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_INVALIDATIONCAUSE(CAUSE_TEXT)
 
 	ScrollingField::onCharacter(character, option1, option2);
 
@@ -608,7 +612,6 @@ long TextField::onContentHold(Vector position, long holdTime)
 	int column;
 	Desktop::getInstance()->getSkin()->getTextFieldRowAndColumnAtPosition(this, row, column, position);
 
-	bool modified = false;
 	if (cursorRow != row || cursorColumn != column)
 	{
 		cursorRow = row;
@@ -1400,6 +1403,7 @@ void TextField::setMultiLine(bool multiLine)
 void TextField::setText(const String & text)
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_INVALIDATIONCAUSE(CAUSE_TEXT)
 
 	ArrayList<String> lines;
 	splitTextIntoLines(lines, text);
@@ -15,9 +15,9 @@
 	if ((variable = new TextField) == NULL) \
 		throw EOUTOFMEMORY; \
 	if (area != NULL) \
-		((FieldsArea *) area)->appendField(variable); \
+		((FieldsArea *) (void *) (area))->appendField(variable); \
 	if (groupField != NULL) \
-		((GroupField *) groupField)->appendField(variable); \
+		((GroupField *) (void *) (groupField))->appendField(variable); \
 	variable->setMultiLine(multiLine);
 
 #define GLAZIERY_TEXTFIELD_P(variable, area, groupField, px, py, multiLine) \
@@ -83,7 +83,10 @@ void TreeField::collapseAll(bool deeply)
 void TreeField::drawContent(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
-	Desktop::getInstance()->getSkin()->drawTreeField(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawTreeField")
+		Desktop::getInstance()->getSkin()->drawTreeField(context, this);
+	}
 }
 
 void TreeField::ensureFocusVisible(bool deeply)
@@ -566,9 +569,6 @@ void TreeField::onContentContextClick(Vector position, bool option1, bool option
 		if (position.x < item->getPosition().x + skin->getTreeFieldExpansionWidgetSize(item).x)
 			return;
 
-		bool itemWasFocused = item->hasFocus();
-		bool itemWasSelected = item->isSelected();
-
 		setFocusItem(item);
 
 		updateSelectionFromFocus(option1, option2);
@@ -1050,12 +1050,12 @@ void TreeField::selectCurrentItem()
 	if (notifySelectionChanging())
 		return;
 
-	if (getType() == ListField::TYPE_ONE)
+	if (getType() == TYPE_ONE)
 	{
 		selectedItems.RemoveAll();
 		selectedItems.Add(focusItem);
 	}
-	else if (getType() == ListField::TYPE_ONE_OR_NONE)
+	else if (getType() == TYPE_ONE_OR_NONE)
 	{
 		bool focusEqualsSelection = selectedItems.GetCount() == 1 && selectedItems.Contains(focusItem);
 		selectedItems.RemoveAll();
@@ -16,9 +16,9 @@
 	if ((variable = new TreeField) == NULL) \
 		throw EOUTOFMEMORY; \
 	if (area != NULL) \
-		((FieldsArea *) area)->appendField(variable); \
+		((FieldsArea *) (void *) (area))->appendField(variable); \
 	if (groupField != NULL) \
-		((GroupField *) groupField)->appendField(variable); \
+		((GroupField *) (void *) (groupField))->appendField(variable); \
 	variable->setHorizontallyScrollable(horizontallyScrollable); \
 	variable->setVerticallyScrollable(verticallyScrollable); \
 	variable->setType(TreeField::TYPE_##type);
@@ -115,7 +115,6 @@ namespace glaziery
 
 			class Item;
 			class Listener;
-			enum Type;
 
 			class Item : public GlazieryObject
 			{
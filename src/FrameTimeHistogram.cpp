@@ -0,0 +1,160 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+FrameTimeHistogram::FrameTimeHistogram(int windowSize)
+{
+	ASSERTION_COBJECT(this);
+
+	window = NULL;
+	this->windowSize = 0;
+
+	if (windowSize > 0)
+	{
+		if ((window = new float[windowSize]) == NULL)
+			throw EOUTOFMEMORY;
+		this->windowSize = windowSize;
+	}
+
+	reset();
+}
+
+FrameTimeHistogram::~FrameTimeHistogram()
+{
+	ASSERTION_COBJECT(this);
+
+	if (window != NULL) {delete[] window; window = NULL;}
+}
+
+void FrameTimeHistogram::add(double duration)
+{
+	ASSERTION_COBJECT(this);
+
+	if (duration < 0.0)
+		duration = 0.0;
+
+	if (windowSize > 0)
+	{
+		// Forget the oldest duration, if the window is full
+		if (count >= (unsigned long) windowSize)
+		{
+			double oldDuration = window[windowPosition];
+			buckets[getBucket(oldDuration)]--;
+			total -= oldDuration;
+			count--;
+		}
+
+		window[windowPosition] = (float) duration;
+		windowPosition = (windowPosition + 1) % windowSize;
+	}
+	else if (duration > maximum)
+		maximum = duration;
+
+	buckets[getBucket(duration)]++;
+	total += duration;
+	count++;
+}
+
+int FrameTimeHistogram::getBucket(double duration)
+{
+	unsigned long value = duration < 2147483647.0 ? (unsigned long) duration : 0x7FFFFFFFUL;
+	if (value < 64)
+		return (int) value;
+
+	int exponent = 6;
+	while ((value >> (exponent + 1)) != 0)
+		exponent++;
+
+	int shift = exponent - 5;
+	return 64 + (exponent - 6) * 32 + (int) ((value >> shift) - 32);
+}
+
+double FrameTimeHistogram::getBucketUpperBound(int bucket)
+{
+	if (bucket < 64)
+		return bucket + 1.0;
+
+	int exponent = (bucket - 64) / 32 + 6;
+	int subBucket = (bucket - 64) % 32;
+	return (double) (32 + subBucket + 1) * (double) (1UL << (exponent - 5));
+}
+
+unsigned long FrameTimeHistogram::getCount()
+{
+	ASSERTION_COBJECT(this);
+	return count;
+}
+
+double FrameTimeHistogram::getMaximum()
+{
+	ASSERTION_COBJECT(this);
+
+	if (windowSize == 0)
+		return maximum;
+
+	double windowMaximum = 0.0;
+	for (unsigned long i=0; i<count; i++)
+		if (window[i] > windowMaximum)
+			windowMaximum = window[i];
+
+	return windowMaximum;
+}
+
+double FrameTimeHistogram::getMean()
+{
+	ASSERTION_COBJECT(this);
+	return count > 0 ? total / count : 0.0;
+}
+
+double FrameTimeHistogram::getPercentile(double percentile)
+{
+	ASSERTION_COBJECT(this);
+
+	if (count == 0)
+		return 0.0;
+
+	// The percentile is the smallest duration that covers the rank
+	unsigned long rank = (unsigned long) ceil(percentile / 100.0 * count);
+	if (rank < 1)
+		rank = 1;
+	if (rank > count)
+		rank = count;
+
+	double upperBound = 0.0;
+	unsigned long counted = 0;
+	for (int bucket = 0; bucket < GL_FRAMETIMEHISTOGRAM_BUCKETS; bucket++)
+	{
+		counted += buckets[bucket];
+		if (counted >= rank)
+		{
+			upperBound = getBucketUpperBound(bucket);
+			break;
+		}
+	}
+
+	double maximum = getMaximum();
+	return upperBound < maximum ? upperBound : maximum;
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(FrameTimeHistogram, CObject);
+#endif
+
+void FrameTimeHistogram::reset()
+{
+	ASSERTION_COBJECT(this);
+
+	memset(buckets, 0, sizeof(buckets));
+	count = 0;
+	maximum = 0.0;
+	total = 0.0;
+	windowPosition = 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_FRAMETIMEHISTOGRAM_H
+#define __GLAZIERY_FRAMETIMEHISTOGRAM_H
+
+
+namespace glaziery
+{
+	/**
+	 * The frame time histogram counts durations (in micro seconds) in log-linear
+	 * buckets: Below 64 micro seconds, each bucket covers one micro second, above,
+	 * each power of two is divided into 32 buckets. So percentiles are reported with
+	 * a relative error of about 3 percent, while adding a duration is O(1) and never
+	 * allocates memory. Durations of more than 2^31 micro seconds are counted in the last bucket.<br>
+	 *
+	 * The histogram either counts all durations since its creation or last reset(),
+	 * or it rolls over a window of the most recent durations, forgetting older ones.
+	 * @see Profiler
+	 */
+	#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+		class FrameTimeHistogram : public CObject
+	#else
+		class FrameTimeHistogram
+	#endif
+	{
+		protected:
+
+			/**
+			 * The number of durations per bucket.
+			 */
+			unsigned long buckets[GL_FRAMETIMEHISTOGRAM_BUCKETS];
+
+			/**
+			 * The number of durations counted.
+			 */
+			unsigned long count;
+
+			/**
+			 * The maximum duration counted, in micro seconds.
+			 * Not maintained for rolling histograms.
+			 */
+			double maximum;
+
+			/**
+			 * The sum of all durations counted, in micro seconds.
+			 */
+			double total;
+
+			/**
+			 * For rolling histograms, the ring of the most recent durations
+			 * (windowSize entries), or NULL.
+			 */
+			float * window;
+
+			/**
+			 * For rolling histograms, the ring position of the next duration.
+			 */
+			int windowPosition;
+
+			/**
+			 * For rolling histograms, the number of durations rolled over, or 0.
+			 */
+			int windowSize;
+
+			/**
+			 * Returns the bucket of a duration.
+			 * @param duration The duration in micro seconds.
+			 * @return The bucket index.
+			 */
+			static int getBucket(double duration);
+
+			/**
+			 * Returns the exclusive upper bound of a bucket.
+			 * @param bucket The bucket index.
+			 * @return The upper bound in micro seconds.
+			 */
+			static double getBucketUpperBound(int bucket);
+
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(FrameTimeHistogram);
+			#endif
+
+		public:
+
+			/**
+			 * Creates a new, empty frame time histogram.
+			 * @param windowSize The number of most recent durations to roll over,
+			 * or 0 to count all durations.
+			 */
+			FrameTimeHistogram(int windowSize = 0);
+
+			/**
+			 * Destroys the frame time histogram.
+			 */
+			~FrameTimeHistogram();
+
+			/**
+			 * Counts a duration. For rolling histograms, the oldest duration is
+			 * forgotten, if the window is full.
+			 * @param duration The duration in micro seconds.
+			 */
+			void add(double duration);
+
+			/**
+			 * Returns the number of durations counted.
+			 * @return The number of durations.
+			 */
+			unsigned long getCount();
+
+			/**
+			 * Returns the maximum duration counted.
+			 * @return The maximum in micro seconds, or 0 if the histogram is empty.
+			 */
+			double getMaximum();
+
+			/**
+			 * Returns the mean duration counted.
+			 * @return The mean in micro seconds, or 0 if the histogram is empty.
+			 */
+			double getMean();
+
+			/**
+			 * Returns a percentile of the durations counted, i.e. the duration
+			 * the given percentage of durations does not exceed. The upper bound
+			 * of the percentile's bucket is returned, limited to the maximum.
+			 * @param percentile The percentile, from 0 to 100, e.g. 99 for p99.
+			 * @return The percentile in micro seconds, or 0 if the histogram is empty.
+			 */
+			double getPercentile(double percentile);
+
+			/**
+			 * Forgets all durations counted.
+			 */
+			void reset();
+	};
+}
+
+
+#endif
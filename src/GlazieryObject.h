@@ -69,7 +69,7 @@ namespace glaziery
 			 * @param model The model to be destroyed.
 			 * @see setModel()
 			 */
-			static void GlazieryObject::destructor(void * model);
+			static void destructor(void * model);
 
 			/**
 			 * Returns the application (or game) defined data. Typically, there is an object
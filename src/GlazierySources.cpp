@@ -40,6 +40,18 @@
 #include <Glaziery/src/Adapter/MouseHandler.cpp>
 #include <Glaziery/src/Adapter/Mutex.cpp>
 #include <Glaziery/src/Adapter/PlatformAdapter.cpp>
+#include <Glaziery/src/Adapter/PrimitiveBatcher.cpp>
+#include <Glaziery/src/Adapter/RendererStatistics.cpp>
+#ifdef GL_SOFTWARE_ADAPTER
+	#include <Glaziery/src/Adapter/Software/PosixMutex.cpp>
+	#include <Glaziery/src/Adapter/Software/PosixThread.cpp>
+	#include <Glaziery/src/Adapter/Software/SoftwareFont.cpp>
+	#include <Glaziery/src/Adapter/Software/SoftwareImage.cpp>
+	#include <Glaziery/src/Adapter/Software/SoftwareJoystickHandler.cpp>
+	#include <Glaziery/src/Adapter/Software/SoftwareKeyboardHandler.cpp>
+	#include <Glaziery/src/Adapter/Software/SoftwareMouseHandler.cpp>
+	#include <Glaziery/src/Adapter/Software/SoftwarePlatformAdapter.cpp>
+#endif
 #include <Glaziery/src/Adapter/Thread.cpp>
 #include <Glaziery/src/ClientArea/ClientArea.cpp>
 #include <Glaziery/src/ClientArea/FieldsArea.cpp>
@@ -49,9 +61,6 @@
 #include <Glaziery/src/ClientArea/TabbingArea.cpp>
 #include <Glaziery/src/Component/CachableComponent.cpp>
 #include <Glaziery/src/Component/Component.cpp>
-#ifdef GL_DEBUG_CPUPROFILER
-	#include <Glaziery/src/CPUProfiler.cpp>
-#endif
 #include <Glaziery/src/Desktop.cpp>
 #include <Glaziery/src/Dialog/ColorDialog.cpp>
 #include <Glaziery/src/Dialog/Dialog.cpp>
@@ -60,6 +69,7 @@
 #include <Glaziery/src/Dialog/MessageDialog.cpp>
 #include <Glaziery/src/Dialog/PasswordDialog.cpp>
 #include <Glaziery/src/Dialog/ProgressDialog.cpp>
+#include <Glaziery/src/DisplayList.cpp>
 #include <Glaziery/src/DrawingContext.cpp>
 #include <Glaziery/src/Effect/CachableComponentEffect.cpp>
 #include <Glaziery/src/Effect/ComponentEffect.cpp>
@@ -86,6 +96,7 @@
 #include <Glaziery/src/Field/Element/ImageElement.cpp>
 #include <Glaziery/src/Field/Element/TextElement.cpp>
 #include <Glaziery/src/Field/Field.cpp>
+#include <Glaziery/src/Field/FieldIndex.cpp>
 #include <Glaziery/src/Field/GroupField.cpp>
 #include <Glaziery/src/Field/ImageField.cpp>
 #include <Glaziery/src/Field/InputField.cpp>
@@ -95,6 +106,9 @@
 #include <Glaziery/src/Field/ProgressBar.cpp>
 #include <Glaziery/src/Field/RadioBox.cpp>
 #include <Glaziery/src/Field/RadioGroup.cpp>
+#include <Glaziery/src/Field/RowPositions.cpp>
+#include <Glaziery/src/Field/RowSelection.cpp>
+#include <Glaziery/src/Field/RowTextIndex.cpp>
 #include <Glaziery/src/Field/ScrollingField.cpp>
 #include <Glaziery/src/Field/Selector.cpp>
 #include <Glaziery/src/Field/Slider.cpp>
@@ -102,6 +116,7 @@
 #include <Glaziery/src/Field/TabbingField.cpp>
 #include <Glaziery/src/Field/TextField.cpp>
 #include <Glaziery/src/Field/TreeField.cpp>
+#include <Glaziery/src/FrameTimeHistogram.cpp>
 #include <Glaziery/src/GlazieryObject.cpp>
 #include <Glaziery/src/Input/CharacterEvent.cpp>
 #include <Glaziery/src/Input/DraggingSurrogate.cpp>
@@ -116,6 +131,7 @@
 #include <Glaziery/src/Input/PointerMoveEvent.cpp>
 #include <Glaziery/src/Input/PointerWheelEvent.cpp>
 #include <Glaziery/src/Input/SpecialEvent.cpp>
+#include <Glaziery/src/InvalidationTracker.cpp>
 #include <Glaziery/src/Menu/Menu.cpp>
 #include <Glaziery/src/Menu/MenuPopup.cpp>
 #include <Glaziery/src/Layout/ContainerLayoutData.cpp>
@@ -131,6 +147,9 @@
 #include <Glaziery/src/Popup/ClientAreaPopup.cpp>
 #include <Glaziery/src/Popup/Popup.cpp>
 #include <Glaziery/src/Popup/SingleFieldPopup.cpp>
+#include <Glaziery/src/Profiler.cpp>
+#include <Glaziery/src/ProfilerZone.cpp>
+#include <Glaziery/src/Region.cpp>
 #include <Glaziery/src/Runnable.cpp>
 #include <Glaziery/src/Scene.cpp>
 #include <Glaziery/src/SharedObject.cpp>
@@ -17,8 +17,10 @@
 
 // Toolbox
 #include <ToolBox/Headers.h>
-#include <Endpointvolume.h>
-#include <Mmdeviceapi.h>
+#ifdef WIN32
+	#include <Endpointvolume.h>
+	#include <Mmdeviceapi.h>
+#endif
 
 #ifdef D3D_OVERLOADS
 	// Choosing DirectX versions
@@ -44,6 +46,21 @@
 	// Windows includes
 	#include <mmsystem.h>
 	#include <shlobj.h>
+#elif defined(GL_SOFTWARE_ADAPTER)
+	// SSE2 is part of every x86-64 processor, the software adapter uses it for blending
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define GL_SOFTWARE_SSE2
+		#include <emmintrin.h>
+	#endif
+
+	// libpng to decode image files
+	#include <png.h>
+
+	// POSIX includes
+	#include <pthread.h>
+	#include <sys/utsname.h>
+	#include <time.h>
+	#include <unistd.h>
 #endif
 
 // Load localized strings
@@ -79,18 +96,34 @@
 #define GL_WHITE_A(a) GL_COLOR_A(GL_WHITE, a)
 
 
+// Caching defines
+#define GL_CACHING_SAMPLE_COUNT 4
+
+// Frame time histogram defines
+#define GL_FRAMETIMEHISTOGRAM_BUCKETS 864
+
 // Input event defines
 #define GL_KEYCODECOUNT 0x108
 
+// List field defines
+#define GL_LISTFIELD_BACKGROUNDSORTROWS 16384
+#define GL_LISTFIELD_MODELBUCKETS 64
+#define GL_LISTFIELD_SORTTHREADS 4
+#define GL_LISTFIELD_TRANSIENTROWS 256
+
+// Region defines
+#define GL_REGION_MAXIMUM_RECTANGLES 8
+
 
 namespace glaziery
 {
 	// Common class declarations
 
 	class ContainerLayoutData;
-	class CPUProfiler;
+	class DisplayList;
 	class DrawingContext;
 	class Font;
+	class FieldIndex;
 	class FieldLayoutData;
 	class GlazieryObject;
 		class DraggingSurrogate;
@@ -171,7 +204,9 @@ namespace glaziery
 		class PointerButtonEvent;
 		class PointerMoveEvent;
 		class PointerWheelEvent;
+	class FrameTimeHistogram;
 	class InputManager;
+	class InvalidationTracker;
 	class JoystickHandler;
 	class Key;
 	class KeyboardHandler;
@@ -182,8 +217,16 @@ namespace glaziery
 	class Mutex;
 	class PlatformAdapter;
 	class PointerType;
+	class PrimitiveBatcher;
 		class NoPointerType;
 		class SimplePointerType;
+	class Profiler;
+	class ProfilerZone;
+	class Region;
+	class RendererStatistics;
+	class RowPositions;
+	class RowSelection;
+	class RowTextIndex;
 	class Runnable;
 	class Skin;
 		class SimpleSkin;
@@ -218,6 +261,15 @@ namespace glaziery
 		class MacOSMutex;
 		class MacOSPlatformAdapter;
 		class MacOSThread;
+	#elif defined(GL_SOFTWARE_ADAPTER)
+		class PosixMutex;
+		class PosixThread;
+		class SoftwareFont;
+		class SoftwareImage;
+		class SoftwareJoystickHandler;
+		class SoftwareKeyboardHandler;
+		class SoftwareMouseHandler;
+		class SoftwarePlatformAdapter;
 	#else
 		#error Unknown platform
 	#endif
@@ -236,9 +288,15 @@ using namespace glaziery;
 #include <Glaziery/src/Effect/TimeCurve/AccelerationTimeCurve.h>
 #include <Glaziery/src/Effect/TimeCurve/LinearTimeCurve.h>
 #include <Glaziery/src/Effect/TimeCurve/PolynomialTimeCurve.h>
+#include <Glaziery/src/Field/FieldIndex.h>
+#include <Glaziery/src/Field/RowPositions.h>
+#include <Glaziery/src/Field/RowSelection.h>
+#include <Glaziery/src/Field/RowTextIndex.h>
+#include <Glaziery/src/FrameTimeHistogram.h>
 #include <Glaziery/src/Input/DraggingSurrogate.h>
 #include <Glaziery/src/Input/InputAttachmentSet.h>
 #include <Glaziery/src/Layout/Layouter.h>
+#include <Glaziery/src/Region.h>
 #include <Glaziery/src/SharedObject.h>
 #include <Glaziery/src/Skin/ScrollerInfo.h>
 #include <Glaziery/src/Skin/SkinData.h>
@@ -250,16 +308,16 @@ using namespace glaziery;
 #include <Glaziery/src/Listenable.h>
 	#include <Glaziery/src/Adapter/Image.h>
 #include <Glaziery/src/Adapter/Mutex.h>
+#include <Glaziery/src/Adapter/RendererStatistics.h>
 #include <Glaziery/src/Adapter/Thread.h>
-#ifdef GL_DEBUG_CPUPROFILER
-	#include <Glaziery/src/CPUProfiler.h>
-#endif
 #include <Glaziery/src/DrawingContext.h>
 #include <Glaziery/src/Input/InputManager.h>
+#include <Glaziery/src/InvalidationTracker.h>
 #include <Glaziery/src/Layout/ContainerLayoutData.h>
 #include <Glaziery/src/Layout/FieldLayoutData.h>
 #include <Glaziery/src/Layout/GridLayouter.h>
 #include <Glaziery/src/Menu/Menu.h>
+#include <Glaziery/src/Profiler.h>
 #include <Glaziery/src/Runnable.h>
 
 // Glaziery headers, group 4
@@ -302,6 +360,9 @@ using namespace glaziery;
 #include <Glaziery/src/Scene.h>
 
 // Glaziery headers, group 5
+#include <Glaziery/src/Adapter/PrimitiveBatcher.h>
+#include <Glaziery/src/DisplayList.h>
+#include <Glaziery/src/ProfilerZone.h>
 #include <Glaziery/src/Effect/DesktopEndEffect.h>
 #include <Glaziery/src/Effect/EffectFork.h>
 #include <Glaziery/src/Effect/EffectSequence.h>
@@ -372,12 +433,22 @@ using namespace glaziery;
 	#include <Glaziery/src/Adapter/MacOS/MacOSMutex.h>
 	#include <Glaziery/src/Adapter/MacOS/MacOSPlatformAdapter.h>
 	#include <Glaziery/src/Adapter/MacOS/MacOSThread.h>
+#elif defined(GL_SOFTWARE_ADAPTER)
+	#include <Glaziery/src/Adapter/Software/PosixMutex.h>
+	#include <Glaziery/src/Adapter/Software/PosixThread.h>
+	#include <Glaziery/src/Adapter/Software/SoftwareFont.h>
+	#include <Glaziery/src/Adapter/Software/SoftwareImage.h>
+	#include <Glaziery/src/Adapter/Software/SoftwareJoystickHandler.h>
+	#include <Glaziery/src/Adapter/Software/SoftwareKeyboardHandler.h>
+	#include <Glaziery/src/Adapter/Software/SoftwareMouseHandler.h>
+	#include <Glaziery/src/Adapter/Software/SoftwarePlatformAdapter.h>
 #else
 	#error Unknown platform
 #endif
 
 // Glaziery inlines
 #include <Glaziery/src/Adapter/PlatformAdapter.inl>
+#include <Glaziery/src/Adapter/RendererStatistics.inl>
 #ifdef D3D_OVERLOADS
 	#include <Glaziery/src/Adapter/DirectX/DirectXPlatformAdapter.inl>
 #endif
@@ -213,7 +213,7 @@ int InputAttachmentSet::getAttachmentKey(int eventNumber, bool positive, bool ne
 		if (factor < 0 && negative || factor > 0 && positive)
 		{
 			if (result >= 0)
-				return NULL;
+				return -1;
 			else
 				result = keyCode;
 		}
@@ -59,7 +59,7 @@ namespace glaziery
 			/**
 			 * Executes (handles) the event.
 			 */
-			virtual void execute() = NULL;
+			virtual void execute() = 0;
 
 		// Runtime class macros require their own public section.
 		public:
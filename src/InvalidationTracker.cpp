@@ -0,0 +1,456 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+const int InvalidationTracker::CAPACITY = 512;
+
+const char * InvalidationTracker::CAUSE_NAMES[CAUSE_COUNT] =
+{
+	"Other",
+	"Resize",
+	"Move",
+	"Text",
+	"Scroll",
+	"Focus"
+};
+
+const int InvalidationTracker::SLOT_COUNT = 1024;
+
+InvalidationTracker::InvalidationTracker()
+{
+	ASSERTION_COBJECT(this);
+
+	currentCause = CAUSE_OTHER;
+	enabled = false;
+	entryCount = 0;
+	font = NULL;
+	nesting = 0;
+	overlayShown = false;
+	secondStart = 0;
+
+	if ((entries = new ComponentStatistics[CAPACITY]) == NULL)
+		throw EOUTOFMEMORY;
+	if ((slots = new int[SLOT_COUNT]) == NULL)
+		throw EOUTOFMEMORY;
+
+	for (int slot = 0; slot < SLOT_COUNT; slot++)
+		slots[slot] = -1;
+}
+
+InvalidationTracker::~InvalidationTracker()
+{
+	ASSERTION_COBJECT(this);
+
+	if (entries != NULL) {delete[] entries; entries = NULL;}
+	if (slots != NULL) {delete[] slots; slots = NULL;}
+}
+
+bool InvalidationTracker::beginInvalidation(Component * component, Vector size)
+{
+	ASSERTION_COBJECT(this);
+
+	if (!enabled)
+		return false;
+
+	// Propagations to the ancestors are part of the origin's invalidation
+	if (nesting++ == 0)
+	{
+		ComponentStatistics * entry = getEntry(component);
+		if (entry != NULL)
+		{
+			Vector componentSize = component->getSize();
+			size.constrain(Vector(), componentSize);
+
+			entry->currentCauseInvalidations[currentCause]++;
+			entry->currentInvalidatedPixels += (unsigned long) size.x * (unsigned long) size.y;
+		}
+	}
+
+	return true;
+}
+
+void InvalidationTracker::drawOverlay()
+{
+	ASSERTION_COBJECT(this);
+
+	if (!overlayShown || !enabled)
+		return;
+
+	Desktop * desktop = Desktop::getInstance();
+	PlatformAdapter * adapter = desktop->getPlatformAdapter();
+	if (font == NULL)
+		font = adapter->getFont("fonts\\Arial-8-bold-white.png");
+
+	// Tint each component by its invalidations per second, saturating at 60
+
+	DrawingContext context(desktop);
+	int entryNo;
+	for (entryNo = 0; entryNo < entryCount; entryNo++)
+	{
+		ComponentStatistics & entry = entries[entryNo];
+		unsigned long invalidations = entry.getInvalidations();
+		if (entry.component == NULL || invalidations == 0 || !entry.component->isVisible())
+			continue;
+
+		unsigned int alpha = (unsigned int) (invalidations >= 60 ? 255 : 64 + invalidations * 191 / 60);
+		Vector position = entry.component->getAbsolutePosition();
+		adapter->drawRect(context, position, position + entry.component->getSize() - Vector(1, 1),
+			GL_RGBA(255, 0, 0, alpha / 3), GL_RGBA(255, 64, 64, alpha));
+	}
+
+	// List the top offenders in the bottom-left corner
+
+	const int maximumCount = 8;
+	ComponentStatistics offenders[maximumCount];
+	int count = getTopOffenders(offenders, maximumCount);
+	if (count == 0)
+		return;
+
+	Vector size(299, (count + 1) * 10 + 6);
+	DrawingContext panelContext(DrawingContext(desktop),
+		Vector(8, desktop->getSize().y - 8 - size.y), size);
+	adapter->drawRect(panelContext, Vector(), size - Vector(1, 1), GL_RGBA(0, 0, 0, 128));
+	adapter->drawMonoText(panelContext, font, Vector(4, 3), "Invalidations/s, kilo pixels/s, cause",
+		GL_WHITE_A(192), false, false);
+
+	String text;
+	for (int offenderNo = 0; offenderNo < count; offenderNo++)
+	{
+		ComponentStatistics & offender = offenders[offenderNo];
+
+		int topCause = CAUSE_OTHER;
+		for (int cause = 0; cause < CAUSE_COUNT; cause++)
+			if (offender.causeInvalidations[cause] > offender.causeInvalidations[topCause])
+				topCause = cause;
+
+		text.Format("%s: %lu, %lu, %s", (const char *) offender.name, offender.getInvalidations(),
+			offender.invalidatedPixels / 1000, CAUSE_NAMES[topCause]);
+		adapter->drawMonoText(panelContext, font, Vector(4, 13 + offenderNo * 10), text,
+			GL_WHITE_A(160), false, false);
+	}
+}
+
+void InvalidationTracker::endInvalidation()
+{
+	ASSERTION_COBJECT(this);
+
+	if (nesting > 0)
+		nesting--;
+}
+
+InvalidationTracker::Cause InvalidationTracker::getCause()
+{
+	ASSERTION_COBJECT(this);
+	return currentCause;
+}
+
+const char * InvalidationTracker::getCauseName(Cause cause)
+{
+	return CAUSE_NAMES[cause];
+}
+
+InvalidationTracker::ComponentStatistics * InvalidationTracker::getEntry(Component * component)
+{
+	ASSERTION_COBJECT(this);
+
+	int slot = getSlot(component);
+	if (slots[slot] >= 0)
+		return &entries[slots[slot]];
+
+	if (entryCount >= CAPACITY)
+		return NULL;
+
+	ComponentStatistics & entry = entries[entryCount];
+	entry = ComponentStatistics();
+	entry.component = component;
+	entry.name = component->toString();
+
+	slots[slot] = entryCount++;
+	return &entry;
+}
+
+int InvalidationTracker::getSlot(Component * component)
+{
+	ASSERTION_COBJECT(this);
+
+	// Fibonacci hashing of the address, then linear probing
+	int slot = (int) ((((size_t) component >> 4) * 2654435761UL) & (SLOT_COUNT - 1));
+	while (slots[slot] >= 0 && entries[slots[slot]].component != component)
+		slot = (slot + 1) & (SLOT_COUNT - 1);
+
+	return slot;
+}
+
+int InvalidationTracker::getTopOffenders(ComponentStatistics * offenders, int maximumCount)
+{
+	ASSERTION_COBJECT(this);
+
+	// Insert each active component into the sorted offenders, if it invalidated enough pixels
+	int count = 0;
+	for (int entryNo = 0; entryNo < entryCount; entryNo++)
+	{
+		ComponentStatistics & entry = entries[entryNo];
+		if (entry.getInvalidations() == 0)
+			continue;
+
+		int position = count;
+		while (position > 0 && offenders[position - 1].invalidatedPixels < entry.invalidatedPixels)
+			position--;
+		if (position >= maximumCount)
+			continue;
+
+		if (count < maximumCount)
+			count++;
+		for (int i = count - 1; i > position; i--)
+			offenders[i] = offenders[i - 1];
+		offenders[position] = entry;
+	}
+
+	return count;
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(InvalidationTracker, CObject);
+#endif
+
+bool InvalidationTracker::isEnabled()
+{
+	ASSERTION_COBJECT(this);
+	return enabled;
+}
+
+bool InvalidationTracker::isOverlayShown()
+{
+	ASSERTION_COBJECT(this);
+	return overlayShown;
+}
+
+void InvalidationTracker::logTopOffenders(int maximumCount)
+{
+	ASSERTION_COBJECT(this);
+
+	if (maximumCount <= 0)
+		return;
+
+	ComponentStatistics * offenders;
+	if ((offenders = new ComponentStatistics[maximumCount]) == NULL)
+		throw EOUTOFMEMORY;
+
+	int count = getTopOffenders(offenders, maximumCount);
+	LOGPRINTF1(LOG_INFO, "Top %d invalidating components of the last second:", count);
+
+	String text;
+	for (int offenderNo = 0; offenderNo < count; offenderNo++)
+	{
+		ComponentStatistics & offender = offenders[offenderNo];
+		text.Format("%s: %lu invalidations (", (const char *) offender.name, offender.getInvalidations());
+
+		bool first = true;
+		for (int cause = 0; cause < CAUSE_COUNT; cause++)
+			if (offender.causeInvalidations[cause] > 0)
+			{
+				String causeText;
+				causeText.Format("%s%s %lu", first ? "" : ", ", CAUSE_NAMES[cause],
+					offender.causeInvalidations[cause]);
+				text += causeText;
+				first = false;
+			}
+
+		String pixelsText;
+		pixelsText.Format("), %lu pixels invalidated, %lu pixels redrawn",
+			offender.invalidatedPixels, offender.redrawnPixels);
+		text += pixelsText;
+
+		LOGPRINTF1(LOG_INFO, "%s", (const char *) text);
+	}
+
+	delete[] offenders;
+}
+
+void InvalidationTracker::onComponentDestroyed(Component * component)
+{
+	ASSERTION_COBJECT(this);
+
+	if (!enabled)
+		return;
+
+	// Keep the statistics, they may be one of the offenders
+	int slot = getSlot(component);
+	if (slots[slot] >= 0)
+		entries[slots[slot]].component = NULL;
+}
+
+void InvalidationTracker::onFrame()
+{
+	ASSERTION_COBJECT(this);
+
+	if (!enabled)
+		return;
+
+	unsigned long now = Desktop::getInstance()->getPlatformAdapter()->getTime();
+	if (now - secondStart >= 1000)
+	{
+		rollOver();
+		secondStart = now;
+	}
+}
+
+void InvalidationTracker::onRedraw(Component * component, unsigned long pixels)
+{
+	ASSERTION_COBJECT(this);
+
+	if (!enabled)
+		return;
+
+	ComponentStatistics * entry = getEntry(component);
+	if (entry != NULL)
+		entry->currentRedrawnPixels += pixels;
+}
+
+void InvalidationTracker::rollOver()
+{
+	ASSERTION_COBJECT(this);
+
+	int keptCount = 0;
+	int entryNo;
+	for (entryNo = 0; entryNo < entryCount; entryNo++)
+	{
+		ComponentStatistics & entry = entries[entryNo];
+		for (int cause = 0; cause < CAUSE_COUNT; cause++)
+		{
+			entry.causeInvalidations[cause] = entry.currentCauseInvalidations[cause];
+			entry.currentCauseInvalidations[cause] = 0;
+		}
+		entry.invalidatedPixels = entry.currentInvalidatedPixels;
+		entry.currentInvalidatedPixels = 0;
+		entry.redrawnPixels = entry.currentRedrawnPixels;
+		entry.currentRedrawnPixels = 0;
+
+		if (entry.isActive())
+		{
+			if (keptCount != entryNo)
+				entries[keptCount] = entry;
+			keptCount++;
+		}
+	}
+
+	for (entryNo = keptCount; entryNo < entryCount; entryNo++)
+		entries[entryNo] = ComponentStatistics();
+	entryCount = keptCount;
+
+	// Rebuild the hash table for the components still existing
+	int slot;
+	for (slot = 0; slot < SLOT_COUNT; slot++)
+		slots[slot] = -1;
+	for (entryNo = 0; entryNo < entryCount; entryNo++)
+		if (entries[entryNo].component != NULL)
+			slots[getSlot(entries[entryNo].component)] = entryNo;
+}
+
+InvalidationTracker::Cause InvalidationTracker::setCause(Cause cause)
+{
+	ASSERTION_COBJECT(this);
+
+	Cause previousCause = currentCause;
+	currentCause = cause;
+	return previousCause;
+}
+
+void InvalidationTracker::setEnabled(bool enabled)
+{
+	ASSERTION_COBJECT(this);
+
+	if (this->enabled == enabled)
+		return;
+
+	this->enabled = enabled;
+	nesting = 0;
+
+	// Start with empty statistics
+	for (int entryNo = 0; entryNo < entryCount; entryNo++)
+		entries[entryNo] = ComponentStatistics();
+	entryCount = 0;
+	for (int slot = 0; slot < SLOT_COUNT; slot++)
+		slots[slot] = -1;
+
+	Desktop * desktop = Desktop::getInstance();
+	secondStart = desktop != NULL ? desktop->getPlatformAdapter()->getTime() : 0;
+}
+
+void InvalidationTracker::setOverlayShown(bool overlayShown)
+{
+	ASSERTION_COBJECT(this);
+
+	this->overlayShown = overlayShown;
+	if (overlayShown)
+		setEnabled(true);
+}
+
+
+InvalidationTracker::CauseScope::CauseScope(Cause cause)
+{
+	previousCause = Desktop::getInstance()->getInvalidationTracker().setCause(cause);
+}
+
+InvalidationTracker::CauseScope::~CauseScope()
+{
+	Desktop::getInstance()->getInvalidationTracker().setCause(previousCause);
+}
+
+
+InvalidationTracker::InvalidationScope::InvalidationScope(Component * component, Vector size)
+{
+	begun = Desktop::getInstance()->getInvalidationTracker().beginInvalidation(component, size);
+}
+
+InvalidationTracker::InvalidationScope::~InvalidationScope()
+{
+	if (begun)
+		Desktop::getInstance()->getInvalidationTracker().endInvalidation();
+}
+
+
+InvalidationTracker::ComponentStatistics::ComponentStatistics()
+{
+	for (int cause = 0; cause < CAUSE_COUNT; cause++)
+	{
+		causeInvalidations[cause] = 0;
+		currentCauseInvalidations[cause] = 0;
+	}
+
+	component = NULL;
+	currentInvalidatedPixels = 0;
+	currentRedrawnPixels = 0;
+	invalidatedPixels = 0;
+	redrawnPixels = 0;
+}
+
+unsigned long InvalidationTracker::ComponentStatistics::getInvalidations()
+{
+	unsigned long invalidations = 0;
+	for (int cause = 0; cause < CAUSE_COUNT; cause++)
+		invalidations += causeInvalidations[cause];
+
+	return invalidations;
+}
+
+bool InvalidationTracker::ComponentStatistics::isActive()
+{
+	if (invalidatedPixels > 0 || redrawnPixels > 0 || currentInvalidatedPixels > 0
+		|| currentRedrawnPixels > 0)
+		return true;
+
+	for (int cause = 0; cause < CAUSE_COUNT; cause++)
+		if (causeInvalidations[cause] > 0 || currentCauseInvalidations[cause] > 0)
+			return true;
+
+	return false;
+}
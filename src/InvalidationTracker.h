@@ -0,0 +1,428 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_INVALIDATIONTRACKER_H
+#define __GLAZIERY_INVALIDATIONTRACKER_H
+
+
+/**
+ * Attributes the invalidations of the remainder of the current block to a cause.
+ * @param cause The cause, e.g. CAUSE_RESIZE.
+ * @see InvalidationTracker::Cause
+ */
+#define GLAZIERY_INVALIDATIONCAUSE(cause) \
+	InvalidationTracker::CauseScope invalidationCauseScope(InvalidationTracker::cause);
+
+/**
+ * Tracks the invalidations of the remainder of the current block as an invalidation
+ * of a component. Used by the implementations of Component::invalidateArea().
+ * @param component The component invalidated.
+ * @param size The size of the area invalidated.
+ * @see InvalidationTracker::InvalidationScope
+ */
+#define GLAZIERY_INVALIDATIONSCOPE(component, size) \
+	InvalidationTracker::InvalidationScope invalidationScope(component, size);
+
+
+namespace glaziery
+{
+	/**
+	 * The invalidation tracker counts, per component and second, how often it is
+	 * invalidated, how many pixels it invalidates, and how many pixels are redrawn
+	 * because of it. Invalidations are attributed to the component they originate from
+	 * (not to the ancestors they propagate to) and to their cause (resizing, moving,
+	 * text changes, scrolling, focus changes, or others). The top offenders are available
+	 * using getTopOffenders() and logTopOffenders(), and as a heat-map overlay that tints
+	 * each component by its invalidation rate.<br>
+	 *
+	 * The tracker is available in all builds, but turned off by default. When it is off,
+	 * an invalidation costs a single check. Components and fields record their causes
+	 * using GLAZIERY_INVALIDATIONCAUSE. The tracker must be used from the main thread only.
+	 * @see Desktop::getInvalidationTracker()
+	 * @see Component::invalidateArea()
+	 */
+	#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+		class InvalidationTracker : public CObject
+	#else
+		class InvalidationTracker
+	#endif
+	{
+		public:
+
+			/**
+			 * The causes of invalidations.
+			 */
+			enum Cause
+			{
+				/**
+				 * Any other cause, e.g. an explicit invalidate() of the application.
+				 */
+				CAUSE_OTHER = 0,
+
+				/**
+				 * Resizing a component.
+				 */
+				CAUSE_RESIZE,
+
+				/**
+				 * Moving a component.
+				 */
+				CAUSE_MOVE,
+
+				/**
+				 * Changing a text, e.g. of a field or a window title.
+				 */
+				CAUSE_TEXT,
+
+				/**
+				 * Scrolling a scrolling area or field.
+				 */
+				CAUSE_SCROLL,
+
+				/**
+				 * A component gaining or losing the focus.
+				 */
+				CAUSE_FOCUS,
+
+				/**
+				 * The total number of different causes.
+				 */
+				CAUSE_COUNT
+			};
+
+			/**
+			 * Attributes all invalidations to a cause while it exists,
+			 * restoring the previous cause on destruction.
+			 * Use GLAZIERY_INVALIDATIONCAUSE to create one.
+			 */
+			class CauseScope
+			{
+				protected:
+
+					/**
+					 * The cause before this scope.
+					 */
+					Cause previousCause;
+
+				public:
+
+					/**
+					 * Creates a new cause scope.
+					 * @param cause The cause of the invalidations within the scope.
+					 */
+					CauseScope(Cause cause);
+
+					/**
+					 * Destroys the cause scope and restores the previous cause.
+					 */
+					~CauseScope();
+			};
+
+			/**
+			 * Begins an invalidation of a component on creation, and ends it on destruction.
+			 * The invalidations propagated to the ancestors within the scope are counted
+			 * for the component, not for the ancestors.
+			 * Use GLAZIERY_INVALIDATIONSCOPE to create one.
+			 */
+			class InvalidationScope
+			{
+				protected:
+
+					/**
+					 * Whether the invalidation has begun, i.e. must be ended on destruction.
+					 */
+					bool begun;
+
+				public:
+
+					/**
+					 * Creates a new invalidation scope.
+					 * @param component The component invalidated.
+					 * @param size The size of the area invalidated.
+					 */
+					InvalidationScope(Component * component, Vector size);
+
+					/**
+					 * Destroys the invalidation scope and ends the invalidation.
+					 */
+					~InvalidationScope();
+			};
+
+			/**
+			 * The invalidation statistics of a component.
+			 * The counters cover the last complete second, the current ones the running second.
+			 */
+			class ComponentStatistics
+			{
+				public:
+
+					/**
+					 * The invalidations per cause in the last complete second.
+					 */
+					unsigned long causeInvalidations[CAUSE_COUNT];
+
+					/**
+					 * The component, or NULL if it has been destroyed meanwhile.
+					 */
+					Component * component;
+
+					/**
+					 * The invalidations per cause in the running second.
+					 */
+					unsigned long currentCauseInvalidations[CAUSE_COUNT];
+
+					/**
+					 * The pixels invalidated in the running second.
+					 */
+					unsigned long currentInvalidatedPixels;
+
+					/**
+					 * The pixels redrawn in the running second.
+					 */
+					unsigned long currentRedrawnPixels;
+
+					/**
+					 * The pixels invalidated in the last complete second.
+					 */
+					unsigned long invalidatedPixels;
+
+					/**
+					 * The name of the component (see Component::toString()).
+					 */
+					String name;
+
+					/**
+					 * The pixels redrawn in the last complete second.
+					 */
+					unsigned long redrawnPixels;
+
+					/**
+					 * Creates new, empty component statistics.
+					 */
+					ComponentStatistics();
+
+					/**
+					 * Returns the invalidations in the last complete second, of all causes.
+					 * @return The invalidations per second.
+					 */
+					unsigned long getInvalidations();
+
+					/**
+					 * Returns whether any invalidation or redraw has been counted, in the last
+					 * complete or the running second.
+					 * @return Whether any activity has been counted.
+					 */
+					bool isActive();
+			};
+
+		protected:
+
+			/**
+			 * The maximum number of components tracked at the same time.
+			 * Further components are not tracked until the next second.
+			 */
+			static const int CAPACITY;
+
+			/**
+			 * The names of the causes, e.g. for logging.
+			 */
+			static const char * CAUSE_NAMES[CAUSE_COUNT];
+
+			/**
+			 * The number of slots of the hash table (a power of two, twice the capacity).
+			 */
+			static const int SLOT_COUNT;
+
+			/**
+			 * The cause of the current invalidations.
+			 */
+			Cause currentCause;
+
+			/**
+			 * Whether the tracker is turned on.
+			 */
+			bool enabled;
+
+			/**
+			 * The statistics of the tracked components (CAPACITY entries).
+			 */
+			ComponentStatistics * entries;
+
+			/**
+			 * The number of used entries.
+			 */
+			int entryCount;
+
+			/**
+			 * The font used for rendering the overlay.
+			 */
+			Font * font;
+
+			/**
+			 * The nesting depth of invalidations, to count propagated ones for their origin only.
+			 */
+			int nesting;
+
+			/**
+			 * Whether the heat-map overlay is shown.
+			 */
+			bool overlayShown;
+
+			/**
+			 * The start time of the running second in milli seconds.
+			 */
+			unsigned long secondStart;
+
+			/**
+			 * The hash table of entry indexes by component (SLOT_COUNT slots, -1 if free).
+			 */
+			int * slots;
+
+			/**
+			 * Returns the statistics of a component, adding them if not tracked yet.
+			 * @param component The component.
+			 * @return The statistics, or NULL if the tracker is full.
+			 */
+			ComponentStatistics * getEntry(Component * component);
+
+			/**
+			 * Returns the hash table slot of a component.
+			 * @param component The component.
+			 * @return The slot of the component, or the free slot to be used for it.
+			 */
+			int getSlot(Component * component);
+
+			/**
+			 * Completes the running second, and drops the statistics of all
+			 * components without invalidations in the completed second.
+			 */
+			void rollOver();
+
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(InvalidationTracker);
+			#endif
+
+		public:
+
+			/**
+			 * Creates a new invalidation tracker. It is turned off initially.
+			 */
+			InvalidationTracker();
+
+			/**
+			 * Destroys the invalidation tracker.
+			 */
+			~InvalidationTracker();
+
+			/**
+			 * Begins an invalidation of a component. Called by InvalidationScope.
+			 * Counts the invalidation, unless it has been propagated from a child.
+			 * @param component The component invalidated.
+			 * @param size The size of the area invalidated.
+			 * @return Whether the invalidation has begun, i.e. whether endInvalidation()
+			 * must be called.
+			 */
+			bool beginInvalidation(Component * component, Vector size);
+
+			/**
+			 * Renders the heat-map overlay on the desktop, if it is shown.
+			 */
+			void drawOverlay();
+
+			/**
+			 * Ends an invalidation begun by beginInvalidation().
+			 */
+			void endInvalidation();
+
+			/**
+			 * Returns the current cause of invalidations.
+			 * @return The cause.
+			 */
+			Cause getCause();
+
+			/**
+			 * Returns the name of a cause.
+			 * @param cause The cause.
+			 * @return The name.
+			 */
+			static const char * getCauseName(Cause cause);
+
+			/**
+			 * Returns the components that invalidated the most pixels in the last complete second,
+			 * in descending order.
+			 * @param offenders The array to receive the statistics.
+			 * @param maximumCount The maximum number of statistics to be returned (the array size).
+			 * @return The number of statistics returned.
+			 */
+			int getTopOffenders(ComponentStatistics * offenders, int maximumCount);
+
+			/**
+			 * Returns whether the tracker is turned on.
+			 * @return Whether the tracker is turned on.
+			 */
+			bool isEnabled();
+
+			/**
+			 * Returns whether the heat-map overlay is shown.
+			 * @return Whether the overlay is shown.
+			 */
+			bool isOverlayShown();
+
+			/**
+			 * Writes the top offenders of the last complete second to the log.
+			 * @param maximumCount The maximum number of components to be logged.
+			 */
+			void logTopOffenders(int maximumCount = 10);
+
+			/**
+			 * Notifies the tracker that a component is being destroyed.
+			 * Its statistics are kept until they are inactive, but without the component.
+			 * @param component The component.
+			 */
+			void onComponentDestroyed(Component * component);
+
+			/**
+			 * Notifies the tracker about the end of a frame. Called by the Desktop.
+			 */
+			void onFrame();
+
+			/**
+			 * Notifies the tracker that a component has redrawn its content.
+			 * Called by CachableComponent::draw().
+			 * @param component The component.
+			 * @param pixels The number of pixels redrawn.
+			 */
+			void onRedraw(Component * component, unsigned long pixels);
+
+			/**
+			 * Sets the current cause of invalidations.
+			 * @param cause The cause.
+			 * @return The previous cause.
+			 * @see GLAZIERY_INVALIDATIONCAUSE
+			 */
+			Cause setCause(Cause cause);
+
+			/**
+			 * Turns the tracker on or off. Turning it off discards the statistics.
+			 * @param enabled Whether the tracker is turned on.
+			 */
+			void setEnabled(bool enabled);
+
+			/**
+			 * Sets whether the heat-map overlay is shown. Showing the overlay turns on the tracker.
+			 * @param overlayShown Whether the overlay is shown.
+			 */
+			void setOverlayShown(bool overlayShown);
+	};
+}
+
+
+#endif
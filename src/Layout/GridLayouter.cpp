@@ -56,6 +56,7 @@ bool GridLayouter::isLayouting(Field * field)
 bool GridLayouter::layout(FieldsArea * fieldsArea, bool resizeArea)
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_PROFILERZONE_D("GridLayouter::layout", fieldsArea->toString())
 
 	ContainerLayoutData * containerLayoutData = fieldsArea->getLayoutData();
 
@@ -81,6 +82,7 @@ bool GridLayouter::layout(FieldsArea * fieldsArea, bool resizeArea)
 bool GridLayouter::layout(GroupField * groupField, bool resizeGroupField)
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_PROFILERZONE_D("GridLayouter::layout", groupField->toString())
 
 	ContainerLayoutData * containerLayoutData = groupField->getGroupLayoutData();
 
@@ -881,8 +883,6 @@ bool GridLayouter::layoutFields(const ArrayList<Field> & fields, Component * con
 
 		Vector position = field->getPosition();
 		Vector size = field->getSize();
-		Vector minimumSize = field->getMinimumSize();
-		Vector maximumSize = field->getMaximumSize();
 
 		int columnSpan = fieldLayoutData->getColumnSpan();
 		if (oneRowOnly && columnSpan < 1)
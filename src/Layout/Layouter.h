@@ -54,7 +54,7 @@ namespace glaziery
 			 * Same holds for the groups in the fields area, containing groups and fields themselves.
 			 * @return Whether any component was moved or resized.
 			 */
-			virtual bool layout(FieldsArea * fieldsArea, bool resizeArea) = NULL;
+			virtual bool layout(FieldsArea * fieldsArea, bool resizeArea) = 0;
 
 			/**
 			 * Layouts the fields of a group field and resizes the group field.
@@ -68,7 +68,7 @@ namespace glaziery
 			 * Same holds for the groups in the group field, containing groups and fields themselves.
 			 * @return Whether any component was moved or resized.
 			 */
-			virtual bool layout(GroupField * groupField, bool resizeGroupField) = NULL;
+			virtual bool layout(GroupField * groupField, bool resizeGroupField) = 0;
 	};
 }
 
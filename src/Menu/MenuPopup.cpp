@@ -40,7 +40,10 @@ void MenuPopup::destroy()
 void MenuPopup::drawContent(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
-	Desktop::getInstance()->getSkin()->drawMenuPopup(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawMenuPopup")
+		Desktop::getInstance()->getSkin()->drawMenuPopup(context, this);
+	}
 }
 
 Menu * MenuPopup::getMenu()
@@ -15,6 +15,15 @@ void NoPointerType::draw(DrawingContext & context, Vector position)
 	ASSERTION_COBJECT(this);
 }
 
+bool NoPointerType::getDrawingArea(Vector position, Vector & areaPosition, Vector & areaSize)
+{
+	ASSERTION_COBJECT(this);
+
+	areaPosition = position;
+	areaSize = Vector();
+	return true;
+}
+
 #if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
 	IMPLEMENT_DYNAMIC(NoPointerType, PointerType);
 #endif
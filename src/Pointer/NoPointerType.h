@@ -33,6 +33,16 @@ namespace glaziery
 			 * @param position The position to draw the pointer at.
 			 */
 			virtual void draw(DrawingContext & context, Vector position);
+
+			/**
+			 * Determines the screen area covered when drawing the pointer at a given position.
+			 * Since nothing is drawn, the area is always empty.
+			 * @param position The position the pointer is drawn at.
+			 * @param areaPosition Set to the top-left position of the covered area.
+			 * @param areaSize Set to the size of the covered area.
+			 * @return Whether the area is known (always true).
+			 */
+			virtual bool getDrawingArea(Vector position, Vector & areaPosition, Vector & areaSize);
 	};
 }
 
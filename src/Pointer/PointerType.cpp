@@ -15,6 +15,12 @@ PointerType::~PointerType()
 	ASSERTION_COBJECT(this);
 }
 
+bool PointerType::getDrawingArea(Vector position, Vector & areaPosition, Vector & areaSize)
+{
+	ASSERTION_COBJECT(this);
+	return false;
+}
+
 #if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
 	IMPLEMENT_DYNAMIC(PointerType, CObject);
 #endif
@@ -44,7 +44,21 @@ namespace glaziery
 			 * rectangle for the drawing operation.
 			 * @param position The position to draw the pointer at.
 			 */
-			virtual void draw(DrawingContext & context, Vector position) = NULL;
+			virtual void draw(DrawingContext & context, Vector position) = 0;
+
+			/**
+			 * Determines the screen area covered when drawing the pointer at a given position.
+			 * The Desktop uses this area to redraw only the old and new pointer areas
+			 * when the pointer moves, if damage tracking is enabled.
+			 * The default implementation returns false (the area is unknown),
+			 * so that any pointer change redraws the entire desktop.
+			 * @param position The position the pointer is drawn at.
+			 * @param areaPosition Set to the top-left position of the covered area.
+			 * @param areaSize Set to the size of the covered area.
+			 * @return Whether the area is known.
+			 * @see Desktop::setDamageTracking()
+			 */
+			virtual bool getDrawingArea(Vector position, Vector & areaPosition, Vector & areaSize);
 
 			/**
 			 * Handles the event that the pointer has moved, e.g. by creating an effect.
@@ -26,6 +26,15 @@ void SimplePointerType::draw(DrawingContext & context, Vector position)
 	adapter->drawImage(context, image, position - hotSpot);
 }
 
+bool SimplePointerType::getDrawingArea(Vector position, Vector & areaPosition, Vector & areaSize)
+{
+	ASSERTION_COBJECT(this);
+
+	areaPosition = position - hotSpot;
+	areaSize = image->getSize();
+	return true;
+}
+
 Vector SimplePointerType::getHotSpot()
 {
 	ASSERTION_COBJECT(this);
@@ -60,6 +60,16 @@ namespace glaziery
 			 */
 			virtual void draw(DrawingContext & context, Vector position);
 
+			/**
+			 * Determines the screen area covered when drawing the pointer at a given position.
+			 * This is the pointer image, translated negatively by the hot spot.
+			 * @param position The position the pointer is drawn at.
+			 * @param areaPosition Set to the top-left position of the covered area.
+			 * @param areaSize Set to the size of the covered area.
+			 * @return Whether the area is known (always true).
+			 */
+			virtual bool getDrawingArea(Vector position, Vector & areaPosition, Vector & areaSize);
+
 			/**
 			 * Returns the hot spot is the position within the pointer
 			 * image that corresponds to the pointer position. The pointer
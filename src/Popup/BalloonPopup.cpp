@@ -24,7 +24,10 @@ BalloonPopup::BalloonPopup()
 void BalloonPopup::drawContent(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
-	Desktop::getInstance()->getSkin()->drawBalloonPopup(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawBalloonPopup")
+		Desktop::getInstance()->getSkin()->drawBalloonPopup(context, this);
+	}
 }
 
 BalloonPopup::ArrowPosition BalloonPopup::getArrowPosition()
@@ -49,9 +49,15 @@ void ClientAreaPopup::drawContent(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
 
-	Desktop::getInstance()->getSkin()->drawClientAreaPopup(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawClientAreaPopup")
+		Desktop::getInstance()->getSkin()->drawClientAreaPopup(context, this);
+	}
 	if (clientArea != NULL)
-		clientArea->draw(DrawingContext(context, clientArea));
+	{
+		DrawingContext clientAreaContext(context, clientArea);
+		clientArea->draw(clientAreaContext);
+	}
 }
 
 ClientArea * ClientAreaPopup::getContentArea()
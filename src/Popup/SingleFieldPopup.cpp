@@ -56,9 +56,15 @@ void SingleFieldPopup::drawContent(DrawingContext & context)
 {
 	ASSERTION_COBJECT(this);
 
-	Desktop::getInstance()->getSkin()->drawSingleFieldPopup(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawSingleFieldPopup")
+		Desktop::getInstance()->getSkin()->drawSingleFieldPopup(context, this);
+	}
 	if (contentField != NULL && contentField->isVisible())
-		contentField->draw(DrawingContext(context, contentField));
+	{
+		DrawingContext fieldContext(context, contentField);
+		contentField->drawRecorded(fieldContext);
+	}
 }
 
 Field * SingleFieldPopup::getContentField()
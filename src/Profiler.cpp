@@ -0,0 +1,934 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+unsigned long Profiler::allocatedBytes = 0;
+
+unsigned long Profiler::allocationCount = 0;
+
+#ifdef WIN32
+	DWORD Profiler::mainThreadId;
+#else
+	pthread_t Profiler::mainThreadId;
+#endif
+
+bool Profiler::mainThreadKnown = false;
+
+const int Profiler::DEFAULT_CAPTURE_CAPACITY = 262144;
+
+const int Profiler::MAX_ALLOCATION_ZONES = 64;
+
+const int Profiler::MAX_DEPTH = 64;
+
+const int Profiler::MAX_FRAME_ZONES = 16;
+
+const int Profiler::OVERLAY_WIDTH = 199;
+
+const char * Profiler::PHASE_NAMES[PHASE_COUNT] =
+{
+	"Input",
+	"Events",
+	"Deferrals",
+	"Effects",
+	"Draw",
+	"Present",
+	"Idle",
+	"Other"
+};
+
+const int Profiler::RECENT_FRAME_COUNT = 600;
+
+Profiler::Profiler()
+	: recentFrameHistogram(RECENT_FRAME_COUNT)
+{
+	ASSERTION_COBJECT(this);
+
+	allocatingFrameCount = 0;
+	allocationZoneCount = 0;
+	captureCapacity = 0;
+	capturedZones = NULL;
+	capturedZoneCount = 0;
+	captureOverflowed = false;
+	capturing = false;
+	currentFrameZoneCount = 0;
+	currentPhase = PHASE_OTHER;
+	for (int phase = 0; phase < PHASE_COUNT; phase++)
+	{
+		currentPhaseAllocatedBytes[phase] = 0;
+		currentPhaseAllocations[phase] = 0;
+		currentPhaseTimes[phase] = 0.0;
+		phaseAllocatedBytes[phase] = 0;
+		phaseAllocations[phase] = 0;
+	}
+	depth = 0;
+	enabled = false;
+	enabledRequested = false;
+	font = NULL;
+	frameBudget = 1000000.0 / 60.0;
+	frameStarted = false;
+	fpsFrameCount = 0;
+	fpsSampleStart = 0.0;
+	framesPerSecond = 0;
+	frameStart = 0.0;
+	lastFrameAllocatedBytes = 0;
+	lastFrameAllocations = 0;
+	lastFrameDuration = 0.0;
+	lastFrameZoneCount = 0;
+
+	// The profiler is created by the desktop, i.e. on the main thread
+	#ifdef WIN32
+		mainThreadId = GetCurrentThreadId();
+	#else
+		mainThreadId = pthread_self();
+	#endif
+	mainThreadKnown = true;
+
+	overlayShown = false;
+	overBudgetFrameCount = 0;
+	phaseStart = 0.0;
+	phaseStartAllocatedBytes = 0;
+	phaseStartAllocations = 0;
+	rendererStatisticsShown = false;
+
+	if ((allocationZoneBytes = new unsigned long[MAX_ALLOCATION_ZONES]) == NULL)
+		throw EOUTOFMEMORY;
+	if ((allocationZoneCounts = new unsigned long[MAX_ALLOCATION_ZONES]) == NULL)
+		throw EOUTOFMEMORY;
+	if ((allocationZoneNames = new const char *[MAX_ALLOCATION_ZONES]) == NULL)
+		throw EOUTOFMEMORY;
+	if ((currentFrameZoneNames = new const char *[MAX_FRAME_ZONES]) == NULL)
+		throw EOUTOFMEMORY;
+	if ((currentFrameZoneTimes = new double[MAX_FRAME_ZONES]) == NULL)
+		throw EOUTOFMEMORY;
+	if ((lastFrameZoneNames = new const char *[MAX_FRAME_ZONES]) == NULL)
+		throw EOUTOFMEMORY;
+	if ((lastFrameZoneTimes = new double[MAX_FRAME_ZONES]) == NULL)
+		throw EOUTOFMEMORY;
+	if ((openZones = new Zone[MAX_DEPTH]) == NULL)
+		throw EOUTOFMEMORY;
+}
+
+Profiler::~Profiler()
+{
+	ASSERTION_COBJECT(this);
+
+	if (allocationZoneBytes != NULL) {delete[] allocationZoneBytes; allocationZoneBytes = NULL;}
+	if (allocationZoneCounts != NULL) {delete[] allocationZoneCounts; allocationZoneCounts = NULL;}
+	if (allocationZoneNames != NULL) {delete[] allocationZoneNames; allocationZoneNames = NULL;}
+	if (capturedZones != NULL) {delete[] capturedZones; capturedZones = NULL;}
+	if (currentFrameZoneNames != NULL) {delete[] currentFrameZoneNames; currentFrameZoneNames = NULL;}
+	if (currentFrameZoneTimes != NULL) {delete[] currentFrameZoneTimes; currentFrameZoneTimes = NULL;}
+	if (lastFrameZoneNames != NULL) {delete[] lastFrameZoneNames; lastFrameZoneNames = NULL;}
+	if (lastFrameZoneTimes != NULL) {delete[] lastFrameZoneTimes; lastFrameZoneTimes = NULL;}
+	if (openZones != NULL) {delete[] openZones; openZones = NULL;}
+}
+
+bool Profiler::beginZone(const char * name, const char * detail)
+{
+	ASSERTION_COBJECT(this);
+
+	if (!enabled)
+		return false;
+
+	if (depth < MAX_DEPTH)
+	{
+		Zone & zone = openZones[depth];
+		zone.name = name;
+		if (capturing)
+			zone.detail = detail != NULL ? detail : "";
+		zone.allocatedBytes = zone.allocatedBytesAtStart = allocatedBytes;
+		zone.allocations = zone.allocationsAtStart = allocationCount;
+		zone.start = getTime();
+	}
+
+	depth++;
+	return true;
+}
+
+void Profiler::attributeAllocations(const char * name, unsigned long allocations,
+	unsigned long allocatedBytes)
+{
+	ASSERTION_COBJECT(this);
+
+	int zoneNo;
+	for (zoneNo = 0; zoneNo < allocationZoneCount; zoneNo++)
+		if (allocationZoneNames[zoneNo] == name)
+			break;
+
+	if (zoneNo >= allocationZoneCount)
+	{
+		if (allocationZoneCount >= MAX_ALLOCATION_ZONES)
+			return;
+
+		allocationZoneNames[allocationZoneCount] = name;
+		allocationZoneCounts[allocationZoneCount] = 0;
+		allocationZoneBytes[allocationZoneCount++] = 0;
+	}
+
+	allocationZoneCounts[zoneNo] += allocations;
+	allocationZoneBytes[zoneNo] += allocatedBytes;
+}
+
+void Profiler::captureZone(const Zone & zone, double duration)
+{
+	ASSERTION_COBJECT(this);
+
+	if (capturedZoneCount >= captureCapacity)
+	{
+		captureOverflowed = true;
+		return;
+	}
+
+	Zone & capturedZone = capturedZones[capturedZoneCount++];
+	capturedZone.allocatedBytes = zone.allocatedBytes;
+	capturedZone.allocations = zone.allocations;
+	capturedZone.name = zone.name;
+	capturedZone.detail = zone.detail;
+	capturedZone.start = zone.start;
+	capturedZone.duration = duration;
+}
+
+void Profiler::completePhase(double now)
+{
+	ASSERTION_COBJECT(this);
+
+	currentPhaseTimes[currentPhase] += now - phaseStart;
+	currentPhaseAllocations[currentPhase] += allocationCount - phaseStartAllocations;
+	currentPhaseAllocatedBytes[currentPhase] += allocatedBytes - phaseStartAllocatedBytes;
+
+	phaseStart = now;
+	phaseStartAllocations = allocationCount;
+	phaseStartAllocatedBytes = allocatedBytes;
+}
+
+void Profiler::countAllocation(size_t size)
+{
+	// The counters are not synchronized, other threads must not touch them
+	if (!isMainThread())
+		return;
+
+	allocationCount++;
+	allocatedBytes += (unsigned long) size;
+}
+
+void Profiler::drawOverlay()
+{
+	ASSERTION_COBJECT(this);
+
+	if (!overlayShown || !enabled)
+		return;
+
+	Desktop * desktop = Desktop::getInstance();
+	PlatformAdapter * adapter = desktop->getPlatformAdapter();
+	if (font == NULL)
+		font = adapter->getFont("fonts\\Arial-8-bold-white.png");
+
+	// Render overlay background
+
+	int height = getOverlayHeight();
+	DrawingContext context(DrawingContext(desktop), getOverlayPosition(), Vector(OVERLAY_WIDTH, height));
+	adapter->drawRect(context, Vector(), context.getClippingSize() - Vector(1, 1),
+		GL_RGBA(0, 0, 0, 96));
+
+	// Render frames per second and the last frame's time
+
+	String text;
+	text.Format("%ld FPS", framesPerSecond);
+	adapter->drawMonoText(context, font, Vector(4, 3), text, GL_WHITE_A(192), false, false);
+
+	text.Format("%.1f ms", lastFrameDuration / 1000.0);
+	int textWidth = font->getWidth(text);
+	adapter->drawMonoText(context, font, Vector(OVERLAY_WIDTH - textWidth - 3, 3),
+		text, GL_WHITE_A(192), false, false);
+
+	// Render the percentiles of the recent frames and the frames over budget
+
+	text.Format("p99 %.1f  max %.1f ms", recentFrameHistogram.getPercentile(99.0) / 1000.0,
+		recentFrameHistogram.getMaximum() / 1000.0);
+	adapter->drawMonoText(context, font, Vector(4, 13), text, GL_WHITE_A(192), false, false);
+
+	text.Format("%lu over", overBudgetFrameCount);
+	textWidth = font->getWidth(text);
+	adapter->drawMonoText(context, font, Vector(OVERLAY_WIDTH - textWidth - 3, 13),
+		text, GL_WHITE_A(192), false, false);
+
+	// Render the allocations of the last frame, if counted
+
+	int y = 23;
+	if (allocationCount > 0)
+	{
+		text.Format("%lu allocations", lastFrameAllocations);
+		adapter->drawMonoText(context, font, Vector(4, y), text, GL_WHITE_A(192), false, false);
+
+		text.Format("%.1f KB", lastFrameAllocatedBytes / 1024.0);
+		textWidth = font->getWidth(text);
+		adapter->drawMonoText(context, font, Vector(OVERLAY_WIDTH - textWidth - 3, y),
+			text, GL_WHITE_A(192), false, false);
+
+		y += 10;
+	}
+
+	// Render the top-level zones of the last frame
+
+	for (int zoneNo = 0; zoneNo < lastFrameZoneCount; zoneNo++, y += 10)
+	{
+		adapter->drawMonoText(context, font, Vector(4, y), lastFrameZoneNames[zoneNo],
+			GL_WHITE_A(160), false, false);
+
+		text.Format("%.2f ms", lastFrameZoneTimes[zoneNo] / 1000.0);
+		textWidth = font->getWidth(text);
+		adapter->drawMonoText(context, font, Vector(OVERLAY_WIDTH - textWidth - 3, y),
+			text, GL_WHITE_A(160), false, false);
+	}
+
+	// Render renderer statistics, if requested
+
+	if (rendererStatisticsShown)
+		drawRendererStatistics(getOverlayPosition() + Vector(0, height + 4));
+}
+
+void Profiler::drawRendererStatistics(Vector position)
+{
+	ASSERTION_COBJECT(this);
+
+	Desktop * desktop = Desktop::getInstance();
+	PlatformAdapter * adapter = desktop->getPlatformAdapter();
+	const RendererStatistics & statistics = adapter->getFrameStatistics();
+
+	// The statistics show the primitives in total, and then the device related counters
+	int lineCount = RendererStatistics::COUNT - RendererStatistics::GLYPHS + 1;
+	DrawingContext context(DrawingContext(desktop), position, Vector(OVERLAY_WIDTH, lineCount * 10 + 6));
+	adapter->drawRect(context, Vector(), context.getClippingSize() - Vector(1, 1),
+		GL_RGBA(0, 0, 0, 96));
+
+	String text;
+	for (int lineNo = 0; lineNo < lineCount; lineNo++)
+	{
+		const char * name;
+		unsigned long value;
+		if (lineNo == 0)
+		{
+			name = "Primitives";
+			value = statistics.getPrimitiveCount();
+		}
+		else
+		{
+			RendererStatistics::Counter counter
+				= (RendererStatistics::Counter) (RendererStatistics::GLYPHS + lineNo - 1);
+			name = RendererStatistics::getName(counter);
+			value = statistics.get(counter);
+		}
+
+		Vector textPosition(4, 3 + lineNo * 10);
+		adapter->drawMonoText(context, font, textPosition, name, GL_WHITE_A(192), false, false);
+
+		text.Format("%lu", value);
+		int textWidth = font->getWidth(text);
+		adapter->drawMonoText(context, font, Vector(OVERLAY_WIDTH - textWidth - 3, textPosition.y),
+			text, GL_WHITE_A(192), false, false);
+	}
+}
+
+void Profiler::endZone()
+{
+	ASSERTION_COBJECT(this);
+
+	if (!enabled || depth == 0)
+		return;
+
+	depth--;
+	if (depth >= MAX_DEPTH)
+		return;
+
+	Zone & zone = openZones[depth];
+	double duration = getTime() - zone.start;
+
+	// The zone's own allocations exclude the ones of its nested zones,
+	// which are accounted to the enclosing zone as a whole
+	zone.allocations = allocationCount - zone.allocations;
+	zone.allocatedBytes = allocatedBytes - zone.allocatedBytes;
+	if (depth > 0)
+	{
+		Zone & enclosingZone = openZones[depth - 1];
+		enclosingZone.allocations += allocationCount - zone.allocationsAtStart;
+		enclosingZone.allocatedBytes += allocatedBytes - zone.allocatedBytesAtStart;
+	}
+
+	if (zone.allocations > 0)
+		attributeAllocations(zone.name, zone.allocations, zone.allocatedBytes);
+
+	// Sum up the top-level zones of the frame for the overlay
+	if (depth == 0)
+	{
+		int zoneNo;
+		for (zoneNo = 0; zoneNo < currentFrameZoneCount; zoneNo++)
+			if (currentFrameZoneNames[zoneNo] == zone.name)
+				break;
+
+		if (zoneNo < currentFrameZoneCount)
+			currentFrameZoneTimes[zoneNo] += duration;
+		else if (currentFrameZoneCount < MAX_FRAME_ZONES)
+		{
+			currentFrameZoneNames[currentFrameZoneCount] = zone.name;
+			currentFrameZoneTimes[currentFrameZoneCount++] = duration;
+		}
+	}
+
+	if (capturing)
+		captureZone(zone, duration);
+}
+
+unsigned long Profiler::getAllocatedBytes()
+{
+	return allocatedBytes;
+}
+
+unsigned long Profiler::getAllocatingFrameCount()
+{
+	ASSERTION_COBJECT(this);
+	return allocatingFrameCount;
+}
+
+unsigned long Profiler::getAllocationCount()
+{
+	return allocationCount;
+}
+
+int Profiler::getCapturedZoneCount()
+{
+	ASSERTION_COBJECT(this);
+	return capturedZoneCount;
+}
+
+double Profiler::getFrameBudget()
+{
+	ASSERTION_COBJECT(this);
+	return frameBudget;
+}
+
+FrameTimeHistogram & Profiler::getFrameHistogram()
+{
+	ASSERTION_COBJECT(this);
+	return frameHistogram;
+}
+
+long Profiler::getFramesPerSecond()
+{
+	ASSERTION_COBJECT(this);
+	return framesPerSecond;
+}
+
+unsigned long Profiler::getLastFrameAllocatedBytes()
+{
+	ASSERTION_COBJECT(this);
+	return lastFrameAllocatedBytes;
+}
+
+unsigned long Profiler::getLastFrameAllocations()
+{
+	ASSERTION_COBJECT(this);
+	return lastFrameAllocations;
+}
+
+double Profiler::getLastFrameDuration()
+{
+	ASSERTION_COBJECT(this);
+	return lastFrameDuration;
+}
+
+unsigned long Profiler::getOverBudgetFrameCount()
+{
+	ASSERTION_COBJECT(this);
+	return overBudgetFrameCount;
+}
+
+int Profiler::getOverlayHeight()
+{
+	ASSERTION_COBJECT(this);
+
+	int lineCount = 2 + lastFrameZoneCount;
+	if (allocationCount > 0)
+		lineCount++;
+
+	return lineCount * 10 + 6;
+}
+
+Vector Profiler::getOverlayPosition()
+{
+	ASSERTION_COBJECT(this);
+	return Vector(Desktop::getInstance()->getSize().x - 8 - OVERLAY_WIDTH, 8);
+}
+
+Vector Profiler::getOverlaySize()
+{
+	ASSERTION_COBJECT(this);
+
+	int height = getOverlayHeight();
+	if (rendererStatisticsShown)
+		height += 4 + (RendererStatistics::COUNT - RendererStatistics::GLYPHS + 1) * 10 + 6;
+
+	return Vector(OVERLAY_WIDTH, height);
+}
+
+Profiler::Phase Profiler::getPhase()
+{
+	ASSERTION_COBJECT(this);
+	return currentPhase;
+}
+
+unsigned long Profiler::getPhaseAllocatedBytes(Phase phase)
+{
+	ASSERTION_COBJECT(this);
+	return phaseAllocatedBytes[phase];
+}
+
+unsigned long Profiler::getPhaseAllocations(Phase phase)
+{
+	ASSERTION_COBJECT(this);
+	return phaseAllocations[phase];
+}
+
+FrameTimeHistogram & Profiler::getPhaseHistogram(Phase phase)
+{
+	ASSERTION_COBJECT(this);
+	return phaseHistograms[phase];
+}
+
+const char * Profiler::getPhaseName(Phase phase)
+{
+	return PHASE_NAMES[phase];
+}
+
+FrameTimeHistogram & Profiler::getRecentFrameHistogram()
+{
+	ASSERTION_COBJECT(this);
+	return recentFrameHistogram;
+}
+
+double Profiler::getTime()
+{
+	return Desktop::getInstance()->getPlatformAdapter()->getPreciseTime();
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(Profiler, CObject);
+#endif
+
+bool Profiler::isCapturing()
+{
+	ASSERTION_COBJECT(this);
+	return capturing;
+}
+
+bool Profiler::isEnabled()
+{
+	ASSERTION_COBJECT(this);
+	return enabled;
+}
+
+bool Profiler::isMainThread()
+{
+	if (!mainThreadKnown)
+		return true;
+
+	#ifdef WIN32
+		return GetCurrentThreadId() == mainThreadId;
+	#else
+		return pthread_equal(pthread_self(), mainThreadId) != 0;
+	#endif
+}
+
+bool Profiler::isOverlayShown()
+{
+	ASSERTION_COBJECT(this);
+	return overlayShown;
+}
+
+bool Profiler::isRendererStatisticsShown()
+{
+	ASSERTION_COBJECT(this);
+	return rendererStatisticsShown;
+}
+
+void Profiler::logFrameStatistics()
+{
+	ASSERTION_COBJECT(this);
+
+	LOGPRINTF3(LOG_INFO, "Frame statistics: %lu of %lu frames over the budget of %.1f ms",
+		overBudgetFrameCount, frameHistogram.getCount(), frameBudget / 1000.0);
+	logHistogram("Frame", frameHistogram);
+	int phase;
+	for (phase = 0; phase < PHASE_COUNT; phase++)
+		logHistogram(PHASE_NAMES[phase], phaseHistograms[phase]);
+
+	// Report the allocations, if the application counts them
+	if (allocationCount == 0)
+		return;
+
+	unsigned long frameCount = frameHistogram.getCount();
+	double divisor = frameCount > 0 ? (double) frameCount : 1.0;
+	unsigned long frameAllocations = 0;
+	for (phase = 0; phase < PHASE_COUNT; phase++)
+		frameAllocations += phaseAllocations[phase];
+
+	LOGPRINTF3(LOG_INFO, "Allocation statistics: %lu of %lu frames allocated, %.1f allocations per frame",
+		allocatingFrameCount, frameCount, frameAllocations / divisor);
+	for (phase = 0; phase < PHASE_COUNT; phase++)
+		LOGPRINTF3(LOG_INFO, "%s: %.1f allocations, %.0f bytes per frame", PHASE_NAMES[phase],
+			phaseAllocations[phase] / divisor, phaseAllocatedBytes[phase] / divisor);
+
+	sortAllocationZones();
+	for (int zoneNo = 0; zoneNo < allocationZoneCount; zoneNo++)
+		LOGPRINTF3(LOG_INFO, "Zone %s: %lu allocations, %lu bytes", allocationZoneNames[zoneNo],
+			allocationZoneCounts[zoneNo], allocationZoneBytes[zoneNo]);
+}
+
+void Profiler::logHistogram(const char * name, FrameTimeHistogram & histogram)
+{
+	String text;
+	text.Format("%s: mean %.2f ms, p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms",
+		name, histogram.getMean() / 1000.0, histogram.getPercentile(50.0) / 1000.0,
+		histogram.getPercentile(95.0) / 1000.0, histogram.getPercentile(99.0) / 1000.0,
+		histogram.getMaximum() / 1000.0);
+	LOGPRINTF1(LOG_INFO, "%s", (const char *) text);
+}
+
+void Profiler::onFrame()
+{
+	ASSERTION_COBJECT(this);
+
+	double now = getTime();
+
+	// Count the frame time and the phase times, excluding idle waiting,
+	// and the allocations, including idle waiting
+	completePhase(now);
+
+	int phase;
+	if (frameStarted)
+	{
+		double frameDuration = 0.0;
+		unsigned long frameAllocatedBytes = 0;
+		unsigned long frameAllocations = 0;
+		for (phase = 0; phase < PHASE_COUNT; phase++)
+		{
+			if (phase != PHASE_IDLE)
+				frameDuration += currentPhaseTimes[phase];
+			phaseHistograms[phase].add(currentPhaseTimes[phase]);
+
+			frameAllocatedBytes += currentPhaseAllocatedBytes[phase];
+			frameAllocations += currentPhaseAllocations[phase];
+			phaseAllocatedBytes[phase] += currentPhaseAllocatedBytes[phase];
+			phaseAllocations[phase] += currentPhaseAllocations[phase];
+		}
+
+		frameHistogram.add(frameDuration);
+		recentFrameHistogram.add(frameDuration);
+		if (frameDuration > frameBudget)
+			overBudgetFrameCount++;
+		if (frameAllocations > 0)
+			allocatingFrameCount++;
+
+		lastFrameAllocatedBytes = frameAllocatedBytes;
+		lastFrameAllocations = frameAllocations;
+		lastFrameDuration = frameDuration;
+	}
+
+	for (phase = 0; phase < PHASE_COUNT; phase++)
+	{
+		currentPhaseAllocatedBytes[phase] = 0;
+		currentPhaseAllocations[phase] = 0;
+		currentPhaseTimes[phase] = 0.0;
+	}
+	frameStarted = true;
+
+	if (enabled)
+	{
+		if (capturing)
+		{
+			Zone frameZone;
+			frameZone.allocatedBytes = lastFrameAllocatedBytes;
+			frameZone.allocations = lastFrameAllocations;
+			frameZone.name = "Frame";
+			frameZone.start = frameStart;
+			captureZone(frameZone, now - frameStart);
+		}
+
+		// The zones of the frame become the last frame's ones
+		const char ** names = lastFrameZoneNames;
+		lastFrameZoneNames = currentFrameZoneNames;
+		currentFrameZoneNames = names;
+
+		double * times = lastFrameZoneTimes;
+		lastFrameZoneTimes = currentFrameZoneTimes;
+		currentFrameZoneTimes = times;
+
+		lastFrameZoneCount = currentFrameZoneCount;
+		currentFrameZoneCount = 0;
+
+		fpsFrameCount++;
+		if (now - fpsSampleStart >= 1000000.0)
+		{
+			framesPerSecond = (long) (fpsFrameCount * 1000000.0 / (now - fpsSampleStart) + 0.5);
+			fpsFrameCount = 0;
+			fpsSampleStart = now;
+		}
+	}
+
+	// Apply enabled state changes at the frame boundary, so that zones are never cut
+	bool wasEnabled = enabled;
+	enabled = enabledRequested || overlayShown || capturing;
+	if (enabled != wasEnabled)
+	{
+		depth = 0;
+		currentFrameZoneCount = 0;
+		lastFrameZoneCount = 0;
+		fpsFrameCount = 0;
+		fpsSampleStart = now;
+	}
+
+	frameStart = now;
+}
+
+void Profiler::resetFrameStatistics()
+{
+	ASSERTION_COBJECT(this);
+
+	allocatingFrameCount = 0;
+	allocationZoneCount = 0;
+	frameHistogram.reset();
+	overBudgetFrameCount = 0;
+	for (int phase = 0; phase < PHASE_COUNT; phase++)
+	{
+		phaseAllocatedBytes[phase] = 0;
+		phaseAllocations[phase] = 0;
+		phaseHistograms[phase].reset();
+	}
+	recentFrameHistogram.reset();
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+	ASSERTION_COBJECT(this);
+	enabledRequested = enabled;
+}
+
+void Profiler::setFrameBudget(double frameBudget)
+{
+	ASSERTION_COBJECT(this);
+
+	if (frameBudget <= 0.0)
+		throw EILLEGALARGUMENT("The frame budget must be positive");
+
+	this->frameBudget = frameBudget;
+}
+
+void Profiler::setOverlayShown(bool overlayShown)
+{
+	ASSERTION_COBJECT(this);
+	this->overlayShown = overlayShown;
+}
+
+Profiler::Phase Profiler::setPhase(Phase phase)
+{
+	ASSERTION_COBJECT(this);
+
+	completePhase(getTime());
+
+	Phase previousPhase = currentPhase;
+	currentPhase = phase;
+	return previousPhase;
+}
+
+void Profiler::setRendererStatisticsShown(bool rendererStatisticsShown)
+{
+	ASSERTION_COBJECT(this);
+	this->rendererStatisticsShown = rendererStatisticsShown;
+}
+
+void Profiler::sortAllocationZones()
+{
+	ASSERTION_COBJECT(this);
+
+	// Insertion sort, there are only a few zones
+	for (int zoneNo = 1; zoneNo < allocationZoneCount; zoneNo++)
+	{
+		const char * name = allocationZoneNames[zoneNo];
+		unsigned long count = allocationZoneCounts[zoneNo];
+		unsigned long bytes = allocationZoneBytes[zoneNo];
+
+		int insertNo;
+		for (insertNo = zoneNo; insertNo > 0 && allocationZoneCounts[insertNo - 1] < count; insertNo--)
+		{
+			allocationZoneNames[insertNo] = allocationZoneNames[insertNo - 1];
+			allocationZoneCounts[insertNo] = allocationZoneCounts[insertNo - 1];
+			allocationZoneBytes[insertNo] = allocationZoneBytes[insertNo - 1];
+		}
+
+		allocationZoneNames[insertNo] = name;
+		allocationZoneCounts[insertNo] = count;
+		allocationZoneBytes[insertNo] = bytes;
+	}
+}
+
+void Profiler::startCapture(int capacity)
+{
+	ASSERTION_COBJECT(this);
+
+	if (capacity <= 0)
+		throw EILLEGALARGUMENT("The capture capacity must be positive");
+
+	if (capturedZones == NULL || captureCapacity != capacity)
+	{
+		if (capturedZones != NULL) {delete[] capturedZones; capturedZones = NULL;}
+		captureCapacity = 0;
+
+		if ((capturedZones = new Zone[capacity]) == NULL)
+			throw EOUTOFMEMORY;
+		captureCapacity = capacity;
+	}
+
+	capturedZoneCount = 0;
+	captureOverflowed = false;
+	capturing = true;
+}
+
+void Profiler::stopCapture()
+{
+	ASSERTION_COBJECT(this);
+
+	capturing = false;
+
+	if (captureOverflowed)
+		LOGPRINTF1(LOG_WARN, "The profiler capture exceeded %d zones, later zones have been dropped",
+			captureCapacity);
+}
+
+void Profiler::writeFrameStatistics(const String & path)
+{
+	ASSERTION_COBJECT(this);
+
+	FILE * file;
+	if ((file = fopen((const char *) path, "w")) == NULL)
+		throw EDEVICEERROR("Cannot open the frame statistics file for writing");
+
+	fprintf(file, "histogram,count,mean_ms,p50_ms,p95_ms,p99_ms,max_ms,over_budget,budget_ms,"
+		"allocations_per_frame,bytes_per_frame\n");
+
+	unsigned long frameCount = frameHistogram.getCount();
+	double divisor = frameCount > 0 ? (double) frameCount : 1.0;
+	unsigned long frameAllocatedBytes = 0;
+	unsigned long frameAllocations = 0;
+	int phase;
+	for (phase = 0; phase < PHASE_COUNT; phase++)
+	{
+		frameAllocatedBytes += phaseAllocatedBytes[phase];
+		frameAllocations += phaseAllocations[phase];
+	}
+
+	for (int histogramNo = -1; histogramNo < PHASE_COUNT; histogramNo++)
+	{
+		FrameTimeHistogram & histogram = histogramNo < 0 ? frameHistogram : phaseHistograms[histogramNo];
+		fprintf(file, "%s,%lu,%.3f,%.3f,%.3f,%.3f,%.3f,",
+			histogramNo < 0 ? "Frame" : PHASE_NAMES[histogramNo], histogram.getCount(),
+			histogram.getMean() / 1000.0, histogram.getPercentile(50.0) / 1000.0,
+			histogram.getPercentile(95.0) / 1000.0, histogram.getPercentile(99.0) / 1000.0,
+			histogram.getMaximum() / 1000.0);
+
+		// Only the frames are related to the budget
+		if (histogramNo < 0)
+			fprintf(file, "%lu,%.3f,", overBudgetFrameCount, frameBudget / 1000.0);
+		else
+			fprintf(file, ",,");
+
+		fprintf(file, "%.2f,%.1f\n",
+			(histogramNo < 0 ? frameAllocations : phaseAllocations[histogramNo]) / divisor,
+			(histogramNo < 0 ? frameAllocatedBytes : phaseAllocatedBytes[histogramNo]) / divisor);
+	}
+
+	bool failed = ferror(file) != 0;
+	if (fclose(file) != 0 || failed)
+		throw EDEVICEERROR("Cannot write the frame statistics file");
+}
+
+void Profiler::writeJsonString(FILE * file, const char * string)
+{
+	fputc('"', file);
+	for (; *string != 0; string++)
+	{
+		unsigned char character = (unsigned char) *string;
+		if (character == '"' || character == '\\')
+			fprintf(file, "\\%c", character);
+		else if (character < 0x20)
+			fprintf(file, "\\u%04x", character);
+		else
+			fputc(character, file);
+	}
+	fputc('"', file);
+}
+
+void Profiler::writeTrace(const String & path)
+{
+	ASSERTION_COBJECT(this);
+
+	FILE * file;
+	if ((file = fopen((const char *) path, "w")) == NULL)
+		throw EDEVICEERROR("Cannot open the profiler trace file for writing");
+
+	// All zones are complete events ("X") of the main thread, in micro seconds
+	fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+	fputs("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Main\"}}", file);
+	for (int zoneNo = 0; zoneNo < capturedZoneCount; zoneNo++)
+	{
+		Zone & zone = capturedZones[zoneNo];
+		fputs(",\n{\"name\":", file);
+		writeJsonString(file, zone.name);
+		fprintf(file, ",\"cat\":\"glaziery\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f",
+			zone.start, zone.duration);
+
+		// The detail and the zone's own allocations are arguments
+		bool hasDetail = zone.detail.GetLength() > 0;
+		if (hasDetail || zone.allocations > 0)
+		{
+			fputs(",\"args\":{", file);
+			if (hasDetail)
+			{
+				fputs("\"detail\":", file);
+				writeJsonString(file, zone.detail);
+			}
+			if (zone.allocations > 0)
+				fprintf(file, "%s\"allocations\":%lu,\"allocatedBytes\":%lu", hasDetail ? "," : "",
+					zone.allocations, zone.allocatedBytes);
+			fputc('}', file);
+		}
+		fputc('}', file);
+	}
+	fputs("\n]}\n", file);
+
+	bool failed = ferror(file) != 0;
+	if (fclose(file) != 0 || failed)
+		throw EDEVICEERROR("Cannot write the profiler trace file");
+
+	LOGPRINTF2(LOG_INFO, "Written %d profiler zones to '%s'", capturedZoneCount, (const char *) path);
+}
+
+
+Profiler::Zone::Zone()
+{
+	ASSERTION_COBJECT(this);
+
+	allocatedBytes = 0;
+	allocatedBytesAtStart = 0;
+	allocations = 0;
+	allocationsAtStart = 0;
+	duration = 0.0;
+	name = NULL;
+	start = 0.0;
+}
@@ -0,0 +1,825 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_PROFILER_H
+#define __GLAZIERY_PROFILER_H
+
+
+namespace glaziery
+{
+	/**
+	 * The profiler measures nested, named zones of the main loop with the platform adapter's
+	 * precise time, e.g. the loop phases, the drawing of each window, the skin's drawing
+	 * functions, layouting, effects, event handling, and deferrals.
+	 * Zones are opened and closed using ProfilerZone objects (see GLAZIERY_PROFILERZONE),
+	 * or using beginZone() and endZone().<br>
+	 *
+	 * The profiler is available in all builds, but turned off by default. When it is off,
+	 * a zone costs a single check. When it is on, it shows an optional overlay with
+	 * the frames per second and the times of the top-level zones of the last frame.
+	 * Additionally, all zones may be captured and written as Chrome trace event JSON,
+	 * which can be opened in chrome://tracing or Perfetto, to see exactly which component
+	 * or skin function exceeded a frame budget.<br>
+	 *
+	 * Independent of the enabled state, the profiler always measures the frame time and
+	 * the time of each loop phase (see Phase) in frame time histograms, to report
+	 * percentiles and frames over budget, e.g. using logFrameStatistics() or
+	 * writeFrameStatistics() at shutdown. The frame time excludes idle waiting.<br>
+	 *
+	 * Applications may enable the allocation accounting by replacing the global operator new
+	 * and calling countAllocation() for each allocation (see the benchmark application).
+	 * Then, the profiler reports the heap allocations and bytes per frame and per phase,
+	 * and, while turned on, attributes them to the innermost open zone.
+	 * Allocations of other threads than the main thread are not counted.<br>
+	 *
+	 * The profiler must be used from the main thread only.
+	 * Changes of the enabled state become effective at the beginning of the next frame.
+	 * @see Desktop::getProfiler()
+	 * @see ProfilerZone
+	 */
+	#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+		class Profiler : public CObject
+	#else
+		class Profiler
+	#endif
+	{
+		public:
+
+			/**
+			 * The phases of the Desktop's main loop, measured per frame.
+			 * @see setPhase()
+			 */
+			enum Phase
+			{
+				/**
+				 * Updating the platform adapter, the skin, and the input manager.
+				 */
+				PHASE_INPUT = 0,
+
+				/**
+				 * Processing input events and updating the scene.
+				 */
+				PHASE_EVENTS,
+
+				/**
+				 * Executing deferrals.
+				 */
+				PHASE_DEFERRALS,
+
+				/**
+				 * Executing effects.
+				 */
+				PHASE_EFFECTS,
+
+				/**
+				 * Drawing the desktop.
+				 */
+				PHASE_DRAW,
+
+				/**
+				 * Presenting the frame, including waiting for the vertical retrace.
+				 */
+				PHASE_PRESENT,
+
+				/**
+				 * Waiting for input or the next frame. Not part of the frame time.
+				 */
+				PHASE_IDLE,
+
+				/**
+				 * Any other operation, e.g. deleting disposable components.
+				 */
+				PHASE_OTHER,
+
+				/**
+				 * The total number of different phases.
+				 */
+				PHASE_COUNT
+			};
+
+		protected:
+
+			/**
+			 * A measured zone.
+			 */
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				class Zone : public CObject
+			#else
+				class Zone
+			#endif
+			{
+				public:
+
+					/**
+					 * While the zone is open, the bytes allocated when opening it plus the bytes
+					 * of the closed nested zones. Once closed, the bytes allocated by the zone
+					 * itself, excluding nested zones.
+					 */
+					unsigned long allocatedBytes;
+
+					/**
+					 * The bytes allocated when opening the zone.
+					 */
+					unsigned long allocatedBytesAtStart;
+
+					/**
+					 * While the zone is open, the allocation count when opening it plus the
+					 * allocations of the closed nested zones. Once closed, the allocations
+					 * of the zone itself, excluding nested zones.
+					 */
+					unsigned long allocations;
+
+					/**
+					 * The allocation count when opening the zone.
+					 */
+					unsigned long allocationsAtStart;
+
+					/**
+					 * An optional detail, e.g. the component drawn.
+					 * Only kept while capturing.
+					 */
+					String detail;
+
+					/**
+					 * The duration in micro seconds.
+					 */
+					double duration;
+
+					/**
+					 * The name of the zone. Must be a static string.
+					 */
+					const char * name;
+
+					/**
+					 * The start time in micro seconds.
+					 */
+					double start;
+
+					/**
+					 * Creates a new zone.
+					 */
+					Zone();
+			};
+
+			/**
+			 * The default maximum number of zones captured.
+			 */
+			static const int DEFAULT_CAPTURE_CAPACITY;
+
+			/**
+			 * The maximum number of different zones the allocations are attributed to.
+			 * The allocations of further zones are reported for their phases only.
+			 */
+			static const int MAX_ALLOCATION_ZONES;
+
+			/**
+			 * The maximum nesting depth of zones. Deeper zones are not measured.
+			 */
+			static const int MAX_DEPTH;
+
+			/**
+			 * The maximum number of different top-level zones per frame shown in the overlay.
+			 */
+			static const int MAX_FRAME_ZONES;
+
+			/**
+			 * The names of the phases, e.g. for reports.
+			 */
+			static const char * PHASE_NAMES[PHASE_COUNT];
+
+			/**
+			 * The number of most recent frames the overlay's percentiles are computed of.
+			 */
+			static const int RECENT_FRAME_COUNT;
+
+			/**
+			 * The width of the overlay in pixels.
+			 */
+			static const int OVERLAY_WIDTH;
+
+			/**
+			 * The bytes allocated since the start of the process, as counted by countAllocation().
+			 */
+			static unsigned long allocatedBytes;
+
+			/**
+			 * The number of frames since the start or the last resetFrameStatistics()
+			 * that allocated memory.
+			 */
+			unsigned long allocatingFrameCount;
+
+			/**
+			 * The number of allocations since the start of the process,
+			 * as counted by countAllocation().
+			 */
+			static unsigned long allocationCount;
+
+			/**
+			 * The bytes allocated per zone since the start or the last resetFrameStatistics(),
+			 * excluding nested zones (MAX_ALLOCATION_ZONES entries).
+			 */
+			unsigned long * allocationZoneBytes;
+
+			/**
+			 * The number of different zones that allocated memory.
+			 */
+			int allocationZoneCount;
+
+			/**
+			 * The allocations per zone since the start or the last resetFrameStatistics(),
+			 * excluding nested zones (MAX_ALLOCATION_ZONES entries).
+			 */
+			unsigned long * allocationZoneCounts;
+
+			/**
+			 * The names of the zones that allocated memory (MAX_ALLOCATION_ZONES entries).
+			 */
+			const char ** allocationZoneNames;
+
+			/**
+			 * The maximum number of zones to be captured.
+			 */
+			int captureCapacity;
+
+			/**
+			 * The captured zones (captureCapacity entries), or NULL if never captured.
+			 */
+			Zone * capturedZones;
+
+			/**
+			 * The number of captured zones.
+			 */
+			int capturedZoneCount;
+
+			/**
+			 * Whether more zones occurred while capturing than could be captured.
+			 */
+			bool captureOverflowed;
+
+			/**
+			 * Whether all zones are being captured.
+			 */
+			bool capturing;
+
+			/**
+			 * The total times (micro seconds) of the top-level zones of the current frame,
+			 * by zone (MAX_FRAME_ZONES entries).
+			 */
+			double * currentFrameZoneTimes;
+
+			/**
+			 * The names of the top-level zones of the current frame (MAX_FRAME_ZONES entries).
+			 */
+			const char ** currentFrameZoneNames;
+
+			/**
+			 * The number of different top-level zones of the current frame.
+			 */
+			int currentFrameZoneCount;
+
+			/**
+			 * The current loop phase.
+			 */
+			Phase currentPhase;
+
+			/**
+			 * The bytes allocated in the phases in the current frame.
+			 */
+			unsigned long currentPhaseAllocatedBytes[PHASE_COUNT];
+
+			/**
+			 * The allocations of the phases in the current frame.
+			 */
+			unsigned long currentPhaseAllocations[PHASE_COUNT];
+
+			/**
+			 * The total times (micro seconds) of the phases in the current frame.
+			 */
+			double currentPhaseTimes[PHASE_COUNT];
+
+			/**
+			 * The current nesting depth of zones, including the ones too deep to be measured.
+			 */
+			int depth;
+
+			/**
+			 * Whether the profiler is turned on.
+			 */
+			bool enabled;
+
+			/**
+			 * Whether the profiler is requested to be turned on with the next frame,
+			 * even if neither the overlay is shown nor zones are captured.
+			 * @see setEnabled()
+			 */
+			bool enabledRequested;
+
+			/**
+			 * The font used for rendering the overlay.
+			 */
+			Font * font;
+
+			/**
+			 * The frame time histogram of all frames since the start or the last resetFrameStatistics().
+			 */
+			FrameTimeHistogram frameHistogram;
+
+			/**
+			 * Whether the first frame has been started, i.e. whether phases are measured.
+			 */
+			bool frameStarted;
+
+			/**
+			 * The frame budget, in micro seconds.
+			 */
+			double frameBudget;
+
+			/**
+			 * The number of frames measured since fpsSampleStart.
+			 */
+			long fpsFrameCount;
+
+			/**
+			 * The start of the current frames per second sample, in micro seconds.
+			 */
+			double fpsSampleStart;
+
+			/**
+			 * The frames per second measured in the last complete sample.
+			 */
+			long framesPerSecond;
+
+			/**
+			 * The start of the current frame, in micro seconds.
+			 */
+			double frameStart;
+
+			/**
+			 * The bytes allocated in the last frame.
+			 */
+			unsigned long lastFrameAllocatedBytes;
+
+			/**
+			 * The allocations of the last frame.
+			 */
+			unsigned long lastFrameAllocations;
+
+			/**
+			 * The duration of the last frame excluding idle waiting, in micro seconds.
+			 */
+			double lastFrameDuration;
+
+			/**
+			 * The total times (micro seconds) of the top-level zones of the last frame,
+			 * by zone (MAX_FRAME_ZONES entries).
+			 */
+			double * lastFrameZoneTimes;
+
+			/**
+			 * The names of the top-level zones of the last frame (MAX_FRAME_ZONES entries).
+			 */
+			const char ** lastFrameZoneNames;
+
+			/**
+			 * The number of different top-level zones of the last frame.
+			 */
+			int lastFrameZoneCount;
+
+			/**
+			 * The thread that created the profiler (the main thread).
+			 * Only its allocations are counted.
+			 */
+			#ifdef WIN32
+				static DWORD mainThreadId;
+			#else
+				static pthread_t mainThreadId;
+			#endif
+
+			/**
+			 * Whether mainThreadId is known, i.e. a profiler has been created.
+			 * Until then, all allocations are counted.
+			 */
+			static bool mainThreadKnown;
+
+			/**
+			 * The currently open zones, outermost first (MAX_DEPTH entries).
+			 */
+			Zone * openZones;
+
+			/**
+			 * Whether the overlay is shown.
+			 */
+			bool overlayShown;
+
+			/**
+			 * The number of frames since the start or the last resetFrameStatistics()
+			 * that exceeded the frame budget.
+			 */
+			unsigned long overBudgetFrameCount;
+
+			/**
+			 * The bytes allocated per phase since the start or the last resetFrameStatistics().
+			 */
+			unsigned long phaseAllocatedBytes[PHASE_COUNT];
+
+			/**
+			 * The allocations per phase since the start or the last resetFrameStatistics().
+			 */
+			unsigned long phaseAllocations[PHASE_COUNT];
+
+			/**
+			 * The frame time histograms of the phases, since the start or the last
+			 * resetFrameStatistics().
+			 */
+			FrameTimeHistogram phaseHistograms[PHASE_COUNT];
+
+			/**
+			 * The bytes allocated when the current phase started.
+			 */
+			unsigned long phaseStartAllocatedBytes;
+
+			/**
+			 * The allocation count when the current phase started.
+			 */
+			unsigned long phaseStartAllocations;
+
+			/**
+			 * The start of the current phase, in micro seconds.
+			 */
+			double phaseStart;
+
+			/**
+			 * The frame time histogram of the RECENT_FRAME_COUNT most recent frames.
+			 */
+			FrameTimeHistogram recentFrameHistogram;
+
+			/**
+			 * Whether the renderer statistics of the last frame are shown below the overlay.
+			 * @see PlatformAdapter::getFrameStatistics()
+			 */
+			bool rendererStatisticsShown;
+
+			/**
+			 * Attributes allocations to a zone.
+			 * @param name The name of the zone.
+			 * @param allocations The number of allocations.
+			 * @param allocatedBytes The bytes allocated.
+			 */
+			void attributeAllocations(const char * name, unsigned long allocations,
+				unsigned long allocatedBytes);
+
+			/**
+			 * Appends a zone to the captured zones, if capturing.
+			 * @param zone The zone, with its own allocations.
+			 * @param duration The duration in micro seconds.
+			 */
+			void captureZone(const Zone & zone, double duration);
+
+			/**
+			 * Accounts the time and the allocations since the start of the current phase
+			 * to the phase, and starts a new phase period.
+			 * @param now The current time in micro seconds.
+			 */
+			void completePhase(double now);
+
+			/**
+			 * Renders the renderer statistics of the last frame below the overlay.
+			 * @param position The top-left position of the statistics.
+			 */
+			void drawRendererStatistics(Vector position);
+
+			/**
+			 * Returns the height of the overlay, excluding the renderer statistics.
+			 * @return The height in pixels.
+			 */
+			int getOverlayHeight();
+
+			/**
+			 * Returns the current precise time of the platform adapter.
+			 * @return The time in micro seconds.
+			 */
+			static double getTime();
+
+			/**
+			 * Returns whether the calling thread is the main thread, i.e. the one that
+			 * created the profiler. It does not allocate memory.
+			 * @return Whether the calling thread is the main thread.
+			 */
+			static bool isMainThread();
+
+			/**
+			 * Writes a line of frame statistics to the log.
+			 * @param name The name of the histogram.
+			 * @param histogram The histogram.
+			 */
+			static void logHistogram(const char * name, FrameTimeHistogram & histogram);
+
+			/**
+			 * Sorts the zones that allocated memory by their allocations, in descending order.
+			 */
+			void sortAllocationZones();
+
+			/**
+			 * Writes a string to a JSON file, escaping it as required.
+			 * @param file The file.
+			 * @param string The string.
+			 */
+			static void writeJsonString(FILE * file, const char * string);
+
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(Profiler);
+			#endif
+
+		public:
+
+			/**
+			 * Creates a new profiler. It is turned off initially.
+			 */
+			Profiler();
+
+			/**
+			 * Destroys the profiler.
+			 */
+			~Profiler();
+
+			/**
+			 * Opens a zone, nested into the currently open zone.
+			 * Every successful call must be followed by a call to endZone().
+			 * Prefer ProfilerZone objects, which close their zone automatically.
+			 * @param name The name of the zone. Must be a static string, it is not copied.
+			 * @param detail An optional detail (e.g. the component), or NULL.
+			 * It is copied, but only when capturing.
+			 * @return Whether the zone has been opened, i.e. whether the profiler is turned on.
+			 */
+			bool beginZone(const char * name, const char * detail = NULL);
+
+			/**
+			 * Counts a heap allocation for the allocation accounting. To be called by the
+			 * application's replacement of the global operator new (and new[]) for each
+			 * allocation. It must not allocate memory itself.
+			 * Allocations of other threads than the one that created the profiler are ignored,
+			 * e.g. the ones of worker threads, since they do not belong to the frame.
+			 * @param size The size of the allocation in bytes.
+			 */
+			static void countAllocation(size_t size);
+
+			/**
+			 * Renders the overlay on the desktop, if it is shown.
+			 */
+			void drawOverlay();
+
+			/**
+			 * Closes the innermost open zone.
+			 * Calls without an open zone are ignored.
+			 */
+			void endZone();
+
+			/**
+			 * Returns the bytes allocated since the start of the process.
+			 * @return The bytes, or 0 if the application does not count allocations.
+			 * @see countAllocation()
+			 */
+			static unsigned long getAllocatedBytes();
+
+			/**
+			 * Returns the number of frames since the start or the last resetFrameStatistics()
+			 * that allocated memory.
+			 * @return The number of frames.
+			 */
+			unsigned long getAllocatingFrameCount();
+
+			/**
+			 * Returns the number of allocations since the start of the process.
+			 * @return The number of allocations, or 0 if the application does not count allocations.
+			 * @see countAllocation()
+			 */
+			static unsigned long getAllocationCount();
+
+			/**
+			 * Returns the number of zones captured since the last startCapture().
+			 * @return The number of zones.
+			 */
+			int getCapturedZoneCount();
+
+			/**
+			 * Returns the frame budget, frames exceeding it are counted as over budget.
+			 * @return The frame budget in micro seconds.
+			 */
+			double getFrameBudget();
+
+			/**
+			 * Returns the frame time histogram of all frames since the start or the last
+			 * resetFrameStatistics(). The frame time excludes idle waiting.
+			 * @return The frame time histogram.
+			 */
+			FrameTimeHistogram & getFrameHistogram();
+
+			/**
+			 * Returns the frames per second, measured over the last second.
+			 * Only measured while the profiler is turned on.
+			 * @return The frames per second.
+			 */
+			long getFramesPerSecond();
+
+			/**
+			 * Returns the bytes allocated in the last frame, including idle waiting.
+			 * @return The bytes.
+			 */
+			unsigned long getLastFrameAllocatedBytes();
+
+			/**
+			 * Returns the allocations of the last frame, including idle waiting.
+			 * @return The number of allocations.
+			 */
+			unsigned long getLastFrameAllocations();
+
+			/**
+			 * Returns the duration of the last frame, excluding idle waiting.
+			 * @return The duration in micro seconds.
+			 */
+			double getLastFrameDuration();
+
+			/**
+			 * Returns the number of frames since the start or the last resetFrameStatistics()
+			 * that exceeded the frame budget.
+			 * @return The number of frames.
+			 */
+			unsigned long getOverBudgetFrameCount();
+
+			/**
+			 * Returns the top-left position of the overlay, for invalidating it each frame.
+			 * @return The position.
+			 */
+			Vector getOverlayPosition();
+
+			/**
+			 * Returns the size of the overlay, including the renderer statistics, if shown.
+			 * @return The size.
+			 */
+			Vector getOverlaySize();
+
+			/**
+			 * Returns the current loop phase.
+			 * @return The phase.
+			 */
+			Phase getPhase();
+
+			/**
+			 * Returns the bytes allocated in a phase since the start or the last resetFrameStatistics().
+			 * @param phase The phase.
+			 * @return The bytes.
+			 */
+			unsigned long getPhaseAllocatedBytes(Phase phase);
+
+			/**
+			 * Returns the allocations of a phase since the start or the last resetFrameStatistics().
+			 * @param phase The phase.
+			 * @return The number of allocations.
+			 */
+			unsigned long getPhaseAllocations(Phase phase);
+
+			/**
+			 * Returns the frame time histogram of a phase, since the start or the last
+			 * resetFrameStatistics(). Each frame adds the total time of the phase in that frame.
+			 * @param phase The phase.
+			 * @return The frame time histogram.
+			 */
+			FrameTimeHistogram & getPhaseHistogram(Phase phase);
+
+			/**
+			 * Returns the name of a phase.
+			 * @param phase The phase.
+			 * @return The name.
+			 */
+			static const char * getPhaseName(Phase phase);
+
+			/**
+			 * Returns the frame time histogram of the most recent frames, as shown in the overlay.
+			 * @return The frame time histogram.
+			 */
+			FrameTimeHistogram & getRecentFrameHistogram();
+
+			/**
+			 * Returns whether all zones are being captured.
+			 * @return Whether capturing.
+			 * @see startCapture()
+			 */
+			bool isCapturing();
+
+			/**
+			 * Returns whether the profiler is turned on.
+			 * @return Whether the profiler is turned on.
+			 */
+			bool isEnabled();
+
+			/**
+			 * Returns whether the overlay is shown.
+			 * @return Whether the overlay is shown.
+			 */
+			bool isOverlayShown();
+
+			/**
+			 * Returns whether the renderer statistics of the last frame are shown below the overlay.
+			 * @return Whether the renderer statistics are shown.
+			 */
+			bool isRendererStatisticsShown();
+
+			/**
+			 * Writes the frame statistics (count, mean, p50, p95, p99, maximum, and frames
+			 * over budget) of the frames and of each phase to the log, e.g. at shutdown.
+			 * If allocations are counted, the allocations per frame, per phase, and per zone
+			 * are written, too.
+			 */
+			void logFrameStatistics();
+
+			/**
+			 * Notifies the profiler about the end of a frame. Called by the Desktop.
+			 * Counts the frame time and the phase times in the histograms, the allocations
+			 * of the frame, and applies the enabled state requested by setEnabled().
+			 */
+			void onFrame();
+
+			/**
+			 * Forgets the frame statistics measured so far, e.g. after loading a scene.
+			 */
+			void resetFrameStatistics();
+
+			/**
+			 * Turns the profiler on or off. The change becomes effective with the next frame.
+			 * The profiler is also on while the overlay is shown or zones are captured.
+			 * @param enabled Whether the profiler is turned on.
+			 */
+			void setEnabled(bool enabled);
+
+			/**
+			 * Sets the frame budget, frames exceeding it are counted as over budget.
+			 * Defaults to 1/60 second.
+			 * @param frameBudget The frame budget in micro seconds.
+			 */
+			void setFrameBudget(double frameBudget);
+
+			/**
+			 * Sets whether the overlay is shown. Showing the overlay turns on the profiler.
+			 * @param overlayShown Whether the overlay is shown.
+			 */
+			void setOverlayShown(bool overlayShown);
+
+			/**
+			 * Switches the current loop phase. The time since the last switch is
+			 * accounted to the previous phase. Called by the Desktop.
+			 * @param phase The new phase.
+			 * @return The previous phase, e.g. to switch back after a nested operation.
+			 */
+			Phase setPhase(Phase phase);
+
+			/**
+			 * Sets whether the renderer statistics of the last frame (primitives, batches,
+			 * texture binds, etc.) are shown below the overlay. Defaults to false.
+			 * @param rendererStatisticsShown Whether the renderer statistics are shown.
+			 */
+			void setRendererStatisticsShown(bool rendererStatisticsShown);
+
+			/**
+			 * Starts capturing all zones (and frames) for a trace, discarding previously
+			 * captured zones. Capturing turns on the profiler.
+			 * When the capacity is exceeded, further zones are dropped.
+			 * @param capacity The maximum number of zones to be captured.
+			 * @see writeTrace()
+			 */
+			void startCapture(int capacity = DEFAULT_CAPTURE_CAPACITY);
+
+			/**
+			 * Stops capturing zones. The captured zones are kept until the next startCapture().
+			 */
+			void stopCapture();
+
+			/**
+			 * Writes the frame statistics of the frames and of each phase as CSV,
+			 * one line per histogram, with the times in milli seconds and the mean
+			 * allocations and bytes per frame, e.g. at shutdown to compare builds.
+			 * @param path The path of the file to be written.
+			 * @throws EDeviceError If the file cannot be written.
+			 */
+			void writeFrameStatistics(const String & path);
+
+			/**
+			 * Writes the captured zones as Chrome trace event JSON,
+			 * to be opened in chrome://tracing or Perfetto.
+			 * If allocations are counted, each zone's own allocations are written as arguments.
+			 * @param path The path of the file to be written.
+			 * @throws EDeviceError If the file cannot be written.
+			 */
+			void writeTrace(const String & path);
+	};
+}
+
+
+#endif
@@ -0,0 +1,23 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+ProfilerZone::ProfilerZone(const char * name, const char * detail)
+{
+	Desktop * desktop = Desktop::getInstance();
+	active = desktop != NULL && desktop->getProfiler().beginZone(name, detail);
+}
+
+ProfilerZone::~ProfilerZone()
+{
+	if (active)
+		Desktop::getInstance()->getProfiler().endZone();
+}
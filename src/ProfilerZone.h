@@ -0,0 +1,66 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_PROFILERZONE_H
+#define __GLAZIERY_PROFILERZONE_H
+
+
+/**
+ * Measures the remainder of the current block as a profiler zone.
+ * @param name The name of the zone, a static string (e.g. "Desktop::draw").
+ */
+#define GLAZIERY_PROFILERZONE(name) \
+	ProfilerZone profilerZone(name, NULL);
+
+/**
+ * Measures the remainder of the current block as a profiler zone with a detail.
+ * The detail expression is evaluated only while the profiler captures zones.
+ * @param name The name of the zone, a static string (e.g. "CachableComponent::draw").
+ * @param detail An expression of type String or const char * describing the zone's subject,
+ * e.g. toString().
+ */
+#define GLAZIERY_PROFILERZONE_D(name, detail) \
+	ProfilerZone profilerZone(name, Desktop::getInstance()->getProfiler().isCapturing() \
+		? (const char *) (detail) : NULL);
+
+
+namespace glaziery
+{
+	/**
+	 * A profiler zone opens a zone of the Desktop's profiler on construction and
+	 * closes it on destruction, so a zone covers a block even if it is left by
+	 * a return or an exception. Use the GLAZIERY_PROFILERZONE macros to create one.
+	 * @see Profiler
+	 */
+	class ProfilerZone
+	{
+		protected:
+
+			/**
+			 * Whether the zone has been opened, i.e. whether it must be closed.
+			 */
+			bool active;
+
+		public:
+
+			/**
+			 * Creates a new profiler zone and opens it, if the profiler is turned on.
+			 * @param name The name of the zone. Must be a static string.
+			 * @param detail An optional detail, or NULL.
+			 */
+			ProfilerZone(const char * name, const char * detail);
+
+			/**
+			 * Destroys the profiler zone and closes it, if it has been opened.
+			 */
+			~ProfilerZone();
+	};
+}
+
+
+#endif
@@ -0,0 +1,302 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+// Main header file
+#include <Glaziery/src/Headers.h>
+
+
+Region::Region() : count(0)
+{
+	ASSERTION_COBJECT(this);
+}
+
+Region::Region(const Region & region) : count(region.count)
+{
+	ASSERTION_COBJECT(this);
+
+	for (int i = 0; i < count; i++)
+	{
+		positions[i] = region.positions[i];
+		sizes[i] = region.sizes[i];
+	}
+}
+
+void Region::operator =(const Region & region)
+{
+	ASSERTION_COBJECT(this);
+
+	count = region.count;
+	for (int i = 0; i < count; i++)
+	{
+		positions[i] = region.positions[i];
+		sizes[i] = region.sizes[i];
+	}
+}
+
+void Region::add(Vector position, Vector size)
+{
+	ASSERTION_COBJECT(this);
+
+	if (size.x <= 0 || size.y <= 0)
+		return;
+
+	// Merge the new rectangle with existing ones until it may be stored separately.
+	// Merged rectangles may overlap others, so restart after each merge.
+	bool merged;
+	do
+	{
+		merged = false;
+		for (int i = 0; i < count; i++)
+		{
+			Vector end = position + size;
+			Vector existingEnd = positions[i] + sizes[i];
+
+			// Already covered completely
+			if (position >= positions[i] && end <= existingEnd)
+				return;
+
+			// Merge overlapping rectangles (to keep the region disjoint),
+			// and those whose bounding box covers not much more than themselves
+			long waste = getUnionWaste(i, position, size);
+			bool overlapping = position < existingEnd && positions[i] < end;
+			if (overlapping || waste * 2 <= getArea(size) + getArea(sizes[i]))
+			{
+				getUnion(i, position, size, position, size);
+				remove(i);
+				merged = true;
+				break;
+			}
+		}
+
+		// No more room, merge with the cheapest existing rectangle
+		if (!merged && count >= GL_REGION_MAXIMUM_RECTANGLES)
+		{
+			int cheapestIndex = 0;
+			long cheapestWaste = getUnionWaste(0, position, size);
+			for (int i = 1; i < count; i++)
+			{
+				long waste = getUnionWaste(i, position, size);
+				if (waste < cheapestWaste)
+				{
+					cheapestIndex = i;
+					cheapestWaste = waste;
+				}
+			}
+
+			getUnion(cheapestIndex, position, size, position, size);
+			remove(cheapestIndex);
+			merged = true;
+		}
+	}
+	while (merged);
+
+	positions[count] = position;
+	sizes[count] = size;
+	count++;
+}
+
+void Region::clear()
+{
+	ASSERTION_COBJECT(this);
+	count = 0;
+}
+
+long Region::getArea(Vector size)
+{
+	return (long) size.x * (long) size.y;
+}
+
+void Region::getBounds(Vector & position, Vector & size)
+{
+	ASSERTION_COBJECT(this);
+
+	if (count == 0)
+	{
+		position = Vector();
+		size = Vector();
+		return;
+	}
+
+	position = positions[0];
+	size = sizes[0];
+	for (int i = 1; i < count; i++)
+		getUnion(i, position, size, position, size);
+}
+
+int Region::getRectangleCount()
+{
+	ASSERTION_COBJECT(this);
+	return count;
+}
+
+Vector Region::getRectanglePosition(int index)
+{
+	ASSERTION_COBJECT(this);
+
+	if (index < 0 || index >= count)
+		throw EILLEGALARGUMENT("The rectangle index is out of bounds");
+
+	return positions[index];
+}
+
+Vector Region::getRectangleSize(int index)
+{
+	ASSERTION_COBJECT(this);
+
+	if (index < 0 || index >= count)
+		throw EILLEGALARGUMENT("The rectangle index is out of bounds");
+
+	return sizes[index];
+}
+
+void Region::getUnion(int index, Vector position, Vector size, Vector & unionPosition, Vector & unionSize)
+{
+	ASSERTION_COBJECT(this);
+
+	Vector end = position + size;
+	Vector existingEnd = positions[index] + sizes[index];
+
+	unionPosition.x = position.x < positions[index].x ? position.x : positions[index].x;
+	unionPosition.y = position.y < positions[index].y ? position.y : positions[index].y;
+	unionSize.x = (end.x > existingEnd.x ? end.x : existingEnd.x) - unionPosition.x;
+	unionSize.y = (end.y > existingEnd.y ? end.y : existingEnd.y) - unionPosition.y;
+}
+
+long Region::getUnionWaste(int index, Vector position, Vector size)
+{
+	ASSERTION_COBJECT(this);
+
+	Vector unionPosition;
+	Vector unionSize;
+	getUnion(index, position, size, unionPosition, unionSize);
+
+	Vector end = position + size;
+	Vector existingEnd = positions[index] + sizes[index];
+	Vector overlap((end.x < existingEnd.x ? end.x : existingEnd.x)
+		- (position.x > positions[index].x ? position.x : positions[index].x),
+		(end.y < existingEnd.y ? end.y : existingEnd.y)
+		- (position.y > positions[index].y ? position.y : positions[index].y));
+	long overlapArea = overlap.x > 0 && overlap.y > 0 ? getArea(overlap) : 0;
+
+	return getArea(unionSize) - getArea(size) - getArea(sizes[index]) + overlapArea;
+}
+
+#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+	IMPLEMENT_DYNAMIC(Region, CObject);
+#endif
+
+bool Region::intersects(Vector position, Vector size)
+{
+	ASSERTION_COBJECT(this);
+
+	if (size.x <= 0 || size.y <= 0)
+		return false;
+
+	Vector end = position + size;
+	for (int i = 0; i < count; i++)
+		if (position < positions[i] + sizes[i] && positions[i] < end)
+			return true;
+
+	return false;
+}
+
+bool Region::isEmpty()
+{
+	ASSERTION_COBJECT(this);
+	return count == 0;
+}
+
+void Region::remove(int index)
+{
+	ASSERTION_COBJECT(this);
+
+	count--;
+	positions[index] = positions[count];
+	sizes[index] = sizes[count];
+}
+
+void Region::subtract(Vector position, Vector size)
+{
+	ASSERTION_COBJECT(this);
+
+	if (size.x <= 0 || size.y <= 0)
+		return;
+
+	Vector end = position + size;
+	int i = 0;
+	while (i < count)
+	{
+		Vector existingPosition = positions[i];
+		Vector existingEnd = positions[i] + sizes[i];
+		if (!(position < existingEnd && existingPosition < end))
+		{
+			i++;
+			continue;
+		}
+
+		// Split into the parts above, below, left, and right of the subtracted rectangle.
+		// The pieces do not overlap the subtracted rectangle, so they are skipped when reached.
+		Vector piecePositions[4];
+		Vector pieceSizes[4];
+		int pieceCount = 0;
+
+		int top = position.y > existingPosition.y ? position.y : existingPosition.y;
+		int bottom = end.y < existingEnd.y ? end.y : existingEnd.y;
+		if (position.y > existingPosition.y)
+		{
+			piecePositions[pieceCount] = existingPosition;
+			pieceSizes[pieceCount++] = Vector(sizes[i].x, position.y - existingPosition.y);
+		}
+		if (end.y < existingEnd.y)
+		{
+			piecePositions[pieceCount] = Vector(existingPosition.x, end.y);
+			pieceSizes[pieceCount++] = Vector(sizes[i].x, existingEnd.y - end.y);
+		}
+		if (position.x > existingPosition.x)
+		{
+			piecePositions[pieceCount] = Vector(existingPosition.x, top);
+			pieceSizes[pieceCount++] = Vector(position.x - existingPosition.x, bottom - top);
+		}
+		if (end.x < existingEnd.x)
+		{
+			piecePositions[pieceCount] = Vector(end.x, top);
+			pieceSizes[pieceCount++] = Vector(existingEnd.x - end.x, bottom - top);
+		}
+
+		if (count - 1 + pieceCount > GL_REGION_MAXIMUM_RECTANGLES)
+		{
+			i++;
+			continue;
+		}
+
+		remove(i);
+		for (int j = 0; j < pieceCount; j++)
+		{
+			positions[count] = piecePositions[j];
+			sizes[count] = pieceSizes[j];
+			count++;
+		}
+	}
+}
+
+String Region::toString()
+{
+	ASSERTION_COBJECT(this);
+
+	String string("Region(");
+	for (int i = 0; i < count; i++)
+	{
+		String rectangle;
+		rectangle.Format(i > 0 ? ",(%d,%d,%d,%d)" : "(%d,%d,%d,%d)",
+			positions[i].x, positions[i].y, sizes[i].x, sizes[i].y);
+		string += rectangle;
+	}
+	string += ")";
+
+	return string;
+}
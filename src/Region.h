@@ -0,0 +1,179 @@
+/*
+ * This file is part of the Glaziery.
+ * Copyright Thomas Jacob.
+ *
+ * READ README.TXT BEFORE USE!!
+ */
+
+
+#ifndef __GLAZIERY_REGION_H
+#define __GLAZIERY_REGION_H
+
+
+namespace glaziery
+{
+	/**
+	 * The region is a small set of disjoint rectangles, used to track invalid areas
+	 * that are scattered over a component or the desktop (e.g. a blinking caret in
+	 * one corner and a progress bar in the other one). Instead of growing a single
+	 * bounding box, rectangles are kept separately as long as merging them would
+	 * cover too much area that is actually valid. Overlapping rectangles are always
+	 * merged, and if the region exceeds GL_REGION_MAXIMUM_RECTANGLES, the cheapest
+	 * pair is merged, so the region never allocates memory.
+	 */
+	#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+		class Region : public CObject
+	#else
+		class Region
+	#endif
+	{
+		// Runtime class macros require their own public section.
+		public:
+
+			#if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
+				DECLARE_DYNAMIC(Region);
+			#endif
+
+		private:
+
+			/**
+			 * The number of rectangles currently stored in the region.
+			 */
+			int count;
+
+			/**
+			 * The top-left positions of the rectangles.
+			 */
+			Vector positions[GL_REGION_MAXIMUM_RECTANGLES];
+
+			/**
+			 * The sizes of the rectangles.
+			 */
+			Vector sizes[GL_REGION_MAXIMUM_RECTANGLES];
+
+			/**
+			 * Returns the area of a rectangle.
+			 * @param size The rectangle size.
+			 * @return The area in pixels.
+			 */
+			static long getArea(Vector size);
+
+			/**
+			 * Returns the bounding box of the given rectangle and the i-th rectangle of the region.
+			 * @param index The index of the region's rectangle.
+			 * @param position The position of the other rectangle.
+			 * @param size The size of the other rectangle.
+			 * @param unionPosition Set to the top-left position of the bounding box.
+			 * @param unionSize Set to the size of the bounding box.
+			 */
+			void getUnion(int index, Vector position, Vector size, Vector & unionPosition, Vector & unionSize);
+
+			/**
+			 * Returns the number of pixels that would be covered by the bounding box
+			 * of the given rectangle and the i-th rectangle of the region,
+			 * but not by any of the two rectangles.
+			 * @param index The index of the region's rectangle.
+			 * @param position The position of the other rectangle.
+			 * @param size The size of the other rectangle.
+			 * @return The wasted area in pixels.
+			 */
+			long getUnionWaste(int index, Vector position, Vector size);
+
+			/**
+			 * Removes the i-th rectangle from the region.
+			 * The order of the rectangles is not preserved.
+			 * @param index The index of the rectangle.
+			 */
+			void remove(int index);
+
+		public:
+
+			/**
+			 * Creates a new empty region.
+			 */
+			Region();
+
+			/**
+			 * Copy constructor: Creates a new region from a given one.
+			 * @param region The region template.
+			 */
+			Region(const Region & region);
+
+			/**
+			 * Sets another region's rectangles into this region.
+			 * @param region The region to be set.
+			 */
+			void operator =(const Region & region);
+
+			/**
+			 * Adds a rectangle to the region. Empty rectangles are ignored.
+			 * @param position The top-left position of the rectangle.
+			 * @param size The size of the rectangle.
+			 */
+			void add(Vector position, Vector size);
+
+			/**
+			 * Removes all rectangles from the region.
+			 */
+			void clear();
+
+			/**
+			 * Returns the bounding box of all rectangles of the region.
+			 * @param position Set to the top-left position of the bounding box.
+			 * @param size Set to the size of the bounding box. Zero if the region is empty.
+			 */
+			void getBounds(Vector & position, Vector & size);
+
+			/**
+			 * Returns the number of (disjoint) rectangles of the region.
+			 * @return The number of rectangles.
+			 */
+			int getRectangleCount();
+
+			/**
+			 * Returns the top-left position of the i-th rectangle of the region.
+			 * @param index The index of the rectangle.
+			 * @return The position.
+			 */
+			Vector getRectanglePosition(int index);
+
+			/**
+			 * Returns the size of the i-th rectangle of the region.
+			 * @param index The index of the rectangle.
+			 * @return The size.
+			 */
+			Vector getRectangleSize(int index);
+
+			/**
+			 * Returns whether any rectangle of the region overlaps a given rectangle.
+			 * @param position The top-left position of the rectangle.
+			 * @param size The size of the rectangle.
+			 * @return Whether the region overlaps the rectangle.
+			 */
+			bool intersects(Vector position, Vector size);
+
+			/**
+			 * Returns whether the region contains no rectangles.
+			 * @return Whether the region is empty.
+			 */
+			bool isEmpty();
+
+			/**
+			 * Removes a rectangle from the region, splitting the rectangles it partly covers
+			 * into up to four pieces each. If the region has no room for the pieces of a rectangle,
+			 * that rectangle is kept entirely, so the region may cover more than the exact difference.
+			 * @param position The top-left position of the rectangle.
+			 * @param size The size of the rectangle.
+			 */
+			void subtract(Vector position, Vector size);
+
+			/**
+			 * Returns a string representation of the region for debugging purposes.
+			 * @return The string representation.
+			 */
+			String toString();
+	};
+}
+
+
+#endif
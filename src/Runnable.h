@@ -33,7 +33,7 @@ namespace glaziery
 			/**
 			 * Performs the operation.
 			 */
-			virtual void run() = NULL;
+			virtual void run() = 0;
 	};
 }
 
@@ -271,6 +271,12 @@ InputAttachment & Scene::getMouseYAxisAttachment()
 	return sceneAttachments.mouseYAxisAttachment;
 }
 
+long Scene::getNextFrameDelay()
+{
+	ASSERTION_COBJECT(this);
+	return -1;
+}
+
 #if defined(_DEBUG) && (defined(_AFX) || defined(_AFXDLL))
 	IMPLEMENT_DYNAMIC(Scene, CObject);
 #endif
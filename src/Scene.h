@@ -484,7 +484,7 @@ namespace glaziery
 			 * It is reasonable to provide a constant class field for other classes.
 			 * @see Desktop::setScene()
 			 */
-			virtual const char * getId() = NULL;
+			virtual const char * getId() = 0;
 
 			/**
 			 * Returns the scene joystick X axis attachment.
@@ -569,6 +569,18 @@ namespace glaziery
 			 */
 			InputAttachment & getMouseYAxisAttachment();
 
+			/**
+			 * Returns the time in milli seconds until the scene needs its next frame,
+			 * i.e. its next update() call, if no input arrives before.
+			 * Idle waiting desktops sleep that long.
+			 * @return The time in milli seconds until the next frame, 0 for the next frame,
+			 * or -1 if the scene does not need any frame without input.
+			 * @note The default implementation returns -1. Animating scenes and scenes
+			 * that poll for something in their update() method must return 0 (or their polling period).
+			 * @see Desktop::setIdleWaiting()
+			 */
+			virtual long getNextFrameDelay();
+
 			/**
 			 * Returns whether the configuration has been read successfully.
 			 * @return Whether the configuration has been read successfully.
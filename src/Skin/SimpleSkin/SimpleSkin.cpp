@@ -10,15 +10,15 @@
 #include <Glaziery/src/Headers.h>
 
 
-const int SimpleSkin::BLUE = GL_RGBA(40, 115, 155, 255);
+const unsigned long SimpleSkin::BLUE = GL_RGBA(40, 115, 155, 255);
 
-const int SimpleSkin::DARK_BLUE = GL_RGBA(20, 57, 116, 255);
+const unsigned long SimpleSkin::DARK_BLUE = GL_RGBA(20, 57, 116, 255);
 
-const int SimpleSkin::DEEP_DARK_BLUE = GL_RGBA(0, 0, 77, 255);
+const unsigned long SimpleSkin::DEEP_DARK_BLUE = GL_RGBA(0, 0, 77, 255);
 
 const char SimpleSkin::MASK_CHARACTER = '*';
 
-const int SimpleSkin::LIGHT_BLUE = GL_RGBA(226, 226, 249, 255);
+const unsigned long SimpleSkin::LIGHT_BLUE = GL_RGBA(226, 226, 249, 255);
 
 SimpleSkin::SimpleSkin()
 {
@@ -61,6 +61,7 @@ SimpleSkin::SimpleSkin()
 	rightWidgetImage = NULL;
 	rootImage = NULL;
 	selectPointerType = NULL;
+	splashDrawn = false;
 	unknownImage = NULL;
 	upWidgetImage = NULL;
 	virtualImage = NULL;
@@ -339,8 +340,6 @@ void SimpleSkin::drawListFieldCell(DrawingContext & context, ListField::Cell * c
 {
 	ASSERTION_COBJECT(this);
 
-	int rowHeight = getListFieldRowHeight(cell->getField());
-
 	if (focused)
 	{
 		PlatformAdapter * adapter = Desktop::getInstance()->getPlatformAdapter();
@@ -367,7 +366,8 @@ void SimpleSkin::drawListFieldCell(DrawingContext & context, ListField::Cell * c
 			x = cell->getColumn()->getWidth() - elementsWidth;
 	}
 
-	FieldElement::drawElements(context, elements, cellSize.y, textElements, !textElements);
+	DrawingContext elementsContext(context, Vector(x, 0));
+	FieldElement::drawElements(elementsContext, elements, cellSize.y, 0, textElements, !textElements);
 }
 
 void SimpleSkin::drawListFieldRow(DrawingContext & context, ListField::Row * row, bool focused)
@@ -411,8 +411,8 @@ void SimpleSkin::drawListFieldRow(DrawingContext & context, ListField::Row * row
 			&& position.x < rowsField->getScrollPositionNow().x + rowsField->getContentViewSize().x)
 		{
 			Vector cellSize = Vector(columnWidth, rowHeight);
-			drawListFieldCell(DrawingContext(context, position, cellSize),
-				cells.Get(i), cellSize, focused && field->getFocusColumnNo() == i, true);
+			DrawingContext cellContext(context, position, cellSize);
+			drawListFieldCell(cellContext, cells.Get(i), cellSize, focused && field->getFocusColumnNo() == i, true);
 		}
 
 		position.x += columnWidth + columnBorderWidth;
@@ -432,8 +432,8 @@ void SimpleSkin::drawListFieldRow(DrawingContext & context, ListField::Row * row
 			&& position.x < rowsField->getScrollPositionNow().x + rowsField->getContentViewSize().x)
 		{
 			Vector cellSize = Vector(columnWidth, rowHeight);
-			drawListFieldCell(DrawingContext(context, position, cellSize),
-				cells.Get(i), cellSize, focused && field->getFocusColumnNo() == i, false);
+			DrawingContext cellContext(context, position, cellSize);
+			drawListFieldCell(cellContext, cells.Get(i), cellSize, focused && field->getFocusColumnNo() == i, false);
 		}
 
 		position.x += columnWidth + columnBorderWidth;
@@ -446,27 +446,28 @@ void SimpleSkin::drawListFieldRowsField(DrawingContext & context, ListField::Row
 
 	PlatformAdapter * adapter = Desktop::getInstance()->getPlatformAdapter();
 	ListField * listField = field->getListField();
-	const ArrayList<ListField::Row> & rows = listField->getRows();
+	int rowCount = listField->getRowCount();
 	const ArrayList<ListField::Column> & columns = listField->getColumns();
 
 	adapter->drawRect(context, Vector(), context.getClippingSize() - Vector(1, 1),
 		GL_COLOR_A(DEEP_DARK_BLUE, getAlpha(field)));
 
-	if (!field->isVisible() || rows.IsEmpty() || columns.IsEmpty())
+	if (!field->isVisible() || rowCount == 0 || columns.IsEmpty())
 		return;
 
 	int rowHeight = getListFieldRowHeight(listField);
+	int rowWidth = listField->getRowWidth();
+	int focusRowNo = listField->getFocusRowNo();
 
-	int firstVisibleRow = field->getScrollPositionNow().y / rowHeight;
-	if (firstVisibleRow < 0)
-		firstVisibleRow = 0;
-	int lastVisibleRow = (field->getScrollPositionNow().y + field->getContentViewSize().y) / rowHeight;
-	if (lastVisibleRow > rows.GetCount() - 1)
-		lastVisibleRow = rows.GetCount() - 1;
-
-	for (int i=0; i<=lastVisibleRow; i++)
-		drawListFieldRow(DrawingContext(context, Vector(0, rowHeight * i),
-			Vector(listField->getRowWidth(), rowHeight)), rows.Get(i), i == listField->getFocusRowNo());
+	// Virtual list fields materialize the rows drawn, so draw the visible ones only
+	int firstVisibleRow;
+	int lastVisibleRow;
+	listField->getVisibleRowNos(firstVisibleRow, lastVisibleRow);
+	for (int i=firstVisibleRow; i<=lastVisibleRow; i++)
+	{
+		DrawingContext rowContext(context, Vector(0, rowHeight * i), Vector(rowWidth, rowHeight));
+		drawListFieldRow(rowContext, listField->getRow(i), i == focusRowNo);
+	}
 }
 
 void SimpleSkin::drawMenuPopup(DrawingContext & context, MenuPopup * menuPopup)
@@ -569,7 +570,6 @@ void SimpleSkin::drawScrollingComponent(DrawingContext & context, Component * co
 	int scrollerBreadth = 16;
 	bool horizontallyScrollable = false;
 	bool verticallyScrollable = false;
-	Skin * skin = Desktop::getInstance()->getSkin();
 	if (field != NULL)
 	{
 		fillScrollerInfo(info, field);
@@ -749,7 +749,8 @@ void SimpleSkin::drawSplash(DrawingContext & context)
 
 	Desktop * desktop = Desktop::getInstance();
 	unsigned long frameTime = desktop->getFrameTime();
-	if (frameTime > 3000 && frameTime < 12000)
+	splashDrawn = frameTime > 3000 && frameTime < 12000;
+	if (splashDrawn)
 	{
 		int alpha;
 		if (frameTime > 3000 && frameTime < 3500)
@@ -976,7 +977,6 @@ void SimpleSkin::drawTreeFieldItem(DrawingContext & context, TreeField::Item * i
 	DrawingContext itemContext(context, item->getPosition());
 	Vector widgetSize = getTreeFieldExpansionWidgetSize(item);
 	int elementSpaceWidth = getTreeFieldElementSpaceWidth(item);
-	int itemsSpace = getTreeFieldItemSpaceHeight(field);
 
 	// Draw selection background
 
@@ -1157,7 +1157,7 @@ Vector SimpleSkin::getCheckBoxSize(CheckBox * checkBox)
 	ASSERTION_COBJECT(this);
 
 	Vector textSize = checkBox->getFont()->getSize(checkBox->getText(), checkBox->isCaps(), true);
-	return Vector(20 + textSize.x, max(15, textSize.y));
+	return Vector(20 + textSize.x, textSize.y > 15 ? textSize.y : 15);
 }
 
 PointerType * SimpleSkin::getDefaultDraggingPointerType()
@@ -1292,6 +1292,26 @@ Image * SimpleSkin::getMessageDialogIconImage(MessageDialog::Icon icon)
 	}
 }
 
+long SimpleSkin::getNextFrameDelay()
+{
+	ASSERTION_COBJECT(this);
+
+	Desktop * desktop = Desktop::getInstance();
+
+	// Fade the focusables while switching between modal and non-modal mode
+	if (desktop->isModal() ? focusableFactor > 0 : focusableFactor < 250)
+		return 0;
+
+	// Animate the splash while it is displayed, and erase it afterwards
+	unsigned long frameTime = desktop->getFrameTime();
+	if ((frameTime > 3000 && frameTime < 12000) || splashDrawn)
+		return 0;
+	if (frameTime <= 3000)
+		return (long) (3001 - frameTime);
+
+	return -1;
+}
+
 Image * SimpleSkin::getPathTypeImage(Path::Type type)
 {
 	ASSERTION_COBJECT(this);
@@ -1319,7 +1339,7 @@ Vector SimpleSkin::getRadioBoxSize(RadioBox * radioBox)
 	ASSERTION_COBJECT(this);
 
 	Vector textSize = radioBox->getFont()->getSize(radioBox->getText(), radioBox->isCaps(), true);
-	return Vector(20 + textSize.x, max(15, textSize.y));
+	return Vector(20 + textSize.x, textSize.y > 15 ? textSize.y : 15);
 }
 
 int SimpleSkin::getSelectorHeight(Selector * selector)
@@ -1362,8 +1382,6 @@ void SimpleSkin::getTabbingAreaFrameSizes(TabbingArea * area,
 {
 	ASSERTION_COBJECT(this);
 
-	PlatformAdapter * adapter = Desktop::getInstance()->getPlatformAdapter();
-
 	const ArrayList<ClientArea> & panes = area->getPanes();
 	int panesCount = panes.GetCount();
 	int x = 0;
@@ -1538,8 +1556,6 @@ void SimpleSkin::initialize()
 
 	Skin::initialize();
 
-	PlatformAdapter * adapter = Desktop::getInstance()->getPlatformAdapter();
-
 	initializeFonts();
 	initializeRegularImages();
 	initializePathTypeImages();
@@ -1821,6 +1837,12 @@ void SimpleSkin::update()
 	ASSERTION_COBJECT(this);
 
 	Desktop * desktop = Desktop::getInstance();
+
+	// The splash fades in and out, so redraw it (and erase it) while it is displayed
+	unsigned long frameTime = desktop->getFrameTime();
+	if ((frameTime > 3000 && frameTime < 12000) || splashDrawn)
+		desktop->invalidate();
+
 	if (desktop->isModal())
 	{
 		if (focusableFactor > 0)
@@ -2176,21 +2198,11 @@ void SimpleSkin::ScrollingComponentHandleWidget::onDragMove(const Vector & start
 		return;
 
 	ScrollerInfo info;
-	bool horizontallyScrollable = false;
-	bool verticallyScrollable = false;
 	Skin * skin = Desktop::getInstance()->getSkin();
 	if (field != NULL)
-	{
 		skin->fillScrollerInfo(info, field);
-		horizontallyScrollable = field->isHorizontallyScrollable();
-		verticallyScrollable = field->isVerticallyScrollable();
-	}
 	else if (area != NULL)
-	{
 		skin->fillScrollerInfo(info, area);
-		horizontallyScrollable = area->isHorizontallyScrollable();
-		verticallyScrollable = area->isVerticallyScrollable();
-	}
 
 	if (direction == HORIZONTALLY)
 	{
@@ -2480,7 +2492,6 @@ int SimpleSkin::TabWidget::getTabAt(Vector position)
 	ASSERTION_COBJECT(this);
 
 	SimpleSkin * skin = (SimpleSkin *) Desktop::getInstance()->getSkin();
-	PlatformAdapter * adapter = Desktop::getInstance()->getPlatformAdapter();
 	TabbingArea * area = (TabbingArea *) getParent();
 
 	const ArrayList<ClientArea> & panes = area->getPanes();
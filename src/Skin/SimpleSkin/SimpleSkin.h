@@ -125,7 +125,7 @@ namespace glaziery
 			{
 				protected:
 
-					int TabWidget::getTabAt(Vector position);
+					int getTabAt(Vector position);
 					virtual void onClick(Vector position, bool option1, bool option2);
 
 				public:
@@ -200,10 +200,10 @@ namespace glaziery
 
 		protected:
 
-			static const int BLUE;
-			static const int DARK_BLUE;
-			static const int DEEP_DARK_BLUE;
-			static const int LIGHT_BLUE;
+			static const unsigned long BLUE;
+			static const unsigned long DARK_BLUE;
+			static const unsigned long DEEP_DARK_BLUE;
+			static const unsigned long LIGHT_BLUE;
 			static const char MASK_CHARACTER;
 
 			Image * cdromImage;
@@ -243,6 +243,7 @@ namespace glaziery
 			Image * rightWidgetImage;
 			Image * rootImage;
 			PointerType * selectPointerType;
+			bool splashDrawn;
 			Font * tabFont;
 			Image * unknownImage;
 			Image * upWidgetImage;
@@ -324,6 +325,7 @@ namespace glaziery
 			virtual int getListFieldHeadingHeight(ListField * field);
 			virtual int getListFieldRowHeight(ListField * field);
 			virtual Image * getMessageDialogIconImage(MessageDialog::Icon icon);
+			virtual long getNextFrameDelay();
 			virtual Vector getMenuItemSize(Menu::Item * item);
 			virtual void getMenuPopupBorderSizes(MenuPopup * menuPopup,
 				Vector & topLeftSize, Vector & bottomRightSize);
@@ -57,6 +57,12 @@ void Skin::fillScrollerInfo(ScrollerInfo & info, ScrollingField * field)
 	info.fillInfo(field);
 }
 
+long Skin::getNextFrameDelay()
+{
+	ASSERTION_COBJECT(this);
+	return -1;
+}
+
 Vector Skin::getScrollingAreaScrollPosition(ScrollingArea * area)
 {
 	ASSERTION_COBJECT(this);
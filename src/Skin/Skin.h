@@ -88,7 +88,7 @@ namespace glaziery
 			 * If this skin does not emit effects, the method does nothing.
 			 * @param popup The popup to be created visually.
 			 */
-			virtual void addPopupCreateEffect(Popup * popup) = NULL;
+			virtual void addPopupCreateEffect(Popup * popup) = 0;
 
 			/**
 			 * Creates a new effect for destroying a popup and adds it to the Desktop.
@@ -98,7 +98,7 @@ namespace glaziery
 			 * @param popup The popup to be destroyed with or without effect.
 			 * @see Component::destroy()
 			 */
-			virtual void addPopupDestroyEffect(Popup * popup) = NULL;
+			virtual void addPopupDestroyEffect(Popup * popup) = 0;
 
 			/**
 			 * Creates a new effect for creating a window and adds it to the Desktop.
@@ -106,7 +106,7 @@ namespace glaziery
 			 * If this skin does not emit effects, the method does nothing.
 			 * @param window The window to be created visually.
 			 */
-			virtual void addWindowCreateEffect(Window * window) = NULL;
+			virtual void addWindowCreateEffect(Window * window) = 0;
 
 			/**
 			 * Creates a new effect for destroying a window and adds it to the Desktop.
@@ -116,7 +116,7 @@ namespace glaziery
 			 * @param window The window to be destroyed with or without effect.
 			 * @see Component::destroy()
 			 */
-			virtual void addWindowDestroyEffect(Window * window) = NULL;
+			virtual void addWindowDestroyEffect(Window * window) = 0;
 
 			/**
 			 * Cancels any pending scrolling area scroll effects.
@@ -145,7 +145,7 @@ namespace glaziery
 			 * @param popup The popup to be drawn.
 			 * @see BalloonPopup
 			 */
-			virtual void drawBalloonPopup(DrawingContext & context, BalloonPopup * popup) = NULL;
+			virtual void drawBalloonPopup(DrawingContext & context, BalloonPopup * popup) = 0;
 
 			/**
 			 * Draws a button. This method is called from the button's draw() method.
@@ -154,7 +154,7 @@ namespace glaziery
 			 * @param button The button to be drawn.
 			 * @see Button
 			 */
-			virtual void drawButton(DrawingContext & context, Button * button) = NULL;
+			virtual void drawButton(DrawingContext & context, Button * button) = 0;
 
 			/**
 			 * Draws a check box. This method is called from the check box's draw() method.
@@ -163,7 +163,7 @@ namespace glaziery
 			 * @param checkBox The check box to be drawn.
 			 * @see CheckBox
 			 */
-			virtual void drawCheckBox(DrawingContext & context, CheckBox * checkBox) = NULL;
+			virtual void drawCheckBox(DrawingContext & context, CheckBox * checkBox) = 0;
 
 			/**
 			 * Draws the border and background of a client area popup.
@@ -181,7 +181,7 @@ namespace glaziery
 			 * rectangle for the drawing operation.
 			 * @see Desktop
 			 */
-			virtual void drawDesktop(DrawingContext & context) = NULL;
+			virtual void drawDesktop(DrawingContext & context) = 0;
 
 			/**
 			 * Draws the client area background of a fields area.
@@ -191,7 +191,7 @@ namespace glaziery
 			 * @param area The fields area to be drawn.
 			 * @see FieldsArea
 			 */
-			virtual void drawFieldsArea(DrawingContext & context, FieldsArea * area) = NULL;
+			virtual void drawFieldsArea(DrawingContext & context, FieldsArea * area) = 0;
 
 			/**
 			 * Draws a group field. This method is called from the group's draw() method.
@@ -201,7 +201,7 @@ namespace glaziery
 			 * @see ProgressBar
 			 */
 			virtual void drawGroupField(DrawingContext & context,
-				GroupField * groupField) = NULL;
+				GroupField * groupField) = 0;
 
 			/**
 			 * Draws an image field element. This method is called from the field element's draw() method.
@@ -210,7 +210,7 @@ namespace glaziery
 			 * @param element The image element to be drawn.
 			 * @see ImageElement
 			 */
-			virtual void drawImageElement(DrawingContext & context, ImageElement * element) = NULL;
+			virtual void drawImageElement(DrawingContext & context, ImageElement * element) = 0;
 
 			/**
 			 * Draws an image field. This method is called from the field's draw() method.
@@ -219,7 +219,7 @@ namespace glaziery
 			 * @param field The image field to be drawn.
 			 * @see ImageField
 			 */
-			virtual void drawImageField(DrawingContext & context, ImageField * field) = NULL;
+			virtual void drawImageField(DrawingContext & context, ImageField * field) = 0;
 
 			/**
 			 * Draws a key stroke field. This method is called from the field's draw() method.
@@ -229,7 +229,7 @@ namespace glaziery
 			 * @see KeyStrokeField
 			 */
 			virtual void drawKeyStrokeField(DrawingContext & context,
-				KeyStrokeField * field) = NULL;
+				KeyStrokeField * field) = 0;
 
 			/**
 			 * Draws a label. This method is called from the label's draw() method.
@@ -238,7 +238,7 @@ namespace glaziery
 			 * @param label The label to be drawn.
 			 * @see Label
 			 */
-			virtual void drawLabel(DrawingContext & context, Label * label) = NULL;
+			virtual void drawLabel(DrawingContext & context, Label * label) = 0;
 
 			/**
 			 * Draws a list field background, border, and heading.
@@ -249,7 +249,7 @@ namespace glaziery
 			 * @param field The list field to be drawn.
 			 * @see ListField
 			 */
-			virtual void drawListField(DrawingContext & context, ListField * field) = NULL;
+			virtual void drawListField(DrawingContext & context, ListField * field) = 0;
 
 			/**
 			 * Draws a list field's rows field background.
@@ -261,7 +261,7 @@ namespace glaziery
 			 * @see ListField
 			 */
 			virtual void drawListFieldRowsField(DrawingContext & context,
-				ListField::RowsField * field) = NULL;
+				ListField::RowsField * field) = 0;
 
 			/**
 			 * Draws a menu popup. This method is called from the menu popup's draw() method.
@@ -270,7 +270,7 @@ namespace glaziery
 			 * @param menuPopup The menu popup to be drawn.
 			 * @see MenuPopup
 			 */
-			virtual void drawMenuPopup(DrawingContext & context, MenuPopup * menuPopup) = NULL;
+			virtual void drawMenuPopup(DrawingContext & context, MenuPopup * menuPopup) = 0;
 
 			/**
 			 * Draws a progress bar. This method is called from the bar's draw() method.
@@ -280,7 +280,7 @@ namespace glaziery
 			 * @see ProgressBar
 			 */
 			virtual void drawProgressBar(DrawingContext & context,
-				ProgressBar * progressBar) = NULL;
+				ProgressBar * progressBar) = 0;
 
 			/**
 			 * Draws a radio box. This method is called from the radio box's draw() method.
@@ -289,7 +289,7 @@ namespace glaziery
 			 * @param radioBox The radio box to be drawn.
 			 * @see RadioBox
 			 */
-			virtual void drawRadioBox(DrawingContext & context, RadioBox * radioBox) = NULL;
+			virtual void drawRadioBox(DrawingContext & context, RadioBox * radioBox) = 0;
 
 			/**
 			 * Draws the scrolling widgets of a scrolling area.
@@ -300,7 +300,7 @@ namespace glaziery
 			 * @see ScrollingArea
 			 */
 			virtual void drawScrollingArea(DrawingContext & context,
-				ScrollingArea * area) = NULL;
+				ScrollingArea * area) = 0;
 
 			/**
 			 * Draws the scrolling widgets of a scrolling field.
@@ -311,7 +311,7 @@ namespace glaziery
 			 * @see ScrollingField
 			 */
 			virtual void drawScrollingField(DrawingContext & context,
-				ScrollingField * field) = NULL;
+				ScrollingField * field) = 0;
 
 			/**
 			 * Draws a selector. This method is called from the selector's draw() method.
@@ -320,7 +320,7 @@ namespace glaziery
 			 * @param selector The selector to be drawn.
 			 * @see Selector
 			 */
-			virtual void drawSelector(DrawingContext & context, Selector * selector) = NULL;
+			virtual void drawSelector(DrawingContext & context, Selector * selector) = 0;
 
 			/**
 			 * Draws the client area background of a single field area.
@@ -330,7 +330,7 @@ namespace glaziery
 			 * @param area The single field area to be drawn.
 			 * @see SingleFieldArea
 			 */
-			virtual void drawSingleFieldArea(DrawingContext & context, SingleFieldArea * area) = NULL;
+			virtual void drawSingleFieldArea(DrawingContext & context, SingleFieldArea * area) = 0;
 
 			/**
 			 * Draws the border and background of a single field popup.
@@ -340,7 +340,7 @@ namespace glaziery
 			 * @param popup The single field popup to be drawn.
 			 * @see SingleFieldPopup
 			 */
-			virtual void drawSingleFieldPopup(DrawingContext & context, SingleFieldPopup * popup) = NULL;
+			virtual void drawSingleFieldPopup(DrawingContext & context, SingleFieldPopup * popup) = 0;
 
 			/**
 			 * Draws a slider field. This method is called from the slider's draw() method.
@@ -349,7 +349,7 @@ namespace glaziery
 			 * @param slider The slider field to be drawn.
 			 * @see Slider
 			 */
-			virtual void drawSlider(DrawingContext & context, Slider * slider) = NULL;
+			virtual void drawSlider(DrawingContext & context, Slider * slider) = 0;
 
 			/**
 			 * Draws the splash text to show credits about this skin and about Glaziery.
@@ -357,7 +357,7 @@ namespace glaziery
 			 * @param context The drawing context that specifies the surface and clipping
 			 * rectangle for the drawing operation.
 			 */
-			virtual void drawSplash(DrawingContext & context) = NULL;
+			virtual void drawSplash(DrawingContext & context) = 0;
 
 			/**
 			 * Draws the client area background of a splitting area.
@@ -368,7 +368,7 @@ namespace glaziery
 			 * @see SplittingArea
 			 */
 			virtual void drawSplittingArea(DrawingContext & context,
-				SplittingArea * area) = NULL;
+				SplittingArea * area) = 0;
 
 			/**
 			 * Draws the client area background and the tabs of a tabbing area.
@@ -378,7 +378,7 @@ namespace glaziery
 			 * @param area The tabbing area to be drawn.
 			 * @see TabbingArea
 			 */
-			virtual void drawTabbingArea(DrawingContext & context, TabbingArea * area) = NULL;
+			virtual void drawTabbingArea(DrawingContext & context, TabbingArea * area) = 0;
 
 			/**
 			 * Draws an text field element. This method is called from the field element's draw() method.
@@ -387,7 +387,7 @@ namespace glaziery
 			 * @param element The text element to be drawn.
 			 * @see TextElement
 			 */
-			virtual void drawTextElement(DrawingContext & context, TextElement * element) = NULL;
+			virtual void drawTextElement(DrawingContext & context, TextElement * element) = 0;
 
 			/**
 			 * Draws a text field. This method is called from the field's draw() method.
@@ -396,7 +396,7 @@ namespace glaziery
 			 * @param field The text field to be drawn.
 			 * @see TextField
 			 */
-			virtual void drawTextField(DrawingContext & context, TextField * field) = NULL;
+			virtual void drawTextField(DrawingContext & context, TextField * field) = 0;
 
 			/**
 			 * Draws a tree field. This method is called from the field's draw() method.
@@ -405,7 +405,7 @@ namespace glaziery
 			 * @param field The tree field to be drawn.
 			 * @see TreeField
 			 */
-			virtual void drawTreeField(DrawingContext & context, TreeField * field) = NULL;
+			virtual void drawTreeField(DrawingContext & context, TreeField * field) = 0;
 
 			/**
 			 * Draws a window after the client area has drawn, called from the window's draw() method.
@@ -414,7 +414,7 @@ namespace glaziery
 			 * @param window The window to be drawn.
 			 * @see Window
 			 */
-			virtual void drawWindowAfterClientArea(DrawingContext & context, Window * window) = NULL;
+			virtual void drawWindowAfterClientArea(DrawingContext & context, Window * window) = 0;
 
 			/**
 			 * Draws a window before the client area has drawn, called from the window's draw() method.
@@ -423,7 +423,7 @@ namespace glaziery
 			 * @param window The window to be drawn.
 			 * @see Window
 			 */
-			virtual void drawWindowBeforeClientArea(DrawingContext & context, Window * window) = NULL;
+			virtual void drawWindowBeforeClientArea(DrawingContext & context, Window * window) = 0;
 
 			/**
 			 * Fills a given scroller info according to the properties of a given scrolling area.
@@ -447,28 +447,28 @@ namespace glaziery
 			 * @param popup The popup to return the border size of.
 			 * @return The border size.
 			 */
-			virtual Vector getBalloonBorderSize(BalloonPopup * popup) = NULL;
+			virtual Vector getBalloonBorderSize(BalloonPopup * popup) = 0;
 
 			/**
 			 * Returns the X offset of a balloon popup's pointing arrow from the nearer side.
 			 * @param popup The popup to return the arrow offset.
 			 * @return The arrow offset.
 			 */
-			virtual int getBalloonArrowOffset(BalloonPopup * popup) = NULL;
+			virtual int getBalloonArrowOffset(BalloonPopup * popup) = 0;
 
 			/**
 			 * Returns the size of a button to readjust it on image and/or text changes.
 			 * @param button The button to return the size of.
 			 * @return The size of the button.
 			 */
-			virtual Vector getButtonSize(Button * button) = NULL;
+			virtual Vector getButtonSize(Button * button) = 0;
 
 			/**
 			 * Returns the size of a check box to readjust it on text changes.
 			 * @param checkBox The check box to return the size of.
 			 * @return The size of the check box.
 			 */
-			virtual Vector getCheckBoxSize(CheckBox * checkBox) = NULL;
+			virtual Vector getCheckBoxSize(CheckBox * checkBox) = 0;
 
 			/**
 			 * Returns the default pointer type to be used when dragging.
@@ -476,13 +476,13 @@ namespace glaziery
 			 * another pointer type.
 			 * @return the default dragging pointer type.
 			 */
-			virtual PointerType * getDefaultDraggingPointerType() = NULL;
+			virtual PointerType * getDefaultDraggingPointerType() = 0;
 
 			/**
 			 * Returns the default font for fields.
 			 * @return the default font for fields.
 			 */
-			virtual Font * getDefaultFieldFont() = NULL;
+			virtual Font * getDefaultFieldFont() = 0;
 
 			/**
 			 * Returns the default pointer type to be used when an operation
@@ -491,7 +491,7 @@ namespace glaziery
 			 * another pointer type.
 			 * @return the default impossible pointer type.
 			 */
-			virtual PointerType * getDefaultImpossiblePointerType() = NULL;
+			virtual PointerType * getDefaultImpossiblePointerType() = 0;
 
 			/**
 			 * Fills integers with the dialog margins and spacings.
@@ -503,7 +503,7 @@ namespace glaziery
 			 * @return The horizontal dialog button margin.
 			 */
 			virtual void getDialogMargins(Dialog * dialog, int & bottomContentMargin,
-				int & buttonSpacing, int & iconContentSpacing) = NULL;
+				int & buttonSpacing, int & iconContentSpacing) = 0;
 
 			/**
 			 * Fills two vectors with the widths and heights of the top-left
@@ -514,13 +514,13 @@ namespace glaziery
 			 * @param bottomRightSize The vector to be filled with the bottom and right sizes.
 			 */
 			virtual void getGroupFieldMarginSizes(GroupField * field,
-				Vector & topLeftSize, Vector & bottomRightSize) = NULL;
+				Vector & topLeftSize, Vector & bottomRightSize) = 0;
 
 			/**
 			 * Returns the pointer type for the hour glass (waiting for an operation).
 			 * @return the hour glass pointer type.
 			 */
-			virtual PointerType * getHourGlassPointerType() = NULL;
+			virtual PointerType * getHourGlassPointerType() = 0;
 
 			/**
 			 * Returns the width of the border between two columns of a list field.
@@ -528,7 +528,7 @@ namespace glaziery
 			 * @param field The list field to return the border width of.
 			 * @return The width of the border.
 			 */
-			virtual int getListFieldColumnBorderWidth(ListField * field) = NULL;
+			virtual int getListFieldColumnBorderWidth(ListField * field) = 0;
 
 			/**
 			 * Returns the width of the padding between the elements of a list field's cell
@@ -536,28 +536,28 @@ namespace glaziery
 			 * @param field The list field to return the padding width of.
 			 * @return The width of the padding.
 			 */
-			virtual int getListFieldColumnPaddingWidth(ListField * field) = NULL;
+			virtual int getListFieldColumnPaddingWidth(ListField * field) = 0;
 
 			/**
 			 * Returns the height of the heading row of a list field.
 			 * @param field The list field to return the heading height of.
 			 * @return The height of the heading row.
 			 */
-			virtual int getListFieldHeadingHeight(ListField * field) = NULL;
+			virtual int getListFieldHeadingHeight(ListField * field) = 0;
 
 			/**
 			 * Returns the height of one row of a list field.
 			 * @param field The list field to return the row height of.
 			 * @return The height of one row.
 			 */
-			virtual int getListFieldRowHeight(ListField * field) = NULL;
+			virtual int getListFieldRowHeight(ListField * field) = 0;
 
 			/**
 			 * Returns the size of a menu item.
 			 * @param item The item to return the size of.
 			 * @return The size.
 			 */
-			virtual Vector getMenuItemSize(Menu::Item * item) = NULL;
+			virtual Vector getMenuItemSize(Menu::Item * item) = 0;
 
 			/**
 			 * Fills two vectors with the widths and heights of the top-left
@@ -570,14 +570,25 @@ namespace glaziery
 			 * with the bottom and right sizes.
 			 */
 			virtual void getMenuPopupBorderSizes(MenuPopup * menuPopup,
-				Vector & topLeftSize, Vector & bottomRightSize) = NULL;
+				Vector & topLeftSize, Vector & bottomRightSize) = 0;
 
 			/**
 			 * Returns a message dialog icon for a given identifier.
 			 * @param icon The icon identifier.
 			 * @return The icon image.
 			 */
-			virtual Image * getMessageDialogIconImage(MessageDialog::Icon icon) = NULL;
+			virtual Image * getMessageDialogIconImage(MessageDialog::Icon icon) = 0;
+
+			/**
+			 * Returns the time in milli seconds until the skin needs its next frame,
+			 * e.g. for the next step of an animation it performs in update().
+			 * Idle waiting desktops sleep that long, unless input arrives earlier.
+			 * @return The time in milli seconds until the next frame, 0 for the next frame,
+			 * or -1 if the skin does not need any frame without input.
+			 * @note The default implementation returns -1.
+			 * @see Desktop::setIdleWaiting()
+			 */
+			virtual long getNextFrameDelay();
 
 			/**
 			 * Returns the icon image used for resources of a given type,
@@ -585,14 +596,14 @@ namespace glaziery
 			 * @param type The type of resource to return the image for.
 			 * @return The icon image.
 			 */
-			virtual Image * getPathTypeImage(Path::Type type) = NULL;
+			virtual Image * getPathTypeImage(Path::Type type) = 0;
 
 			/**
 			 * Returns the size of a radio box to readjust it on text changes.
 			 * @param radioBox The radio box to return the size of.
 			 * @return The size of the radio box.
 			 */
-			virtual Vector getRadioBoxSize(RadioBox * radioBox) = NULL;
+			virtual Vector getRadioBoxSize(RadioBox * radioBox) = 0;
 
 			/**
 			 * Returns the scroll position of a scrolling area, e.g. by getting the
@@ -617,13 +628,13 @@ namespace glaziery
 			 * @param selector The selector to return the height of.
 			 * @return The height of the selector.
 			 */
-			virtual int getSelectorHeight(Selector * selector) = NULL;
+			virtual int getSelectorHeight(Selector * selector) = 0;
 
 			/**
 			 * Returns the pointer type for the select pointer.
 			 * @return the select pointer type.
 			 */
-			virtual PointerType * getSelectPointerType() = NULL;
+			virtual PointerType * getSelectPointerType() = 0;
 
 			/**
 			 * Fills two vectors with the widths and heights of the top-left
@@ -636,14 +647,14 @@ namespace glaziery
 			 * with the bottom and right sizes.
 			 */
 			virtual void getSingleFieldPopupBorderSizes(SingleFieldPopup * popup,
-				Vector & topLeftSize, Vector & bottomRightSize) = NULL;
+				Vector & topLeftSize, Vector & bottomRightSize) = 0;
 
 			/**
 			 * Returns the size (width resp. height) of the splitter of a splitter area.
 			 * @param area The splitting area to return the size of.
 			 * @return The size of the splitter of a splitter area.
 			 */
-			virtual int getSplitterSize(SplittingArea * area) = NULL;
+			virtual int getSplitterSize(SplittingArea * area) = 0;
 
 			/**
 			 * Fills two vectors with the widths and heights of the top-left
@@ -658,7 +669,7 @@ namespace glaziery
 			 * with the bottom and right sizes.
 			 */
 			virtual void getTabbingAreaFrameSizes(TabbingArea * area,
-				Vector & topLeftSize, Vector & bottomRightSize) = NULL;
+				Vector & topLeftSize, Vector & bottomRightSize) = 0;
 
 			/**
 			 * Returns the size of the scrolling field content
@@ -667,14 +678,14 @@ namespace glaziery
 			 * @param field The text field to return content size of.
 			 * @return The size of the text field content.
 			 */
-			virtual Vector getTextFieldContentSize(TextField * field) = NULL;
+			virtual Vector getTextFieldContentSize(TextField * field) = 0;
 
 			/**
 			 * Returns the cursor width of a text field.
 			 * @param field The text field to cursor widht of.
 			 * @return The width of the cursor.
 			 */
-			virtual int getTextFieldCursorWidth(TextField * field) = NULL;
+			virtual int getTextFieldCursorWidth(TextField * field) = 0;
 
 			/**
 			 * Sets the row and column of a given pixel position into given variables.
@@ -683,28 +694,28 @@ namespace glaziery
 			 * @param position The position to set the row and column of.
 			 */
 			virtual void getTextFieldRowAndColumnAtPosition(TextField * field,
-				int & row, int & column, Vector position) = NULL;
+				int & row, int & column, Vector position) = 0;
 
 			/**
 			 * Returns the width of the space between the elements of a tree field item.
 			 * @param item The tree field item.
 			 * @return The width of the item elements space.
 			 */
-			virtual int getTreeFieldElementSpaceWidth(TreeField::Item * item) = NULL;
+			virtual int getTreeFieldElementSpaceWidth(TreeField::Item * item) = 0;
 
 			/**
 			 * Returns the size of the tree field expansion widget of a tree field item.
 			 * @param item The tree field item.
 			 * @return The size of the tree field expansion widget.
 			 */
-			virtual Vector getTreeFieldExpansionWidgetSize(TreeField::Item * item) = NULL;
+			virtual Vector getTreeFieldExpansionWidgetSize(TreeField::Item * item) = 0;
 
 			/**
 			 * Returns the height of the space between items of a tree field.
 			 * @param field The tree field.
 			 * @return The height of the items space.
 			 */
-			virtual int getTreeFieldItemSpaceHeight(TreeField * field) = NULL;
+			virtual int getTreeFieldItemSpaceHeight(TreeField * field) = 0;
 
 			/**
 			 * Fills two vectors with the widths and heights of the top-left
@@ -717,7 +728,7 @@ namespace glaziery
 			 * with the bottom and right sizes.
 			 */
 			virtual void getWindowFrameSizes(Window * window,
-				Vector & topLeftSize, Vector & bottomRightSize) = NULL;
+				Vector & topLeftSize, Vector & bottomRightSize) = 0;
 
 			/**
 			 * Returns the modulation color used when actually rendering a given window.
@@ -1077,7 +1088,7 @@ namespace glaziery
 			 * if its candy mode changes.
 			 * @param progressBar The progress bar whose candy mode changed.
 			 */
-			virtual void updateProgressBarCandyMode(ProgressBar * progressBar) = NULL;
+			virtual void updateProgressBarCandyMode(ProgressBar * progressBar) = 0;
 	};
 }
 
@@ -261,7 +261,7 @@ namespace glaziery
 
 			bool isCanceled();
 
-			virtual void run() = NULL;
+			virtual void run() = 0;
 	};
 }
 
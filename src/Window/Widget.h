@@ -88,7 +88,7 @@ namespace glaziery
 			 * position of the widget's component.
 			 * @return Whether the point lies within the widget.
 			 */
-			virtual bool isHitAt(Vector point) = NULL;
+			virtual bool isHitAt(Vector point) = 0;
 
 			/**
 			 * Returns a string reprensentation of this object.
@@ -161,10 +161,19 @@ void Window::drawContent(DrawingContext & context)
 	Skin * skin = desktop->getSkin();
 
 	adapter->clear(context);
-	skin->drawWindowBeforeClientArea(context, this);
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawWindowBeforeClientArea")
+		skin->drawWindowBeforeClientArea(context, this);
+	}
 	if (clientArea != NULL && clientArea->isVisible())
-		clientArea->draw(DrawingContext(context, clientArea));
-	skin->drawWindowAfterClientArea(context, this);
+	{
+		DrawingContext clientAreaContext(context, clientArea);
+		clientArea->draw(clientAreaContext);
+	}
+	{
+		GLAZIERY_PROFILERZONE("Skin::drawWindowAfterClientArea")
+		skin->drawWindowAfterClientArea(context, this);
+	}
 }
 
 void Window::executeDeferrals()
@@ -758,6 +767,7 @@ void Window::setStayOnTop(bool stayOnTop)
 void Window::setTitle(const String & title)
 {
 	ASSERTION_COBJECT(this);
+	GLAZIERY_INVALIDATIONCAUSE(CAUSE_TEXT)
 
 	if (this->title == title)
 		return;